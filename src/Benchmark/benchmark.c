@@ -0,0 +1,116 @@
+/**
+ * @file benchmark.c
+ * @author Hugo Cruz (a23010)
+ * @brief Programa de medição de desempenho dos algoritmos de caminhos.
+ *
+ * Este programa gera um grafo em grelha (semelhante a uma rede de estradas) com pesos aleatórios
+ * e mede o tempo do cálculo dos k caminhos mais curtos para k = 1 até 50.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "../Grafos/kcaminhos.h"
+
+/**
+ * @brief Devolve o instante atual em segundos.
+ *
+ * @return double Segundos desde uma origem fixa.
+ */
+static double Agora()
+{
+	struct timespec t;
+	timespec_get(&t, TIME_UTC);
+	return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Cria um grafo em grelha com ligações nos dois sentidos.
+ *
+ * O vértice da linha l e coluna c tem o id l * colunas + c + 1. Cada vértice liga aos vizinhos
+ * da direita e de baixo, e vice-versa, com pesos aleatórios entre 1 e 100.
+ *
+ * @param linhas Número de linhas da grelha.
+ * @param colunas Número de colunas da grelha.
+ * @return Grafo* Apontador para o grafo criado.
+ */
+static Grafo* CriarGrafoGrelha(int linhas, int colunas)
+{
+	bool inf;
+	Grafo* g = CriarGrafo(&inf);
+
+	for (int i = 1; i <= linhas * colunas; i++)
+	{
+		g = InserirVerticeGrafo(g, i, &inf);
+	}
+
+	for (int l = 0; l < linhas; l++)
+	{
+		for (int c = 0; c < colunas; c++)
+		{
+			int id = l * colunas + c + 1;
+
+			if (c + 1 < colunas)
+			{
+				g = InserirAdjGrafo(g, id, id + 1, 1 + rand() % 100, &inf);
+				g = InserirAdjGrafo(g, id + 1, id, 1 + rand() % 100, &inf);
+			}
+
+			if (l + 1 < linhas)
+			{
+				g = InserirAdjGrafo(g, id, id + colunas, 1 + rand() % 100, &inf);
+				g = InserirAdjGrafo(g, id + colunas, id, 1 + rand() % 100, &inf);
+			}
+		}
+	}
+
+	return g;
+}
+
+/**
+ * @brief Função principal do programa de medição.
+ *
+ * @param argc Números de argumentos
+ * @param argv Array de strings (lado da grelha e semente, opcionais)
+ */
+int main(int argc, char* argv[])
+{
+	int lado = argc > 1 ? atoi(argv[1]) : 40;
+	unsigned semente = argc > 2 ? (unsigned)atoi(argv[2]) : 7;
+	bool inf;
+
+	srand(semente);
+
+	double t0 = Agora();
+	Grafo* g = CriarGrafoGrelha(lado, lado);
+	printf("construcao grelha %dx%d: %.3f s\n", lado, lado, Agora() - t0);
+
+	//Cantos opostos da grelha, que têm muitos caminhos alternativos
+	int origem = 1, destino = lado * lado;
+
+	printf("k;caminhos;segundos;custo_k\n");
+
+	for (int k = 1; k <= 50; k++)
+	{
+		t0 = Agora();
+		ConjuntoCaminhos* c = KCaminhosMaisCurtos(g, origem, destino, k, &inf);
+		double t = Agora() - t0;
+
+		if (c == NULL)
+		{
+			printf("%d;erro\n", k);
+			continue;
+		}
+
+		printf("%d;%d;%.6f;%lld\n", k, c->total, t, c->total > 0 ? (long long)c->custos[c->total - 1] : -1);
+		ApagarConjuntoCaminhos(c);
+	}
+
+	ApagaGrafo(g);
+	return 0;
+}
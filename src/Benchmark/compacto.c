@@ -0,0 +1,214 @@
+/**
+ * @file compacto.c
+ * @author Hugo Cruz (a23010)
+ * @brief Programa de medição da memória e do tempo das pesquisas com as adjacências comprimidas.
+ *
+ * Este programa gera uma grelha (ou carrega uma lista origem;destino;peso com ids externos),
+ * renumera os vértices com a ordem RCM e compara a lista de adjacências, a imagem com arrays
+ * contíguos e a imagem comprimida: bytes por adjacência e tempo médio das pesquisas de Dijkstra
+ * e em largura.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "../Grafos/InputOutput.h"
+#include "../Grafos/lote.h"
+#include "../Grafos/reordenar.h"
+#include "../Grafos/compacto.h"
+
+/**
+ * @def NUM_PESQUISAS
+ * @brief Número de pesquisas de cada tipo por representação.
+ */
+#define NUM_PESQUISAS 20
+
+/**
+ * @brief Devolve o instante atual em segundos.
+ *
+ * @return double Segundos desde uma origem fixa.
+ */
+static double Agora()
+{
+	struct timespec t;
+	timespec_get(&t, TIME_UTC);
+	return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Cria uma grelha com ligações nos dois sentidos e pesos entre 1 e 100.
+ *
+ * @param lado Número de linhas e de colunas.
+ * @return Grafo* Apontador para o grafo criado.
+ */
+static Grafo* CriarGrafoGrelha(int lado)
+{
+	bool inf;
+	Grafo* g = CriarGrafo(&inf);
+	LoteAlteracoes* l = CriarLoteAlteracoes(lado * lado * 5, &inf);
+
+	for (int i = 0; i < lado * lado; i++)
+	{
+		InserirVerticeLote(l, i, &inf);
+	}
+
+	for (int i = 0; i < lado * lado; i++)
+	{
+		if ((i + 1) % lado != 0)
+		{
+			InserirAdjLote(l, i, i + 1, 1 + rand() % 100, &inf);
+			InserirAdjLote(l, i + 1, i, 1 + rand() % 100, &inf);
+		}
+
+		if (i + lado < lado * lado)
+		{
+			InserirAdjLote(l, i, i + lado, 1 + rand() % 100, &inf);
+			InserirAdjLote(l, i + lado, i, 1 + rand() % 100, &inf);
+		}
+	}
+
+	g = AplicarLoteGrafo(g, l, &inf);
+	ApagarLoteAlteracoes(l);
+	return g;
+}
+
+/**
+ * @brief Pesquisa em largura sobre uma imagem com arrays contíguos.
+ *
+ * @param im Apontador para a imagem.
+ * @param origem Vértice de origem.
+ * @param nivel Array com o nível de cada vértice (-1 se não alcançado).
+ * @param fila Array auxiliar com im->tamanho posições.
+ * @return int Número de vértices alcançados.
+ */
+static int Largura(ImagemGrafo* im, int origem, int nivel[], int fila[])
+{
+	for (int i = 0; i < im->tamanho; i++)
+	{
+		nivel[i] = -1;
+	}
+
+	int frente = 0, fim = 0;
+	fila[fim++] = origem;
+	nivel[origem] = 0;
+
+	while (frente < fim)
+	{
+		int u = fila[frente++];
+
+		for (int i = im->inicio[u]; i < im->inicio[u + 1]; i++)
+		{
+			int w = im->destinos[i];
+
+			if (nivel[w] == -1)
+			{
+				nivel[w] = nivel[u] + 1;
+				fila[fim++] = w;
+			}
+		}
+	}
+
+	return fim;
+}
+
+/**
+ * @brief Função principal do programa de medição.
+ *
+ * @param argc Números de argumentos
+ * @param argv Array de strings (ficheiro ou lado da grelha, opcional)
+ */
+int main(int argc, char* argv[])
+{
+	char* origem = argc > 1 ? argv[1] : "500";
+	MapaIds* m = NULL;
+	bool inf;
+
+	srand(7);
+	Grafo* g = CarregaAdjacenciasExternas(origem, &m);
+
+	if (g == NULL)
+	{
+		g = CriarGrafoGrelha(atoi(origem) > 0 ? atoi(origem) : 500);
+	}
+
+	ApagarMapaIds(m);
+
+	//A compressão das diferenças depende de os vizinhos terem ids próximos
+	int tamanho;
+	int* novoId = CalcularOrdemVertices(g, ORDEM_RCM, &tamanho, &inf);
+	g = RenumerarGrafo(g, novoId, tamanho, &inf);
+	free(novoId);
+
+	ImagemGrafo* im = CriarImagemGrafo(g, &inf);
+	ImagemCompacta* c = ComprimirImagemGrafo(im, &inf);
+	EspacoCaminhos* e = CriarEspacoImagem(im, &inf);
+	int* nivel = (int*)malloc(sizeof(int) * im->tamanho);
+	int* fila = (int*)malloc(sizeof(int) * im->tamanho);
+	int origens[NUM_PESQUISAS];
+
+	for (int i = 0; i < NUM_PESQUISAS; i++)
+	{
+		do
+		{
+			origens[i] = rand() % im->tamanho;
+		} while (!im->existe[origens[i]]);
+	}
+
+	double arestas = im->numArestas > 0 ? im->numArestas : 1;
+	double lista = ((double)sizeof(Vertice) * im->numVertices + (double)sizeof(Adjacente) * im->numArestas) / arestas;
+	double contigua = ((double)(sizeof(int) + sizeof(PesoAresta)) * im->numArestas +
+		(double)(sizeof(int) + sizeof(bool)) * (im->tamanho + 1)) / arestas;
+	double comprimida = MemoriaImagemCompacta(c) / arestas;
+
+	printf("representacao;vertices;arestas;bytes_aresta;ms_dijkstra;ms_largura\n");
+	printf("lista;%d;%d;%.2f;;\n", im->numVertices, im->numArestas, lista);
+
+	double t0 = Agora();
+
+	for (int i = 0; i < NUM_PESQUISAS; i++)
+	{
+		DijkstraImagem(im, e, origens[i], -1);
+	}
+
+	double dijkstra = (Agora() - t0) / NUM_PESQUISAS * 1e3;
+	t0 = Agora();
+
+	for (int i = 0; i < NUM_PESQUISAS; i++)
+	{
+		Largura(im, origens[i], nivel, fila);
+	}
+
+	double largura = (Agora() - t0) / NUM_PESQUISAS * 1e3;
+	printf("contigua;%d;%d;%.2f;%.3f;%.3f\n", im->numVertices, im->numArestas, contigua, dijkstra, largura);
+
+	t0 = Agora();
+
+	for (int i = 0; i < NUM_PESQUISAS; i++)
+	{
+		DijkstraCompacta(c, e, origens[i], -1);
+	}
+
+	dijkstra = (Agora() - t0) / NUM_PESQUISAS * 1e3;
+	t0 = Agora();
+
+	for (int i = 0; i < NUM_PESQUISAS; i++)
+	{
+		LarguraCompacta(c, origens[i], -1, nivel);
+	}
+
+	largura = (Agora() - t0) / NUM_PESQUISAS * 1e3;
+	printf("comprimida;%d;%lld;%.2f;%.3f;%.3f\n", c->numVertices, c->numArestas, comprimida, dijkstra, largura);
+
+	free(nivel);
+	free(fila);
+	ApagarEspacoCaminhos(e);
+	ApagarImagemCompacta(c);
+	ApagarImagemGrafo(im);
+	ApagaGrafo(g);
+	return 0;
+}
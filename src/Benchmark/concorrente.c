@@ -0,0 +1,146 @@
+/**
+ * @file concorrente.c
+ * @author Hugo Cruz (a23010)
+ * @brief Programa de medição da inserção de adjacências por várias threads ao mesmo tempo.
+ *
+ * Este programa constrói o mesmo grafo aleatório com 1, 2, 4 e 8 threads escritoras e escreve o
+ * número de adjacências inseridas por segundo em cada caso.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include <threads.h>
+#include "../Grafos/concorrente.h"
+
+/**
+ * @brief Estado de uma thread escritora.
+ *
+ */
+typedef struct Escritor
+{
+	GrafoConcorrente* gc; ///< Construção partilhada.
+	int numVertices;	  ///< Número de vértices do grafo.
+	int primeira;		  ///< Índice da primeira adjacência desta thread.
+	int ultima;			  ///< Índice a seguir à última adjacência desta thread.
+	int falhas;			  ///< Número de inserções que falharam.
+
+} Escritor;
+
+/**
+ * @brief Devolve o instante atual em segundos.
+ *
+ * @return double Segundos desde uma origem fixa.
+ */
+static double Agora()
+{
+	struct timespec t;
+	timespec_get(&t, TIME_UTC);
+	return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Calcula os extremos da adjacência com um dado índice (o mesmo grafo em todas as medições).
+ *
+ * @param i Índice da adjacência.
+ * @param numVertices Número de vértices do grafo.
+ * @param origem Apontador para a origem calculada.
+ * @param destino Apontador para o destino calculado.
+ */
+static void Extremos(int i, int numVertices, int* origem, int* destino)
+{
+	unsigned s = (unsigned)i * 2654435761u;
+	*origem = (int)(s % (unsigned)numVertices);
+	s = s * 1103515245u + 12345u;
+	*destino = (int)((s >> 8) % (unsigned)numVertices);
+}
+
+/**
+ * @brief Função das threads escritoras: insere os vértices e depois as adjacências do seu intervalo.
+ *
+ * @param arg Apontador para o Escritor.
+ * @return int 0.
+ */
+static int ExecutarEscritor(void* arg)
+{
+	Escritor* w = (Escritor*)arg;
+	bool inf;
+
+	for (int i = w->primeira; i < w->ultima; i++)
+	{
+		int origem, destino;
+		Extremos(i, w->numVertices, &origem, &destino);
+		InserirAdjConcorrente(w->gc, origem, destino, 1 + i % 100, &inf);
+
+		if (!inf)
+		{
+			w->falhas++;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Função principal do programa de medição.
+ *
+ * @param argc Números de argumentos
+ * @param argv Array de strings (número de vértices e de adjacências, opcionais)
+ */
+int main(int argc, char* argv[])
+{
+	int numVertices = argc > 1 ? atoi(argv[1]) : 100000;
+	int numArestas = argc > 2 ? atoi(argv[2]) : 4000000;
+	int numThreads[] = { 1, 2, 4, 8 };
+	bool inf;
+
+	printf("threads;arestas;segundos;arestas_s;falhas\n");
+
+	for (int k = 0; k < (int)(sizeof(numThreads) / sizeof(numThreads[0])); k++)
+	{
+		int t = numThreads[k];
+		Grafo* g = CriarGrafo(&inf);
+		GrafoConcorrente* gc = IniciarConstrucaoConcorrente(g, numVertices, &inf);
+		thrd_t threads[8];
+		Escritor escritores[8];
+
+		//Os vértices são inseridos antes de medir, as threads só inserem adjacências
+		for (int i = 0; i < numVertices; i++)
+		{
+			InserirVerticeConcorrente(gc, i, &inf);
+		}
+
+		double t0 = Agora();
+
+		for (int i = 0; i < t; i++)
+		{
+			escritores[i].gc = gc;
+			escritores[i].numVertices = numVertices;
+			escritores[i].primeira = (int)((long long)numArestas * i / t);
+			escritores[i].ultima = (int)((long long)numArestas * (i + 1) / t);
+			escritores[i].falhas = 0;
+			thrd_create(&threads[i], ExecutarEscritor, &escritores[i]);
+		}
+
+		int falhas = 0;
+
+		for (int i = 0; i < t; i++)
+		{
+			thrd_join(threads[i], NULL);
+			falhas += escritores[i].falhas;
+		}
+
+		g = ConcluirConstrucaoConcorrente(gc, &inf);
+		double segundos = Agora() - t0;
+
+		printf("%d;%d;%.3f;%.0f;%d\n", t, numArestas, segundos, numArestas / segundos, falhas);
+		ApagaGrafo(g);
+	}
+
+	return 0;
+}
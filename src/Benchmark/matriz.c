@@ -0,0 +1,165 @@
+/**
+ * @file matriz.c
+ * @author Hugo Cruz (a23010)
+ * @brief Programa de medição das pesquisas num grafo denso guardado em matriz.
+ *
+ * Este programa escreve um ficheiro CSV com uma matriz de adjacências aleatória, carrega-o com
+ * CarregaDadosCSV (que fica com a matriz) e compara, para várias densidades, a memória e o tempo
+ * da pesquisa em largura com conjuntos de bits e da pesquisa em largura sobre a imagem com arrays
+ * contíguos criada a partir do mesmo grafo.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "../Grafos/InputOutput.h"
+
+/**
+ * @def NUM_PESQUISAS
+ * @brief Número de pesquisas de cada tipo por densidade.
+ */
+#define NUM_PESQUISAS 20
+
+/**
+ * @brief Devolve o instante atual em segundos.
+ *
+ * @return double Segundos desde uma origem fixa.
+ */
+static double Agora()
+{
+	struct timespec t;
+	timespec_get(&t, TIME_UTC);
+	return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Escreve uma matriz de adjacências aleatória num ficheiro CSV.
+ *
+ * @param file Nome do ficheiro.
+ * @param n Número de linhas e de colunas.
+ * @param percentagem Percentagem de células com ligação.
+ */
+static void EscreverMatrizCSV(char* file, int n, int percentagem)
+{
+	FILE* ficheiro = fopen(file, "w");
+
+	for (int i = 0; i < n; i++)
+	{
+		for (int j = 0; j < n; j++)
+		{
+			fprintf(ficheiro, "%d%c", rand() % 100 < percentagem ? 1 + rand() % 100 : 0, j + 1 < n ? ';' : '\n');
+		}
+	}
+
+	fclose(ficheiro);
+}
+
+/**
+ * @brief Pesquisa em largura sobre uma imagem com arrays contíguos.
+ *
+ * @param im Apontador para a imagem.
+ * @param origem Vértice de origem.
+ * @param nivel Array com o nível de cada vértice (-1 se não alcançado).
+ * @param fila Array auxiliar com im->tamanho posições.
+ * @return int Número de vértices alcançados.
+ */
+static int Largura(ImagemGrafo* im, int origem, int nivel[], int fila[])
+{
+	for (int i = 0; i < im->tamanho; i++)
+	{
+		nivel[i] = -1;
+	}
+
+	int frente = 0, fim = 0;
+	fila[fim++] = origem;
+	nivel[origem] = 0;
+
+	while (frente < fim)
+	{
+		int u = fila[frente++];
+
+		for (int i = im->inicio[u]; i < im->inicio[u + 1]; i++)
+		{
+			int w = im->destinos[i];
+
+			if (nivel[w] == -1)
+			{
+				nivel[w] = nivel[u] + 1;
+				fila[fim++] = w;
+			}
+		}
+	}
+
+	return fim;
+}
+
+/**
+ * @brief Função principal do programa de medição.
+ *
+ * @param argc Números de argumentos
+ * @param argv Array de strings (número de vértices e ficheiro temporário, opcionais)
+ */
+int main(int argc, char* argv[])
+{
+	int n = argc > 1 ? atoi(argv[1]) : 2000;
+	char* file = argc > 2 ? argv[2] : "matriz_medicao.csv";
+	int percentagens[] = { 30, 50, 90 };
+	bool inf;
+
+	srand(7);
+	printf("percentagem;vertices;arestas;mb_lista;mb_matriz;ms_largura_imagem;ms_largura_bits\n");
+
+	for (int k = 0; k < (int)(sizeof(percentagens) / sizeof(percentagens[0])); k++)
+	{
+		EscreverMatrizCSV(file, n, percentagens[k]);
+		Grafo* g = CarregaDadosCSV(file);
+
+		if (g == NULL || g->matriz == NULL)
+		{
+			printf("%d;o grafo nao ficou em matriz\n", percentagens[k]);
+			ApagaGrafo(g);
+			continue;
+		}
+
+		MatrizAdjacencia* m = g->matriz;
+		ImagemGrafo* im = CriarImagemGrafo(g, &inf);
+		int* nivel = (int*)malloc(sizeof(int) * im->tamanho);
+		int* fila = (int*)malloc(sizeof(int) * im->tamanho);
+
+		double lista = ((double)sizeof(Vertice) * n + (double)sizeof(Adjacente) * m->numArestas) / 1e6;
+		double matriz = ((double)m->tamanho * m->tamanho * sizeof(PesoAresta) +
+			(double)m->tamanho * m->palavrasLinha * sizeof(PalavraBits)) / 1e6;
+
+		double t0 = Agora();
+
+		for (int i = 0; i < NUM_PESQUISAS; i++)
+		{
+			Largura(im, 1 + i % n, nivel, fila);
+		}
+
+		double imagem = (Agora() - t0) / NUM_PESQUISAS * 1e3;
+		t0 = Agora();
+
+		for (int i = 0; i < NUM_PESQUISAS; i++)
+		{
+			LarguraMatriz(m, 1 + i % n, nivel);
+		}
+
+		double bits = (Agora() - t0) / NUM_PESQUISAS * 1e3;
+
+		printf("%d;%d;%lld;%.1f;%.1f;%.3f;%.3f\n", percentagens[k], n, m->numArestas, lista, matriz, imagem, bits);
+
+		free(nivel);
+		free(fila);
+		ApagarImagemGrafo(im);
+		ApagaGrafo(g);
+	}
+
+	remove(file);
+	return 0;
+}
@@ -0,0 +1,183 @@
+/**
+ * @file relaxacao.c
+ * @author Hugo Cruz (a23010)
+ * @brief Programa de medição do custo da relaxação de adjacências no algoritmo de Dijkstra.
+ *
+ * Este programa gera grafos com alguns vértices de grau elevado e mede o tempo médio por
+ * adjacência relaxada. A relaxação antiga, que confirmava cada adjacência com
+ * ExisteAdjDoisVertices, é reproduzida para comparação com a função Dijkstra e com
+ * DijkstraRestrito sobre um espaço de trabalho reutilizado.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "../Grafos/caminhos.h"
+
+/**
+ * @brief Devolve o instante atual em segundos.
+ *
+ * @return double Segundos desde uma origem fixa.
+ */
+static double Agora()
+{
+	struct timespec t;
+	timespec_get(&t, TIME_UTC);
+	return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Cria um grafo com vértices centrais de grau elevado.
+ *
+ * Os vértices 0 até centrais - 1 formam uma cadeia com peso 1 e cada um liga a todas as folhas
+ * (ids centrais até centrais + grau - 1) com pesos aleatórios. Uma pesquisa a partir do vértice 0
+ * relaxa centrais * grau adjacências.
+ *
+ * @param centrais Número de vértices centrais.
+ * @param grau Número de folhas ligadas a cada vértice central.
+ * @return Grafo* Apontador para o grafo criado.
+ */
+static Grafo* CriarGrafoCentral(int centrais, int grau)
+{
+	bool inf;
+	Grafo* g = CriarGrafo(&inf);
+
+	for (int i = 0; i < centrais + grau; i++)
+	{
+		g = InserirVerticeGrafo(g, i, &inf);
+	}
+
+	for (int c = 0; c < centrais; c++)
+	{
+		if (c + 1 < centrais)
+		{
+			g = InserirAdjGrafo(g, c, c + 1, 1, &inf);
+		}
+
+		for (int f = 0; f < grau; f++)
+		{
+			g = InserirAdjGrafo(g, c, centrais + f, 1 + rand() % 1000, &inf);
+		}
+	}
+
+	return g;
+}
+
+/**
+ * @brief Relaxação antiga, com uma confirmação da adjacência por cada aresta.
+ *
+ * Reproduz o ciclo interno do algoritmo de Dijkstra antes de usar arrays contíguos: para cada
+ * adjacência do vértice é chamada ExisteAdjDoisVertices, que volta a percorrer a lista.
+ *
+ * @param g Apontador para o grafo.
+ * @param centrais Número de vértices centrais a relaxar.
+ * @param distancias Array de distâncias.
+ * @param verticeAnt Array de antecessores.
+ * @return int Número de adjacências relaxadas.
+ */
+static int RelaxacaoComPesquisa(Grafo* g, int centrais, Distancia distancias[], int verticeAnt[])
+{
+	bool inf;
+	int arestas = 0;
+
+	for (int u = 0; u < centrais; u++)
+	{
+		Vertice* auxV = ColocaNumaPosicaoLista(g->inicioGrafo, u, &inf);
+
+		for (Adjacente* auxA = auxV->nextA; auxA != NULL; auxA = auxA->next)
+		{
+			if (distancias[u] + auxA->peso < distancias[auxA->id] && ExisteAdjDoisVertices(auxV, u, auxA->id))
+			{
+				distancias[auxA->id] = distancias[u] + auxA->peso;
+				verticeAnt[auxA->id] = u;
+			}
+
+			arestas++;
+		}
+	}
+
+	return arestas;
+}
+
+/**
+ * @brief Função principal do programa de medição.
+ *
+ * Escreve uma linha por grau com o tempo médio por adjacência, em nanossegundos, da relaxação
+ * antiga, da função Dijkstra e de DijkstraRestrito com o espaço de trabalho já criado.
+ *
+ * @param argc Números de argumentos
+ * @param argv Array de strings (número de vértices centrais e repetições, opcionais)
+ */
+int main(int argc, char* argv[])
+{
+	int centrais = argc > 1 ? atoi(argv[1]) : 8;
+	int repeticoes = argc > 2 ? atoi(argv[2]) : 20;
+	int graus[] = { 64, 256, 1024, 4096 };
+	bool inf;
+
+	srand(7);
+	printf("grau;arestas;ns_aresta_pesquisa;ns_aresta_dijkstra;ns_aresta_espaco\n");
+
+	for (int i = 0; i < (int)(sizeof(graus) / sizeof(graus[0])); i++)
+	{
+		Grafo* g = CriarGrafoCentral(centrais, graus[i]);
+		int tamanho = TamanhoArraysCaminhos(g);
+		Distancia* distancias = (Distancia*)malloc(sizeof(Distancia) * tamanho);
+		int* verticeAnt = (int*)malloc(sizeof(int) * tamanho);
+		int arestas = 0;
+
+		//Relaxação antiga
+		double t0 = Agora();
+
+		for (int r = 0; r < repeticoes; r++)
+		{
+			InicializarArrays(distancias, tamanho);
+			distancias[0] = 0;
+
+			//A cadeia de peso 1 dá a distância final de cada vértice central
+			for (int c = 1; c < centrais; c++)
+			{
+				distancias[c] = c;
+			}
+
+			arestas = RelaxacaoComPesquisa(g, centrais, distancias, verticeAnt);
+		}
+
+		double pesquisa = (Agora() - t0) / repeticoes / arestas * 1e9;
+
+		//Função Dijkstra, que cria o espaço de trabalho em cada chamada
+		t0 = Agora();
+
+		for (int r = 0; r < repeticoes; r++)
+		{
+			Dijkstra(g, 0, distancias, verticeAnt);
+		}
+
+		double dijkstra = (Agora() - t0) / repeticoes / arestas * 1e9;
+
+		//DijkstraRestrito com o espaço de trabalho reutilizado
+		EspacoCaminhos* e = CriarEspacoCaminhos(g, &inf);
+		t0 = Agora();
+
+		for (int r = 0; r < repeticoes; r++)
+		{
+			DijkstraRestrito(g, e, 0, -1, NULL, 0);
+		}
+
+		double espaco = (Agora() - t0) / repeticoes / arestas * 1e9;
+
+		printf("%d;%d;%.2f;%.2f;%.2f\n", graus[i], arestas, pesquisa, dijkstra, espaco);
+
+		ApagarEspacoCaminhos(e);
+		free(distancias);
+		free(verticeAnt);
+		ApagaGrafo(g);
+	}
+
+	return 0;
+}
@@ -0,0 +1,273 @@
+/**
+ * @file reordenar.c
+ * @author Hugo Cruz (a23010)
+ * @brief Programa de medição do efeito da renumeração dos vértices nas pesquisas.
+ *
+ * Este programa carrega um grafo (uma lista origem;destino;peso com ids externos) ou gera uma
+ * grelha com os ids baralhados, e mede o tempo de pesquisas de Dijkstra e em largura com a
+ * numeração original e depois de cada renumeração. A distância média entre os ids dos extremos
+ * de cada adjacência indica a localidade obtida. Para contar as falhas de cache, cada ordem pode
+ * ser medida sozinha com o segundo argumento, por exemplo com perf stat -e cache-misses.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "../Grafos/InputOutput.h"
+#include "../Grafos/lote.h"
+#include "../Grafos/reordenar.h"
+
+/**
+ * @def NUM_PESQUISAS
+ * @brief Número de pesquisas de cada tipo por ordem.
+ */
+#define NUM_PESQUISAS 20
+
+/**
+ * @brief Devolve o instante atual em segundos.
+ *
+ * @return double Segundos desde uma origem fixa.
+ */
+static double Agora()
+{
+	struct timespec t;
+	timespec_get(&t, TIME_UTC);
+	return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Cria uma grelha com ligações nos dois sentidos e os ids baralhados.
+ *
+ * @param lado Número de linhas e de colunas.
+ * @return Grafo* Apontador para o grafo criado.
+ */
+static Grafo* CriarGrelhaBaralhada(int lado)
+{
+	bool inf;
+	int n = lado * lado;
+	int* id = (int*)malloc(sizeof(int) * n);
+
+	for (int i = 0; i < n; i++)
+	{
+		id[i] = i;
+	}
+
+	srand(7);
+
+	for (int i = n - 1; i > 0; i--)
+	{
+		int j = (int)(((long long)rand() * (RAND_MAX + 1LL) + rand()) % (i + 1));
+		int t = id[i];
+		id[i] = id[j];
+		id[j] = t;
+	}
+
+	Grafo* g = CriarGrafo(&inf);
+	LoteAlteracoes* l = CriarLoteAlteracoes(n * 5, &inf);
+
+	for (int i = 0; i < n; i++)
+	{
+		InserirVerticeLote(l, i, &inf);
+	}
+
+	for (int i = 0; i < n; i++)
+	{
+		if ((i + 1) % lado != 0)
+		{
+			InserirAdjLote(l, id[i], id[i + 1], 1 + rand() % 100, &inf);
+			InserirAdjLote(l, id[i + 1], id[i], 1 + rand() % 100, &inf);
+		}
+
+		if (i + lado < n)
+		{
+			InserirAdjLote(l, id[i], id[i + lado], 1 + rand() % 100, &inf);
+			InserirAdjLote(l, id[i + lado], id[i], 1 + rand() % 100, &inf);
+		}
+	}
+
+	g = AplicarLoteGrafo(g, l, &inf);
+	ApagarLoteAlteracoes(l);
+	free(id);
+	return g;
+}
+
+/**
+ * @brief Cria o grafo da medição.
+ *
+ * @param origem Nome do ficheiro, ou o lado da grelha.
+ * @return Grafo* Apontador para o grafo criado.
+ */
+static Grafo* CriarGrafoMedicao(char* origem)
+{
+	MapaIds* m = NULL;
+	Grafo* g = CarregaAdjacenciasExternas(origem, &m);
+
+	if (g != NULL)
+	{
+		ApagarMapaIds(m);
+		return g;
+	}
+
+	return CriarGrelhaBaralhada(atoi(origem) > 0 ? atoi(origem) : 300);
+}
+
+/**
+ * @brief Pesquisa em largura sobre uma imagem.
+ *
+ * @param im Apontador para a imagem.
+ * @param origem Vértice de origem.
+ * @param nivel Array com o nível de cada vértice (-1 se não alcançado).
+ * @param fila Array auxiliar com im->tamanho posições.
+ * @return int Número de vértices alcançados.
+ */
+static int Largura(ImagemGrafo* im, int origem, int nivel[], int fila[])
+{
+	for (int i = 0; i < im->tamanho; i++)
+	{
+		nivel[i] = -1;
+	}
+
+	int frente = 0, fim = 0;
+	fila[fim++] = origem;
+	nivel[origem] = 0;
+
+	while (frente < fim)
+	{
+		int u = fila[frente++];
+
+		for (int i = im->inicio[u]; i < im->inicio[u + 1]; i++)
+		{
+			int w = im->destinos[i];
+
+			if (nivel[w] == -1)
+			{
+				nivel[w] = nivel[u] + 1;
+				fila[fim++] = w;
+			}
+		}
+	}
+
+	return fim;
+}
+
+/**
+ * @brief Mede as pesquisas sobre o grafo com a numeração atual e escreve uma linha.
+ *
+ * As origens são as mesmas em todas as ordens (convertidas com a renumeração aplicada).
+ *
+ * @param nome Nome da ordem.
+ * @param g Apontador para o grafo.
+ * @param origens Origens das pesquisas, na numeração atual.
+ */
+static void Medir(const char* nome, Grafo* g, int origens[])
+{
+	bool inf;
+	ImagemGrafo* im = CriarImagemGrafo(g, &inf);
+	EspacoCaminhos* e = CriarEspacoImagem(im, &inf);
+	int* nivel = (int*)malloc(sizeof(int) * im->tamanho);
+	int* fila = (int*)malloc(sizeof(int) * im->tamanho);
+	double distancia = 0;
+
+	for (int u = 0; u < im->tamanho; u++)
+	{
+		for (int i = im->inicio[u]; i < im->inicio[u + 1]; i++)
+		{
+			distancia += abs(im->destinos[i] - u);
+		}
+	}
+
+	double t0 = Agora();
+
+	for (int i = 0; i < NUM_PESQUISAS; i++)
+	{
+		DijkstraImagem(im, e, origens[i], -1);
+	}
+
+	double dijkstra = (Agora() - t0) / NUM_PESQUISAS * 1e3;
+	t0 = Agora();
+
+	for (int i = 0; i < NUM_PESQUISAS; i++)
+	{
+		Largura(im, origens[i], nivel, fila);
+	}
+
+	double largura = (Agora() - t0) / NUM_PESQUISAS * 1e3;
+
+	printf("%s;%d;%d;%.1f;%.3f;%.3f\n", nome, im->numVertices, im->numArestas,
+		im->numArestas > 0 ? distancia / im->numArestas : 0, dijkstra, largura);
+
+	free(nivel);
+	free(fila);
+	ApagarEspacoCaminhos(e);
+	ApagarImagemGrafo(im);
+}
+
+/**
+ * @brief Função principal do programa de medição.
+ *
+ * @param argc Números de argumentos
+ * @param argv Array de strings (ficheiro ou lado da grelha, e uma ordem para medir sozinha, opcionais)
+ */
+int main(int argc, char* argv[])
+{
+	const char* nomes[] = { "rcm", "bfs", "grau" };
+	OrdemVertices ordens[] = { ORDEM_RCM, ORDEM_BFS, ORDEM_GRAU };
+	char* origem = argc > 1 ? argv[1] : "300";
+	char* apenas = argc > 2 ? argv[2] : NULL;
+	bool inf;
+
+	printf("ordem;vertices;arestas;distancia_media_ids;ms_dijkstra;ms_largura\n");
+
+	for (int k = -1; k < 3; k++)
+	{
+		const char* nome = k < 0 ? "original" : nomes[k];
+
+		if (apenas != NULL && strcmp(apenas, nome) != 0)
+		{
+			continue;
+		}
+
+		//O grafo é criado de novo em cada ordem para partir sempre da numeração original
+		Grafo* g = CriarGrafoMedicao(origem);
+		int tamanho = TamanhoArraysCaminhos(g);
+		int origens[NUM_PESQUISAS];
+
+		srand(11);
+
+		for (int i = 0; i < NUM_PESQUISAS; i++)
+		{
+			Vertice* v;
+
+			do
+			{
+				int id = rand() % tamanho;
+				for (v = g->inicioGrafo; v != NULL && v->id != id; v = v->nextV);
+			} while (v == NULL);
+
+			origens[i] = v->id;
+		}
+
+		if (k >= 0)
+		{
+			int* novoId = CalcularOrdemVertices(g, ordens[k], &tamanho, &inf);
+			g = RenumerarGrafo(g, novoId, tamanho, &inf);
+
+			for (int i = 0; i < NUM_PESQUISAS; i++)
+			{
+				origens[i] = novoId[origens[i]];
+			}
+
+			free(novoId);
+		}
+
+		Medir(nome, g, origens);
+		ApagaGrafo(g);
+	}
+
+	return 0;
+}
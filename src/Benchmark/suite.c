@@ -0,0 +1,826 @@
+/**
+ * @file suite.c
+ * @author Hugo Cruz (a23010)
+ * @brief Conjunto de medições de desempenho sobre grafos sintéticos.
+ *
+ * Este programa gera grafos R-MAT (Kronecker), Erdős–Rényi, em grelha (semelhantes a uma rede de
+ * estradas) e com graus em lei de potência (Chung-Lu), para escalas de 2^escalaMin até 2^escalaMax
+ * vértices. Para cada grafo mede a construção (pela API, por lote e a partir de um CSV), a gravação
+ * e a leitura do formato binário, o algoritmo de Dijkstra, a pesquisa de caminhos, a pesquisa em
+ * largura, as componentes conexas e fortemente conexas, o PageRank, a centralidade de proximidade,
+ * o cálculo de todos os caminhos mais curtos e a eliminação do grafo.
+ *
+ * O resultado é escrito em JSON, um objeto por gerador, escala e operação, com o mínimo, os
+ * percentis 50, 90 e 99, o máximo e a média em milissegundos. A memória do grafo, por categoria,
+ * e a do espaço de trabalho das pesquisas são escritas em objetos com a operação "memoria" (e
+ * "memoria_apsp" para o grafo de todos os caminhos mais curtos). Serve de referência para detetar
+ * regressões na biblioteca: basta comparar dois ficheiros gerados com os mesmos argumentos.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "../Grafos/caminhos.h"
+#include "../Grafos/lote.h"
+#include "../Grafos/InputOutput.h"
+#include "../Grafos/largura.h"
+#include "../Grafos/componentes.h"
+#include "../Grafos/centralidade.h"
+
+/**
+ * @def LIMITE_API
+ * @brief Número máximo de vértices para medir a construção pela API (a inserção de vértices é linear).
+ */
+#define LIMITE_API (1 << 14)
+
+/**
+ * @def LIMITE_CSV
+ * @brief Número máximo de vértices para medir a construção a partir de um CSV (o ficheiro tem n² células).
+ */
+#define LIMITE_CSV (1 << 11)
+
+/**
+ * @def LIMITE_APSP
+ * @brief Número máximo de vértices para medir o cálculo de todos os caminhos mais curtos (n² arestas).
+ */
+#define LIMITE_APSP (1 << 8)
+
+/**
+ * @def CONSULTAS
+ * @brief Número de pares origem/destino medidos nas pesquisas.
+ */
+#define CONSULTAS 200
+
+/**
+ * @def ARESTAS_VERTICE
+ * @brief Número médio de arestas por vértice dos geradores aleatórios.
+ */
+#define ARESTAS_VERTICE 8
+
+/**
+ * @brief Lista de arestas gerada, com os vértices numerados de 1 a numVertices.
+ *
+ */
+typedef struct ListaArestas
+{
+	int numVertices; ///< Número de vértices.
+	int numArestas;	 ///< Número de arestas.
+	int capacidade;	 ///< Número de arestas que cabem nos arrays.
+	int* origem;	 ///< Vértice de origem de cada aresta.
+	int* destino;	 ///< Vértice de destino de cada aresta.
+	int* peso;		 ///< Peso de cada aresta, entre 1 e 100.
+
+} ListaArestas;
+
+/**
+ * @brief Destino dos resultados em JSON.
+ *
+ */
+typedef struct Resultados
+{
+	FILE* saida;   ///< Ficheiro onde os objetos são escritos.
+	int escritos;  ///< Número de objetos já escritos (para separar com vírgulas).
+
+} Resultados;
+
+/**
+ * @brief Estado do gerador pseudo-aleatório (rand não chega aos ids dos grafos maiores em Windows).
+ */
+static unsigned long long estado = 88172645463325252ULL;
+
+/**
+ * @brief Devolve o instante atual em segundos.
+ *
+ * @return double Segundos desde uma origem fixa.
+ */
+static double Agora()
+{
+	struct timespec t;
+	timespec_get(&t, TIME_UTC);
+	return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Gerador xorshift de 64 bits.
+ *
+ * @return unsigned long long Próximo número.
+ */
+static unsigned long long Aleatorio()
+{
+	estado ^= estado << 13;
+	estado ^= estado >> 7;
+	estado ^= estado << 17;
+	return estado;
+}
+
+/**
+ * @brief Devolve um número real uniforme em [0, 1).
+ *
+ * @return double Número gerado.
+ */
+static double AleatorioReal()
+{
+	return (Aleatorio() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * @brief Cria uma lista de arestas vazia.
+ *
+ * @param numVertices Número de vértices do grafo.
+ * @param capacidade Número de arestas previsto.
+ * @return ListaArestas* Apontador para a lista criada.
+ */
+static ListaArestas* CriarListaArestas(int numVertices, int capacidade)
+{
+	ListaArestas* l = (ListaArestas*)malloc(sizeof(ListaArestas));
+	l->numVertices = numVertices;
+	l->numArestas = 0;
+	l->capacidade = capacidade > 0 ? capacidade : 1;
+	l->origem = (int*)malloc(sizeof(int) * l->capacidade);
+	l->destino = (int*)malloc(sizeof(int) * l->capacidade);
+	l->peso = (int*)malloc(sizeof(int) * l->capacidade);
+	return l;
+}
+
+/**
+ * @brief Liberta a memória de uma lista de arestas.
+ *
+ * @param l Apontador para a lista.
+ */
+static void ApagarListaArestas(ListaArestas* l)
+{
+	free(l->origem);
+	free(l->destino);
+	free(l->peso);
+	free(l);
+}
+
+/**
+ * @brief Acrescenta uma aresta à lista, com um peso aleatório entre 1 e 100. Os lacetes são ignorados.
+ *
+ * @param l Apontador para a lista.
+ * @param origem Vértice de origem.
+ * @param destino Vértice de destino.
+ */
+static void AcrescentarAresta(ListaArestas* l, int origem, int destino)
+{
+	if (origem == destino)
+	{
+		return;
+	}
+
+	if (l->numArestas == l->capacidade)
+	{
+		l->capacidade *= 2;
+		l->origem = (int*)realloc(l->origem, sizeof(int) * l->capacidade);
+		l->destino = (int*)realloc(l->destino, sizeof(int) * l->capacidade);
+		l->peso = (int*)realloc(l->peso, sizeof(int) * l->capacidade);
+	}
+
+	l->origem[l->numArestas] = origem;
+	l->destino[l->numArestas] = destino;
+	l->peso[l->numArestas] = 1 + (int)(Aleatorio() % 100);
+	l->numArestas++;
+}
+
+/**
+ * @brief Compara duas arestas codificadas num long long (origem, destino e peso) para qsort.
+ *
+ * @param a Apontador para a primeira aresta.
+ * @param b Apontador para a segunda aresta.
+ * @return int Negativo, zero ou positivo, como em qsort.
+ */
+static int CompararChave(const void* a, const void* b)
+{
+	long long x = *(const long long*)a, y = *(const long long*)b;
+	return (x > y) - (x < y);
+}
+
+/**
+ * @brief Retira as arestas repetidas, que os geradores aleatórios produzem e o CSV não representa.
+ *
+ * As arestas ficam ordenadas por origem e destino, com o peso da primeira ocorrência.
+ *
+ * @param l Apontador para a lista.
+ */
+static void RetirarRepetidas(ListaArestas* l)
+{
+	long long* chaves = (long long*)malloc(sizeof(long long) * (l->numArestas > 0 ? l->numArestas : 1));
+
+	for (int i = 0; i < l->numArestas; i++)
+	{
+		chaves[i] = (long long)l->origem[i] << 32 | (long long)l->destino[i] << 7 | l->peso[i];
+	}
+
+	qsort(chaves, l->numArestas, sizeof(long long), CompararChave);
+
+	int k = 0;
+
+	for (int i = 0; i < l->numArestas; i++)
+	{
+		//Os 7 bits mais baixos são o peso, o resto identifica o par de vértices
+		if (i > 0 && chaves[i] >> 7 == chaves[i - 1] >> 7)
+		{
+			continue;
+		}
+
+		l->origem[k] = (int)(chaves[i] >> 32);
+		l->destino[k] = (int)(chaves[i] >> 7 & 0x1FFFFFF);
+		l->peso[k] = (int)(chaves[i] & 127);
+		k++;
+	}
+
+	l->numArestas = k;
+	free(chaves);
+}
+
+/**
+ * @brief Gera um grafo R-MAT (Kronecker) com 2^escala vértices.
+ *
+ * Cada aresta escolhe um quadrante da matriz de adjacências em cada nível, com as probabilidades
+ * 0.57, 0.19, 0.19 e 0.05 do Graph500, o que dá graus muito desiguais e comunidades encaixadas.
+ *
+ * @param escala Logaritmo de base 2 do número de vértices.
+ * @return ListaArestas* Lista com as arestas geradas.
+ */
+static ListaArestas* GerarRMAT(int escala)
+{
+	int n = 1 << escala;
+	ListaArestas* l = CriarListaArestas(n, n * ARESTAS_VERTICE);
+
+	for (int i = 0; i < n * ARESTAS_VERTICE; i++)
+	{
+		int u = 0, v = 0;
+
+		for (int nivel = 0; nivel < escala; nivel++)
+		{
+			double p = AleatorioReal();
+			u <<= 1;
+			v <<= 1;
+
+			if (p >= 0.57 && p < 0.76)
+			{
+				v |= 1;
+			}
+			else if (p >= 0.76 && p < 0.95)
+			{
+				u |= 1;
+			}
+			else if (p >= 0.95)
+			{
+				u |= 1;
+				v |= 1;
+			}
+		}
+
+		AcrescentarAresta(l, u + 1, v + 1);
+	}
+
+	RetirarRepetidas(l);
+	return l;
+}
+
+/**
+ * @brief Gera um grafo de Erdős–Rényi G(n, m) com 2^escala vértices e ARESTAS_VERTICE * n arestas.
+ *
+ * @param escala Logaritmo de base 2 do número de vértices.
+ * @return ListaArestas* Lista com as arestas geradas.
+ */
+static ListaArestas* GerarErdosRenyi(int escala)
+{
+	int n = 1 << escala;
+	ListaArestas* l = CriarListaArestas(n, n * ARESTAS_VERTICE);
+
+	for (int i = 0; i < n * ARESTAS_VERTICE; i++)
+	{
+		AcrescentarAresta(l, 1 + (int)(Aleatorio() % n), 1 + (int)(Aleatorio() % n));
+	}
+
+	RetirarRepetidas(l);
+	return l;
+}
+
+/**
+ * @brief Gera uma grelha com cerca de 2^escala vértices, semelhante a uma rede de estradas.
+ *
+ * Cada vértice liga aos vizinhos da direita e de baixo nos dois sentidos, com pesos independentes.
+ * Uma em cada dez ligações é retirada para que os caminhos não sejam todos equivalentes.
+ *
+ * @param escala Logaritmo de base 2 do número de vértices.
+ * @return ListaArestas* Lista com as arestas geradas.
+ */
+static ListaArestas* GerarGrelha(int escala)
+{
+	int colunas = 1 << (escala / 2);
+	int linhas = (1 << escala) / colunas;
+	ListaArestas* l = CriarListaArestas(linhas * colunas, linhas * colunas * 4);
+
+	for (int i = 0; i < linhas * colunas; i++)
+	{
+		if ((i + 1) % colunas != 0 && Aleatorio() % 10 != 0)
+		{
+			AcrescentarAresta(l, i + 1, i + 2);
+			AcrescentarAresta(l, i + 2, i + 1);
+		}
+
+		if (i + colunas < linhas * colunas && Aleatorio() % 10 != 0)
+		{
+			AcrescentarAresta(l, i + 1, i + colunas + 1);
+			AcrescentarAresta(l, i + colunas + 1, i + 1);
+		}
+	}
+
+	return l;
+}
+
+/**
+ * @brief Gera um grafo de Chung-Lu com graus em lei de potência (expoente 2.5).
+ *
+ * O vértice i tem peso proporcional a (i + 1)^(-1 / 1.5); os dois extremos de cada aresta são
+ * escolhidos com probabilidade proporcional ao peso, por pesquisa binária nos pesos acumulados.
+ *
+ * @param escala Logaritmo de base 2 do número de vértices.
+ * @return ListaArestas* Lista com as arestas geradas.
+ */
+static ListaArestas* GerarPotencia(int escala)
+{
+	int n = 1 << escala;
+	ListaArestas* l = CriarListaArestas(n, n * ARESTAS_VERTICE);
+	double* acumulado = (double*)malloc(sizeof(double) * n);
+	double total = 0;
+
+	for (int i = 0; i < n; i++)
+	{
+		total += pow(i + 1.0, -1.0 / 1.5);
+		acumulado[i] = total;
+	}
+
+	for (int i = 0; i < n * ARESTAS_VERTICE * 2; i++)
+	{
+		double p = AleatorioReal() * total;
+		int inicio = 0, fim = n - 1;
+
+		while (inicio < fim)
+		{
+			int meio = (inicio + fim) / 2;
+
+			if (acumulado[meio] <= p)
+			{
+				inicio = meio + 1;
+			}
+			else
+			{
+				fim = meio;
+			}
+		}
+
+		//As posições pares são origens e as ímpares destinos da aresta anterior
+		if (i % 2 == 0)
+		{
+			l->origem[l->numArestas] = inicio + 1;
+		}
+		else
+		{
+			AcrescentarAresta(l, l->origem[l->numArestas], inicio + 1);
+		}
+	}
+
+	free(acumulado);
+	RetirarRepetidas(l);
+	return l;
+}
+
+/**
+ * @brief Constrói o grafo pela API, com o índice de vértices ativo.
+ *
+ * @param l Lista de arestas.
+ * @return Grafo* Apontador para o grafo criado.
+ */
+static Grafo* ConstruirAPI(ListaArestas* l)
+{
+	bool inf;
+	Grafo* g = CriarGrafo(&inf);
+	g = ConfigurarIndiceEntradasGrafo(g, true, &inf);
+
+	//Os vértices são inseridos do maior para o menor, sempre no início da lista
+	for (int i = l->numVertices; i >= 1; i--)
+	{
+		g = InserirVerticeGrafo(g, i, &inf);
+	}
+
+	for (int i = 0; i < l->numArestas; i++)
+	{
+		g = InserirAdjGrafo(g, l->origem[i], l->destino[i], l->peso[i], &inf);
+	}
+
+	return g;
+}
+
+/**
+ * @brief Constrói o grafo com um único lote de alterações.
+ *
+ * @param l Lista de arestas.
+ * @return Grafo* Apontador para o grafo criado.
+ */
+static Grafo* ConstruirLote(ListaArestas* l)
+{
+	bool inf;
+	Grafo* g = CriarGrafo(&inf);
+	LoteAlteracoes* lote = CriarLoteAlteracoes(l->numVertices + l->numArestas, &inf);
+
+	for (int i = 1; i <= l->numVertices; i++)
+	{
+		InserirVerticeLote(lote, i, &inf);
+	}
+
+	for (int i = 0; i < l->numArestas; i++)
+	{
+		InserirAdjLote(lote, l->origem[i], l->destino[i], l->peso[i], &inf);
+	}
+
+	g = AplicarLoteGrafo(g, lote, &inf);
+	ApagarLoteAlteracoes(lote);
+	return g;
+}
+
+/**
+ * @brief Escreve a lista de arestas como uma matriz de pesos em CSV, no formato de CarregaDadosCSV.
+ *
+ * @param l Lista de arestas, ordenada por origem e destino.
+ * @param file Nome do ficheiro.
+ * @return bool true se o ficheiro foi escrito.
+ */
+static bool EscreverCSV(ListaArestas* l, char* file)
+{
+	FILE* ficheiro = fopen(file, "w");
+
+	if (ficheiro == NULL)
+	{
+		return false;
+	}
+
+	int k = 0;
+
+	for (int u = 1; u <= l->numVertices; u++)
+	{
+		for (int v = 1; v <= l->numVertices; v++)
+		{
+			//As células vazias têm um espaço, porque strtok junta separadores seguidos
+			if (k < l->numArestas && l->origem[k] == u && l->destino[k] == v)
+			{
+				fprintf(ficheiro, v > 1 ? ";%d" : "%d", l->peso[k++]);
+			}
+			else
+			{
+				fputs(v > 1 ? "; " : " ", ficheiro);
+			}
+		}
+
+		fputc('\n', ficheiro);
+	}
+
+	fclose(ficheiro);
+	return true;
+}
+
+/**
+ * @brief Compara dois doubles para qsort.
+ *
+ * @param a Apontador para o primeiro valor.
+ * @param b Apontador para o segundo valor.
+ * @return int Negativo, zero ou positivo, como em qsort.
+ */
+static int CompararDouble(const void* a, const void* b)
+{
+	double x = *(const double*)a, y = *(const double*)b;
+	return (x > y) - (x < y);
+}
+
+/**
+ * @brief Devolve o percentil p (entre 0 e 1) de um array ordenado, pelo método do posto mais próximo.
+ *
+ * @param amostras Array ordenado.
+ * @param n Número de amostras.
+ * @param p Percentil pretendido.
+ * @return double Valor do percentil.
+ */
+static double Percentil(double amostras[], int n, double p)
+{
+	int posicao = (int)ceil(p * n) - 1;
+	return amostras[posicao < 0 ? 0 : posicao];
+}
+
+/**
+ * @brief Escreve o objeto JSON de uma operação medida.
+ *
+ * @param r Destino dos resultados.
+ * @param gerador Nome do gerador.
+ * @param l Lista de arestas do grafo medido.
+ * @param operacao Nome da operação.
+ * @param amostras Tempos de cada execução, em segundos (o array é ordenado).
+ * @param n Número de amostras.
+ */
+static void EscreverResultado(Resultados* r, const char* gerador, ListaArestas* l, const char* operacao, double amostras[], int n)
+{
+	if (n <= 0)
+	{
+		return;
+	}
+
+	double soma = 0;
+	qsort(amostras, n, sizeof(double), CompararDouble);
+
+	for (int i = 0; i < n; i++)
+	{
+		soma += amostras[i];
+	}
+
+	fprintf(r->saida, "%s\n  {\"gerador\": \"%s\", \"vertices\": %d, \"arestas\": %d, \"operacao\": \"%s\", "
+		"\"amostras\": %d, \"min_ms\": %.4f, \"p50_ms\": %.4f, \"p90_ms\": %.4f, \"p99_ms\": %.4f, "
+		"\"max_ms\": %.4f, \"media_ms\": %.4f}",
+		r->escritos > 0 ? "," : "", gerador, l->numVertices, l->numArestas, operacao, n,
+		amostras[0] * 1e3, Percentil(amostras, n, 0.5) * 1e3, Percentil(amostras, n, 0.9) * 1e3,
+		Percentil(amostras, n, 0.99) * 1e3, amostras[n - 1] * 1e3, soma / n * 1e3);
+	fflush(r->saida);
+	r->escritos++;
+}
+
+/**
+ * @brief Escreve o objeto JSON com a memória ocupada por um grafo.
+ *
+ * @param r Destino dos resultados.
+ * @param gerador Nome do gerador.
+ * @param l Lista de arestas do grafo medido.
+ * @param operacao Nome do objeto ("memoria" ou "memoria_apsp").
+ * @param m Memória do grafo, por categoria.
+ * @param espaco Memória do espaço de trabalho das pesquisas (0 se não foi usado), fora do total do grafo.
+ */
+static void EscreverMemoria(Resultados* r, const char* gerador, ListaArestas* l, const char* operacao, MemoriaGrafo m, size_t espaco)
+{
+	fprintf(r->saida, "%s\n  {\"gerador\": \"%s\", \"vertices\": %d, \"arestas\": %d, \"operacao\": \"%s\", "
+		"\"bytes_vertices\": %zu, \"bytes_adjacencias\": %zu, \"bytes_indices\": %zu, \"bytes_caches\": %zu, "
+		"\"bytes_espacos\": %zu, \"bytes_total\": %zu, \"bytes_pico\": %zu}",
+		r->escritos > 0 ? "," : "", gerador, l->numVertices, l->numArestas, operacao, m.vertices, m.adjacencias,
+		m.indices, m.caches, espaco, m.total, m.pico);
+	fflush(r->saida);
+	r->escritos++;
+}
+
+/**
+ * @brief Mede todas as operações sobre um grafo gerado.
+ *
+ * @param r Destino dos resultados.
+ * @param gerador Nome do gerador.
+ * @param l Lista de arestas do grafo.
+ * @param repeticoes Número de repetições das construções, gravações e eliminações.
+ */
+static void MedirGrafo(Resultados* r, const char* gerador, ListaArestas* l, int repeticoes)
+{
+	int n = l->numVertices;
+	double* amostras = (double*)malloc(sizeof(double) * (repeticoes > CONSULTAS ? repeticoes : CONSULTAS));
+	double* eliminacoes = (double*)malloc(sizeof(double) * repeticoes);
+	bool inf;
+
+	//Construção pela API, com uma inserção por vértice e por aresta
+	if (n <= LIMITE_API)
+	{
+		for (int i = 0; i < repeticoes; i++)
+		{
+			double t0 = Agora();
+			Grafo* g = ConstruirAPI(l);
+			amostras[i] = Agora() - t0;
+			ApagaGrafo(g);
+		}
+
+		EscreverResultado(r, gerador, l, "construcao_api", amostras, repeticoes);
+	}
+
+	//Construção por lote, seguida da eliminação do grafo construído
+	for (int i = 0; i < repeticoes; i++)
+	{
+		double t0 = Agora();
+		Grafo* g = ConstruirLote(l);
+		amostras[i] = Agora() - t0;
+
+		t0 = Agora();
+		ApagaGrafo(g);
+		eliminacoes[i] = Agora() - t0;
+	}
+
+	EscreverResultado(r, gerador, l, "construcao_lote", amostras, repeticoes);
+	EscreverResultado(r, gerador, l, "apagar", eliminacoes, repeticoes);
+
+	//Construção a partir de um ficheiro CSV com a matriz de pesos
+	if (n <= LIMITE_CSV && EscreverCSV(l, "suite.csv"))
+	{
+		for (int i = 0; i < repeticoes; i++)
+		{
+			double t0 = Agora();
+			Grafo* g = CarregaDadosCSV("suite.csv");
+			amostras[i] = Agora() - t0;
+			ApagaGrafo(g);
+		}
+
+		EscreverResultado(r, gerador, l, "construcao_csv", amostras, repeticoes);
+		remove("suite.csv");
+	}
+
+	Grafo* g = ConstruirLote(l);
+
+	//Gravação e leitura do formato binário
+	for (int i = 0; i < repeticoes; i++)
+	{
+		double t0 = Agora();
+		GuardaGrafo(g, "suite_vertices.bin", "suite_adjacencias.bin");
+		amostras[i] = Agora() - t0;
+	}
+
+	EscreverResultado(r, gerador, l, "guardar_binario", amostras, repeticoes);
+
+	for (int i = 0; i < repeticoes; i++)
+	{
+		double t0 = Agora();
+		Grafo* carregado = CarregaGrafo("suite_vertices.bin", "suite_adjacencias.bin");
+		amostras[i] = Agora() - t0;
+		ApagaGrafo(carregado);
+	}
+
+	EscreverResultado(r, gerador, l, "carregar_binario", amostras, repeticoes);
+	remove("suite_vertices.bin");
+	remove("suite_adjacencias.bin");
+
+	//Pesquisas entre pares de vértices aleatórios, sempre os mesmos para cada grafo
+	int* origens = (int*)malloc(sizeof(int) * CONSULTAS);
+	int* destinos = (int*)malloc(sizeof(int) * CONSULTAS);
+
+	for (int i = 0; i < CONSULTAS; i++)
+	{
+		origens[i] = 1 + (int)(Aleatorio() % n);
+		destinos[i] = 1 + (int)(Aleatorio() % n);
+	}
+
+	EspacoCaminhos* e = CriarEspacoCaminhos(g, &inf);
+
+	for (int i = 0; i < CONSULTAS; i++)
+	{
+		double t0 = Agora();
+		DijkstraRestrito(g, e, origens[i], destinos[i], NULL, 0);
+		amostras[i] = Agora() - t0;
+	}
+
+	EscreverResultado(r, gerador, l, "dijkstra", amostras, CONSULTAS);
+	EscreverMemoria(r, gerador, l, "memoria", ContabilizarMemoriaGrafo(g), MemoriaEspacoCaminhos(e));
+	ApagarEspacoCaminhos(e);
+
+	for (int i = 0; i < CONSULTAS; i++)
+	{
+		double t0 = Agora();
+		ExisteCaminhoGrafo(g, origens[i], destinos[i]);
+		amostras[i] = Agora() - t0;
+	}
+
+	EscreverResultado(r, gerador, l, "alcancabilidade", amostras, CONSULTAS);
+
+	//Pesquisas em largura completas, com mudança de direção, numa imagem do grafo
+	ImagemGrafo* im = CriarImagemGrafo(g, &inf);
+	EspacoLargura* el = CriarEspacoLargura(im, NULL, &inf);
+
+	for (int i = 0; i < CONSULTAS; i++)
+	{
+		double t0 = Agora();
+		LarguraDirecional(el, NULL, origens[i], -1);
+		amostras[i] = Agora() - t0;
+	}
+
+	EscreverResultado(r, gerador, l, "largura", amostras, CONSULTAS);
+	ApagarEspacoLargura(el);
+
+	//Componentes da mesma imagem, sem executor
+	for (int i = 0; i < repeticoes; i++)
+	{
+		double t0 = Agora();
+		ApagarComponentes(ComponentesConexas(im, NULL, NULL, &inf));
+		amostras[i] = Agora() - t0;
+	}
+
+	EscreverResultado(r, gerador, l, "componentes_conexas", amostras, repeticoes);
+
+	for (int i = 0; i < repeticoes; i++)
+	{
+		double t0 = Agora();
+		ApagarComponentes(ComponentesFortes(im, &inf));
+		amostras[i] = Agora() - t0;
+	}
+
+	EscreverResultado(r, gerador, l, "componentes_fortes", amostras, repeticoes);
+
+	//PageRank até convergir e proximidade das mesmas origens das pesquisas, uma de cada vez
+	double* pontuacao = (double*)malloc(sizeof(double) * (im->tamanho > 0 ? im->tamanho : 1));
+
+	for (int i = 0; i < repeticoes; i++)
+	{
+		double t0 = Agora();
+		PageRank(im, NULL, NULL, AMORTECIMENTO_PAGERANK, TOLERANCIA_PAGERANK, MAX_ITERACOES_PAGERANK, pontuacao);
+		amostras[i] = Agora() - t0;
+	}
+
+	EscreverResultado(r, gerador, l, "pagerank", amostras, repeticoes);
+	free(pontuacao);
+
+	for (int i = 0; i < CONSULTAS; i++)
+	{
+		double proximidade;
+		double t0 = Agora();
+		CentralidadeProximidade(im, NULL, &origens[i], 1, &proximidade);
+		amostras[i] = Agora() - t0;
+	}
+
+	EscreverResultado(r, gerador, l, "proximidade", amostras, CONSULTAS);
+	ApagarImagemGrafo(im);
+
+	//Todos os caminhos mais curtos, que criam um grafo com n² arestas
+	if (n <= LIMITE_APSP)
+	{
+		MemoriaGrafo memoria = { 0 };
+
+		for (int i = 0; i < repeticoes; i++)
+		{
+			double t0 = Agora();
+			Grafo* apsp = CriarGrafoCaminhoMaisCurto(g);
+			amostras[i] = Agora() - t0;
+			memoria = ContabilizarMemoriaGrafo(apsp);
+			ApagaGrafo(apsp);
+		}
+
+		EscreverResultado(r, gerador, l, "apsp", amostras, repeticoes);
+		EscreverMemoria(r, gerador, l, "memoria_apsp", memoria, 0);
+	}
+
+	free(origens);
+	free(destinos);
+	free(amostras);
+	free(eliminacoes);
+	ApagaGrafo(g);
+}
+
+/**
+ * @brief Função principal do programa de medição.
+ *
+ * @param argc Números de argumentos
+ * @param argv Array de strings (escala mínima, escala máxima, repetições e ficheiro JSON, opcionais)
+ */
+int main(int argc, char* argv[])
+{
+	int escalaMin = argc > 1 ? atoi(argv[1]) : 8;
+	int escalaMax = argc > 2 ? atoi(argv[2]) : 14;
+	int repeticoes = argc > 3 ? atoi(argv[3]) : 5;
+	const char* nomes[] = { "rmat", "erdos_renyi", "grelha", "potencia" };
+	ListaArestas* (*geradores[])(int) = { GerarRMAT, GerarErdosRenyi, GerarGrelha, GerarPotencia };
+	Resultados r = { stdout, 0 };
+
+	if (escalaMin < 2 || escalaMax > 24 || escalaMin > escalaMax || repeticoes < 1)
+	{
+		fprintf(stderr, "uso: %s [escalaMin] [escalaMax] [repeticoes] [ficheiro.json]\n", argv[0]);
+		return 1;
+	}
+
+	if (argc > 4)
+	{
+		r.saida = fopen(argv[4], "w");
+
+		if (r.saida == NULL)
+		{
+			perror(argv[4]);
+			return 1;
+		}
+	}
+
+	fprintf(r.saida, "[");
+
+	for (int escala = escalaMin; escala <= escalaMax; escala++)
+	{
+		for (int i = 0; i < (int)(sizeof(nomes) / sizeof(nomes[0])); i++)
+		{
+			ListaArestas* l = geradores[i](escala);
+			fprintf(stderr, "%s 2^%d: %d vertices, %d arestas\n", nomes[i], escala, l->numVertices, l->numArestas);
+			MedirGrafo(&r, nomes[i], l, repeticoes);
+			ApagarListaArestas(l);
+		}
+	}
+
+	fprintf(r.saida, "\n]\n");
+
+	if (r.saida != stdout)
+	{
+		fclose(r.saida);
+	}
+
+	return 0;
+}
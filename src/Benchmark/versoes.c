@@ -0,0 +1,321 @@
+/**
+ * @file versoes.c
+ * @author Hugo Cruz (a23010)
+ * @brief Programa de medição da latência das pesquisas enquanto o grafo é alterado.
+ *
+ * Este programa cria um grafo em grelha e várias threads leitoras que fazem pesquisas de Dijkstra
+ * sobre a versão publicada. A latência é medida primeiro sem alterações e depois com uma thread
+ * escritora a aplicar lotes de alterações e a publicar novas versões continuamente.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include <threads.h>
+#include "../Grafos/caminhos.h"
+#include "../Grafos/lote.h"
+#include "../Grafos/versoes.h"
+
+/**
+ * @def MAX_AMOSTRAS
+ * @brief Número máximo de latências guardadas por thread leitora.
+ */
+#define MAX_AMOSTRAS 100000
+
+/**
+ * @brief Estado partilhado entre as threads do programa.
+ *
+ */
+typedef struct Medicao
+{
+	GestorVersoes* gv;	   ///< Gestor com as versões publicadas.
+	int lado;			   ///< Lado da grelha.
+	atomic_bool terminar;  ///< Indica às threads que devem parar.
+	atomic_long publicacoes; ///< Número de versões publicadas pela escritora.
+
+} Medicao;
+
+/**
+ * @brief Estado de uma thread leitora.
+ *
+ */
+typedef struct Leitor
+{
+	Medicao* m;		  ///< Estado partilhado.
+	unsigned semente; ///< Semente dos vértices pesquisados.
+	double* amostras; ///< Latência de cada pesquisa, em microssegundos.
+	int numAmostras;  ///< Número de pesquisas feitas.
+
+} Leitor;
+
+/**
+ * @brief Devolve o instante atual em segundos.
+ *
+ * @return double Segundos desde uma origem fixa.
+ */
+static double Agora()
+{
+	struct timespec t;
+	timespec_get(&t, TIME_UTC);
+	return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Gerador pseudo-aleatório de cada thread (rand não pode ser usado em várias threads).
+ *
+ * @param s Apontador para o estado do gerador.
+ * @return unsigned Próximo número.
+ */
+static unsigned Aleatorio(unsigned* s)
+{
+	*s = *s * 1103515245u + 12345u;
+	return *s >> 8;
+}
+
+/**
+ * @brief Cria um grafo em grelha com ligações nos dois sentidos e pesos entre 1 e 100.
+ *
+ * @param lado Número de linhas e de colunas.
+ * @return Grafo* Apontador para o grafo criado.
+ */
+static Grafo* CriarGrafoGrelha(int lado)
+{
+	bool inf;
+	Grafo* g = CriarGrafo(&inf);
+	LoteAlteracoes* l = CriarLoteAlteracoes(lado * lado * 5, &inf);
+
+	for (int i = 0; i < lado * lado; i++)
+	{
+		InserirVerticeLote(l, i, &inf);
+	}
+
+	for (int i = 0; i < lado * lado; i++)
+	{
+		if ((i + 1) % lado != 0)
+		{
+			InserirAdjLote(l, i, i + 1, 1 + rand() % 100, &inf);
+			InserirAdjLote(l, i + 1, i, 1 + rand() % 100, &inf);
+		}
+
+		if (i + lado < lado * lado)
+		{
+			InserirAdjLote(l, i, i + lado, 1 + rand() % 100, &inf);
+			InserirAdjLote(l, i + lado, i, 1 + rand() % 100, &inf);
+		}
+	}
+
+	g = AplicarLoteGrafo(g, l, &inf);
+	ApagarLoteAlteracoes(l);
+	return g;
+}
+
+/**
+ * @brief Função das threads leitoras: pesquisas entre vértices aleatórios até terminar.
+ *
+ * @param arg Apontador para o Leitor.
+ * @return int 0.
+ */
+static int ExecutarLeitor(void* arg)
+{
+	Leitor* l = (Leitor*)arg;
+	Medicao* m = l->m;
+	int id = RegistarLeitor(m->gv);
+	EspacoCaminhos* e = NULL;
+	bool inf;
+
+	while (!atomic_load(&m->terminar) && l->numAmostras < MAX_AMOSTRAS)
+	{
+		int origem = Aleatorio(&l->semente) % (m->lado * m->lado);
+		int destino = Aleatorio(&l->semente) % (m->lado * m->lado);
+
+		double t0 = Agora();
+		ImagemGrafo* im = FixarVersao(m->gv, id);
+
+		if (e == NULL)
+		{
+			e = CriarEspacoImagem(im, &inf);
+		}
+
+		DijkstraImagem(im, e, origem, destino);
+		SoltarVersao(m->gv, id);
+
+		l->amostras[l->numAmostras++] = (Agora() - t0) * 1e6;
+	}
+
+	ApagarEspacoCaminhos(e);
+	RemoverLeitor(m->gv, id);
+	return 0;
+}
+
+/**
+ * @brief Função da thread escritora: altera pesos ao acaso e publica uma versão por lote.
+ *
+ * @param arg Apontador para um array com o Medicao e o grafo.
+ * @return int 0.
+ */
+static int ExecutarEscritor(void* arg)
+{
+	void** args = (void**)arg;
+	Medicao* m = (Medicao*)args[0];
+	Grafo* g = (Grafo*)args[1];
+	unsigned semente = 99;
+	bool inf;
+	LoteAlteracoes* l = CriarLoteAlteracoes(2048, &inf);
+
+	while (!atomic_load(&m->terminar))
+	{
+		LimparLoteAlteracoes(l);
+
+		//Substitui 500 adjacências para a direita por outras com um peso novo
+		for (int i = 0; i < 500; i++)
+		{
+			int v = Aleatorio(&semente) % (m->lado * m->lado);
+
+			if ((v + 1) % m->lado != 0)
+			{
+				EliminaAdjLote(l, v, v + 1, &inf);
+				InserirAdjLote(l, v, v + 1, 1 + Aleatorio(&semente) % 100, &inf);
+			}
+		}
+
+		g = AplicarLoteGrafo(g, l, &inf);
+		PublicarVersao(m->gv, g, &inf);
+		atomic_fetch_add(&m->publicacoes, 1);
+	}
+
+	ApagarLoteAlteracoes(l);
+	return 0;
+}
+
+/**
+ * @brief Compara dois doubles para qsort.
+ *
+ * @param a Apontador para o primeiro valor.
+ * @param b Apontador para o segundo valor.
+ * @return int Negativo, zero ou positivo, como em qsort.
+ */
+static int CompararDouble(const void* a, const void* b)
+{
+	double x = *(const double*)a, y = *(const double*)b;
+	return (x > y) - (x < y);
+}
+
+/**
+ * @brief Executa uma fase da medição e escreve os percentis da latência.
+ *
+ * @param m Estado partilhado.
+ * @param g Grafo usado pela escritora.
+ * @param numLeitores Número de threads leitoras.
+ * @param comEscritor true para alterar o grafo durante a fase.
+ * @param segundos Duração da fase.
+ */
+static void ExecutarFase(Medicao* m, Grafo* g, int numLeitores, bool comEscritor, double segundos)
+{
+	thrd_t threads[MAX_LEITORES_VERSOES], escritor;
+	Leitor leitores[MAX_LEITORES_VERSOES];
+	void* args[2] = { m, g };
+
+	atomic_store(&m->terminar, false);
+	atomic_store(&m->publicacoes, 0);
+
+	for (int i = 0; i < numLeitores; i++)
+	{
+		leitores[i].m = m;
+		leitores[i].semente = 17 + i;
+		leitores[i].amostras = (double*)malloc(sizeof(double) * MAX_AMOSTRAS);
+		leitores[i].numAmostras = 0;
+		thrd_create(&threads[i], ExecutarLeitor, &leitores[i]);
+	}
+
+	if (comEscritor)
+	{
+		thrd_create(&escritor, ExecutarEscritor, args);
+	}
+
+	struct timespec espera = { (time_t)segundos, (long)((segundos - (time_t)segundos) * 1e9) };
+	thrd_sleep(&espera, NULL);
+	atomic_store(&m->terminar, true);
+
+	for (int i = 0; i < numLeitores; i++)
+	{
+		thrd_join(threads[i], NULL);
+	}
+
+	if (comEscritor)
+	{
+		thrd_join(escritor, NULL);
+	}
+
+	//Junta as amostras de todos os leitores
+	int total = 0;
+
+	for (int i = 0; i < numLeitores; i++)
+	{
+		total += leitores[i].numAmostras;
+	}
+
+	double* todas = (double*)malloc(sizeof(double) * (total > 0 ? total : 1));
+	int k = 0;
+
+	for (int i = 0; i < numLeitores; i++)
+	{
+		for (int j = 0; j < leitores[i].numAmostras; j++)
+		{
+			todas[k++] = leitores[i].amostras[j];
+		}
+
+		free(leitores[i].amostras);
+	}
+
+	qsort(todas, total, sizeof(double), CompararDouble);
+
+	if (total > 0)
+	{
+		printf("%s;%d;%ld;%.1f;%.1f;%.1f;%.1f\n", comEscritor ? "com_escritor" : "sem_escritor", total,
+			atomic_load(&m->publicacoes), todas[total / 2], todas[(int)(total * 0.99)],
+			todas[(int)(total * 0.999)], todas[total - 1]);
+	}
+
+	free(todas);
+}
+
+/**
+ * @brief Função principal do programa de medição.
+ *
+ * @param argc Números de argumentos
+ * @param argv Array de strings (lado da grelha, número de leitores e segundos por fase, opcionais)
+ */
+int main(int argc, char* argv[])
+{
+	int lado = argc > 1 ? atoi(argv[1]) : 100;
+	int numLeitores = argc > 2 ? atoi(argv[2]) : 4;
+	double segundos = argc > 3 ? atof(argv[3]) : 2.0;
+	bool inf;
+
+	if (numLeitores < 1 || numLeitores > MAX_LEITORES_VERSOES - 1)
+	{
+		numLeitores = 4;
+	}
+
+	srand(7);
+	Grafo* g = CriarGrafoGrelha(lado);
+
+	Medicao m;
+	m.gv = CriarGestorVersoes(g, &inf);
+	m.lado = lado;
+	atomic_init(&m.terminar, false);
+	atomic_init(&m.publicacoes, 0);
+
+	printf("fase;pesquisas;publicacoes;p50_us;p99_us;p999_us;max_us\n");
+	ExecutarFase(&m, g, numLeitores, false, segundos);
+	ExecutarFase(&m, g, numLeitores, true, segundos);
+
+	ApagarGestorVersoes(m.gv);
+	ApagaGrafo(g);
+	return 0;
+}
@@ -8,7 +8,79 @@
  * @copyright Copyright (c) 2024
  *
  */
+#include <math.h>
 #include "InputOutput.h"
+#include "kcaminhos.h"
+#include "lote.h"
+#include "estatisticas.h"
+#include "largura.h"
+#include "componentes.h"
+#include "centralidade.h"
+
+//Fora do Visual Studio usa-se a função POSIX equivalente, com os mesmos parâmetros
+#if !defined(_MSC_VER)
+#define strtok_s strtok_r
+#endif
+
+/**
+ * @def TAMANHO_BUFFER_ESCRITA
+ * @brief Tamanho do buffer usado para escrever caminhos em ficheiros.
+ */
+#define TAMANHO_BUFFER_ESCRITA (1 << 16)
+
+/**
+ * @brief Devolve o tamanho de um ficheiro aberto, sem alterar a posição de leitura.
+ *
+ * @param ficheiro Ficheiro aberto.
+ * @return long long Tamanho em bytes, ou -1 se não puder ser obtido.
+ */
+static long long TamanhoFicheiro(FILE* ficheiro)
+{
+	long posicao = ftell(ficheiro);
+
+	if (posicao < 0 || fseek(ficheiro, 0, SEEK_END) != 0)
+	{
+		return -1;
+	}
+
+	long long tamanho = ftell(ficheiro);
+	fseek(ficheiro, posicao, SEEK_SET);
+	return tamanho;
+}
+
+/**
+ * @brief Escreve um inteiro em texto decimal.
+ *
+ * Esta função evita o custo de printf quando são escritos muitos ids seguidos.
+ *
+ * @param destino Posição onde o texto é escrito (precisa de pelo menos 20 caracteres).
+ * @param valor Inteiro a escrever (um id ou uma distância).
+ * @return size_t Número de caracteres escritos.
+ */
+static size_t EscreverInteiro(char* destino, long long valor)
+{
+	char aux[20];
+	size_t n = 0, escritos = 0;
+	unsigned long long u = valor < 0 ? 0ull - (unsigned long long)valor : (unsigned long long)valor;
+
+	do
+	{
+		aux[n++] = (char)('0' + u % 10);
+		u /= 10;
+	} while (u > 0);
+
+	if (valor < 0)
+	{
+		destino[escritos++] = '-';
+	}
+
+	while (n > 0)
+	{
+		destino[escritos++] = aux[--n];
+	}
+
+	return escritos;
+}
 
  /**
   * @brief Função para mostar vértices as adjacências.
@@ -30,7 +102,7 @@ void MostraVertice(Vertice* grafo)
 
 		while (adj)
 		{
-			if (adj->peso > 0 && adj->peso != INT_MAX)
+			if (adj->peso != 0)
 			{
 				printf("\tAdj: %d - (%d)\n", adj->id, adj->peso);
 
@@ -52,7 +124,28 @@ void MostraVertice(Vertice* grafo)
  */
 void MostraGrafo(Grafo* g)
 {
-	MostraVertice(g->inicioGrafo);
+	if (g->matriz == NULL)
+	{
+		MostraVertice(g->inicioGrafo);
+		return;
+	}
+
+	//Num grafo denso as adjacências de cada vértice são as colunas da sua linha
+	for (Vertice* aux = g->inicioGrafo; aux != NULL; aux = aux->nextV)
+	{
+		printf("\nVertice: %d\n\n", aux->id);
+
+		if (aux->id < 0 || aux->id >= g->matriz->tamanho)
+		{
+			continue;
+		}
+
+		for (int w = ProximaLigacaoMatriz(g->matriz, aux->id, 0); w >= 0; w = ProximaLigacaoMatriz(g->matriz, aux->id, w + 1))
+		{
+			printf("\tAdj: %d - (%d)\n", w, (int)PesoLigacaoMatriz(g->matriz, aux->id, w));
+		}
+	}
+	printf("\n");
 }
 
 /**
@@ -60,6 +153,9 @@ void MostraGrafo(Grafo* g)
  *
  * Esta função recebe o nome de um ficheiro, lê o ficheiro e retorna os dados lidos. Se o ficheiro não puder ser aberto, retorna NULL. Caso contrário, lê o ficheiro inteiro para uma string e retorna essa string.
  *
+ * Com um orçamento de memória definido (DefinirOrcamentoMemoria), os ficheiros maiores do que o
+ * orçamento não são lidos e a função retorna NULL.
+ *
  * @param file Nome do arquivo a ser lido.
  * @return char* Retorna os dados lidos do arquivo.
  */
@@ -72,6 +168,13 @@ char* ReadFile(char* file)
 	int tamanho = ftell(ficheiro); //Calcula o tamanho em bytes 
 	fseek(ficheiro, 0, SEEK_SET); //Coloca o apontador para fille no início do arquivo
 
+	//Com orçamento de memória o ficheiro só é lido se couber
+	if (tamanho < 0 || !CabeNoOrcamentoMemoria((size_t)tamanho + 1))
+	{
+		fclose(ficheiro);
+		return NULL;
+	}
+
 	char* dados = (char*)malloc(sizeof(char) * tamanho + 1); //Aloca memória para o tamanho do ficheiro + 1
 
 	//Informa me o tamanho lido em bytes coloca o final da string como NULL
@@ -79,6 +182,7 @@ char* ReadFile(char* file)
 	{
 		size_t bytesRead = fread(dados, 1, tamanho, ficheiro);
 		dados[bytesRead] = '\0';
+		CONTAR_ESTATISTICA(bytesLidos, bytesRead);
 	}
 	else
 	{
@@ -155,9 +259,14 @@ Grafo* CriarVerticesCSV(char* dados)
 	//Conta linhas e colunas
 	Contador(dados, &linhas, &colunas);
 
+	if (linhas == 0 || colunas == 0)
+	{
+		free(dados);
+		return NULL;
+	}
+
 	Grafo* g = CriarGrafo(&inf);
 
-	if (linhas == NULL || colunas == NULL) return NULL;
 	//Cria o número de vertices que corresponde ao maior valor
 	if (linhas <= colunas)
 	{
@@ -187,6 +296,11 @@ Grafo* CriarVerticesCSV(char* dados)
  * Esta função recebe uma string de dados que representa um ficheiro CSV. Cria
  * um grafo e insere vértices no grafo com base nos dados. O número de vértices inseridos
  * é o maior entre o número de linhas e o número de colunas nos dados. Retorna um apontador para o grafo criado.
+ * Os pesos são lidos para uma matriz de adjacências; se mais de DENSIDADE_MATRIZ das células forem
+ * ligações o grafo fica com a matriz, caso contrário as adjacências passam para as listas.
+ *
+ * O carregamento falha se o texto ou a matriz não couberem no orçamento de memória definido com
+ * DefinirOrcamentoMemoria; a verificação é feita antes de alocar a matriz.
  *
  * @param file Nome do arquivo CSV (argumento 1).
  * @return Grafo* Retorna um apontador para o grafo criado.
@@ -200,9 +314,41 @@ Grafo* CarregaDadosCSV(char* file)
 	char* saveptr_coluna = NULL;
 
 	char* dados = ReadFile(file); //Le tudo do ficheiro csv
+
+	if (dados == NULL) return NULL;
+
+	//strtok_s avança dados, pelo que o início do texto é guardado para o libertar no fim
+	char* inicioDados = dados;
+
+	//O texto fica duas vezes em memória enquanto os vértices são contados
+	size_t texto = strlen(dados) + 1;
+
+	if (!CabeNoOrcamentoMemoria(2 * texto))
+	{
+		free(dados);
+		return NULL;
+	}
+
 	char* dados_copy = strdup(dados); // Cria uma c�pia da string lida
 	Grafo* g = CriarVerticesCSV(dados_copy); // Conta e cria os vertices
 
+	//Os vértices vão de 1 ao maior número de linhas ou de colunas
+	int numVertices = g != NULL ? ContadorVertices(g) : 0;
+
+	//A matriz é alocada antes de ler os pesos, pelo que o seu tamanho é conhecido
+	size_t lado = (size_t)numVertices + 1;
+	size_t necessario = texto + ContabilizarMemoriaGrafo(g).total + sizeof(MatrizAdjacencia) +
+		lado * lado * sizeof(PesoAresta) + lado * ((lado + BITS_PALAVRA - 1) / BITS_PALAVRA) * sizeof(PalavraBits);
+
+	if (g != NULL && !CabeNoOrcamentoMemoria(necessario))
+	{
+		ApagaGrafo(g);
+		free(dados);
+		return NULL;
+	}
+
+	MatrizAdjacencia* m = g != NULL ? CriarMatrizAdjacencia(numVertices + 1, &inf) : NULL;
+
 	//Divide uma string em tokens separados por \n
 	dados = strtok_s(dados, "\n", &saveptr_linha);
 
@@ -214,14 +360,47 @@ Grafo* CarregaDadosCSV(char* file)
 		while (dados != NULL)
 		{
 			colunas++;
-			g = InserirAdjGrafo(g, linhas, colunas, atoi(dados), &inf); //Tranforma uma string em inteiro
+			int peso = atoi(dados); //Tranforma uma string em inteiro
+
+			//Células vazias ou a 0 não são ligações, valores negativos são descontos válidos
+			if (peso != 0 && m != NULL)
+			{
+				if (PESO_VALIDO(peso))
+				{
+					DefinirLigacaoMatriz(m, linhas, colunas, (PesoAresta)peso);
+				}
+			}
+			else if (peso != 0)
+			{
+				g = InserirAdjGrafo(g, linhas, colunas, peso, &inf);
+			}
 			dados = strtok_s(NULL, ";", &saveptr_coluna); //Coloca NULL e avança
 		}
 		colunas = 0;
 		dados = strtok_s(NULL, "\n", &saveptr_linha);
 	}
 
-	free(dados);
+	//Só os grafos densos ficam com a matriz
+	if (m != NULL)
+	{
+		g->matriz = m;
+
+		//O pico inclui a matriz, mesmo que depois passe para as listas
+		AjustarMemoriaGrafo(g, 0, (long long)MemoriaMatrizAdjacencia(m), 0);
+
+		if (m->numArestas > 0)
+		{
+			g->versao++;
+		}
+
+		if (m->numArestas <= DENSIDADE_MATRIZ * numVertices * numVertices)
+		{
+			ExpandirMatrizGrafo(g);
+		}
+	}
+
+	ContabilizarMemoriaGrafo(g);
+	free(inicioDados);
 	return g;
 
 }
@@ -256,6 +435,7 @@ void GuardaVertices(Grafo* g, char* file)
 		auxV = auxV->nextV;
 	}
 
+	CONTAR_ESTATISTICA(bytesEscritos, ftell(ficheiro));
 	fclose(ficheiro);  // Fecha o ficheiro após a escrita
 }
 
@@ -265,6 +445,9 @@ void GuardaVertices(Grafo* g, char* file)
  * Esta função carrega os vértices de um ficheiro binário para um grafo. Lê o
  * ficheiro e adiciona cada vértice ao grafo.
  *
+ * Falha, sem alocar, se a memória estimada a partir do tamanho do ficheiro ultrapassar o orçamento
+ * definido com DefinirOrcamentoMemoria.
+ *
  * @param file Nome do arquivo
  * @return Grafo* Retorna um apontador para o grafo criado
  */
@@ -273,18 +456,23 @@ Grafo* CarregaVertices(char* file)
 	bool inf;
 	FILE* ficheiro = fopen(file, "rb");
 
-	if (ficheiro == NULL) return;
+	if (ficheiro == NULL) return NULL;
+
+	//Cada registo do ficheiro dá origem a um vértice
+	long long tamanho = TamanhoFicheiro(ficheiro);
+
+	if (tamanho < 0 || !CabeNoOrcamentoMemoria(sizeof(Grafo) + (size_t)(tamanho / sizeof(VerticeFile)) * sizeof(Vertice)))
+	{
+		fclose(ficheiro);
+		return NULL;
+	}
 
 	Grafo* g = CriarGrafo(&inf);//Cria um grafo 
 
 	VerticeFile auxVF;
-	Vertice* novo = NULL;
-
-	//Le o cabeçalho
-	fread(&auxVF, sizeof(auxVF), 1, ficheiro) == 1;
 
-	//Se for o ficheiro correto contínua a ler 
-	if (auxVF.id == -7)
+	//Le o cabeçalho e, se for o ficheiro correto, contínua a ler
+	if (fread(&auxVF, sizeof(auxVF), 1, ficheiro) == 1 && auxVF.id == -7)
 	{
 		while (fread(&auxVF, sizeof(auxVF), 1, ficheiro) == 1)
 		{
@@ -293,9 +481,12 @@ Grafo* CarregaVertices(char* file)
 	}
 	else
 	{
+		ApagaGrafo(g);
+		fclose(ficheiro);
 		return NULL;
 	}
 
+	CONTAR_ESTATISTICA(bytesLidos, ftell(ficheiro));
 	fclose(ficheiro);//Fecha o ficheiro 
 	return g;
 }
@@ -337,6 +528,17 @@ void GuardarAdjacentes(Grafo* g, char* file)
 			auxA = auxA->next;
 		}
 
+		//Num grafo denso as adjacências estão na linha da matriz
+		if (g->matriz != NULL && auxV->id >= 0 && auxV->id < g->matriz->tamanho)
+		{
+			for (int w = ProximaLigacaoMatriz(g->matriz, auxV->id, 0); w >= 0; w = ProximaLigacaoMatriz(g->matriz, auxV->id, w + 1))
+			{
+				auxAF.id = w;
+				auxAF.peso = PesoLigacaoMatriz(g->matriz, auxV->id, w);
+				fwrite(&auxAF, sizeof(AdjacenteFile), 1, ficheiro);
+			}
+		}
+
 		//Marca para sair do while na leitura
 		auxAF.id = -1;
 		fwrite(&auxAF, sizeof(AdjacenteFile), 1, ficheiro);
@@ -344,6 +546,7 @@ void GuardarAdjacentes(Grafo* g, char* file)
 		auxV = auxV->nextV;
 	}
 
+	CONTAR_ESTATISTICA(bytesEscritos, ftell(ficheiro));
 	fclose(ficheiro);
 }
 
@@ -353,6 +556,9 @@ void GuardarAdjacentes(Grafo* g, char* file)
  * Esta função carrega as adjacências de um ficheiro binário para um grafo. Lê o ficheiro
  * e adiciona cada adjacência ao grafo correspondente.
  *
+ * Se as adjacências do ficheiro, somadas à memória atual do grafo, não couberem no orçamento
+ * (ver DefinirOrcamentoMemoria), o grafo não é alterado e a função retorna NULL.
+ *
  * @param grafo Apontador para o grafo onde seram carregado os dados.
  * @param file  Nome do arquivo.
  * @return Grafo* Retorna um apontador para o grafo atualizado.
@@ -365,11 +571,23 @@ Grafo* CarregaAdjacencias(Grafo* grafo, char* file)
 
 	AdjacenteFile auxAF;
 
-	//Le o cabeçalho
-	fread(&auxAF, sizeof(auxAF), 1, ficheiro) == 1;
+	//Le o cabeçalho; se for o ficheiro com um id diferente de -8 não le
+	if (fread(&auxAF, sizeof(auxAF), 1, ficheiro) != 1 || auxAF.id != -8)
+	{
+		fclose(ficheiro);
+		return NULL;
+	}
+
+	//Cada registo é uma adjacência (e mais uma entrada se o índice estiver ativo), exceto o cabeçalho e o -1 de cada vértice
+	long long tamanho = TamanhoFicheiro(ficheiro);
+	long long registos = tamanho / (long long)sizeof(AdjacenteFile) - 1 - ContadorVertices(grafo);
+	size_t porAresta = grafo->indice != NULL ? 2 * sizeof(Adjacente) : sizeof(Adjacente);
 
-	//Se for o ficheiro com um id diferente de -8 não le
-	if (auxAF.id != -8) return NULL;
+	if (tamanho < 0 || !CabeNoOrcamentoMemoria(ContabilizarMemoriaGrafo(grafo).total + (size_t)(registos > 0 ? registos : 0) * porAresta))
+	{
+		fclose(ficheiro);
+		return NULL;
+	}
 
 	Vertice* aux = grafo->inicioGrafo;
 
@@ -384,7 +602,7 @@ Grafo* CarregaAdjacencias(Grafo* grafo, char* file)
 		aux = aux->nextV;
 	}
 
-
+	CONTAR_ESTATISTICA(bytesLidos, ftell(ficheiro));
 	fclose(ficheiro);
 	return grafo;
 }
@@ -421,6 +639,15 @@ Grafo* CarregaGrafo(char* vertices, char* adjacencias)
 	if (g == NULL)return NULL;
 	Grafo* grafo = CarregaAdjacencias(g, adjacencias);
 
+	//Sem as adjacências o grafo carregado não é devolvido
+	if (grafo == NULL)
+	{
+		ApagaGrafo(g);
+		return NULL;
+	}
+
+	ContabilizarMemoriaGrafo(grafo);
+
 	return grafo;
 }
 
@@ -457,30 +684,182 @@ Grafo* CarregaDados(char* file, char* vertices, char* adjacencias)
 
 }
 
+/**
+ * @brief Carrega um grafo de uma lista de adjacências com ids externos de 64 bits.
+ *
+ * Cada linha do ficheiro tem o formato origem;destino;peso. Os ids externos são convertidos em
+ * ids internos seguidos, pela ordem em que aparecem, e todos os vértices e adjacências são
+ * inseridos num único lote. As linhas com peso 0 só registam os vértices.
+ *
+ * @param file Nome do ficheiro de texto.
+ * @param mapa Apontador onde fica o mapa entre ids externos e internos.
+ * @return Grafo* Retorna um apontador para o grafo criado, ou NULL em caso de erro.
+ */
+Grafo* CarregaAdjacenciasExternas(char* file, MapaIds** mapa)
+{
+	bool inf;
+	*mapa = NULL;
+
+	char* dados = ReadFile(file);
+
+	if (dados == NULL) return NULL;
+
+	MapaIds* m = CriarMapaIds(1024, &inf);
+	LoteAlteracoes* l = CriarLoteAlteracoes(1024, &inf);
+	Grafo* g = CriarGrafo(&inf);
+	bool ok = m != NULL && l != NULL && g != NULL;
+	char* p = dados;
+
+	while (ok && *p != '\0')
+	{
+		char* fim;
+		long long ids[2];
+		int n = 0;
+
+		//Lê a origem e o destino, separados por ;
+		while (n < 2)
+		{
+			ids[n] = strtoll(p, &fim, 10);
+
+			if (fim == p || *fim != ';') break;
+
+			n++;
+			p = fim + 1;
+		}
+
+		int peso = (int)strtol(p, &fim, 10);
+
+		if (n == 2 && fim != p)
+		{
+			for (int i = 0; i < 2 && ok; i++)
+			{
+				int total = m->numIds;
+				ids[i] = RegistarIdExterno(m, ids[i], &ok);
+
+				//Só os ids novos dão origem a vértices
+				if (ok && m->numIds > total)
+				{
+					InserirVerticeLote(l, (int)ids[i], &ok);
+				}
+			}
+
+			if (ok && peso != 0)
+			{
+				InserirAdjLote(l, (int)ids[0], (int)ids[1], peso, &ok);
+			}
+
+			p = fim;
+		}
+
+		//Avança para a linha seguinte (as linhas mal formadas são ignoradas)
+		while (*p != '\0' && *p != '\n') p++;
+		if (*p == '\n') p++;
+	}
+
+	free(dados);
+
+	if (ok)
+	{
+		g = AplicarLoteGrafo(g, l, &ok);
+	}
+
+	ApagarLoteAlteracoes(l);
+
+	if (!ok)
+	{
+		ApagarMapaIds(m);
+		if (g != NULL) ApagaGrafo(g);
+		return NULL;
+	}
+
+	*mapa = m;
+	return g;
+}
+
+/**
+ * @brief Guarda um grafo com ids externos em três ficheiros binários.
+ *
+ * Os vértices e as adjacências são guardados com GuardaGrafo, com os ids internos, e o mapa
+ * com GuardaMapaIds.
+ *
+ * @param g Apontador para o grafo a guardar.
+ * @param m Apontador para o mapa de ids.
+ * @param vertices Nome do arquivo para vértices.
+ * @param adjacencias Nome do arquivo para adjacências.
+ * @param mapa Nome do arquivo para o mapa de ids.
+ */
+void GuardaGrafoExterno(Grafo* g, MapaIds* m, char* vertices, char* adjacencias, char* mapa)
+{
+	GuardaGrafo(g, vertices, adjacencias);
+	GuardaMapaIds(m, mapa);
+}
+
+/**
+ * @brief Carrega um grafo com ids externos guardado com GuardaGrafoExterno.
+ *
+ * @param vertices Nome do arquivo para vértices.
+ * @param adjacencias Nome do arquivo para adjacências.
+ * @param mapa Nome do arquivo para o mapa de ids.
+ * @param m Apontador onde fica o mapa carregado.
+ * @return Grafo* Retorna um apontador para o grafo carregado, ou NULL em caso de erro.
+ */
+Grafo* CarregaGrafoExterno(char* vertices, char* adjacencias, char* mapa, MapaIds** m)
+{
+	*m = CarregaMapaIds(mapa);
+
+	if (*m == NULL) return NULL;
+
+	Grafo* g = CarregaGrafo(vertices, adjacencias);
+
+	if (g == NULL)
+	{
+		ApagarMapaIds(*m);
+		*m = NULL;
+	}
+
+	return g;
+}
+
 /**
  * @brief Mostra o caminho de um vértice de origem a um vértice de destino.
  * 
+ * O caminho é copiado para um array com o tamanho exato e escrito de uma só vez.
+ * 
  * @param verticeAnt Array que contém os antecessore de cada vertice
+ * @param tamanho Número de elementos de verticeAnt
  * @param destino Destino final 
  */
-void ImprimirCaminho(int verticeAnt[], int destino)
+void ImprimirCaminho(int verticeAnt[], int tamanho, int destino)
 {
-	int caminho[MAX];
-	int contador = 0;
-	int atual = destino;
+	int numVertices = TamanhoCaminho(verticeAnt, tamanho, destino);
 
-     // Coloca num arrays todos os anteriores a cada vertice
-	while (atual != -1)
+	if (numVertices < 1)
 	{
-		caminho[contador++] = atual;
-		atual = verticeAnt[atual];
+		return;
 	}
 
- 	// Imprime o caminho do vértice de origem ao vértice de destino
-	for (int i = contador - 1; i >= 0; i--)
+	//Cada id ocupa no máximo 11 caracteres mais o espaço
+	int* caminho = (int*)malloc(sizeof(int) * numVertices);
+	char* texto = (char*)malloc((size_t)numVertices * 12 + 1);
+
+	if (caminho != NULL && texto != NULL)
 	{
-		printf("%d ", caminho[i]);
+		CopiarCaminho(verticeAnt, tamanho, destino, caminho, numVertices);
+
+		// Imprime o caminho do vértice de origem ao vértice de destino
+		size_t posicao = 0;
+
+		for (int i = 0; i < numVertices; i++)
+		{
+			posicao += EscreverInteiro(texto + posicao, caminho[i]);
+			texto[posicao++] = ' ';
+		}
+
+		fwrite(texto, 1, posicao, stdout);
 	}
+
+	free(caminho);
+	free(texto);
 }
 
 /**
@@ -500,28 +879,391 @@ void MostrarCaminho(Grafo* g, int origem, int destino)
 		return;
 	}
 
-	int distanciasFinais[MAX];
-	int verticeAnt[MAX];
+	// Obtém as distâncias e os vértices anteriores, reaproveitando a cache do grafo
+	ArvoreCaminhos* a = ObterArvoreCaminhos(g, origem);
 
-	// Inicializa o array de vértices anteriores
-	for (int i = 0; i < MAX; i++)
+	if (a == NULL)
 	{
-		verticeAnt[i] = -1;
+		return;
 	}
 
- 	// Inicializa o array de vértices anteriores
-	InicializarArrays(distanciasFinais);
-
-	Dijkstra(g, origem, distanciasFinais, verticeAnt);
-
-	if (distanciasFinais[destino] == INT_MAX)
+	if (destino < 0 || destino >= a->tamanho || a->distancias[destino] == DISTANCIA_INFINITA)
 	{
 		printf("Nao existe caminho de %d para %d\n", origem, destino);
 	}
 	else
 	{
 		printf("Caminho de %d para %d: ", origem, destino);
-		ImprimirCaminho(verticeAnt, destino);
-		printf("\nDistancia: %d\n", distanciasFinais[destino]);
+		ImprimirCaminho(a->verticeAnt, a->tamanho, destino);
+		printf("\nDistancia: %lld\n", (long long)a->distancias[destino]);
+	}
+
+	LibertarArvoreCaminhos(a);
+}
+
+/**
+ * @brief Mostra o caminho com menos ligações entre dois vértices num grafo.
+ *
+ * Os pesos não contam: o caminho é encontrado com uma pesquisa em largura sobre uma imagem do
+ * grafo, que para quando chega ao destino, e é mostrado com o número de ligações.
+ *
+ * @param g O grafo.
+ * @param origem O vértice de origem.
+ * @param destino O vértice de destino.
+ */
+void MostrarCaminhoLigacoes(Grafo* g, int origem, int destino)
+{
+	if (g == NULL)
+	{
+		return;
+	}
+
+	bool inf;
+	ImagemGrafo* im = CriarImagemGrafo(g, &inf);
+	EspacoLargura* e = im != NULL ? CriarEspacoLargura(im, NULL, &inf) : NULL;
+
+	if (e != NULL)
+	{
+		int ligacoes = LarguraDirecional(e, NULL, origem, destino);
+
+		if (ligacoes < 0)
+		{
+			printf("Nao existe caminho de %d para %d\n", origem, destino);
+		}
+		else
+		{
+			printf("Caminho de %d para %d: ", origem, destino);
+			ImprimirCaminho(e->verticeAnt, im->tamanho, destino);
+			printf("\nLigacoes: %d\n", ligacoes);
+		}
+	}
+
+	ApagarEspacoLargura(e);
+	ApagarImagemGrafo(im);
+}
+
+/**
+ * @brief Mostra as componentes conexas e fortemente conexas de um grafo.
+ *
+ * Os vértices são agrupados por componente com uma contagem, a partir do número de membros de
+ * cada componente, para não percorrer todos os vértices uma vez por componente.
+ *
+ * @param g O grafo.
+ */
+void MostrarComponentes(Grafo* g)
+{
+	if (g == NULL)
+	{
+		return;
+	}
+
+	bool inf;
+	ImagemGrafo* im = CriarImagemGrafo(g, &inf);
+	Componentes* conexas = im != NULL ? ComponentesConexas(im, NULL, NULL, &inf) : NULL;
+	Componentes* fortes = im != NULL ? ComponentesFortes(im, &inf) : NULL;
+	int* posicao = fortes != NULL ? (int*)malloc(sizeof(int) * (fortes->numComponentes + 1)) : NULL;
+	int* ordem = fortes != NULL ? (int*)malloc(sizeof(int) * (im->numVertices > 0 ? im->numVertices : 1)) : NULL;
+
+	if (conexas != NULL && posicao != NULL && ordem != NULL)
+	{
+		printf("Componentes conexas: %d\n", conexas->numComponentes);
+		printf("Componentes fortemente conexas: %d\n", fortes->numComponentes);
+
+		posicao[0] = 0;
+
+		for (int c = 0; c < fortes->numComponentes; c++)
+		{
+			posicao[c + 1] = posicao[c] + fortes->numMembros[c];
+		}
+
+		//Os vértices ficam por ordem crescente dentro de cada componente
+		for (int v = 0; v < im->tamanho; v++)
+		{
+			if (fortes->componente[v] >= 0)
+			{
+				ordem[posicao[fortes->componente[v]]++] = v;
+			}
+		}
+
+		for (int c = 0, k = 0; c < fortes->numComponentes; c++)
+		{
+			printf("Componente %d:", c);
+
+			for (int i = 0; i < fortes->numMembros[c]; i++)
+			{
+				printf(" %d", ordem[k++]);
+			}
+
+			printf("\n");
+		}
+	}
+
+	free(posicao);
+	free(ordem);
+	ApagarComponentes(conexas);
+	ApagarComponentes(fortes);
+	ApagarImagemGrafo(im);
+}
+
+/**
+ * @brief Mostra o PageRank, a centralidade de grau e a centralidade de proximidade de cada vértice de um grafo.
+ *
+ * Os valores são calculados numa imagem do grafo, com a proximidade de todos os vértices como
+ * origens, e mostrados um vértice por linha. A proximidade aparece como indefinida quando a soma
+ * das distâncias não é positiva e é omitida se o grafo tiver um ciclo negativo.
+ *
+ * @param g O grafo.
+ */
+void MostrarCentralidade(Grafo* g)
+{
+	if (g == NULL)
+	{
+		return;
+	}
+
+	bool inf;
+	ImagemGrafo* im = CriarImagemGrafo(g, &inf);
+
+	if (im == NULL)
+	{
+		return;
+	}
+
+	int n = im->tamanho > 0 ? im->tamanho : 1;
+	double* pontuacao = (double*)malloc(sizeof(double) * n);
+	double* saida = (double*)malloc(sizeof(double) * n);
+	double* entrada = (double*)malloc(sizeof(double) * n);
+	double* proximidade = (double*)malloc(sizeof(double) * n);
+
+	if (pontuacao != NULL && saida != NULL && entrada != NULL && proximidade != NULL)
+	{
+		int iteracoes = PageRank(im, NULL, NULL, AMORTECIMENTO_PAGERANK, TOLERANCIA_PAGERANK, MAX_ITERACOES_PAGERANK, pontuacao);
+
+		if (iteracoes >= 0 && CentralidadeGrau(im, NULL, NULL, saida, entrada))
+		{
+			bool comProximidade = CentralidadeProximidade(im, NULL, NULL, im->tamanho, proximidade);
+			printf("Centralidade (PageRank em %d iteracoes):\n", iteracoes);
+
+			if (!comProximidade)
+			{
+				printf("Proximidade nao calculada (ciclo negativo ou falta de memoria)\n");
+			}
+
+			for (int v = 0; v < im->tamanho; v++)
+			{
+				if (!im->existe[v])
+				{
+					continue;
+				}
+
+				printf("Vertice %d: pagerank %.4f, grau %.2f/%.2f", v, pontuacao[v], saida[v], entrada[v]);
+
+				if (comProximidade && isnan(proximidade[v]))
+				{
+					printf(", proximidade indefinida\n");
+				}
+				else if (comProximidade)
+				{
+					printf(", proximidade %.4f\n", proximidade[v]);
+				}
+				else
+				{
+					printf("\n");
+				}
+			}
+		}
+	}
+
+	free(pontuacao);
+	free(saida);
+	free(entrada);
+	free(proximidade);
+	ApagarImagemGrafo(im);
+}
+
+/**
+ * @brief Mostra os k caminhos mais curtos entre dois vértices num grafo.
+ *
+ * Esta função calcula, com o algoritmo de Yen, até k caminhos alternativos sem ciclos do vértice de
+ * origem ao vértice de destino e imprime cada um com a respetiva distância.
+ *
+ * @param g O grafo.
+ * @param origem O vértice de origem.
+ * @param destino O vértice de destino.
+ * @param k Número máximo de caminhos a mostrar.
+ */
+void MostrarKCaminhos(Grafo* g, int origem, int destino, int k)
+{
+	if (g == NULL)
+	{
+		return;
+	}
+
+	bool inf;
+	ConjuntoCaminhos* c = KCaminhosMaisCurtos(g, origem, destino, k, &inf);
+
+	if (c == NULL)
+	{
+		return;
+	}
+
+	if (c->total == 0)
+	{
+		printf("Nao existe caminho de %d para %d\n", origem, destino);
+	}
+
+	for (int i = 0; i < c->total; i++)
+	{
+		printf("Caminho %d de %d para %d: ", i + 1, origem, destino);
+
+		for (int j = c->inicio[i]; j < c->inicio[i + 1]; j++)
+		{
+			printf("%d ", c->vertices[j]);
+		}
+
+		printf("\nDistancia: %lld\n", (long long)c->custos[i]);
+	}
+
+	ApagarConjuntoCaminhos(c);
+}
+
+/**
+ * @brief Escreve num ficheiro os caminhos mais curtos de vários pedidos.
+ *
+ * Esta função calcula o caminho mais curto de cada par (origens[i], destinos[i]) e escreve uma
+ * linha por pedido no formato "origem;destino;distancia;v1 v2 ... vn". Como com pesos negativos
+ * qualquer número pode ser uma distância, quando não existe caminho a distância é escrita como
+ * "inf" e quando a origem alcança um ciclo negativo, que impede haver caminhos mais curtos, como
+ * "ciclo"; em ambos os casos a lista de vértices fica vazia. Os pedidos com a mesma origem
+ * reaproveitam a cache do grafo, e o texto é acumulado num buffer e escrito em blocos, pelo que o
+ * custo por caminho não depende de chamadas a printf.
+ *
+ * @param g Apontador para o grafo.
+ * @param origens Array com o vértice de origem de cada pedido.
+ * @param destinos Array com o vértice de destino de cada pedido.
+ * @param numPedidos Número de pedidos.
+ * @param file Nome do ficheiro a escrever.
+ * @return bool true se todos os pedidos foram escritos, e false em caso de erro (incluindo falta de memória para uma árvore).
+ */
+bool EscreverCaminhos(Grafo* g, int origens[], int destinos[], int numPedidos, char* file)
+{
+	if (g == NULL || origens == NULL || destinos == NULL)
+	{
+		return false;
 	}
+
+	FILE* ficheiro = fopen(file, "w");
+
+	if (ficheiro == NULL)
+	{
+		return false;
+	}
+
+	char* buffer = (char*)malloc(TAMANHO_BUFFER_ESCRITA);
+	int* caminho = NULL;
+	int capacidade = 0;
+	bool correu = buffer != NULL;
+	size_t posicao = 0;
+
+	for (int i = 0; i < numPedidos && correu; i++)
+	{
+		bool ciclo;
+		ArvoreCaminhos* a = ObterArvoreCaminhosCiclo(g, origens[i], &ciclo);
+		int numVertices = 0;
+		Distancia distancia = DISTANCIA_INFINITA;
+
+		if (a == NULL && !ciclo)
+		{
+			correu = false;
+			break;
+		}
+
+		if (a != NULL && destinos[i] >= 0 && destinos[i] < a->tamanho && a->distancias[destinos[i]] != DISTANCIA_INFINITA)
+		{
+			distancia = a->distancias[destinos[i]];
+			numVertices = CopiarCaminho(a->verticeAnt, a->tamanho, destinos[i], caminho, capacidade);
+
+			//O buffer do caminho só cresce quando aparece um caminho maior
+			if (numVertices > capacidade)
+			{
+				int* aux = (int*)realloc(caminho, sizeof(int) * numVertices);
+
+				if (aux == NULL)
+				{
+					correu = false;
+					LibertarArvoreCaminhos(a);
+					break;
+				}
+
+				caminho = aux;
+				capacidade = numVertices;
+				CopiarCaminho(a->verticeAnt, a->tamanho, destinos[i], caminho, capacidade);
+			}
+		}
+
+		LibertarArvoreCaminhos(a);
+
+		//Cabeçalho da linha: dois ids, uma distância e separadores
+		if (posicao + 64 > TAMANHO_BUFFER_ESCRITA)
+		{
+			correu = fwrite(buffer, 1, posicao, ficheiro) == posicao;
+			posicao = 0;
+		}
+
+		posicao += EscreverInteiro(buffer + posicao, origens[i]);
+		buffer[posicao++] = ';';
+		posicao += EscreverInteiro(buffer + posicao, destinos[i]);
+		buffer[posicao++] = ';';
+		if (ciclo)
+		{
+			memcpy(buffer + posicao, "ciclo", 5);
+			posicao += 5;
+		}
+		else if (distancia == DISTANCIA_INFINITA)
+		{
+			memcpy(buffer + posicao, "inf", 3);
+			posicao += 3;
+		}
+		else
+		{
+			posicao += EscreverInteiro(buffer + posicao, distancia);
+		}
+
+		buffer[posicao++] = ';';
+
+		for (int j = 0; j < numVertices && correu; j++)
+		{
+			//Esvazia o buffer quando não cabe mais um id
+			if (posicao + 13 > TAMANHO_BUFFER_ESCRITA)
+			{
+				correu = fwrite(buffer, 1, posicao, ficheiro) == posicao;
+				posicao = 0;
+			}
+
+			posicao += EscreverInteiro(buffer + posicao, caminho[j]);
+
+			if (j < numVertices - 1)
+			{
+				buffer[posicao++] = ' ';
+			}
+		}
+
+		buffer[posicao++] = '\n';
+	}
+
+	if (correu && posicao > 0)
+	{
+		correu = fwrite(buffer, 1, posicao, ficheiro) == posicao;
+	}
+
+	free(buffer);
+	free(caminho);
+	CONTAR_ESTATISTICA(bytesEscritos, ftell(ficheiro));
+
+	if (fclose(ficheiro) != 0)
+	{
+		correu = false;
+	}
+
+	return correu;
 }
@@ -14,7 +14,8 @@
 #include <stdio.h>
 #include <string.h>
 #include <locale.h>
-#include "grafo.h"
+#include "caminhos.h"
+#include "mapa.h"
 
 
 /**
@@ -41,6 +42,9 @@ void MostraGrafo(Grafo* g);
  * 
  * Esta função recebe o nome de um ficheiro, lê o ficheiro e retorna os dados lidos. Se o ficheiro não puder ser aberto, retorna NULL. Caso contrário, lê o ficheiro inteiro para uma string e retorna essa string.
  * 
+ * Com um orçamento de memória definido (DefinirOrcamentoMemoria), os ficheiros maiores do que o
+ * orçamento não são lidos e a função retorna NULL.
+ *
  * @param file Nome do arquivo a ser lido.
  * @return char* Retorna os dados lidos do arquivo.
  */
@@ -74,7 +78,12 @@ Grafo* CriarVerticesCSV(char* dados);
  * Esta função recebe uma string de dados que representa um ficheiro CSV. Cria 
  * um grafo e insere vértices no grafo com base nos dados. O número de vértices inseridos 
  * é o maior entre o número de linhas e o número de colunas nos dados. Retorna um apontador para o grafo criado.
+ * Os pesos são lidos para uma matriz de adjacências; se mais de DENSIDADE_MATRIZ das células forem
+ * ligações o grafo fica com a matriz, caso contrário as adjacências passam para as listas.
  * 
+ * O carregamento falha se o texto ou a matriz não couberem no orçamento de memória definido com
+ * DefinirOrcamentoMemoria; a verificação é feita antes de alocar a matriz.
+ *
  * @param file Nome do arquivo CSV (argumento 1).
  * @return Grafo* Retorna um apontador para o grafo criado.
  */
@@ -97,6 +106,9 @@ void GuardaVertices(Grafo* g, char* file);
  * Esta função carrega os vértices de um ficheiro binário para um grafo. Lê o 
  * ficheiro e adiciona cada vértice ao grafo.
  * 
+ * Falha, sem alocar, se a memória estimada a partir do tamanho do ficheiro ultrapassar o orçamento
+ * definido com DefinirOrcamentoMemoria.
+ *
  * @param file Nome do arquivo
  * @return Grafo* Retorna um apontador para o grafo criado
  */
@@ -119,6 +131,9 @@ void GuardarAdjacentes(Grafo* g, char* file);
  * Esta função carrega as adjacências de um ficheiro binário para um grafo. Lê o ficheiro 
  * e adiciona cada adjacência ao grafo correspondente.
  * 
+ * Se as adjacências do ficheiro, somadas à memória atual do grafo, não couberem no orçamento
+ * (ver DefinirOrcamentoMemoria), o grafo não é alterado e a função retorna NULL.
+ *
  * @param grafo Apontador para o grafo onde seram carregado os dados. 
  * @param file  Nome do arquivo.
  * @return Grafo* Retorna um apontador para o grafo atualizado.
@@ -162,13 +177,54 @@ Grafo* CarregaGrafo(char* vertices, char* adjacencias);
  */
 Grafo* CarregaDados(char* file, char* vertices, char* adjacencias);
 
+/**
+ * @brief Carrega um grafo de uma lista de adjacências com ids externos de 64 bits.
+ *
+ * Cada linha do ficheiro tem o formato origem;destino;peso. Os ids externos são convertidos em
+ * ids internos seguidos, pela ordem em que aparecem, e todos os vértices e adjacências são
+ * inseridos num único lote. As linhas com peso 0 só registam os vértices.
+ *
+ * @param file Nome do ficheiro de texto.
+ * @param mapa Apontador onde fica o mapa entre ids externos e internos.
+ * @return Grafo* Retorna um apontador para o grafo criado, ou NULL em caso de erro.
+ */
+Grafo* CarregaAdjacenciasExternas(char* file, MapaIds** mapa);
+
+/**
+ * @brief Guarda um grafo com ids externos em três ficheiros binários.
+ *
+ * Os vértices e as adjacências são guardados com GuardaGrafo, com os ids internos, e o mapa
+ * com GuardaMapaIds.
+ *
+ * @param g Apontador para o grafo a guardar.
+ * @param m Apontador para o mapa de ids.
+ * @param vertices Nome do arquivo para vértices.
+ * @param adjacencias Nome do arquivo para adjacências.
+ * @param mapa Nome do arquivo para o mapa de ids.
+ */
+void GuardaGrafoExterno(Grafo* g, MapaIds* m, char* vertices, char* adjacencias, char* mapa);
+
+/**
+ * @brief Carrega um grafo com ids externos guardado com GuardaGrafoExterno.
+ *
+ * @param vertices Nome do arquivo para vértices.
+ * @param adjacencias Nome do arquivo para adjacências.
+ * @param mapa Nome do arquivo para o mapa de ids.
+ * @param m Apontador onde fica o mapa carregado.
+ * @return Grafo* Retorna um apontador para o grafo carregado, ou NULL em caso de erro.
+ */
+Grafo* CarregaGrafoExterno(char* vertices, char* adjacencias, char* mapa, MapaIds** m);
+
 /**
  * @brief Mostra o caminho de um vértice de origem a um vértice de destino.
  * 
+ * O caminho é copiado para um array com o tamanho exato e escrito de uma só vez.
+ * 
  * @param verticeAnt Array que contém os antecessore de cada vertice
+ * @param tamanho Número de elementos de verticeAnt
  * @param destino Destino final 
  */
-void ImprimirCaminho(int verticeAnt[], int destino);
+void ImprimirCaminho(int verticeAnt[], int tamanho, int destino);
 
 /**
  * @brief Mostra o caminho mais curto entre dois vértices num grafo.
@@ -182,7 +238,66 @@ void ImprimirCaminho(int verticeAnt[], int destino);
  */
 void MostrarCaminho(Grafo* g, int origem, int destino);
 
+/**
+ * @brief Mostra o caminho com menos ligações entre dois vértices num grafo.
+ *
+ * Os pesos não contam: o caminho é encontrado com uma pesquisa em largura sobre uma imagem do
+ * grafo, que para quando chega ao destino, e é mostrado com o número de ligações.
+ *
+ * @param g O grafo.
+ * @param origem O vértice de origem.
+ * @param destino O vértice de destino.
+ */
+void MostrarCaminhoLigacoes(Grafo* g, int origem, int destino);
 
+/**
+ * @brief Mostra as componentes conexas e fortemente conexas de um grafo.
+ *
+ * Indica o número de componentes de cada tipo e os vértices de cada componente fortemente conexa,
+ * ou seja, de cada grupo de vértices com caminho de qualquer um deles para qualquer outro.
+ *
+ * @param g O grafo.
+ */
+void MostrarComponentes(Grafo* g);
+
+/**
+ * @brief Mostra o PageRank, a centralidade de grau e a centralidade de proximidade de cada vértice de um grafo.
+ *
+ * @param g O grafo.
+ */
+void MostrarCentralidade(Grafo* g);
 
+/**
+ * @brief Mostra os k caminhos mais curtos entre dois vértices num grafo.
+ *
+ * Esta função calcula, com o algoritmo de Yen, até k caminhos alternativos sem ciclos do vértice de
+ * origem ao vértice de destino e imprime cada um com a respetiva distância.
+ *
+ * @param g O grafo.
+ * @param origem O vértice de origem.
+ * @param destino O vértice de destino.
+ * @param k Número máximo de caminhos a mostrar.
+ */
+void MostrarKCaminhos(Grafo* g, int origem, int destino, int k);
+
+/**
+ * @brief Escreve num ficheiro os caminhos mais curtos de vários pedidos.
+ *
+ * Esta função calcula o caminho mais curto de cada par (origens[i], destinos[i]) e escreve uma
+ * linha por pedido no formato "origem;destino;distancia;v1 v2 ... vn". Como com pesos negativos
+ * qualquer número pode ser uma distância, quando não existe caminho a distância é escrita como
+ * "inf" e quando a origem alcança um ciclo negativo, que impede haver caminhos mais curtos, como
+ * "ciclo"; em ambos os casos a lista de vértices fica vazia. Os pedidos com a mesma origem
+ * reaproveitam a cache do grafo, e o texto é acumulado num buffer e escrito em blocos, pelo que o
+ * custo por caminho não depende de chamadas a printf.
+ *
+ * @param g Apontador para o grafo.
+ * @param origens Array com o vértice de origem de cada pedido.
+ * @param destinos Array com o vértice de destino de cada pedido.
+ * @param numPedidos Número de pedidos.
+ * @param file Nome do ficheiro a escrever.
+ * @return bool true se todos os pedidos foram escritos, e false em caso de erro (incluindo falta de memória para uma árvore).
+ */
+bool EscreverCaminhos(Grafo* g, int origens[], int destinos[], int numPedidos, char* file);
 
 #endif
\ No newline at end of file
@@ -1,181 +1,368 @@
-/**
- * @file adjacente.c
- * @author Hugo Cruz (a23010)
- * @brief Implementação de funções para manipular listas de adjacências.
- * @version 93.0
- * @date 2024-05-15
- *
- * @copyright Copyright (c) 2024
- *
- */
-#include "adjacente.h"
-
- /**
-  * @brief Liberta a memória alocada para a lista
-  *
-  * Esta função liberta a memória alocada para a lista de adjacências.
-  *
-  * @param a Apontador para a lista a eliminar
-  */
-void ApagarAdjacencia(Adjacente* a)
-{
-	if (a != NULL)
-	{
-		free(a); //Liberta a memória alocada
-	}
-}
-
-/**
- * @brief Cria uma nova adjacência.
- *
- * Esta função cria uma nova adjacência com um identificador de destino e um peso. Também
- * inicializa os apontadores para a proxima adjacência
- *
- * @param idDestino Identificador do vértice de destino de uma adjacências.
- * @param peso Distância entre adjacências.
- * @param inf Apontador para o estado da funcionalidade.
- * @return Apontador para uma nova adjacência.
- */
-Adjacente* CriarAdjacencia(int idDestino, int peso, bool* inf)
-{
-	*inf = false;
-
-	Adjacente* aux = (Adjacente*)malloc(sizeof(Adjacente)); // Aloca memória para a estrura Adjacente
-	if (aux == NULL) return NULL;
-
-	aux->id = idDestino; //Atribui valor a nova adjacência
-	aux->peso = peso;
-	aux->next = NULL; //Inicializa o apontador para next com um valor nulo
-
-	*inf = true;
-	return aux;
-}
-
-
-/**
- * @brief Insere e cria uma nova adjacência e coloca a no final de uma lista.
- *
- * Esta função cria e insere uma nova adjacência com o identificador do vértice de destino
- * e a distância entre as adjacências no final de uma lista de adjacências.
- *
- * @param inicio Aponta para o início da lista de adjacências.
- * @param idDestino Identificador do vértice de destino da adjacência.
- * @param peso Distância entre as adjacências.
- * @param inf Apontador para o estado da funcionalidade.
- * @return Aponta para o início da lista de adjacências após a inserção.
- */
-Adjacente* InserirAdjacenciaLista(Adjacente* inicio, int idDestino, int peso, bool* inf)
-{
-	*inf = false;
-
-	Adjacente* adj = CriarAdjacencia(idDestino, peso, inf); //Cria uma adjacências
-
-	if (adj == NULL)
-	{
-		perror("CriarAdjacencia");
-		return NULL;
-	}
-
-	if (inicio == NULL)
-	{
-		inicio = adj;
-	}
-	else
-	{
-		Adjacente* aux = inicio;
-
-		while (aux->next != NULL) //Coloca-se no fim da lista
-		{
-			aux = aux->next;
-		}
-
-		aux->next = adj; //Adiciona a lista
-	}
-
-	*inf = true;
-	return inicio;
-}
-
-/**
- * @brief Elimina uma adjacência da lista de adjacências.
- *
- *  Esta função remove uma adjacência específica da lista de adjacências.
- *
- * @param inicio Apontador para o início de uma lista de adjacências.
- * @param idDestino Identificador do destino da adjacência a eliminar.
- * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
- * @return Apontador para o início da lista de adjacências.
- */
-Adjacente* EliminaUmaAdj(Adjacente* inicio, int idDestino, bool* inf)
-{
-	*inf = false;
-
-	if (inicio == NULL)
-	{
-		return NULL;
-	}
-
-	Adjacente* aux = inicio;//Guarda a adjacências atual 
-	Adjacente* ant = NULL; //Guarda a adjacências anterior 
-
-	while (aux && aux->id != idDestino) // Anda até encontar o destino ou o fim da lista
-	{
-		ant = aux;
-		aux = aux->next;
-	}
-
-	//Não encontrou o vertice a ser removido
-	if (aux == NULL)
-	{
-		*inf = false;
-		return inicio;
-	}
-
-	if (ant == NULL) //Insere no topo da lista
-	{
-		inicio = aux->next;
-	}
-	else
-	{
-		ant->next = aux->next;
-	}
-
-	ApagarAdjacencia(aux);
-	*inf = true;
-	return inicio;
-}
-
-/**
- * @brief Apaga todas as adjacências de uma lista.
- *
- * Esta função remove todas as adjacências de uma lista.
- *
- * @param adj Apontador para o início da lista de adjacências.
- * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
- * @return NULL após apagar todas as adjacências.
- */
-Adjacente* ElimanaTodasAdj(Adjacente* adj, bool* inf)
-{
-	*inf = false;
-
-	if (adj == NULL) return NULL;
-
-	Adjacente* aux = adj;
-
-	//Corre a lista de adjacências até ao fim e apaga todas as adjacências.
-	while (aux)
-	{
-		if (aux)
-		{
-			adj = aux->next;
-		}
-
-		ApagarAdjacencia(aux);
-		aux = adj;
-	}
-
-	adj = NULL;
-	*inf = true;
-	return adj;
-}
-
+/**
+ * @file adjacente.c
+ * @author Hugo Cruz (a23010)
+ * @brief Implementação de funções para manipular listas de adjacências.
+ * @version 93.0
+ * @date 2024-05-15
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include <stdio.h>
+#include "adjacente.h"
+#include "estatisticas.h"
+
+ /**
+  * @brief Liberta a memória alocada para a lista
+  *
+  * Esta função liberta a memória alocada para a lista de adjacências.
+  *
+  * @param a Apontador para a lista a eliminar
+  */
+void ApagarAdjacencia(Adjacente* a)
+{
+	if (a != NULL)
+	{
+		free(a); //Liberta a memória alocada
+	}
+}
+
+/**
+ * @brief Cria uma nova adjacência.
+ *
+ * Esta função cria uma nova adjacência com um identificador de destino e um peso. Também
+ * inicializa os apontadores para a proxima adjacência
+ *
+ * @param idDestino Identificador do vértice de destino de uma adjacências.
+ * @param peso Distância entre adjacências.
+ * @param inf Apontador para o estado da funcionalidade.
+ * @return Apontador para uma nova adjacência.
+ */
+Adjacente* CriarAdjacencia(int idDestino, int peso, bool* inf)
+{
+	*inf = false;
+
+	Adjacente* aux = (Adjacente*)malloc(sizeof(Adjacente)); // Aloca memória para a estrura Adjacente
+	if (aux == NULL) return NULL;
+
+	CONTAR_ESTATISTICA(alocacoes, 1);
+	aux->id = idDestino; //Atribui valor a nova adjacência
+	aux->peso = peso;
+	aux->next = NULL; //Inicializa o apontador para next com um valor nulo
+
+	*inf = true;
+	return aux;
+}
+
+
+/**
+ * @brief Insere e cria uma nova adjacência e coloca a no final de uma lista.
+ *
+ * Esta função cria e insere uma nova adjacência com o identificador do vértice de destino
+ * e a distância entre as adjacências no final de uma lista de adjacências.
+ *
+ * @param inicio Aponta para o início da lista de adjacências.
+ * @param idDestino Identificador do vértice de destino da adjacência.
+ * @param peso Distância entre as adjacências.
+ * @param inf Apontador para o estado da funcionalidade.
+ * @return Aponta para o início da lista de adjacências após a inserção.
+ */
+Adjacente* InserirAdjacenciaLista(Adjacente* inicio, int idDestino, int peso, bool* inf)
+{
+	*inf = false;
+
+	Adjacente* adj = CriarAdjacencia(idDestino, peso, inf); //Cria uma adjacências
+
+	if (adj == NULL)
+	{
+		perror("CriarAdjacencia");
+		return NULL;
+	}
+
+	if (inicio == NULL)
+	{
+		inicio = adj;
+	}
+	else
+	{
+		Adjacente* aux = inicio;
+
+		while (aux->next != NULL) //Coloca-se no fim da lista
+		{
+			CONTAR_ESTATISTICA(adjacenciasPercorridas, 1);
+			aux = aux->next;
+		}
+
+		aux->next = adj; //Adiciona a lista
+	}
+
+	*inf = true;
+	return inicio;
+}
+
+/**
+ * @brief Elimina uma adjacência da lista de adjacências.
+ *
+ *  Esta função remove uma adjacência específica da lista de adjacências.
+ *
+ * @param inicio Apontador para o início de uma lista de adjacências.
+ * @param idDestino Identificador do destino da adjacência a eliminar.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para o início da lista de adjacências.
+ */
+Adjacente* EliminaUmaAdj(Adjacente* inicio, int idDestino, bool* inf)
+{
+	*inf = false;
+
+	if (inicio == NULL)
+	{
+		return NULL;
+	}
+
+	Adjacente* aux = inicio;//Guarda a adjacências atual 
+	Adjacente* ant = NULL; //Guarda a adjacências anterior 
+
+	while (aux && aux->id != idDestino) // Anda até encontar o destino ou o fim da lista
+	{
+		ant = aux;
+		aux = aux->next;
+	}
+
+	//Não encontrou o vertice a ser removido
+	if (aux == NULL)
+	{
+		*inf = false;
+		return inicio;
+	}
+
+	if (ant == NULL) //Insere no topo da lista
+	{
+		inicio = aux->next;
+	}
+	else
+	{
+		ant->next = aux->next;
+	}
+
+	ApagarAdjacencia(aux);
+	*inf = true;
+	return inicio;
+}
+
+/**
+ * @brief Apaga todas as adjacências de uma lista.
+ *
+ * Esta função remove todas as adjacências de uma lista.
+ *
+ * @param adj Apontador para o início da lista de adjacências.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return NULL após apagar todas as adjacências.
+ */
+Adjacente* ElimanaTodasAdj(Adjacente* adj, bool* inf)
+{
+	*inf = false;
+
+	if (adj == NULL) return NULL;
+
+	Adjacente* aux = adj;
+
+	//Corre a lista de adjacências até ao fim e apaga todas as adjacências.
+	while (aux)
+	{
+		if (aux)
+		{
+			adj = aux->next;
+		}
+
+		ApagarAdjacencia(aux);
+		aux = adj;
+	}
+
+	adj = NULL;
+	*inf = true;
+	return adj;
+}
+
+/**
+ * @brief Insere uma adjacência numa lista ordenada pelo destino e sem destinos repetidos.
+ *
+ * Se já existir uma adjacência para o mesmo destino só o peso é atualizado. A procura pára no
+ * primeiro destino maior, sem percorrer o resto da lista.
+ *
+ * @param inicio Apontador para o início da lista de adjacências (ordenada).
+ * @param idDestino Identificador do vértice de destino da adjacência.
+ * @param peso Peso da adjacência.
+ * @param nova Apontador para um bool que fica true se foi criada uma adjacência, e false se o peso foi atualizado.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para o início da lista de adjacências.
+ */
+Adjacente* InserirAdjacenciaOrdenada(Adjacente* inicio, int idDestino, int peso, bool* nova, bool* inf)
+{
+	*inf = false;
+	*nova = false;
+
+	Adjacente* ant = NULL;
+	Adjacente* aux = inicio;
+
+	//Avança até ao primeiro destino maior ou igual
+	while (aux != NULL && aux->id < idDestino)
+	{
+		CONTAR_ESTATISTICA(adjacenciasPercorridas, 1);
+		ant = aux;
+		aux = aux->next;
+	}
+
+	if (aux != NULL && aux->id == idDestino)
+	{
+		aux->peso = peso;
+		*inf = true;
+		return inicio;
+	}
+
+	Adjacente* adj = CriarAdjacencia(idDestino, peso, inf);
+
+	if (adj == NULL)
+	{
+		return inicio;
+	}
+
+	adj->next = aux;
+
+	if (ant == NULL)
+	{
+		inicio = adj;
+	}
+	else
+	{
+		ant->next = adj;
+	}
+
+	*nova = true;
+	return inicio;
+}
+
+/**
+ * @brief Junta duas listas ordenadas pelo destino.
+ *
+ * Com destinos iguais fica primeiro a adjacência da lista a, para a ordenação ser estável.
+ *
+ * @param a Primeira lista (a parte da frente da lista original).
+ * @param b Segunda lista.
+ * @return Adjacente* Início da lista junta.
+ */
+static Adjacente* JuntarListasOrdenadas(Adjacente* a, Adjacente* b)
+{
+	Adjacente inicio;
+	Adjacente* fim = &inicio;
+
+	while (a != NULL && b != NULL)
+	{
+		if (b->id < a->id)
+		{
+			fim->next = b;
+			b = b->next;
+		}
+		else
+		{
+			fim->next = a;
+			a = a->next;
+		}
+
+		fim = fim->next;
+	}
+
+	fim->next = a != NULL ? a : b;
+	return inicio.next;
+}
+
+/**
+ * @brief Ordena uma lista de adjacências pelo destino e junta os destinos repetidos.
+ *
+ * A ordenação é estável (merge sort), pelo que, entre adjacências com o mesmo destino, fica o
+ * peso da que estava mais à frente na lista, ou seja, da última inserida.
+ *
+ * @param inicio Apontador para o início da lista de adjacências.
+ * @param removidas Apontador para um inteiro onde é somado o número de adjacências repetidas apagadas.
+ * @return Apontador para o início da lista ordenada.
+ */
+Adjacente* OrdenarListaAdjacencias(Adjacente* inicio, int* removidas)
+{
+	//Uma lista que já está ordenada e sem repetidos não é alterada
+	Adjacente* aux = inicio;
+
+	while (aux != NULL && aux->next != NULL && aux->id < aux->next->id)
+	{
+		aux = aux->next;
+	}
+
+	if (aux == NULL || aux->next == NULL)
+	{
+		return inicio;
+	}
+
+	//Merge sort de baixo para cima: junta sequências de 1, 2, 4, ... adjacências
+	for (int largura = 1; ; largura *= 2)
+	{
+		Adjacente cabeca = { 0 };
+		Adjacente* fim = &cabeca;
+		Adjacente* resto = inicio;
+		int juncoes = 0;
+
+		while (resto != NULL)
+		{
+			Adjacente* a = resto;
+			Adjacente* ultimoA = a;
+
+			for (int i = 1; i < largura && ultimoA->next != NULL; i++)
+			{
+				ultimoA = ultimoA->next;
+			}
+
+			Adjacente* b = ultimoA->next;
+			ultimoA->next = NULL;
+			Adjacente* ultimoB = b;
+
+			for (int i = 1; i < largura && ultimoB != NULL && ultimoB->next != NULL; i++)
+			{
+				ultimoB = ultimoB->next;
+			}
+
+			resto = ultimoB != NULL ? ultimoB->next : NULL;
+
+			if (ultimoB != NULL)
+			{
+				ultimoB->next = NULL;
+			}
+
+			fim->next = JuntarListasOrdenadas(a, b);
+			juncoes++;
+
+			while (fim->next != NULL)
+			{
+				fim = fim->next;
+			}
+		}
+
+		inicio = cabeca.next;
+
+		if (juncoes <= 1)
+		{
+			break;
+		}
+	}
+
+	//Os repetidos ficam seguidos; fica o peso da última adjacência de cada destino
+	for (aux = inicio; aux != NULL; aux = aux->next)
+	{
+		while (aux->next != NULL && aux->next->id == aux->id)
+		{
+			Adjacente* repetida = aux->next;
+			aux->peso = repetida->peso;
+			aux->next = repetida->next;
+			ApagarAdjacencia(repetida);
+			(*removidas)++;
+		}
+	}
+
+	return inicio;
+}
@@ -0,0 +1,810 @@
+/**
+ * @file bellmanford.c
+ * @author Hugo Cruz (a23010)
+ * @brief Implementação dos caminhos mais curtos em grafos com pesos negativos (Bellman-Ford e Johnson).
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include <string.h>
+#include "bellmanford.h"
+
+ /**
+  * @brief Verifica se um grafo tem adjacências com peso negativo.
+  *
+  * @param g Apontador para o grafo
+  * @return true se existir pelo menos uma adjacência com peso negativo, e false caso contrário
+  */
+bool ExistemPesosNegativos(Grafo* g)
+{
+	if (g == NULL)
+	{
+		return false;
+	}
+
+	//A matriz conta as ligações negativas à medida que são definidas
+	if (g->matriz != NULL)
+	{
+		return g->matriz->numNegativos > 0;
+	}
+
+	Vertice* auxV = g->inicioGrafo;
+
+	while (auxV)
+	{
+		Adjacente* auxA = auxV->nextA;
+
+		while (auxA)
+		{
+			if (auxA->peso < 0)
+			{
+				return true;
+			}
+			auxA = auxA->next;
+		}
+
+		auxV = auxV->nextV;
+	}
+
+	return false;
+}
+
+/**
+ * @brief Conta uma aresta no grupo do seu destino ou, na segunda passagem, coloca-a nesse grupo.
+ *
+ * @param a Apontador para as arestas agrupadas
+ * @param origem Vértice de origem
+ * @param destino Vértice de destino
+ * @param peso Peso da aresta
+ * @param proxima Próxima posição livre de cada grupo (NULL para apenas contar)
+ */
+static void RegistarArestaEntrada(ArestasEntrada* a, int origem, int destino, PesoAresta peso, int proxima[])
+{
+	if (peso == 0 || destino < 0 || destino >= a->tamanho)
+	{
+		return;
+	}
+
+	if (proxima == NULL)
+	{
+		a->inicio[destino + 1]++;
+		a->numArestas++;
+		return;
+	}
+
+	int posicao = proxima[destino]++;
+	a->origens[posicao] = origem;
+	a->pesos[posicao] = peso;
+}
+
+/**
+ * @brief Percorre as arestas de um grafo, lidas das listas ou das linhas da matriz densa.
+ *
+ * @param g Apontador para o grafo
+ * @param a Apontador para as arestas agrupadas
+ * @param proxima Próxima posição livre de cada grupo (NULL para apenas contar)
+ */
+static void PercorrerArestasEntrada(Grafo* g, ArestasEntrada* a, int proxima[])
+{
+	MatrizAdjacencia* m = g->matriz;
+
+	for (Vertice* auxV = g->inicioGrafo; auxV; auxV = auxV->nextV)
+	{
+		if (m != NULL)
+		{
+			if (auxV->id < 0 || auxV->id >= m->tamanho)
+			{
+				continue;
+			}
+
+			for (int w = ProximaLigacaoMatriz(m, auxV->id, 0); w >= 0; w = ProximaLigacaoMatriz(m, auxV->id, w + 1))
+			{
+				RegistarArestaEntrada(a, auxV->id, w, PesoLigacaoMatriz(m, auxV->id, w), proxima);
+			}
+		}
+		else
+		{
+			for (Adjacente* auxA = auxV->nextA; auxA; auxA = auxA->next)
+			{
+				RegistarArestaEntrada(a, auxV->id, auxA->id, auxA->peso, proxima);
+			}
+		}
+	}
+}
+
+/**
+ * @brief Agrupa as arestas de um grafo pelo vértice de destino.
+ *
+ * As adjacências com peso 0 não são ligações e não são incluídas. Num grafo denso as ligações são
+ * lidas das linhas da matriz, sem a converter em listas.
+ *
+ * @param g Apontador para o grafo
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida
+ * @return ArestasEntrada* Apontador para as arestas agrupadas
+ */
+ArestasEntrada* CriarArestasEntrada(Grafo* g, bool* inf)
+{
+	*inf = false;
+
+	if (g == NULL)
+	{
+		return NULL;
+	}
+
+	int tamanho = TamanhoArraysCaminhos(g);
+
+	ArestasEntrada* a = (ArestasEntrada*)calloc(1, sizeof(ArestasEntrada));
+
+	if (a == NULL)
+	{
+		return NULL;
+	}
+
+	a->tamanho = tamanho;
+	a->inicio = (int*)calloc(tamanho + 1, sizeof(int));
+
+	if (a->inicio == NULL)
+	{
+		ApagarArestasEntrada(a);
+		return NULL;
+	}
+
+	//Conta as arestas que chegam a cada vértice
+	PercorrerArestasEntrada(g, a, NULL);
+
+	for (int i = 0; i < tamanho; i++)
+	{
+		a->inicio[i + 1] += a->inicio[i];
+	}
+
+	a->origens = (int*)malloc(sizeof(int) * (a->numArestas > 0 ? a->numArestas : 1));
+	a->pesos = (PesoAresta*)malloc(sizeof(PesoAresta) * (a->numArestas > 0 ? a->numArestas : 1));
+	int* proxima = (int*)malloc(sizeof(int) * (tamanho > 0 ? tamanho : 1));
+
+	if (a->origens == NULL || a->pesos == NULL || proxima == NULL)
+	{
+		free(proxima);
+		ApagarArestasEntrada(a);
+		return NULL;
+	}
+
+	for (int i = 0; i < tamanho; i++)
+	{
+		proxima[i] = a->inicio[i];
+	}
+
+	//Coloca cada aresta no grupo do seu destino
+	PercorrerArestasEntrada(g, a, proxima);
+
+	free(proxima);
+
+	*inf = true;
+	return a;
+}
+
+/**
+ * @brief Liberta a memória alocada para as arestas agrupadas.
+ *
+ * @param a Apontador para as arestas a eliminar
+ */
+void ApagarArestasEntrada(ArestasEntrada* a)
+{
+	if (a == NULL)
+	{
+		return;
+	}
+
+	free(a->inicio);
+	free(a->origens);
+	free(a->pesos);
+	free(a);
+}
+
+/**
+ * @brief Bellman-Ford por rondas sobre as arestas agrupadas por destino.
+ *
+ * Em cada ronda cada vértice calcula o mínimo das distâncias propostas pelas arestas que lhe
+ * chegam. Esse mínimo é um ciclo sem dependências entre iterações, que o compilador consegue
+ * vetorizar; o antecessor só é procurado quando a distância melhora.
+ *
+ * @param a Arestas agrupadas por destino
+ * @param numVertices Número de vértices do grafo
+ * @param distancias Distâncias iniciais, atualizadas pela função
+ * @param verticeAnt Antecessores, atualizados pela função
+ * @return true se as distâncias estabilizaram, e false se existir um ciclo negativo
+ */
+static bool BellmanFordArestas(ArestasEntrada* a, int numVertices, Distancia distancias[], int verticeAnt[])
+{
+	const int* origens = a->origens;
+	const PesoAresta* pesos = a->pesos;
+
+	//Sem ciclos negativos bastam numVertices - 1 rondas, a ronda seguinte serve para os detetar
+	for (int ronda = 0; ronda < numVertices; ronda++)
+	{
+		bool alterado = false;
+
+		for (int v = 0; v < a->tamanho; v++)
+		{
+			Distancia melhor = distancias[v];
+			int fim = a->inicio[v + 1];
+
+			for (int j = a->inicio[v]; j < fim; j++)
+			{
+				Distancia du = distancias[origens[j]];
+				Distancia proposta = du == DISTANCIA_INFINITA ? DISTANCIA_INFINITA : du + pesos[j];
+				melhor = proposta < melhor ? proposta : melhor;
+			}
+
+			if (melhor < distancias[v])
+			{
+				//Procura a aresta que deu origem ao mínimo
+				for (int j = a->inicio[v]; j < fim; j++)
+				{
+					Distancia du = distancias[origens[j]];
+
+					if (du != DISTANCIA_INFINITA && du + pesos[j] == melhor)
+					{
+						verticeAnt[v] = origens[j];
+						break;
+					}
+				}
+
+				distancias[v] = melhor;
+				alterado = true;
+			}
+		}
+
+		if (!alterado)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * @brief Bellman-Ford com fila (SPFA).
+ *
+ * Só os vértices cuja distância mudou voltam a relaxar as suas adjacências. Cada vértice guarda o
+ * número de arestas do seu caminho atual; um caminho com numVertices arestas repete um vértice,
+ * o que só acontece quando existe um ciclo negativo.
+ *
+ * @param vertices Índice dos vértices pelo id
+ * @param m Matriz densa do grafo, cujas linhas substituem as listas de adjacências (NULL se não for usada)
+ * @param tamanho Número de elementos dos arrays
+ * @param numVertices Número de vértices do grafo
+ * @param distancias Distâncias iniciais, atualizadas pela função
+ * @param verticeAnt Antecessores, atualizados pela função
+ * @return int 1 se as distâncias estabilizaram, 0 se existir um ciclo negativo e -1 se não houver memória
+ */
+static int BellmanFordFila(Vertice** vertices, MatrizAdjacencia* m, int tamanho, int numVertices, Distancia distancias[], int verticeAnt[])
+{
+	int* fila = (int*)malloc(sizeof(int) * tamanho);
+	int* arestas = (int*)calloc(tamanho, sizeof(int));
+	bool* naFila = (bool*)calloc(tamanho, sizeof(bool));
+
+	if (fila == NULL || arestas == NULL || naFila == NULL)
+	{
+		free(fila);
+		free(arestas);
+		free(naFila);
+		return -1;
+	}
+
+	int inicio = 0, quantidade = 0, resultado = 1;
+
+	//Começa pelos vértices que já têm distância
+	for (int i = 0; i < tamanho; i++)
+	{
+		if (vertices[i] != NULL && distancias[i] != DISTANCIA_INFINITA)
+		{
+			fila[(inicio + quantidade++) % tamanho] = i;
+			naFila[i] = true;
+		}
+	}
+
+	while (quantidade > 0 && resultado == 1)
+	{
+		int u = fila[inicio];
+		inicio = (inicio + 1) % tamanho;
+		quantidade--;
+		naFila[u] = false;
+
+		//Num grafo denso as ligações vêm da linha da matriz, nos outros da lista de adjacências
+		Adjacente* auxA = m == NULL ? vertices[u]->nextA : NULL;
+		int coluna = m != NULL && u < m->tamanho ? ProximaLigacaoMatriz(m, u, 0) : -1;
+
+		while (auxA != NULL || coluna >= 0)
+		{
+			int w;
+			PesoAresta peso;
+
+			if (auxA != NULL)
+			{
+				w = auxA->id;
+				peso = auxA->peso;
+				auxA = auxA->next;
+			}
+			else
+			{
+				w = coluna;
+				peso = PesoLigacaoMatriz(m, u, coluna);
+				coluna = ProximaLigacaoMatriz(m, u, coluna + 1);
+			}
+
+			if (peso == 0 || w < 0 || w >= tamanho || vertices[w] == NULL)
+			{
+				continue;
+			}
+
+			Distancia nova = distancias[u] + peso;
+
+			if (nova < distancias[w])
+			{
+				distancias[w] = nova;
+				verticeAnt[w] = u;
+				arestas[w] = arestas[u] + 1;
+
+				if (arestas[w] >= numVertices)
+				{
+					resultado = 0;
+					break;
+				}
+
+				if (!naFila[w])
+				{
+					fila[(inicio + quantidade++) % tamanho] = w;
+					naFila[w] = true;
+				}
+			}
+		}
+	}
+
+	free(fila);
+	free(arestas);
+	free(naFila);
+	return resultado;
+}
+
+/**
+ * @brief Algoritmo de Bellman-Ford
+ *
+ * Esta função calcula os caminhos mais curtos a partir da origem num grafo que pode ter pesos
+ * negativos, e deteta ciclos de peso negativo alcançáveis. Com origem -1 todos os vértices começam
+ * com distância 0, como se existisse uma origem virtual ligada a todos com peso 0.
+ *
+ * @param g Apontador para o grafo
+ * @param origem O vértice de origem (-1 para a origem virtual)
+ * @param distancias Array com TamanhoArraysCaminhos(g) elementos onde ficam as distâncias (DISTANCIA_INFINITA se não alcançável)
+ * @param verticeAnt Array com TamanhoArraysCaminhos(g) elementos onde ficam os antecessores (-1 se não existir)
+ * @param modo Modo de relaxação
+ * @param cicloNegativo Apontador para um bool que fica true se for encontrado um ciclo negativo
+ * @return true se as distâncias foram calculadas, e false em caso de erro ou de ciclo negativo
+ */
+bool BellmanFord(Grafo* g, int origem, Distancia distancias[], int verticeAnt[], ModoBellmanFord modo, bool* cicloNegativo)
+{
+	*cicloNegativo = false;
+
+	//É uma consulta: um grafo denso não é convertido em listas, as relaxações leem a matriz
+	if (g == NULL)
+	{
+		return false;
+	}
+
+	int tamanho = TamanhoArraysCaminhos(g);
+	int numVertices = ContadorVertices(g);
+
+	if (tamanho == 0 || origem < -1 || origem >= tamanho)
+	{
+		return false;
+	}
+
+	Vertice** vertices = (Vertice**)calloc(tamanho, sizeof(Vertice*));
+
+	if (vertices == NULL)
+	{
+		return false;
+	}
+
+	for (Vertice* aux = g->inicioGrafo; aux; aux = aux->nextV)
+	{
+		if (aux->id >= 0)
+		{
+			vertices[aux->id] = aux;
+		}
+	}
+
+	if (origem != -1 && vertices[origem] == NULL)
+	{
+		free(vertices);
+		return false;
+	}
+
+	//A origem virtual está a distância 0 de todos os vértices
+	for (int i = 0; i < tamanho; i++)
+	{
+		distancias[i] = (origem == -1 && vertices[i] != NULL) ? 0 : DISTANCIA_INFINITA;
+		verticeAnt[i] = -1;
+	}
+
+	if (origem != -1)
+	{
+		distancias[origem] = 0;
+	}
+
+	int resultado;
+
+	if (modo == BELLMAN_FORD_ARESTAS)
+	{
+		bool inf;
+		ArestasEntrada* a = CriarArestasEntrada(g, &inf);
+
+		if (a == NULL)
+		{
+			resultado = -1;
+		}
+		else
+		{
+			resultado = BellmanFordArestas(a, numVertices, distancias, verticeAnt) ? 1 : 0;
+			ApagarArestasEntrada(a);
+		}
+	}
+	else
+	{
+		resultado = BellmanFordFila(vertices, g->matriz, tamanho, numVertices, distancias, verticeAnt);
+	}
+
+	free(vertices);
+
+	*cicloNegativo = resultado == 0;
+	return resultado == 1;
+}
+
+/**
+ * @brief Calcula os potenciais de Johnson e associa-os a um espaço de trabalho.
+ *
+ * Esta função executa o algoritmo de Bellman-Ford a partir da origem virtual. Os potenciais obtidos
+ * tornam todos os pesos não negativos (peso + h[u] - h[v] >= 0), pelo que as pesquisas seguintes
+ * com DijkstraRestrito nesse espaço de trabalho passam a aceitar pesos negativos e devolvem as
+ * distâncias reais. Se o grafo for alterado, os potenciais são descartados e a função tem de ser
+ * chamada de novo.
+ *
+ * @param g Apontador para o grafo
+ * @param e Apontador para o espaço de trabalho
+ * @param cicloNegativo Apontador para um bool que fica true se o grafo tiver um ciclo negativo
+ * @return true se os potenciais foram calculados, e false em caso de erro ou de ciclo negativo
+ */
+bool Johnson(Grafo* g, EspacoCaminhos* e, bool* cicloNegativo)
+{
+	*cicloNegativo = false;
+
+	if (g == NULL || e == NULL)
+	{
+		return false;
+	}
+
+	//Garante que o índice do espaço de trabalho corresponde ao grafo atual
+	DijkstraRestrito(g, e, -1, -1, NULL, 0);
+
+	int tamanho = e->tamanho > 0 ? e->tamanho : 1;
+	Distancia* potencial = (Distancia*)malloc(sizeof(Distancia) * tamanho);
+	int* verticeAnt = (int*)malloc(sizeof(int) * tamanho);
+
+	if (potencial == NULL || verticeAnt == NULL || !BellmanFord(g, -1, potencial, verticeAnt, BELLMAN_FORD_FILA, cicloNegativo))
+	{
+		free(potencial);
+		free(verticeAnt);
+		return false;
+	}
+
+	free(verticeAnt);
+	free(e->potencial);
+	e->potencial = potencial;
+
+	return true;
+}
+
+
+/**
+ * @brief Verifica se a imagem associada a um espaço de trabalho tem adjacências com peso negativo.
+ *
+ * @param e Apontador para o espaço de trabalho
+ * @return true se existir pelo menos uma adjacência com peso negativo, e false caso contrário
+ */
+static bool PesosNegativosEspaco(EspacoCaminhos* e)
+{
+	if (e->imagem != NULL)
+	{
+		for (int i = 0; i < e->imagem->numArestas; i++)
+		{
+			if (e->imagem->pesos[i] < 0)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	for (int u = 0; u < e->compacta->tamanho; u++)
+	{
+		if (!e->compacta->existe[u])
+		{
+			continue;
+		}
+
+		CursorCompacto c;
+		int w;
+		PesoAresta peso;
+		IniciarCursorCompacto(e->compacta, u, &c);
+
+		while (ProximaAdjacenciaCompacta(&c, &w, &peso))
+		{
+			if (peso < 0)
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+/**
+ * @brief Algoritmo de Bellman-Ford com fila a partir da origem virtual, sobre a imagem de um espaço de trabalho.
+ *
+ * Igual a BellmanFordFila, mas as ligações são lidas da imagem ou da imagem comprimida associada
+ * ao espaço, sem passar pelo grafo.
+ *
+ * @param e Apontador para o espaço de trabalho, já associado a uma imagem
+ * @param distancias Array com e->tamanho elementos onde ficam as distâncias à origem virtual
+ * @return int 1 se as distâncias estabilizaram, 0 se existir um ciclo negativo e -1 se não houver memória
+ */
+static int BellmanFordEspaco(EspacoCaminhos* e, Distancia distancias[])
+{
+	ImagemGrafo* im = e->imagem;
+	ImagemCompacta* ic = e->compacta;
+	int tamanho = e->tamanho;
+	const bool* existe = im != NULL ? im->existe : ic->existe;
+	int numVertices = im != NULL ? im->numVertices : ic->numVertices;
+
+	int* fila = (int*)malloc(sizeof(int) * (tamanho > 0 ? tamanho : 1));
+	int* arestas = (int*)calloc(tamanho > 0 ? tamanho : 1, sizeof(int));
+	bool* naFila = (bool*)calloc(tamanho > 0 ? tamanho : 1, sizeof(bool));
+
+	if (fila == NULL || arestas == NULL || naFila == NULL)
+	{
+		free(fila);
+		free(arestas);
+		free(naFila);
+		return -1;
+	}
+
+	int inicio = 0, quantidade = 0, resultado = 1;
+
+	//A origem virtual está a distância 0 de todos os vértices
+	for (int i = 0; i < tamanho; i++)
+	{
+		distancias[i] = existe[i] ? 0 : DISTANCIA_INFINITA;
+
+		if (existe[i])
+		{
+			fila[quantidade++] = i;
+			naFila[i] = true;
+		}
+	}
+
+	while (quantidade > 0 && resultado == 1)
+	{
+		int u = fila[inicio];
+		inicio = (inicio + 1) % tamanho;
+		quantidade--;
+		naFila[u] = false;
+
+		//Na imagem as ligações estão em arrays, na imagem comprimida são descodificadas do bloco
+		int i = im != NULL ? im->inicio[u] : 0;
+		int fim = im != NULL ? im->inicio[u + 1] : 0;
+		CursorCompacto c = { 0 };
+
+		if (ic != NULL)
+		{
+			IniciarCursorCompacto(ic, u, &c);
+		}
+
+		while (true)
+		{
+			int w;
+			PesoAresta peso;
+
+			if (im != NULL)
+			{
+				if (i >= fim)
+				{
+					break;
+				}
+
+				w = im->destinos[i];
+				peso = im->pesos[i];
+				i++;
+			}
+			else if (!ProximaAdjacenciaCompacta(&c, &w, &peso))
+			{
+				break;
+			}
+
+			if (peso == 0 || w < 0 || w >= tamanho || !existe[w])
+			{
+				continue;
+			}
+
+			Distancia nova = distancias[u] + peso;
+
+			if (nova < distancias[w])
+			{
+				distancias[w] = nova;
+				arestas[w] = arestas[u] + 1;
+
+				if (arestas[w] >= numVertices)
+				{
+					resultado = 0;
+					break;
+				}
+
+				if (!naFila[w])
+				{
+					fila[(inicio + quantidade++) % tamanho] = w;
+					naFila[w] = true;
+				}
+			}
+		}
+	}
+
+	free(fila);
+	free(arestas);
+	free(naFila);
+	return resultado;
+}
+
+/**
+ * @brief Calcula os potenciais de Johnson da imagem associada a um espaço de trabalho.
+ *
+ * @param e Apontador para o espaço de trabalho, já associado a uma imagem
+ * @param cicloNegativo Apontador para um bool que fica true se a imagem tiver um ciclo negativo
+ * @return true se o espaço pode pesquisar a imagem, e false em caso de erro ou de ciclo negativo
+ */
+static bool PotenciaisEspaco(EspacoCaminhos* e, bool* cicloNegativo)
+{
+	//A associação mantém os potenciais já calculados para a mesma imagem
+	if (e->potencial != NULL || !PesosNegativosEspaco(e))
+	{
+		return true;
+	}
+
+	Distancia* potencial = (Distancia*)malloc(sizeof(Distancia) * (e->tamanho > 0 ? e->tamanho : 1));
+
+	if (potencial == NULL)
+	{
+		return false;
+	}
+
+	int resultado = BellmanFordEspaco(e, potencial);
+
+	if (resultado != 1)
+	{
+		*cicloNegativo = resultado == 0;
+		free(potencial);
+		return false;
+	}
+
+	e->potencial = potencial;
+	return true;
+}
+
+/**
+ * @brief Calcula os potenciais de Johnson de uma imagem e associa-os a um espaço de trabalho.
+ *
+ * O espaço passa a pesquisar a imagem e, se ela tiver pesos negativos, os potenciais são
+ * calculados com o algoritmo de Bellman-Ford a partir da origem virtual, lendo só a imagem. As
+ * pesquisas seguintes com DijkstraImagem nesse espaço aceitam pesos negativos enquanto a imagem
+ * for a mesma. Sem pesos negativos os potenciais não são precisos e o espaço fica sem eles.
+ *
+ * @param im Apontador para a imagem
+ * @param e Apontador para o espaço de trabalho
+ * @param cicloNegativo Apontador para um bool que fica true se a imagem tiver um ciclo negativo
+ * @return true se o espaço pode pesquisar a imagem, e false em caso de erro ou de ciclo negativo
+ */
+bool JohnsonImagem(ImagemGrafo* im, EspacoCaminhos* e, bool* cicloNegativo)
+{
+	*cicloNegativo = false;
+
+	if (im == NULL || e == NULL)
+	{
+		return false;
+	}
+
+	//Associa o espaço à imagem sem pesquisar
+	DijkstraImagem(im, e, -1, -1);
+
+	if (e->imagem != im || e->tamanho != im->tamanho)
+	{
+		return false;
+	}
+
+	return PotenciaisEspaco(e, cicloNegativo);
+}
+
+/**
+ * @brief Calcula os potenciais de Johnson de uma imagem comprimida e associa-os a um espaço de trabalho.
+ *
+ * Igual a JohnsonImagem, para as pesquisas com DijkstraCompacta. Os blocos são descodificados a
+ * cada relaxação.
+ *
+ * @param im Apontador para a imagem comprimida
+ * @param e Apontador para o espaço de trabalho
+ * @param cicloNegativo Apontador para um bool que fica true se a imagem tiver um ciclo negativo
+ * @return true se o espaço pode pesquisar a imagem, e false em caso de erro ou de ciclo negativo
+ */
+bool JohnsonCompacta(ImagemCompacta* im, EspacoCaminhos* e, bool* cicloNegativo)
+{
+	*cicloNegativo = false;
+
+	if (im == NULL || e == NULL)
+	{
+		return false;
+	}
+
+	DijkstraCompacta(im, e, -1, -1);
+
+	if (e->compacta != im || e->tamanho != im->tamanho)
+	{
+		return false;
+	}
+
+	return PotenciaisEspaco(e, cicloNegativo);
+}
+
+/**
+ * @brief Copia os potenciais de Johnson de um espaço de trabalho para outro associado à mesma imagem.
+ *
+ * Permite calcular os potenciais uma vez e dá-los aos espaços de todas as threads que pesquisam a
+ * mesma imagem.
+ *
+ * @param destino Apontador para o espaço que recebe os potenciais
+ * @param origem Apontador para o espaço com os potenciais (pode não ter potenciais)
+ * @return true se os potenciais foram copiados, e false se os espaços não pesquisam a mesma imagem ou não houver memória
+ */
+bool CopiarPotenciaisEspaco(EspacoCaminhos* destino, EspacoCaminhos* origem)
+{
+	if (destino == NULL || origem == NULL || destino->imagem != origem->imagem ||
+		destino->compacta != origem->compacta || destino->versao != origem->versao || destino->tamanho != origem->tamanho)
+	{
+		return false;
+	}
+
+	if (destino == origem)
+	{
+		return true;
+	}
+
+	free(destino->potencial);
+	destino->potencial = NULL;
+
+	if (origem->potencial == NULL)
+	{
+		return true;
+	}
+
+	size_t bytes = sizeof(Distancia) * (origem->tamanho > 0 ? origem->tamanho : 1);
+	destino->potencial = (Distancia*)malloc(bytes);
+
+	if (destino->potencial == NULL)
+	{
+		return false;
+	}
+
+	memcpy(destino->potencial, origem->potencial, bytes);
+	return true;
+}
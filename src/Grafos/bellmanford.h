@@ -0,0 +1,145 @@
+/**
+ * @file bellmanford.h
+ * @author Hugo Cruz (a23010)
+ * @brief Ficheiro de cabeçalho para os caminhos mais curtos em grafos com pesos negativos (Bellman-Ford e Johnson).
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef BELLMANFORD_H
+#define BELLMANFORD_H
+
+#include "caminhos.h"
+
+/**
+ * @brief Modos de relaxação do algoritmo de Bellman-Ford.
+ *
+ */
+typedef enum ModoBellmanFord
+{
+	BELLMAN_FORD_FILA,	  ///< Só relaxa as adjacências dos vértices que mudaram (SPFA).
+	BELLMAN_FORD_ARESTAS  ///< Relaxa todas as arestas em rondas sobre arrays contíguos.
+
+} ModoBellmanFord;
+
+/**
+ * @brief Estrutura com as arestas de um grafo agrupadas pelo vértice de destino.
+ *
+ * As arestas que chegam ao vértice v ocupam as posições inicio[v] até inicio[v + 1] - 1 dos
+ * arrays origens e pesos. Guardar as arestas em arrays contíguos permite ao compilador
+ * vetorizar a relaxação de cada vértice.
+ */
+typedef struct ArestasEntrada
+{
+	int tamanho;		///< Número de vértices indexados (maior id + 1).
+	int numArestas;		///< Número de arestas.
+	int *inicio;		///< Posição da primeira aresta de cada destino (tamanho + 1 elementos).
+	int *origens;		///< Vértice de origem de cada aresta.
+	PesoAresta *pesos;	///< Peso de cada aresta.
+
+} ArestasEntrada;
+
+/**
+ * @brief Verifica se um grafo tem adjacências com peso negativo.
+ *
+ * @param g Apontador para o grafo
+ * @return true se existir pelo menos uma adjacência com peso negativo, e false caso contrário
+ */
+bool ExistemPesosNegativos(Grafo *g);
+
+/**
+ * @brief Agrupa as arestas de um grafo pelo vértice de destino.
+ *
+ * As adjacências com peso 0 não são ligações e não são incluídas. Num grafo denso as ligações são
+ * lidas das linhas da matriz, sem a converter em listas.
+ *
+ * @param g Apontador para o grafo
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida
+ * @return ArestasEntrada* Apontador para as arestas agrupadas
+ */
+ArestasEntrada *CriarArestasEntrada(Grafo *g, bool *inf);
+
+/**
+ * @brief Liberta a memória alocada para as arestas agrupadas.
+ *
+ * @param a Apontador para as arestas a eliminar
+ */
+void ApagarArestasEntrada(ArestasEntrada *a);
+
+/**
+ * @brief Algoritmo de Bellman-Ford
+ *
+ * Esta função calcula os caminhos mais curtos a partir da origem num grafo que pode ter pesos
+ * negativos, e deteta ciclos de peso negativo alcançáveis. Com origem -1 todos os vértices começam
+ * com distância 0, como se existisse uma origem virtual ligada a todos com peso 0.
+ *
+ * @param g Apontador para o grafo
+ * @param origem O vértice de origem (-1 para a origem virtual)
+ * @param distancias Array com TamanhoArraysCaminhos(g) elementos onde ficam as distâncias (DISTANCIA_INFINITA se não alcançável)
+ * @param verticeAnt Array com TamanhoArraysCaminhos(g) elementos onde ficam os antecessores (-1 se não existir)
+ * @param modo Modo de relaxação
+ * @param cicloNegativo Apontador para um bool que fica true se for encontrado um ciclo negativo
+ * @return true se as distâncias foram calculadas, e false em caso de erro ou de ciclo negativo
+ */
+bool BellmanFord(Grafo *g, int origem, Distancia distancias[], int verticeAnt[], ModoBellmanFord modo, bool *cicloNegativo);
+
+/**
+ * @brief Calcula os potenciais de Johnson e associa-os a um espaço de trabalho.
+ *
+ * Esta função executa o algoritmo de Bellman-Ford a partir da origem virtual. Os potenciais obtidos
+ * tornam todos os pesos não negativos (peso + h[u] - h[v] >= 0), pelo que as pesquisas seguintes
+ * com DijkstraRestrito nesse espaço de trabalho passam a aceitar pesos negativos e devolvem as
+ * distâncias reais. Se o grafo for alterado, os potenciais são descartados e a função tem de ser
+ * chamada de novo.
+ *
+ * @param g Apontador para o grafo
+ * @param e Apontador para o espaço de trabalho
+ * @param cicloNegativo Apontador para um bool que fica true se o grafo tiver um ciclo negativo
+ * @return true se os potenciais foram calculados, e false em caso de erro ou de ciclo negativo
+ */
+bool Johnson(Grafo *g, EspacoCaminhos *e, bool *cicloNegativo);
+
+/**
+ * @brief Calcula os potenciais de Johnson de uma imagem e associa-os a um espaço de trabalho.
+ *
+ * O espaço passa a pesquisar a imagem e, se ela tiver pesos negativos, os potenciais são
+ * calculados com o algoritmo de Bellman-Ford a partir da origem virtual, lendo só a imagem. As
+ * pesquisas seguintes com DijkstraImagem nesse espaço aceitam pesos negativos enquanto a imagem
+ * for a mesma. Sem pesos negativos os potenciais não são precisos e o espaço fica sem eles.
+ *
+ * @param im Apontador para a imagem
+ * @param e Apontador para o espaço de trabalho
+ * @param cicloNegativo Apontador para um bool que fica true se a imagem tiver um ciclo negativo
+ * @return true se o espaço pode pesquisar a imagem, e false em caso de erro ou de ciclo negativo
+ */
+bool JohnsonImagem(ImagemGrafo *im, EspacoCaminhos *e, bool *cicloNegativo);
+
+/**
+ * @brief Calcula os potenciais de Johnson de uma imagem comprimida e associa-os a um espaço de trabalho.
+ *
+ * Igual a JohnsonImagem, para as pesquisas com DijkstraCompacta. Os blocos são descodificados a
+ * cada relaxação.
+ *
+ * @param im Apontador para a imagem comprimida
+ * @param e Apontador para o espaço de trabalho
+ * @param cicloNegativo Apontador para um bool que fica true se a imagem tiver um ciclo negativo
+ * @return true se o espaço pode pesquisar a imagem, e false em caso de erro ou de ciclo negativo
+ */
+bool JohnsonCompacta(ImagemCompacta *im, EspacoCaminhos *e, bool *cicloNegativo);
+
+/**
+ * @brief Copia os potenciais de Johnson de um espaço de trabalho para outro associado à mesma imagem.
+ *
+ * Permite calcular os potenciais uma vez e dá-los aos espaços de todas as threads que pesquisam a
+ * mesma imagem.
+ *
+ * @param destino Apontador para o espaço que recebe os potenciais
+ * @param origem Apontador para o espaço com os potenciais (pode não ter potenciais)
+ * @return true se os potenciais foram copiados, e false se os espaços não pesquisam a mesma imagem ou não houver memória
+ */
+bool CopiarPotenciaisEspaco(EspacoCaminhos *destino, EspacoCaminhos *origem);
+
+#endif
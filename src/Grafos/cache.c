@@ -0,0 +1,355 @@
+/**
+ * @file cache.c
+ * @author Hugo Cruz (a23010)
+ * @brief Implementação da cache LRU de árvores de caminhos mais curtos.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include <limits.h>
+#include "cache.h"
+
+ /**
+  * @brief Cria uma árvore de caminhos vazia.
+  *
+  * Esta função aloca memória para uma árvore e para os seus arrays. As distâncias são
+  * inicializadas com DISTANCIA_INFINITA e os antecessores com -1.
+  *
+  * @param origem Vértice de origem da árvore.
+  * @param tamanho Número de elementos dos arrays.
+  * @param versao Versão do grafo a que a árvore pertence.
+  * @return Apontador para a árvore criada ou NULL se não houver memória.
+  */
+ArvoreCaminhos* CriarArvoreCaminhos(int origem, int tamanho, unsigned long versao)
+{
+	if (tamanho <= 0)
+	{
+		return NULL;
+	}
+
+	ArvoreCaminhos* aux = (ArvoreCaminhos*)malloc(sizeof(ArvoreCaminhos));
+
+	if (aux == NULL)
+	{
+		return NULL;
+	}
+
+	aux->distancias = (Distancia*)malloc(sizeof(Distancia) * tamanho);
+	aux->verticeAnt = (int*)malloc(sizeof(int) * tamanho);
+
+	if (aux->distancias == NULL || aux->verticeAnt == NULL)
+	{
+		free(aux->distancias);
+		free(aux->verticeAnt);
+		free(aux);
+		return NULL;
+	}
+
+	//Nenhum vértice é alcançável antes de executar o algoritmo
+	for (int i = 0; i < tamanho; i++)
+	{
+		aux->distancias[i] = DISTANCIA_INFINITA;
+		aux->verticeAnt[i] = -1;
+	}
+
+	aux->origem = origem;
+	aux->versao = versao;
+	aux->tamanho = tamanho;
+	aux->emCache = false;
+	aux->ant = NULL;
+	aux->next = NULL;
+
+	return aux;
+}
+
+/**
+ * @brief Liberta a memória alocada para uma árvore de caminhos.
+ *
+ * @param a Apontador para a árvore a eliminar.
+ */
+void ApagarArvoreCaminhos(ArvoreCaminhos* a)
+{
+	if (a == NULL)
+	{
+		return;
+	}
+
+	free(a->distancias);
+	free(a->verticeAnt);
+	free(a);
+}
+
+/**
+ * @brief Calcula a memória ocupada por uma árvore de caminhos.
+ *
+ * @param a Apontador para a árvore.
+ * @return size_t Número de bytes ocupados pela árvore e pelos seus arrays.
+ */
+size_t TamanhoArvoreCaminhos(ArvoreCaminhos* a)
+{
+	if (a == NULL)
+	{
+		return 0;
+	}
+
+	return sizeof(ArvoreCaminhos) + (sizeof(Distancia) + sizeof(int)) * (size_t)a->tamanho;
+}
+
+/**
+ * @brief Cria uma cache de caminhos vazia.
+ *
+ * @param orcamento Memória máxima, em bytes, que a cache pode ocupar.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para a cache criada.
+ */
+CacheCaminhos* CriarCacheCaminhos(size_t orcamento, bool* inf)
+{
+	*inf = false;
+
+	CacheCaminhos* aux = (CacheCaminhos*)malloc(sizeof(CacheCaminhos));
+
+	if (aux == NULL)
+	{
+		return NULL;
+	}
+
+	aux->inicio = NULL;
+	aux->fim = NULL;
+	aux->orcamento = orcamento;
+	aux->ocupado = 0;
+	aux->entradas = 0;
+	aux->acertos = 0;
+	aux->falhas = 0;
+
+	*inf = true;
+	return aux;
+}
+
+/**
+ * @brief Retira uma árvore da lista da cache sem a apagar.
+ *
+ * @param c Apontador para a cache.
+ * @param a Apontador para a árvore a retirar.
+ */
+static void RetirarArvoreCache(CacheCaminhos* c, ArvoreCaminhos* a)
+{
+	if (a->ant != NULL)
+	{
+		a->ant->next = a->next;
+	}
+	else
+	{
+		c->inicio = a->next;
+	}
+
+	if (a->next != NULL)
+	{
+		a->next->ant = a->ant;
+	}
+	else
+	{
+		c->fim = a->ant;
+	}
+
+	a->ant = NULL;
+	a->next = NULL;
+	a->emCache = false;
+	c->ocupado -= TamanhoArvoreCaminhos(a);
+	c->entradas--;
+}
+
+/**
+ * @brief Descarta as árvores menos usadas até a cache respeitar o orçamento.
+ *
+ * @param c Apontador para a cache.
+ */
+static void AjustarCacheOrcamento(CacheCaminhos* c)
+{
+	while (c->fim != NULL && c->ocupado > c->orcamento)
+	{
+		ArvoreCaminhos* aux = c->fim;
+		RetirarArvoreCache(c, aux);
+		ApagarArvoreCaminhos(aux);
+	}
+}
+
+/**
+ * @brief Descarta todas as árvores guardadas numa cache.
+ *
+ * Os contadores de acertos e falhas são mantidos.
+ *
+ * @param c Apontador para a cache.
+ */
+void LimparCacheCaminhos(CacheCaminhos* c)
+{
+	if (c == NULL)
+	{
+		return;
+	}
+
+	ArvoreCaminhos* aux = c->inicio;
+
+	while (aux)
+	{
+		ArvoreCaminhos* temp = aux;
+		aux = aux->next;
+		ApagarArvoreCaminhos(temp);
+	}
+
+	c->inicio = NULL;
+	c->fim = NULL;
+	c->ocupado = 0;
+	c->entradas = 0;
+}
+
+/**
+ * @brief Liberta a memória alocada para uma cache e para as suas árvores.
+ *
+ * @param c Apontador para a cache a eliminar.
+ */
+void ApagarCacheCaminhos(CacheCaminhos* c)
+{
+	if (c == NULL)
+	{
+		return;
+	}
+
+	LimparCacheCaminhos(c);
+	free(c);
+}
+
+/**
+ * @brief Procura na cache a árvore de uma origem.
+ *
+ * Esta função procura a árvore da origem pedida. Se a árvore encontrada pertencer a uma versão
+ * antiga do grafo é descartada. Em caso de acerto a árvore passa a ser a mais recente da lista.
+ *
+ * @param c Apontador para a cache.
+ * @param origem Vértice de origem procurado.
+ * @param versao Versão atual do grafo.
+ * @return Apontador para a árvore encontrada ou NULL se não existir.
+ */
+ArvoreCaminhos* ProcurarArvoreCache(CacheCaminhos* c, int origem, unsigned long versao)
+{
+	if (c == NULL)
+	{
+		return NULL;
+	}
+
+	ArvoreCaminhos* aux = c->inicio;
+
+	while (aux && aux->origem != origem)
+	{
+		aux = aux->next;
+	}
+
+	//A árvore não existe ou foi calculada antes da última alteração ao grafo
+	if (aux == NULL || aux->versao != versao)
+	{
+		if (aux != NULL)
+		{
+			RetirarArvoreCache(c, aux);
+			ApagarArvoreCaminhos(aux);
+		}
+
+		c->falhas++;
+		return NULL;
+	}
+
+	//Passa a ser a árvore usada mais recentemente
+	if (aux != c->inicio)
+	{
+		RetirarArvoreCache(c, aux);
+		aux->next = c->inicio;
+		c->inicio->ant = aux;
+		c->inicio = aux;
+		aux->emCache = true;
+		c->ocupado += TamanhoArvoreCaminhos(aux);
+		c->entradas++;
+	}
+
+	c->acertos++;
+	return aux;
+}
+
+/**
+ * @brief Guarda uma árvore na cache.
+ *
+ * Esta função coloca a árvore no início da lista e descarta as árvores menos usadas até a
+ * memória ocupada respeitar o orçamento. Uma árvore maior que o orçamento não é guardada.
+ *
+ * @param c Apontador para a cache.
+ * @param a Apontador para a árvore a guardar.
+ * @return true se a árvore ficou na cache, e false caso contrário.
+ */
+bool GuardarArvoreCache(CacheCaminhos* c, ArvoreCaminhos* a)
+{
+	if (c == NULL || a == NULL || a->emCache)
+	{
+		return false;
+	}
+
+	size_t tamanho = TamanhoArvoreCaminhos(a);
+
+	if (tamanho > c->orcamento)
+	{
+		return false;
+	}
+
+	//Descarta as árvores de versões antigas antes de descartar árvores válidas
+	ArvoreCaminhos* aux = c->inicio;
+
+	while (aux)
+	{
+		ArvoreCaminhos* temp = aux;
+		aux = aux->next;
+
+		if (temp->versao != a->versao)
+		{
+			RetirarArvoreCache(c, temp);
+			ApagarArvoreCaminhos(temp);
+		}
+	}
+
+	a->ant = NULL;
+	a->next = c->inicio;
+
+	if (c->inicio != NULL)
+	{
+		c->inicio->ant = a;
+	}
+	else
+	{
+		c->fim = a;
+	}
+
+	c->inicio = a;
+	a->emCache = true;
+	c->ocupado += tamanho;
+	c->entradas++;
+
+	AjustarCacheOrcamento(c);
+
+	return true;
+}
+
+/**
+ * @brief Altera o orçamento de memória de uma cache.
+ *
+ * Se o novo orçamento for menor que a memória ocupada, as árvores menos usadas são descartadas.
+ *
+ * @param c Apontador para a cache.
+ * @param orcamento Nova memória máxima, em bytes.
+ */
+void AlterarOrcamentoCache(CacheCaminhos* c, size_t orcamento)
+{
+	if (c == NULL)
+	{
+		return;
+	}
+
+	c->orcamento = orcamento;
+	AjustarCacheOrcamento(c);
+}
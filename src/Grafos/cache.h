@@ -0,0 +1,165 @@
+/**
+ * @file cache.h
+ * @author Hugo Cruz (a23010)
+ * @brief Ficheiro de cabeçalho para a cache de árvores de caminhos mais curtos de um grafo.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include "tipos.h"
+
+/**
+ * @def CACHE_ORCAMENTO_PADRAO
+ * @brief Orçamento de memória, em bytes, usado por omissão na cache de caminhos.
+ */
+#define CACHE_ORCAMENTO_PADRAO (1024 * 1024)
+
+/**
+ * @brief Estrutura de uma árvore de caminhos mais curtos a partir de uma origem.
+ *
+ * Guarda o resultado de uma execução do algoritmo de Dijkstra. Os arrays são indexados pelo
+ * id do vértice e têm tamanho elementos. A versão indica a versão do grafo a que o resultado
+ * pertence, e os apontadores ant e next ligam a árvore na lista LRU da cache.
+ */
+typedef struct ArvoreCaminhos
+{
+	int origem;						///< Vértice de origem da árvore.
+	unsigned long versao;			///< Versão do grafo quando a árvore foi calculada.
+	int tamanho;					///< Número de elementos dos arrays.
+	Distancia *distancias;			///< Distância da origem a cada vértice (DISTANCIA_INFINITA se não existir caminho).
+	int *verticeAnt;				///< Antecessor de cada vértice no caminho mais curto (-1 se não existir).
+	bool emCache;					///< Indica se a árvore pertence a uma cache.
+	struct ArvoreCaminhos *ant;		///< Árvore usada mais recentemente antes desta.
+	struct ArvoreCaminhos *next;	///< Árvore usada menos recentemente depois desta.
+
+} ArvoreCaminhos;
+
+/**
+ * @brief Estrutura de uma cache LRU de árvores de caminhos mais curtos.
+ *
+ * A lista começa na árvore usada mais recentemente e termina na menos usada, que é a primeira
+ * a ser descartada quando a memória ocupada ultrapassa o orçamento.
+ */
+typedef struct CacheCaminhos
+{
+	ArvoreCaminhos *inicio; ///< Árvore usada mais recentemente.
+	ArvoreCaminhos *fim;	///< Árvore usada menos recentemente.
+	size_t orcamento;		///< Memória máxima, em bytes, que a cache pode ocupar.
+	size_t ocupado;			///< Memória ocupada, em bytes, pelas árvores guardadas.
+	int entradas;			///< Número de árvores guardadas.
+	unsigned long acertos;	///< Número de pesquisas resolvidas pela cache.
+	unsigned long falhas;	///< Número de pesquisas que obrigaram a recalcular a árvore.
+
+} CacheCaminhos;
+
+/**
+ * @brief Estrutura com as estatísticas de utilização de uma cache de caminhos.
+ *
+ */
+typedef struct EstatisticasCache
+{
+	unsigned long acertos; ///< Número de pesquisas resolvidas pela cache.
+	unsigned long falhas;  ///< Número de pesquisas que obrigaram a recalcular a árvore.
+	int entradas;		   ///< Número de árvores guardadas.
+	size_t ocupado;		   ///< Memória ocupada, em bytes.
+	size_t orcamento;	   ///< Memória máxima, em bytes.
+
+} EstatisticasCache;
+
+/**
+ * @brief Cria uma árvore de caminhos vazia.
+ *
+ * Esta função aloca memória para uma árvore e para os seus arrays. As distâncias são
+ * inicializadas com DISTANCIA_INFINITA e os antecessores com -1.
+ *
+ * @param origem Vértice de origem da árvore.
+ * @param tamanho Número de elementos dos arrays.
+ * @param versao Versão do grafo a que a árvore pertence.
+ * @return Apontador para a árvore criada ou NULL se não houver memória.
+ */
+ArvoreCaminhos *CriarArvoreCaminhos(int origem, int tamanho, unsigned long versao);
+
+/**
+ * @brief Liberta a memória alocada para uma árvore de caminhos.
+ *
+ * @param a Apontador para a árvore a eliminar.
+ */
+void ApagarArvoreCaminhos(ArvoreCaminhos *a);
+
+/**
+ * @brief Calcula a memória ocupada por uma árvore de caminhos.
+ *
+ * @param a Apontador para a árvore.
+ * @return size_t Número de bytes ocupados pela árvore e pelos seus arrays.
+ */
+size_t TamanhoArvoreCaminhos(ArvoreCaminhos *a);
+
+/**
+ * @brief Cria uma cache de caminhos vazia.
+ *
+ * @param orcamento Memória máxima, em bytes, que a cache pode ocupar.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para a cache criada.
+ */
+CacheCaminhos *CriarCacheCaminhos(size_t orcamento, bool *inf);
+
+/**
+ * @brief Descarta todas as árvores guardadas numa cache.
+ *
+ * Os contadores de acertos e falhas são mantidos.
+ *
+ * @param c Apontador para a cache.
+ */
+void LimparCacheCaminhos(CacheCaminhos *c);
+
+/**
+ * @brief Liberta a memória alocada para uma cache e para as suas árvores.
+ *
+ * @param c Apontador para a cache a eliminar.
+ */
+void ApagarCacheCaminhos(CacheCaminhos *c);
+
+/**
+ * @brief Procura na cache a árvore de uma origem.
+ *
+ * Esta função procura a árvore da origem pedida. Se a árvore encontrada pertencer a uma versão
+ * antiga do grafo é descartada. Em caso de acerto a árvore passa a ser a mais recente da lista.
+ *
+ * @param c Apontador para a cache.
+ * @param origem Vértice de origem procurado.
+ * @param versao Versão atual do grafo.
+ * @return Apontador para a árvore encontrada ou NULL se não existir.
+ */
+ArvoreCaminhos *ProcurarArvoreCache(CacheCaminhos *c, int origem, unsigned long versao);
+
+/**
+ * @brief Guarda uma árvore na cache.
+ *
+ * Esta função coloca a árvore no início da lista e descarta as árvores menos usadas até a
+ * memória ocupada respeitar o orçamento. Uma árvore maior que o orçamento não é guardada.
+ *
+ * @param c Apontador para a cache.
+ * @param a Apontador para a árvore a guardar.
+ * @return true se a árvore ficou na cache, e false caso contrário.
+ */
+bool GuardarArvoreCache(CacheCaminhos *c, ArvoreCaminhos *a);
+
+/**
+ * @brief Altera o orçamento de memória de uma cache.
+ *
+ * Se o novo orçamento for menor que a memória ocupada, as árvores menos usadas são descartadas.
+ *
+ * @param c Apontador para a cache.
+ * @param orcamento Nova memória máxima, em bytes.
+ */
+void AlterarOrcamentoCache(CacheCaminhos *c, size_t orcamento);
+
+#endif
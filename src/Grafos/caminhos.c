@@ -9,26 +9,30 @@
  *
  */
 
-#include "caminhos.h"
+#include <string.h>
+#include "bellmanford.h"
+#include "estatisticas.h"
+#include "largura.h"
 
  /**
   * @brief Inicializa os arrays de distâncias.
   *
-  * Esta função inicializa os arrays de distâncias, atribuindo a cada elemento o valor máximo de um inteiro.
+  * Esta função inicializa os arrays de distâncias, atribuindo a cada elemento DISTANCIA_INFINITA.
   *
   * @param dis Array de distâncias a ser inicializado.
+  * @param n Número de elementos do array.
   */
-void InicializarArrays(int* dis[])
+void InicializarArrays(Distancia dis[], int n)
 {
 	if (dis == NULL)
 	{
 		return;
 	}
 
-	//Inicializa um arrays no valor maximo de um inteiro
-	for (int i = 0; i < MAX; i++)
+	//Inicializa um arrays com a distância dos vértices não alcançados
+	for (int i = 0; i < n; i++)
 	{
-		dis[i] = INT_MAX;
+		dis[i] = DISTANCIA_INFINITA;
 	}
 }
 
@@ -61,6 +65,39 @@ int ContadorVertices(Grafo* g)
 	return contador;
 }
 
+/**
+ * @brief Calcula o tamanho dos arrays indexados pelo id dos vértices.
+ *
+ * Esta função percorre a lista de vértices e retorna o maior id mais um, que é o número
+ * de elementos que os arrays de distâncias e antecessores precisam de ter.
+ *
+ * @param g O grafo a ser analisado.
+ * @return int O tamanho dos arrays (0 se o grafo estiver vazio).
+ */
+int TamanhoArraysCaminhos(Grafo* g)
+{
+	if (g == NULL)
+	{
+		return 0;
+	}
+
+	int maior = -1;
+
+	Vertice* aux = g->inicioGrafo;
+
+	//A lista está ordenada por id, mas não se assume a ordem
+	while (aux)
+	{
+		if (aux->id > maior)
+		{
+			maior = aux->id;
+		}
+		aux = aux->nextV;
+	}
+
+	return maior + 1;
+}
+
 /**
  * @brief Encontra a o vértice com a distância mínima
  *
@@ -69,23 +106,26 @@ int ContadorVertices(Grafo* g)
  *
  * @param distancia Array com as distâncias acumuladas de cada vértice.
  * @param visitado Array que indica se um vértice foi ou não visitado.
- * @param n Número total de vértices.
- * @return int O id do vértice com a distância mínima.
+ * @param n Número de elementos dos arrays.
+ * @return int O id do vértice com a distância mínima ou -1 se não restar nenhum vértice alcançável.
  */
-int DistanciaMinima(int distancia[], bool visitado[], int n)
+int DistanciaMinima(Distancia distancia[], bool visitado[], int n)
 {
 	if (distancia == NULL || visitado == NULL)
 	{
 		return -1;
 	}
 
-	int min = INT_MAX;
+	Distancia min = DISTANCIA_INFINITA;
 	int posicao = -1;
 
+	CONTAR_ESTATISTICA(verticesPercorridos, n);
+
 	//Corre o arrays de booleanos verifica se o vértice já foi visitado e encontrar o valor mínimo das adjacências
-	for (int i = 1; i <= n; i++)
+	//Vértices com distância DISTANCIA_INFINITA não são alcançáveis e nunca são escolhidos
+	for (int i = 0; i < n; i++)
 	{
-		if (visitado[i] == false && distancia[i] <= min)
+		if (visitado[i] == false && distancia[i] < min)
 		{
 			min = distancia[i];
 			posicao = i;
@@ -98,101 +138,292 @@ int DistanciaMinima(int distancia[], bool visitado[], int n)
 
 /**
  * @brief Algoritmo de Dijkstra
- * 
- * Esta função implementa o algoritmo de Dijkstra, que é usado para encontrar os caminhos mais 
+ *
+ * Esta função implementa o algoritmo de Dijkstra, que é usado para encontrar os caminhos mais
  * curtos de um vértice de origem para todos os outros vértices num grafo.
- * 
+ * O algoritmo assume pesos não negativos; para grafos com pesos negativos deve ser usada a função BellmanFord.
+ * A pesquisa é feita com DijkstraRestrito, que relaxa as adjacências a partir de arrays contíguos.
+ *
  * @param g Apontador para o grafo no qual o algoritmo de Dijkstra será executado
  * @param origem O vértice de origem para o qual os caminhos mais curtos serão calculados
  * @param distanciasFinais Array que será preenchido com as distâncias mais curtas da origem para cada vértice
  * @param verticeAnt Array que será preenchido com os antecessores de cada vértice
+ *
+ * Os dois arrays têm de ter pelo menos TamanhoArraysCaminhos(g) elementos.
  */
-void Dijkstra(Grafo* g, int origem, int distanciasFinais[], int verticeAnt[])
+void Dijkstra(Grafo* g, int origem, Distancia distanciasFinais[], int verticeAnt[])
 {
 	if (g == NULL)
 	{
 		return;
 	}
 
-	//Arrays temporario
-	int distancias[MAX];
-	bool inf, visitado[MAX] = { false };
+	int tamanho = TamanhoArraysCaminhos(g);
+
+	if (origem < 0 || origem >= tamanho)
+	{
+		return;
+	}
+
+	InicializarArrays(distanciasFinais, tamanho);
 
-	InicializarArrays(distancias);
+	for (int i = 0; i < tamanho; i++)
+	{
+		verticeAnt[i] = -1;
+	}
+
+	bool inf;
+	EspacoCaminhos* e = CriarEspacoCaminhos(g, &inf);
+
+	if (e == NULL)
+	{
+		return;
+	}
 
-	int numVertices = ContadorVertices(g);
+	DijkstraRestrito(g, e, origem, -1, NULL, 0);
 
-	//O peso das origens é sempre 0
-	distancias[origem] = 0;
-	distanciasFinais[origem] = 0;
+	//Só as posições alcançadas foram alteradas pela pesquisa
+	for (int i = 0; i < e->numTocados; i++)
+	{
+		int id = e->tocados[i];
+		distanciasFinais[id] = e->distancias[id];
+		verticeAnt[id] = e->verticeAnt[id];
+	}
+
+	ApagarEspacoCaminhos(e);
+}
+
+/**
+ * @brief Calcula a árvore de caminhos mais curtos de uma origem, indicando se falhou por um ciclo negativo.
+ *
+ * @param g Apontador para o grafo
+ * @param origem O vértice de origem
+ * @param cicloNegativo Apontador para um bool que fica true se for encontrado um ciclo negativo
+ * @return ArvoreCaminhos* Apontador para a árvore calculada ou NULL em caso de erro ou de ciclo negativo
+ */
+static ArvoreCaminhos* CalcularArvore(Grafo* g, int origem, bool* cicloNegativo)
+{
+	*cicloNegativo = false;
 
-	for (int i = 0; i < numVertices; i++)
+	if (g == NULL)
 	{
-		//Encontra a posição da adjacência com menor valor
-		int verticeAtual = DistanciaMinima(distancias, visitado, numVertices);
+		return NULL;
+	}
 
-		visitado[verticeAtual] = true; //Coloca como visitado 
+	ArvoreCaminhos* a = CriarArvoreCaminhos(origem, TamanhoArraysCaminhos(g), g->versao);
 
-		//Colocamos no vertice
-		Vertice* auxV = ColocaNumaPosicaoLista(g->inicioGrafo, verticeAtual, &inf);
-		if (auxV == NULL) return;
-		Adjacente* auxA = auxV->nextA;
+	if (a == NULL)
+	{
+		return NULL;
+	}
 
-		//Avançamos com as adjacências
-		while (auxA)
+	//O algoritmo de Dijkstra não suporta pesos negativos
+	if (ExistemPesosNegativos(g))
+	{
+		if (!BellmanFord(g, origem, a->distancias, a->verticeAnt, BELLMAN_FORD_FILA, cicloNegativo))
 		{
-			//Se o vertice não foi visitado e o peso anterior mais o atual é maior que o guardado  
-			if (!visitado[auxA->id] && distancias[verticeAtual] + auxA->peso < distancias[auxA->id])
-			{
-				//Verifica se existe adjacências entre a origem e adjacência atual
-				if (ExisteAdjDoisVertices(auxV, verticeAtual, auxA->id))
-				{
-					//Soma e guarda o necessário
-					distancias[auxA->id] = distancias[verticeAtual] + auxA->peso;
-					distanciasFinais[auxA->id] = distancias[auxA->id];
-					verticeAnt[auxA->id] = verticeAtual;
-				}
-			}
-			auxA = auxA->next;
+			ApagarArvoreCaminhos(a);
+			return NULL;
 		}
 	}
+	else
+	{
+		Dijkstra(g, origem, a->distancias, a->verticeAnt);
+	}
+
+	return a;
+}
+
+/**
+ * @brief Calcula a árvore de caminhos mais curtos de uma origem.
+ *
+ * Esta função cria uma árvore de caminhos com o tamanho adequado ao grafo e preenche-a com o
+ * algoritmo de Dijkstra, ou com o algoritmo de Bellman-Ford se o grafo tiver pesos negativos.
+ * A árvore não é guardada na cache.
+ *
+ * @param g Apontador para o grafo
+ * @param origem O vértice de origem
+ * @return ArvoreCaminhos* Apontador para a árvore calculada ou NULL em caso de erro ou de ciclo negativo
+ */
+ArvoreCaminhos* CalcularArvoreCaminhos(Grafo* g, int origem)
+{
+	bool cicloNegativo;
+
+	return CalcularArvore(g, origem, &cicloNegativo);
+}
+
+/**
+ * @brief Obtém a árvore de caminhos mais curtos de uma origem, usando a cache do grafo, indicando se falhou por um ciclo negativo.
+ *
+ * @param g Apontador para o grafo
+ * @param origem O vértice de origem
+ * @param cicloNegativo Apontador para um bool que fica true se for encontrado um ciclo negativo
+ * @return ArvoreCaminhos* Apontador para a árvore ou NULL em caso de erro ou de ciclo negativo
+ */
+static ArvoreCaminhos* ObterArvore(Grafo* g, int origem, bool* cicloNegativo)
+{
+	*cicloNegativo = false;
+
+	if (g == NULL)
+	{
+		return NULL;
+	}
+
+	//Sem orçamento a cache fica desativada
+	if (g->orcamentoCache == 0)
+	{
+		return CalcularArvore(g, origem, cicloNegativo);
+	}
+
+	if (g->cache == NULL)
+	{
+		bool inf;
+		g->cache = CriarCacheCaminhos(g->orcamentoCache, &inf);
+	}
+
+	ArvoreCaminhos* a = ProcurarArvoreCache(g->cache, origem, g->versao);
+
+	if (a != NULL)
+	{
+		return a;
+	}
+
+	a = CalcularArvore(g, origem, cicloNegativo);
+	GuardarArvoreCache(g->cache, a);
+
+	//A cache conta para a memória do grafo
+	AjustarMemoriaGrafo(g, 0, 0, 0);
+
+	return a;
+}
+
+/**
+ * @brief Obtém a árvore de caminhos mais curtos de uma origem, usando a cache do grafo.
+ *
+ * Esta função procura a árvore na cache do grafo e só executa o algoritmo de Dijkstra se a árvore
+ * não existir ou se o grafo tiver sido alterado desde que foi calculada. A árvore devolvida deve
+ * ser entregue a LibertarArvoreCaminhos quando deixar de ser usada.
+ *
+ * @param g Apontador para o grafo
+ * @param origem O vértice de origem
+ * @return ArvoreCaminhos* Apontador para a árvore ou NULL em caso de erro
+ */
+ArvoreCaminhos* ObterArvoreCaminhos(Grafo* g, int origem)
+{
+	bool cicloNegativo;
+
+	return ObterArvore(g, origem, &cicloNegativo);
+}
+
+/**
+ * @brief Obtém a árvore de caminhos mais curtos de uma origem, usando a cache do grafo, indicando se falhou por um ciclo negativo.
+ *
+ * Igual a ObterArvoreCaminhos, para quem precisa de distinguir um ciclo negativo alcançável a
+ * partir da origem de uma falta de memória.
+ *
+ * @param g Apontador para o grafo
+ * @param origem O vértice de origem
+ * @param cicloNegativo Apontador para um bool que fica true se for encontrado um ciclo negativo
+ * @return ArvoreCaminhos* Apontador para a árvore ou NULL em caso de erro ou de ciclo negativo
+ */
+ArvoreCaminhos* ObterArvoreCaminhosCiclo(Grafo* g, int origem, bool* cicloNegativo)
+{
+	return ObterArvore(g, origem, cicloNegativo);
+}
+
+/**
+ * @brief Liberta uma árvore obtida com ObterArvoreCaminhos.
+ *
+ * A árvore só é apagada se não pertencer à cache do grafo.
+ *
+ * @param a Apontador para a árvore
+ */
+void LibertarArvoreCaminhos(ArvoreCaminhos* a)
+{
+	if (a != NULL && !a->emCache)
+	{
+		ApagarArvoreCaminhos(a);
+	}
 }
 
 /**
  * @brief Calcula a distância mínima entre dois vértices num grafo
  *
- * Esta função calcula a distância mínima entre dois vértices num grafo.
- * A função retorna a distância mínima entre os vértices de origem e destino.
+ * Esta função calcula a distância mínima entre dois vértices num grafo. Como com pesos negativos
+ * qualquer valor pode ser uma distância, a falta de caminho é indicada com DISTANCIA_INFINITA e um
+ * ciclo negativo alcançável a partir da origem, que impede haver distâncias mínimas, é indicado
+ * em cicloNegativo.
  *
  * @param g Apontador para o grafo onde a operação será realizada
  * @param origem Vértice de origem
  * @param destino Vértice de destino
- * @return int A distância mínima entre os vértices de origem e destino.
+ * @param cicloNegativo Apontador para um bool que fica true se for encontrado um ciclo negativo
+ * @return Distancia A distância mínima entre os vértices de origem e destino (DISTANCIA_INFINITA se não existir caminho, em caso de erro ou de ciclo negativo).
  */
-int DistanciaMinimaEntreVertices(Grafo* g, int origem, int destino)
+Distancia DistanciaMinimaEntreVertices(Grafo* g, int origem, int destino, bool* cicloNegativo)
 {
+	*cicloNegativo = false;
+
 	if (g == NULL)
 	{
-		return -1;
+		return DISTANCIA_INFINITA;
 	}
 
-	int valor = 0;
-	int distanciasFinais[MAX];
-	int verticeAnt[MAX];
+	Distancia valor = DISTANCIA_INFINITA;
 
-	InicializarArrays(distanciasFinais);
-	Dijkstra(g, origem, distanciasFinais, verticeAnt);
+	ArvoreCaminhos* a = ObterArvore(g, origem, cicloNegativo);
 
-	//Verifica recebe o peso de uma adjacência
-	if (distanciasFinais[destino] != INT_MAX && distanciasFinais[destino] > 0)
+	if (a == NULL)
 	{
-		return distanciasFinais[destino];
+		return DISTANCIA_INFINITA;
 	}
-	else
+
+	//Com pesos negativos a distância pode ser negativa ou 0
+	if (destino >= 0 && destino < a->tamanho)
+	{
+		valor = a->distancias[destino];
+	}
+
+	LibertarArvoreCaminhos(a);
+	return valor;
+}
+
+/**
+ * @brief Devolve o espaço de pesquisa em largura sobre a imagem atual de um grafo.
+ *
+ * A imagem e o espaço ficam guardados no grafo e só são criados de novo quando a versão do grafo
+ * muda, pelo que as verificações seguidas sobre o mesmo grafo não voltam a percorrer as listas.
+ *
+ * @param g Apontador para o grafo
+ * @return EspacoLargura* Apontador para o espaço (NULL se faltou memória)
+ */
+static EspacoLargura* EspacoAlcance(Grafo* g)
+{
+	if (g->espacoAlcance != NULL && g->versaoAlcance == g->versao)
+	{
+		return g->espacoAlcance;
+	}
+
+	ApagarEspacoLargura(g->espacoAlcance);
+	ApagarImagemGrafo(g->imagemAlcance);
+	g->espacoAlcance = NULL;
+	g->imagemAlcance = NULL;
+	g->memoriaAlcance = 0;
+
+	bool inf;
+	ImagemGrafo* im = CriarImagemGrafo(g, &inf);
+	EspacoLargura* e = im != NULL ? CriarEspacoLargura(im, NULL, &inf) : NULL;
+
+	if (e == NULL)
 	{
-		return valor;
+		ApagarImagemGrafo(im);
+		return NULL;
 	}
 
+	g->imagemAlcance = im;
+	g->espacoAlcance = e;
+	g->versaoAlcance = g->versao;
+	return e;
 }
 
 /**
@@ -201,6 +432,10 @@ int DistanciaMinimaEntreVertices(Grafo* g, int origem, int destino)
  * Esta função verifica se existe um caminho entre dois vértices num grafo. O grafo, o vértice de origem
  * e o vértice de destino são passados como argumentos. A função retorna verdadeiro se existir um caminho
  *  válido entre os vértices de origem e destino, e falso caso contrário.
+ * Só interessa que vértices são alcançáveis, pelo que os pesos, mesmo negativos, não contam. Num
+ * grafo denso a pesquisa é feita com os conjuntos de bits da matriz; nos restantes é feita uma
+ * pesquisa em largura que para no destino, sobre uma imagem guardada no grafo até à alteração
+ * seguinte.
  *
  * @param g Apontador para o grafo onde a operação será realizada
  * @param origem Vértice de origem
@@ -210,75 +445,1196 @@ int DistanciaMinimaEntreVertices(Grafo* g, int origem, int destino)
  */
 bool ExisteCaminhoGrafo(Grafo* g, int origem, int destino)
 {
-	if (g == NULL)
+	if (g == NULL || destino < 0 || destino == origem)
 	{
 		return false;
 	}
 
-	int verticeAnt[MAX];
-	int distanciasFinais[MAX];
+	bool existe = false;
 
-	InicializarArrays(distanciasFinais);
-	Dijkstra(g, origem, distanciasFinais, verticeAnt);
-
-	//Verifica recebe o peso de uma adjacência e verifica se é valido 
-	if (distanciasFinais[destino] != INT_MAX && distanciasFinais[destino] > 0)
+	if (g->matriz != NULL)
 	{
-		return true;
+		MatrizAdjacencia* m = g->matriz;
+		PalavraBits* alcancados = (PalavraBits*)malloc(sizeof(PalavraBits) * m->palavrasLinha);
+
+		if (alcancados != NULL && destino < m->tamanho && AlcancaveisMatriz(m, origem, alcancados) > 0)
+		{
+			existe = (alcancados[destino / BITS_PALAVRA] >> (destino % BITS_PALAVRA)) & 1;
+		}
+
+		free(alcancados);
+		return existe;
 	}
-	else
+
+	EspacoLargura* e = EspacoAlcance(g);
+
+	if (e == NULL)
 	{
 		return false;
 	}
+
+	existe = LarguraDirecional(e, NULL, origem, destino) >= 0;
+
+	//A imagem inversa é criada pela primeira pesquisa que passa a ser feita de baixo para cima
+	g->memoriaAlcance = MemoriaImagemGrafo(g->imagemAlcance) + MemoriaEspacoLargura(e);
+	AjustarMemoriaGrafo(g, 0, 0, 0);
+	return existe;
 }
 
 /**
  * @brief Cria um grafo com os caminhos mais curto para cada vertice
  *
- * Esta função cria um novo grafo com os caminhos mais curtos para cada vértice
+ * Esta função cria um novo grafo com os caminhos mais curtos para cada vértice. Se o grafo tiver
+ * pesos negativos, os pesos são ajustados com os potenciais de Johnson para que cada origem
+ * continue a ser calculada com o algoritmo de Dijkstra.
+ *
+ * Cada distância passa a ser o peso de uma adjacência, e um peso 0 indica que não há caminho. Por
+ * isso o grafo não é criado se alguma distância não couber em PesoAresta (entre PESO_MINIMO e
+ * PESO_MAXIMO, o que com GRAFOS_PESO_16 limita as distâncias a 16 bits) ou se, com pesos
+ * negativos, dois vértices diferentes estiverem à distância 0.
  *
  * @param g Apontador para o grafo original
- * @return Grafo* Apontador para o novo grafo criado
+ * @return Grafo* Apontador para o novo grafo criado, ou NULL se existir um ciclo negativo, se faltar memória ou se alguma distância não puder ser guardada como peso
  */
 Grafo* CriarGrafoCaminhoMaisCurto(Grafo* g)
 {
-	bool inf;
-	int distanciasFinais[MAX];
-	int verticeAnt[MAX];
+	if (g == NULL)
+	{
+		return NULL;
+	}
 
-	int numVertices = ContadorVertices(g);
+	bool inf, cicloNegativo;
+
+	//Um único espaço de trabalho serve todas as origens
+	EspacoCaminhos* e = CriarEspacoCaminhos(g, &inf);
+
+	if (e == NULL)
+	{
+		return NULL;
+	}
+
+	if (ExistemPesosNegativos(g) && !Johnson(g, e, &cicloNegativo))
+	{
+		ApagarEspacoCaminhos(e);
+		return NULL;
+	}
 
 	Grafo* novo = CriarGrafo(&inf);
 
-	//Cria os vertices
-	for (int i = 1; i <= numVertices; i++)
+	if (novo == NULL)
+	{
+		ApagarEspacoCaminhos(e);
+		return NULL;
+	}
+
+	//Cria os vertices com os mesmos ids do grafo original
+	Vertice* auxG = g->inicioGrafo;
+
+	inf = true;
+
+	while (auxG && inf)
 	{
-		novo = InserirVerticeGrafo(novo, i, &inf);
+		novo = InserirVerticeGrafo(novo, auxG->id, &inf);
+		auxG = auxG->nextV;
 	}
 
 	Vertice* aux = novo->inicioGrafo;
 
 	//Quantos houver vertices
-	while (aux)
+	while (aux && inf)
 	{
+		// Calcula os valores mínimos de uma origem a todos os vertices
+		DijkstraRestrito(g, e, aux->id, -1, NULL, 0);
 
-		InicializarArrays(distanciasFinais);
-		Dijkstra(g, aux->id, distanciasFinais, verticeAnt); // Recebe um arrays com os valores mínimos de uma origem a todos os vertices
+		Vertice* destino = novo->inicioGrafo;
 
-		for (int j = 1; j <= numVertices; j++)
+		while (destino && inf)
 		{
-			if (distanciasFinais[j] == INT_MAX)
+			Distancia d = e->distancias[destino->id];
+
+			//Sem caminho fica o peso 0, que não é uma ligação
+			if (d == DISTANCIA_INFINITA)
 			{
-				novo = InserirAdjGrafo(novo, aux->id, j, 0, &inf);
+				d = 0;
 			}
-			else
+			//Uma distância que não cabe num peso, ou 0 entre vértices diferentes, perder-se-ia
+			else if (!PESO_VALIDO(d) || (d == 0 && destino != aux))
 			{
-				novo = InserirAdjGrafo(novo, aux->id, j, distanciasFinais[j], &inf);
+				inf = false;
+				break;
 			}
+
+			novo = InserirAdjGrafo(novo, aux->id, destino->id, (PesoAresta)d, &inf);
+			destino = destino->nextV;
 		}
 
 		aux = aux->nextV;
 	}
 
+	ApagarEspacoCaminhos(e);
+
+	if (!inf)
+	{
+		ApagaGrafo(novo);
+		return NULL;
+	}
+
+	ContabilizarMemoriaGrafo(novo);
 	return novo;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Ajusta os arrays de um espaço de trabalho a um número de vértices.
+ *
+ * @param e Apontador para o espaço de trabalho
+ * @param tamanho Número de elementos dos arrays (maior id + 1)
+ * @return true se os arrays têm o tamanho pedido, e false se não houver memória
+ */
+static bool AjustarEspacoCaminhos(EspacoCaminhos* e, int tamanho)
+{
+	if (tamanho == e->tamanho)
+	{
+		return true;
+	}
+
+	int n = tamanho > 0 ? tamanho : 1;
+
+	Distancia* distancias = (Distancia*)realloc(e->distancias, sizeof(Distancia) * n);
+	if (distancias != NULL) e->distancias = distancias;
+	int* verticeAnt = (int*)realloc(e->verticeAnt, sizeof(int) * n);
+	if (verticeAnt != NULL) e->verticeAnt = verticeAnt;
+	PesoAresta* pesoAnt = (PesoAresta*)realloc(e->pesoAnt, sizeof(PesoAresta) * n);
+	if (pesoAnt != NULL) e->pesoAnt = pesoAnt;
+	bool* visitado = (bool*)realloc(e->visitado, sizeof(bool) * n);
+	if (visitado != NULL) e->visitado = visitado;
+	bool* bloqueado = (bool*)realloc(e->bloqueado, sizeof(bool) * n);
+	if (bloqueado != NULL) e->bloqueado = bloqueado;
+	int* tocados = (int*)realloc(e->tocados, sizeof(int) * n);
+	if (tocados != NULL) e->tocados = tocados;
+
+	if (distancias == NULL || verticeAnt == NULL || pesoAnt == NULL ||
+		visitado == NULL || bloqueado == NULL || tocados == NULL)
+	{
+		return false;
+	}
+
+	e->tamanho = tamanho;
+
+	//Depois de mudar de tamanho todas as posições são reinicializadas
+	for (int i = 0; i < tamanho; i++)
+	{
+		e->distancias[i] = DISTANCIA_INFINITA;
+		e->verticeAnt[i] = -1;
+		e->pesoAnt[i] = 0;
+		e->visitado[i] = false;
+		e->bloqueado[i] = false;
+	}
+
+	e->numTocados = 0;
+	return true;
+}
+
+/**
+ * @brief Associa uma imagem do grafo a um espaço de trabalho.
+ *
+ * @param e Apontador para o espaço de trabalho
+ * @param im Apontador para a imagem
+ * @param propria true se a imagem passa a pertencer ao espaço de trabalho, false se for partilhada
+ * @return true se a imagem foi associada, e false se não houver memória
+ */
+static bool AssociarImagemEspaco(EspacoCaminhos* e, ImagemGrafo* im, bool propria)
+{
+	//Os potenciais de Johnson só continuam válidos para a mesma versão da mesma imagem
+	if (e->imagem != im || e->compacta != NULL || e->versao != im->versao || e->tamanho != im->tamanho)
+	{
+		free(e->potencial);
+		e->potencial = NULL;
+	}
+
+	if (!AjustarEspacoCaminhos(e, im->tamanho))
+	{
+		return false;
+	}
+
+	if (e->imagemPropria)
+	{
+		ApagarImagemGrafo(e->imagem);
+	}
+
+	e->imagem = im;
+	e->imagemPropria = propria;
+	e->compacta = NULL;
+	e->versao = im->versao;
+	e->grafo = NULL;
+	return true;
+}
+
+/**
+ * @brief Associa uma imagem comprimida a um espaço de trabalho.
+ *
+ * @param e Apontador para o espaço de trabalho
+ * @param im Apontador para a imagem comprimida, que continua a pertencer a quem a criou
+ * @return true se a imagem foi associada, e false se não houver memória
+ */
+static bool AssociarCompactaEspaco(EspacoCaminhos* e, ImagemCompacta* im)
+{
+	if (e->compacta != im || e->versao != im->versao || e->tamanho != im->tamanho)
+	{
+		free(e->potencial);
+		e->potencial = NULL;
+	}
+
+	if (!AjustarEspacoCaminhos(e, im->tamanho))
+	{
+		return false;
+	}
+
+	if (e->imagemPropria)
+	{
+		ApagarImagemGrafo(e->imagem);
+	}
+
+	e->imagem = NULL;
+	e->imagemPropria = false;
+	e->compacta = im;
+	e->versao = im->versao;
+	e->grafo = NULL;
+	return true;
+}
+
+/**
+ * @brief Constrói o índice de vértices de um espaço de trabalho.
+ *
+ * Esta função cria uma imagem com as ligações atuais do grafo e ajusta o tamanho dos arrays.
+ *
+ * @param g Apontador para o grafo
+ * @param e Apontador para o espaço de trabalho
+ * @return true se o índice foi construído, e false se não houver memória
+ */
+static bool IndexarEspacoCaminhos(Grafo* g, EspacoCaminhos* e)
+{
+	bool inf;
+	ImagemGrafo* im = CriarImagemGrafo(g, &inf);
+
+	if (im == NULL)
+	{
+		return false;
+	}
+
+	if (!AssociarImagemEspaco(e, im, true))
+	{
+		ApagarImagemGrafo(im);
+		return false;
+	}
+
+	e->grafo = g;
+	return true;
+}
+
+/**
+ * @brief Cria um espaço de trabalho para o algoritmo de Dijkstra.
+ *
+ * Esta função aloca os arrays de trabalho com o tamanho adequado ao grafo e indexa os vértices
+ * pelo id. O espaço pode ser reutilizado em várias pesquisas; se o grafo for alterado, o índice
+ * é reconstruído automaticamente na pesquisa seguinte.
+ *
+ * @param g Apontador para o grafo
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida
+ * @return EspacoCaminhos* Apontador para o espaço de trabalho criado
+ */
+EspacoCaminhos* CriarEspacoCaminhos(Grafo* g, bool* inf)
+{
+	*inf = false;
+
+	if (g == NULL)
+	{
+		return NULL;
+	}
+
+	EspacoCaminhos* e = (EspacoCaminhos*)calloc(1, sizeof(EspacoCaminhos));
+
+	if (e == NULL)
+	{
+		return NULL;
+	}
+
+	e->tamanho = -1; //Obriga a alocar os arrays
+	e->fila = CriarFilaPrioridade(16, inf);
+
+	if (e->fila == NULL || !IndexarEspacoCaminhos(g, e))
+	{
+		ApagarEspacoCaminhos(e);
+		*inf = false;
+		return NULL;
+	}
+
+	*inf = true;
+	return e;
+}
+
+/**
+ * @brief Liberta a memória alocada para um espaço de trabalho.
+ *
+ * @param e Apontador para o espaço de trabalho a eliminar
+ */
+void ApagarEspacoCaminhos(EspacoCaminhos* e)
+{
+	if (e == NULL)
+	{
+		return;
+	}
+
+	if (e->imagemPropria)
+	{
+		ApagarImagemGrafo(e->imagem);
+	}
+
+	free(e->distancias);
+	free(e->verticeAnt);
+	free(e->pesoAnt);
+	free(e->visitado);
+	free(e->bloqueado);
+	free(e->tocados);
+	free(e->potencial);
+	ApagarFilaPrioridade(e->fila);
+	free(e);
+}
+
+/**
+ * @brief Devolve a memória ocupada por um espaço de trabalho.
+ *
+ * @param e Apontador para o espaço de trabalho
+ * @return size_t Número de bytes alocados
+ */
+size_t MemoriaEspacoCaminhos(EspacoCaminhos* e)
+{
+	if (e == NULL)
+	{
+		return 0;
+	}
+
+	size_t total = sizeof(EspacoCaminhos);
+
+	if (e->tamanho >= 0)
+	{
+		size_t n = e->tamanho > 0 ? (size_t)e->tamanho : 1;
+		total += n * (sizeof(Distancia) + 2 * sizeof(int) + sizeof(PesoAresta) + 2 * sizeof(bool));
+
+		if (e->potencial != NULL)
+		{
+			total += n * sizeof(Distancia);
+		}
+	}
+
+	if (e->fila != NULL)
+	{
+		total += sizeof(FilaPrioridade) + (size_t)e->fila->capacidade * sizeof(ElementoFila);
+	}
+
+	if (e->imagemPropria)
+	{
+		total += MemoriaImagemGrafo(e->imagem);
+	}
+
+	return total;
+}
+
+/**
+ * @brief Marca um vértice como alterado pela pesquisa atual.
+ *
+ * @param e Apontador para o espaço de trabalho
+ * @param id Vértice alterado
+ */
+static void TocarEspacoCaminhos(EspacoCaminhos* e, int id)
+{
+	if (e->distancias[id] == DISTANCIA_INFINITA)
+	{
+		e->tocados[e->numTocados++] = id;
+	}
+}
+
+/**
+ * @brief Relaxa uma adjacência de um vértice já visitado.
+ *
+ * @param e Apontador para o espaço de trabalho
+ * @param u Vértice visitado
+ * @param w Destino da adjacência
+ * @param peso Peso da adjacência
+ */
+static inline void RelaxarAdjacencia(EspacoCaminhos* e, int u, int w, PesoAresta peso)
+{
+	bool inf;
+
+	CONTAR_ESTATISTICA(arestasRelaxadas, 1);
+
+	//Com potenciais usa-se o peso ajustado, que nunca é negativo
+	Distancia nova = e->distancias[u] + peso;
+
+	if (e->potencial != NULL)
+	{
+		nova += e->potencial[u] - e->potencial[w];
+	}
+
+	if (nova < e->distancias[w])
+	{
+		TocarEspacoCaminhos(e, w);
+		e->distancias[w] = nova;
+		e->verticeAnt[w] = u;
+		e->pesoAnt[w] = peso;
+		e->fila = InserirFila(e->fila, w, nova, &inf);
+	}
+}
+
+/**
+ * @brief Relaxa as adjacências de um vértice de uma imagem comprimida.
+ *
+ * O bloco do vértice é descodificado à medida que é percorrido.
+ *
+ * @param e Apontador para o espaço de trabalho, associado a uma imagem comprimida
+ * @param u Vértice visitado
+ */
+static void RelaxarVerticeCompacto(EspacoCaminhos* e, int u)
+{
+	const bool* bloqueado = e->bloqueado;
+	const bool* visitado = e->visitado;
+	bool negativos = e->potencial != NULL;
+	CursorCompacto c;
+	int w;
+	PesoAresta peso;
+
+	IniciarCursorCompacto(e->compacta, u, &c);
+
+	while (ProximaAdjacenciaCompacta(&c, &w, &peso))
+	{
+		if ((peso > 0 || negativos) && !bloqueado[w] && !visitado[w])
+		{
+			RelaxarAdjacencia(e, u, w, peso);
+		}
+	}
+}
+
+/**
+ * @brief Relaxa todas as adjacências de um vértice já visitado.
+ *
+ * As adjacências são lidas dos arrays contíguos da imagem do grafo, que só têm ligações
+ * verdadeiras, pelo que cada par (destino, peso) é relaxado sem outras pesquisas.
+ *
+ * @param e Apontador para o espaço de trabalho
+ * @param u Vértice visitado
+ */
+static void RelaxarVertice(EspacoCaminhos* e, int u)
+{
+	if (e->compacta != NULL)
+	{
+		RelaxarVerticeCompacto(e, u);
+		return;
+	}
+
+	const int* destinos = e->imagem->destinos;
+	const PesoAresta* pesos = e->imagem->pesos;
+	const bool* bloqueado = e->bloqueado;
+	const bool* visitado = e->visitado;
+	bool negativos = e->potencial != NULL;
+
+	for (int i = e->imagem->inicio[u], fim = e->imagem->inicio[u + 1]; i < fim; i++)
+	{
+		int w = destinos[i];
+		PesoAresta peso = pesos[i];
+
+		//Sem potenciais as adjacências com peso negativo não são usadas
+		if ((peso > 0 || negativos) && !bloqueado[w] && !visitado[w])
+		{
+			RelaxarAdjacencia(e, u, w, peso);
+		}
+	}
+}
+
+/**
+ * @brief Relaxa as adjacências da origem que não estão bloqueadas.
+ *
+ * @param e Apontador para o espaço de trabalho
+ * @param u Vértice de origem
+ * @param destinosBloqueados Destinos das adjacências da origem que não podem ser usadas
+ * @param numBloqueados Número de elementos em destinosBloqueados
+ */
+static void RelaxarOrigemRestrita(EspacoCaminhos* e, int u, int destinosBloqueados[], int numBloqueados)
+{
+	bool negativos = e->potencial != NULL;
+
+	for (int i = e->imagem->inicio[u], fim = e->imagem->inicio[u + 1]; i < fim; i++)
+	{
+		int w = e->imagem->destinos[i];
+		PesoAresta peso = e->imagem->pesos[i];
+		bool permitida = (peso > 0 || negativos) && !e->bloqueado[w] && !e->visitado[w];
+
+		for (int j = 0; j < numBloqueados && permitida; j++)
+		{
+			if (destinosBloqueados[j] == w)
+			{
+				permitida = false;
+			}
+		}
+
+		if (permitida)
+		{
+			RelaxarAdjacencia(e, u, w, peso);
+		}
+	}
+}
+
+/**
+ * @brief Troca o vértice de maior id empatado com o último vértice fixado por um vértice com a mesma distância.
+ *
+ * @param e Apontador para o espaço de trabalho
+ * @param fixados Vértices fixados, por ordem de distância
+ * @param numFixados Número de elementos de fixados
+ * @param u Vértice com a mesma distância que o último de fixados
+ */
+static void TrocarEmpateFixados(EspacoCaminhos* e, int fixados[], int numFixados, int u)
+{
+	Distancia d = e->distancias[fixados[numFixados - 1]];
+	int maior = numFixados - 1;
+
+	for (int i = numFixados - 2; i >= 0 && e->distancias[fixados[i]] == d; i--)
+	{
+		if (fixados[i] > fixados[maior])
+		{
+			maior = i;
+		}
+	}
+
+	if (u < fixados[maior])
+	{
+		fixados[maior] = u;
+	}
+}
+
+/**
+ * @brief Executa uma pesquisa de Dijkstra sobre a imagem associada ao espaço de trabalho.
+ *
+ * @param e Apontador para o espaço de trabalho, já associado a uma imagem
+ * @param origem O vértice de origem
+ * @param destino O vértice onde a pesquisa pode parar (-1 para calcular todos os vértices)
+ * @param destinosBloqueados Destinos das adjacências da origem que não podem ser usadas (pode ser NULL)
+ * @param numBloqueados Número de elementos em destinosBloqueados
+ * @param fixados Array onde ficam os vértices fixados, sem a origem, por ordem de distância (pode ser NULL)
+ * @param maxFixados Número de vértices fixados ao fim do qual a pesquisa para (só usado se fixados não for NULL)
+ * @param numFixados Apontador onde fica o número de vértices escritos em fixados (pode ser NULL)
+ * @return Distancia A distância da origem ao destino (DISTANCIA_INFINITA se não existir caminho ou se destino for -1)
+ */
+static Distancia PesquisarEspacoCaminhos(EspacoCaminhos* e, int origem, int destino, int destinosBloqueados[], int numBloqueados, int fixados[], int maxFixados, int* numFixados)
+{
+	int contador = 0;
+
+	bool inf;
+
+	//Reinicializa apenas o que a pesquisa anterior alterou
+	for (int i = 0; i < e->numTocados; i++)
+	{
+		int id = e->tocados[i];
+		e->distancias[id] = DISTANCIA_INFINITA;
+		e->verticeAnt[id] = -1;
+		e->pesoAnt[id] = 0;
+		e->visitado[id] = false;
+	}
+
+	e->numTocados = 0;
+	LimparFila(e->fila);
+
+	const bool* existe = e->compacta != NULL ? e->compacta->existe : e->imagem->existe;
+
+	if (numFixados != NULL)
+	{
+		*numFixados = 0;
+	}
+
+	if (origem < 0 || origem >= e->tamanho || !existe[origem] || e->bloqueado[origem])
+	{
+		return DISTANCIA_INFINITA;
+	}
+
+	TocarEspacoCaminhos(e, origem);
+	e->distancias[origem] = 0;
+	e->fila = InserirFila(e->fila, origem, 0, &inf);
+
+	ElementoFila atual;
+
+	while (RetirarMinimoFila(e->fila, &atual))
+	{
+		int u = atual.vertice;
+
+		//Entrada desatualizada, o vértice já saiu da fila com uma distância menor
+		if (e->visitado[u] || atual.distancia > e->distancias[u])
+		{
+			continue;
+		}
+
+		e->visitado[u] = true;
+		CONTAR_ESTATISTICA(verticesFixados, 1);
+
+		if (u == destino)
+		{
+			break;
+		}
+
+		//Os vértices saem da fila por ordem de distância, pelo que os primeiros fixados são os mais próximos
+		if (fixados != NULL && u != origem)
+		{
+			if (contador < maxFixados)
+			{
+				fixados[contador++] = u;
+			}
+			else if (e->distancias[u] > e->distancias[fixados[contador - 1]])
+			{
+				break;
+			}
+			else
+			{
+				//Empate com o último: fica o menor id, para o resultado não depender da ordem das adjacências
+				TrocarEmpateFixados(e, fixados, contador, u);
+				continue;
+			}
+		}
+
+		if (u == origem && numBloqueados > 0)
+		{
+			RelaxarOrigemRestrita(e, u, destinosBloqueados, numBloqueados);
+		}
+		else
+		{
+			RelaxarVertice(e, u);
+		}
+	}
+
+	//Converte as distâncias ajustadas em distâncias reais
+	if (e->potencial != NULL)
+	{
+		for (int i = 0; i < e->numTocados; i++)
+		{
+			int id = e->tocados[i];
+
+			if (e->distancias[id] != DISTANCIA_INFINITA)
+			{
+				e->distancias[id] += e->potencial[id] - e->potencial[origem];
+			}
+		}
+	}
+
+	if (numFixados != NULL)
+	{
+		*numFixados = contador;
+	}
+
+	if (destino < 0 || destino >= e->tamanho)
+	{
+		return DISTANCIA_INFINITA;
+	}
+
+	return e->distancias[destino];
+}
+
+/**
+ * @brief Algoritmo de Dijkstra com vértices e adjacências excluídos.
+ *
+ * Esta função calcula os caminhos mais curtos a partir da origem usando uma fila de prioridade e
+ * o espaço de trabalho. Os vértices marcados em e->bloqueado não são usados, e as adjacências que
+ * saem da origem para os destinos bloqueados também são ignoradas. Assim é possível calcular
+ * desvios sem copiar o grafo. Tal como no resto da biblioteca, adjacências com peso 0 não são
+ * consideradas ligações; as adjacências com peso negativo só são usadas se o espaço de trabalho
+ * tiver potenciais de Johnson.
+ *
+ * Os resultados ficam em e->distancias, e->verticeAnt e e->pesoAnt até à pesquisa seguinte.
+ *
+ * @param g Apontador para o grafo
+ * @param e Apontador para o espaço de trabalho
+ * @param origem O vértice de origem
+ * @param destino O vértice onde a pesquisa pode parar (-1 para calcular todos os vértices)
+ * @param destinosBloqueados Destinos das adjacências da origem que não podem ser usadas (pode ser NULL)
+ * @param numBloqueados Número de elementos em destinosBloqueados
+ * @return Distancia A distância da origem ao destino (DISTANCIA_INFINITA se não existir caminho ou se destino for -1)
+ */
+Distancia DijkstraRestrito(Grafo* g, EspacoCaminhos* e, int origem, int destino, int destinosBloqueados[], int numBloqueados)
+{
+	if (g == NULL || e == NULL)
+	{
+		return DISTANCIA_INFINITA;
+	}
+
+	//O espaço foi indexado para outro grafo ou para uma imagem partilhada, ou o grafo foi alterado desde a última pesquisa
+	if ((e->grafo != g || e->versao != g->versao) && !IndexarEspacoCaminhos(g, e))
+	{
+		return DISTANCIA_INFINITA;
+	}
+
+	return PesquisarEspacoCaminhos(e, origem, destino, destinosBloqueados, numBloqueados, NULL, 0, NULL);
+}
+
+/**
+ * @brief Cria um espaço de trabalho para pesquisas numa imagem partilhada.
+ *
+ * @param im Apontador para a imagem do grafo
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida
+ * @return EspacoCaminhos* Apontador para o espaço de trabalho criado
+ */
+EspacoCaminhos* CriarEspacoImagem(ImagemGrafo* im, bool* inf)
+{
+	*inf = false;
+
+	if (im == NULL)
+	{
+		return NULL;
+	}
+
+	EspacoCaminhos* e = (EspacoCaminhos*)calloc(1, sizeof(EspacoCaminhos));
+
+	if (e == NULL)
+	{
+		return NULL;
+	}
+
+	e->tamanho = -1; //Obriga a alocar os arrays
+	e->fila = CriarFilaPrioridade(16, inf);
+
+	if (e->fila == NULL || !AssociarImagemEspaco(e, im, false))
+	{
+		ApagarEspacoCaminhos(e);
+		*inf = false;
+		return NULL;
+	}
+
+	*inf = true;
+	return e;
+}
+
+/**
+ * @brief Algoritmo de Dijkstra sobre uma imagem do grafo.
+ *
+ * Esta função não lê nem altera o grafo: só lê a imagem, que é imutável, e escreve no espaço de
+ * trabalho. Várias threads podem pesquisar a mesma imagem ao mesmo tempo, desde que cada uma
+ * use o seu próprio espaço de trabalho. Se o espaço estava associado a outra imagem passa a usar
+ * esta. As adjacências com peso negativo só são usadas depois de JohnsonImagem calcular os
+ * potenciais da imagem no espaço de trabalho.
+ *
+ * @param im Apontador para a imagem do grafo
+ * @param e Apontador para o espaço de trabalho
+ * @param origem O vértice de origem
+ * @param destino O vértice onde a pesquisa pode parar (-1 para calcular todos os vértices)
+ * @return Distancia A distância da origem ao destino (DISTANCIA_INFINITA se não existir caminho ou se destino for -1)
+ */
+Distancia DijkstraImagem(ImagemGrafo* im, EspacoCaminhos* e, int origem, int destino)
+{
+	if (im == NULL || e == NULL)
+	{
+		return DISTANCIA_INFINITA;
+	}
+
+	//Associa sempre: uma imagem apagada pode ser substituída por outra no mesmo endereço
+	if (!AssociarImagemEspaco(e, im, false))
+	{
+		return DISTANCIA_INFINITA;
+	}
+
+	return PesquisarEspacoCaminhos(e, origem, destino, NULL, 0, NULL, 0, NULL);
+}
+
+/**
+ * @brief Cria um espaço de trabalho para pesquisas numa imagem comprimida.
+ *
+ * @param im Apontador para a imagem comprimida
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida
+ * @return EspacoCaminhos* Apontador para o espaço de trabalho criado
+ */
+EspacoCaminhos* CriarEspacoCompacta(ImagemCompacta* im, bool* inf)
+{
+	*inf = false;
+
+	if (im == NULL)
+	{
+		return NULL;
+	}
+
+	EspacoCaminhos* e = (EspacoCaminhos*)calloc(1, sizeof(EspacoCaminhos));
+
+	if (e == NULL)
+	{
+		return NULL;
+	}
+
+	e->tamanho = -1; //Obriga a alocar os arrays
+	e->fila = CriarFilaPrioridade(16, inf);
+
+	if (e->fila == NULL || !AssociarCompactaEspaco(e, im))
+	{
+		ApagarEspacoCaminhos(e);
+		*inf = false;
+		return NULL;
+	}
+
+	*inf = true;
+	return e;
+}
+
+/**
+ * @brief Algoritmo de Dijkstra sobre uma imagem comprimida do grafo.
+ *
+ * As adjacências de cada vértice são descodificadas durante a relaxação, sem passar para arrays.
+ * Tal como em DijkstraImagem, a imagem só é lida, pelo que várias threads podem pesquisar a mesma
+ * imagem com espaços de trabalho diferentes, e as adjacências com peso negativo só são usadas
+ * depois de JohnsonCompacta calcular os potenciais da imagem no espaço de trabalho.
+ *
+ * @param im Apontador para a imagem comprimida
+ * @param e Apontador para o espaço de trabalho
+ * @param origem O vértice de origem
+ * @param destino O vértice onde a pesquisa pode parar (-1 para calcular todos os vértices)
+ * @return Distancia A distância da origem ao destino (DISTANCIA_INFINITA se não existir caminho ou se destino for -1)
+ */
+Distancia DijkstraCompacta(ImagemCompacta* im, EspacoCaminhos* e, int origem, int destino)
+{
+	if (im == NULL || e == NULL)
+	{
+		return DISTANCIA_INFINITA;
+	}
+
+	if (!AssociarCompactaEspaco(e, im))
+	{
+		return DISTANCIA_INFINITA;
+	}
+
+	return PesquisarEspacoCaminhos(e, origem, destino, NULL, 0, NULL, 0, NULL);
+}
+
+/**
+ * @brief Calcula os k vértices mais próximos de uma origem.
+ *
+ * A pesquisa de Dijkstra para assim que k vértices (além da origem) tiverem a distância final,
+ * pelo que o custo depende de k e não do tamanho do grafo. Os vértices ficam por ordem crescente
+ * de distância e, com a mesma distância, por id; nos empates com o k-ésimo ficam os menores ids,
+ * qualquer que seja a ordem das adjacências. As distâncias ficam em e->distancias até à pesquisa
+ * seguinte. Os vértices bloqueados em e->bloqueado não são usados.
+ *
+ * @param e Apontador para o espaço de trabalho, já associado a uma imagem (CriarEspacoImagem, CriarEspacoCompacta ou uma pesquisa anterior)
+ * @param origem O vértice de origem
+ * @param k Número máximo de vértices a devolver
+ * @param vizinhos Array com espaço para k vértices
+ * @return int Número de vértices escritos em vizinhos (menor que k se não houver mais vértices alcançáveis), ou -1 em caso de erro
+ */
+int VerticesMaisProximos(EspacoCaminhos* e, int origem, int k, int vizinhos[])
+{
+	//Com potenciais de Johnson a ordem de saída da fila não é a ordem das distâncias reais
+	if (e == NULL || vizinhos == NULL || k < 0 || e->potencial != NULL || (e->imagem == NULL && e->compacta == NULL))
+	{
+		return -1;
+	}
+
+	if (k == 0)
+	{
+		return 0;
+	}
+
+	int encontrados = 0;
+	PesquisarEspacoCaminhos(e, origem, -1, NULL, 0, vizinhos, k, &encontrados);
+
+	//Os vértices já estão por distância; os empatados ficam por id
+	for (int i = 1; i < encontrados; i++)
+	{
+		int v = vizinhos[i];
+		int j = i - 1;
+
+		while (j >= 0 && e->distancias[vizinhos[j]] == e->distancias[v] && vizinhos[j] > v)
+		{
+			vizinhos[j + 1] = vizinhos[j];
+			j--;
+		}
+
+		vizinhos[j + 1] = v;
+	}
+
+	return encontrados;
+}
+
+/**
+ * @brief Estado partilhado por DistanciasVariasOrigens com os trabalhadores do executor.
+ *
+ */
+typedef struct PedidoVariasOrigens
+{
+	ImagemGrafo* im;			///< Imagem pesquisada.
+	int* origens;				///< Origens (NULL para os ids 0 a numOrigens - 1).
+	Distancia* distancias;		///< Linhas de distâncias, uma por origem.
+	EspacoCaminhos** espacos;	///< Espaço de trabalho de cada trabalhador (o do trabalhador 0 tem os potenciais; os outros são criados no primeiro uso).
+	atomic_bool falhou;			///< Indica que faltou memória para um espaço de trabalho.
+
+} PedidoVariasOrigens;
+
+/**
+ * @brief Calcula as linhas de distâncias de um intervalo de origens.
+ *
+ * @param contexto Apontador para o pedido.
+ * @param inicio Primeira origem do intervalo.
+ * @param fim Origem a seguir à última.
+ * @param trabalhador Número do trabalhador.
+ */
+static void CalcularLinhasDistancias(void* contexto, int inicio, int fim, int trabalhador)
+{
+	PedidoVariasOrigens* p = (PedidoVariasOrigens*)contexto;
+	EspacoCaminhos* e = p->espacos[trabalhador];
+	int tamanho = p->im->tamanho;
+	bool inf;
+
+	if (e == NULL)
+	{
+		e = p->espacos[trabalhador] = CriarEspacoImagem(p->im, &inf);
+
+		//Os potenciais de Johnson, se existirem, são os do espaço do trabalhador 0
+		if (e == NULL || !CopiarPotenciaisEspaco(e, p->espacos[0]))
+		{
+			atomic_store(&p->falhou, true);
+			return;
+		}
+	}
+
+	for (int i = inicio; i < fim; i++)
+	{
+		DijkstraImagem(p->im, e, p->origens != NULL ? p->origens[i] : i, -1);
+		memcpy(p->distancias + (size_t)i * tamanho, e->distancias, sizeof(Distancia) * tamanho);
+	}
+}
+
+/**
+ * @brief Calcula as distâncias de várias origens a todos os vértices de uma imagem, em paralelo.
+ *
+ * Cada trabalhador cria o seu espaço de trabalho na primeira origem que recebe e reutiliza-o nas
+ * seguintes, pelo que os arrays da pesquisa só são alocados uma vez por trabalhador. Com pesos
+ * negativos, os potenciais de Johnson são calculados uma vez, no espaço do trabalhador 0, e
+ * copiados para os espaços dos outros.
+ *
+ * @param im Apontador para a imagem do grafo
+ * @param ex Apontador para o executor (NULL para calcular tudo na thread que chama)
+ * @param origens Array com as origens (NULL para usar os ids 0 a numOrigens - 1)
+ * @param numOrigens Número de origens
+ * @param distancias Array com espaço para numOrigens * im->tamanho distâncias
+ * @return true se as distâncias foram calculadas, false se faltou memória ou a imagem tem um ciclo negativo
+ */
+bool DistanciasVariasOrigens(ImagemGrafo* im, ExecutorParalelo* ex, int origens[], int numOrigens, Distancia distancias[])
+{
+	if (im == NULL || distancias == NULL || numOrigens < 0)
+	{
+		return false;
+	}
+
+	int numTrabalhadores = NumeroTrabalhadores(ex);
+	PedidoVariasOrigens p;
+	p.im = im;
+	p.origens = origens;
+	p.distancias = distancias;
+	p.espacos = (EspacoCaminhos**)calloc(numTrabalhadores, sizeof(EspacoCaminhos*));
+	atomic_init(&p.falhou, false);
+
+	if (p.espacos == NULL)
+	{
+		return false;
+	}
+
+	bool inf, ciclo;
+	p.espacos[0] = CriarEspacoImagem(im, &inf);
+
+	if (p.espacos[0] == NULL || !JohnsonImagem(im, p.espacos[0], &ciclo))
+	{
+		ApagarEspacoCaminhos(p.espacos[0]);
+		free(p.espacos);
+		return false;
+	}
+
+	//Uma pesquisa completa por origem: um grão de uma origem já equilibra bem a carga
+	ParaleloPara(ex, 0, numOrigens, 1, CalcularLinhasDistancias, &p);
+
+	for (int w = 0; w < numTrabalhadores; w++)
+	{
+		ApagarEspacoCaminhos(p.espacos[w]);
+	}
+
+	free(p.espacos);
+	return !atomic_load(&p.falhou);
+}
+
+/**
+ * @brief Conta os vértices do caminho até um destino.
+ *
+ * Esta função percorre os antecessores a partir do destino e devolve o número de vértices do
+ * caminho, que é o tamanho do buffer necessário para CopiarCaminho.
+ *
+ * @param verticeAnt Array com os antecessores de cada vértice
+ * @param tamanho Número de elementos de verticeAnt
+ * @param destino Vértice de destino
+ * @return int Número de vértices do caminho, ou -1 se o destino for inválido ou os antecessores tiverem um ciclo
+ */
+int TamanhoCaminho(int verticeAnt[], int tamanho, int destino)
+{
+	if (verticeAnt == NULL || destino < 0 || destino >= tamanho)
+	{
+		return -1;
+	}
+
+	int contador = 0;
+
+	//Um caminho válido nunca tem mais vértices que o array
+	for (int atual = destino; atual != -1; atual = verticeAnt[atual])
+	{
+		if (atual < 0 || atual >= tamanho || contador == tamanho)
+		{
+			return -1;
+		}
+
+		contador++;
+	}
+
+	return contador;
+}
+
+/**
+ * @brief Copia o caminho até um destino para um buffer do chamador.
+ *
+ * Esta função escreve os vértices do caminho, da origem ao destino, no buffer. Se o buffer não
+ * tiver espaço suficiente nada é escrito e é devolvido o tamanho necessário, como em snprintf.
+ *
+ * @param verticeAnt Array com os antecessores de cada vértice
+ * @param tamanho Número de elementos de verticeAnt
+ * @param destino Vértice de destino
+ * @param buffer Array onde os vértices são escritos (pode ser NULL se capacidade for 0)
+ * @param capacidade Número de elementos do buffer
+ * @return int Número de vértices do caminho, ou -1 se o caminho for inválido
+ */
+int CopiarCaminho(int verticeAnt[], int tamanho, int destino, int buffer[], int capacidade)
+{
+	int numVertices = TamanhoCaminho(verticeAnt, tamanho, destino);
+
+	if (numVertices < 0 || numVertices > capacidade || buffer == NULL)
+	{
+		return numVertices;
+	}
+
+	//Preenche do fim para o início para não ter de inverter
+	int i = numVertices - 1;
+
+	for (int atual = destino; atual != -1; atual = verticeAnt[atual])
+	{
+		buffer[i--] = atual;
+	}
+
+	return numVertices;
+}
+
+/**
+ * @brief Reconstrói o caminho até um destino a partir de uma árvore de caminhos.
+ *
+ * Esta função aloca um caminho com o tamanho exato. Numa árvore de caminhos mais curtos o peso
+ * de cada adjacência é a diferença entre as distâncias dos seus vértices, por isso os pesos podem
+ * ser obtidos sem voltar a percorrer o grafo.
+ *
+ * @param a Apontador para a árvore de caminhos
+ * @param destino Vértice de destino
+ * @param comPesos Indica se o array de pesos deve ser preenchido
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida
+ * @return Caminho* Apontador para o caminho, ou NULL se o destino não for alcançável ou não houver memória
+ */
+Caminho* ReconstruirCaminho(ArvoreCaminhos* a, int destino, bool comPesos, bool* inf)
+{
+	*inf = false;
+
+	if (a == NULL || destino < 0 || destino >= a->tamanho || a->distancias[destino] == DISTANCIA_INFINITA)
+	{
+		return NULL;
+	}
+
+	int numVertices = TamanhoCaminho(a->verticeAnt, a->tamanho, destino);
+
+	if (numVertices < 1)
+	{
+		return NULL;
+	}
+
+	Caminho* c = (Caminho*)malloc(sizeof(Caminho));
+
+	if (c == NULL)
+	{
+		return NULL;
+	}
+
+	c->numVertices = numVertices;
+	c->custo = a->distancias[destino];
+	c->vertices = (int*)malloc(sizeof(int) * numVertices);
+	c->pesos = NULL;
+
+	if (comPesos)
+	{
+		c->pesos = (PesoAresta*)malloc(sizeof(PesoAresta) * numVertices);
+	}
+
+	if (c->vertices == NULL || (comPesos && c->pesos == NULL))
+	{
+		ApagarCaminho(c);
+		return NULL;
+	}
+
+	CopiarCaminho(a->verticeAnt, a->tamanho, destino, c->vertices, numVertices);
+
+	if (comPesos)
+	{
+		for (int i = 0; i < numVertices - 1; i++)
+		{
+			c->pesos[i] = a->distancias[c->vertices[i + 1]] - a->distancias[c->vertices[i]];
+		}
+
+		c->pesos[numVertices - 1] = 0;
+	}
+
+	*inf = true;
+	return c;
+}
+
+/**
+ * @brief Calcula o caminho mais curto entre dois vértices.
+ *
+ * Esta função obtém a árvore de caminhos da origem (usando a cache do grafo) e reconstrói o
+ * caminho até ao destino.
+ *
+ * @param g Apontador para o grafo
+ * @param origem Vértice de origem
+ * @param destino Vértice de destino
+ * @param comPesos Indica se o array de pesos deve ser preenchido
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida
+ * @return Caminho* Apontador para o caminho, ou NULL se não existir caminho
+ */
+Caminho* ObterCaminho(Grafo* g, int origem, int destino, bool comPesos, bool* inf)
+{
+	*inf = false;
+
+	ArvoreCaminhos* a = ObterArvoreCaminhos(g, origem);
+
+	if (a == NULL)
+	{
+		return NULL;
+	}
+
+	Caminho* c = ReconstruirCaminho(a, destino, comPesos, inf);
+
+	LibertarArvoreCaminhos(a);
+	return c;
+}
+
+/**
+ * @brief Liberta a memória alocada para um caminho.
+ *
+ * @param c Apontador para o caminho a eliminar
+ */
+void ApagarCaminho(Caminho* c)
+{
+	if (c == NULL)
+	{
+		return;
+	}
+
+	free(c->vertices);
+	free(c->pesos);
+	free(c);
+}
@@ -0,0 +1,422 @@
+/**
+ * @file centralidade.c
+ * @author Hugo Cruz (a23010)
+ * @brief Implementação das medidas de centralidade dos vértices de um grafo.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include <math.h>
+#include "centralidade.h"
+#include "bellmanford.h"
+
+/**
+ * @def ESPACAMENTO_PARCIAIS
+ * @brief Distância, em doubles, entre as somas parciais de dois trabalhadores.
+ *
+ * Cada soma fica numa linha de cache própria, para que os trabalhadores não escrevam na mesma linha.
+ */
+#define ESPACAMENTO_PARCIAIS 8
+
+/**
+ * @brief Estado de uma iteração do PageRank, partilhado pelos trabalhadores.
+ *
+ */
+typedef struct PassoPageRank
+{
+	const ImagemGrafo* im;		 ///< Imagem do grafo.
+	const ImagemGrafo* inversa;	 ///< Imagem inversa, de onde são lidas as ligações que chegam a cada vértice.
+	double* pontuacao;			 ///< Pontuação de cada vértice.
+	double* contribuicao;		 ///< Parte da pontuação de cada vértice enviada por cada ligação que sai dele.
+	double* inversoGrau;		 ///< 1 / número de ligações que saem de cada vértice (0 sem ligações).
+	double amortecimento;		 ///< Probabilidade de seguir uma ligação.
+	double base;				 ///< Pontuação que cada vértice recebe sem ligações que cheguem a ele.
+	double* parciais;			 ///< Soma parcial de cada trabalhador.
+
+} PassoPageRank;
+
+/**
+ * @brief Calcula as contribuições de um intervalo de vértices e soma a pontuação dos que não têm ligações.
+ *
+ * @param contexto Apontador para o passo.
+ * @param inicio Primeiro vértice.
+ * @param fim Vértice a seguir ao último.
+ * @param trabalhador Número do trabalhador.
+ */
+static void CalcularContribuicoes(void* contexto, int inicio, int fim, int trabalhador)
+{
+	PassoPageRank* p = (PassoPageRank*)contexto;
+	const double* restrict pontuacao = p->pontuacao;
+	const double* restrict inversoGrau = p->inversoGrau;
+	double* restrict contribuicao = p->contribuicao;
+	double soltos = 0;
+
+	//Sem dependências entre posições, o compilador pode vetorizar o ciclo
+	for (int v = inicio; v < fim; v++)
+	{
+		contribuicao[v] = pontuacao[v] * inversoGrau[v];
+		soltos += inversoGrau[v] == 0 ? pontuacao[v] : 0;
+	}
+
+	p->parciais[trabalhador * ESPACAMENTO_PARCIAIS] += soltos;
+}
+
+/**
+ * @brief Calcula a nova pontuação de um intervalo de vértices a partir das ligações que chegam a eles.
+ *
+ * A soma das contribuições usa quatro acumuladores independentes, para que as leituras dispersas
+ * de contribuicao não esperem umas pelas outras.
+ *
+ * @param contexto Apontador para o passo.
+ * @param inicio Primeiro vértice.
+ * @param fim Vértice a seguir ao último.
+ * @param trabalhador Número do trabalhador.
+ */
+static void PuxarPontuacoes(void* contexto, int inicio, int fim, int trabalhador)
+{
+	PassoPageRank* p = (PassoPageRank*)contexto;
+	const int* restrict inicioInversa = p->inversa->inicio;
+	const int* restrict origens = p->inversa->destinos;
+	const double* restrict contribuicao = p->contribuicao;
+	const bool* existe = p->im->existe;
+	double* restrict pontuacao = p->pontuacao;
+	double variacao = 0;
+
+	for (int v = inicio; v < fim; v++)
+	{
+		if (!existe[v])
+		{
+			continue;
+		}
+
+		int k = inicioInversa[v];
+		int fimLigacoes = inicioInversa[v + 1];
+		double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+
+		for (; k + 4 <= fimLigacoes; k += 4)
+		{
+			s0 += contribuicao[origens[k]];
+			s1 += contribuicao[origens[k + 1]];
+			s2 += contribuicao[origens[k + 2]];
+			s3 += contribuicao[origens[k + 3]];
+		}
+
+		for (; k < fimLigacoes; k++)
+		{
+			s0 += contribuicao[origens[k]];
+		}
+
+		double nova = p->base + p->amortecimento * ((s0 + s1) + (s2 + s3));
+		variacao += fabs(nova - pontuacao[v]);
+		pontuacao[v] = nova;
+	}
+
+	p->parciais[trabalhador * ESPACAMENTO_PARCIAIS] += variacao;
+}
+
+/**
+ * @brief Soma as parciais dos trabalhadores e volta a pô-las a zero.
+ *
+ * @param parciais Somas parciais.
+ * @param numTrabalhadores Número de trabalhadores.
+ * @return double Soma total.
+ */
+static double JuntarParciais(double parciais[], int numTrabalhadores)
+{
+	double total = 0;
+
+	for (int w = 0; w < numTrabalhadores; w++)
+	{
+		total += parciais[w * ESPACAMENTO_PARCIAIS];
+		parciais[w * ESPACAMENTO_PARCIAIS] = 0;
+	}
+
+	return total;
+}
+
+/**
+ * @brief Calcula o PageRank dos vértices de uma imagem, com as iterações repartidas pelos trabalhadores de um executor.
+ *
+ * Cada iteração tem dois passos paralelos: o primeiro divide a pontuação de cada vértice pelo
+ * número de ligações que saem dele e o segundo soma, para cada vértice, as contribuições das
+ * ligações que chegam a ele. As contribuições ficam num array à parte, pelo que o segundo passo
+ * lê sempre as pontuações da iteração anterior; o número de trabalhadores só muda os
+ * arredondamentos das somas parciais.
+ *
+ * @param im Apontador para a imagem do grafo.
+ * @param inversa Apontador para a imagem inversa de im (NULL para ser criada e apagada pela função).
+ * @param ex Apontador para o executor (NULL para calcular só na thread que chama).
+ * @param amortecimento Probabilidade de seguir uma ligação (normalmente AMORTECIMENTO_PAGERANK).
+ * @param tolerancia Soma das variações das pontuações numa iteração abaixo da qual as iterações param.
+ * @param maxIteracoes Número máximo de iterações.
+ * @param pontuacao Array com espaço para im->tamanho pontuações (0 nos ids sem vértice).
+ * @return int Número de iterações feitas (-1 se faltou memória ou os argumentos são inválidos).
+ */
+int PageRank(ImagemGrafo* im, ImagemGrafo* inversa, ExecutorParalelo* ex, double amortecimento, double tolerancia,
+	int maxIteracoes, double pontuacao[])
+{
+	if (im == NULL || pontuacao == NULL || (inversa != NULL && inversa->tamanho != im->tamanho) ||
+		amortecimento < 0 || amortecimento > 1 || maxIteracoes < 0)
+	{
+		return -1;
+	}
+
+	int n = im->tamanho > 0 ? im->tamanho : 1;
+	int numTrabalhadores = NumeroTrabalhadores(ex);
+	ImagemGrafo* inversaPropria = NULL;
+	bool inf;
+
+	if (inversa == NULL)
+	{
+		inversa = inversaPropria = InverterImagemGrafo(im, &inf);
+	}
+
+	PassoPageRank p;
+	p.im = im;
+	p.inversa = inversa;
+	p.pontuacao = pontuacao;
+	p.contribuicao = (double*)malloc(sizeof(double) * n);
+	p.inversoGrau = (double*)malloc(sizeof(double) * n);
+	p.amortecimento = amortecimento;
+	p.parciais = (double*)calloc((size_t)numTrabalhadores * ESPACAMENTO_PARCIAIS, sizeof(double));
+
+	int iteracoes = -1;
+
+	if (inversa != NULL && p.contribuicao != NULL && p.inversoGrau != NULL && p.parciais != NULL)
+	{
+		double numVertices = im->numVertices > 0 ? im->numVertices : 1;
+
+		for (int v = 0; v < im->tamanho; v++)
+		{
+			int grau = im->inicio[v + 1] - im->inicio[v];
+			p.inversoGrau[v] = grau > 0 ? 1.0 / grau : 0;
+			pontuacao[v] = im->existe[v] ? 1.0 / numVertices : 0;
+		}
+
+		iteracoes = 0;
+
+		while (iteracoes < maxIteracoes)
+		{
+			ParaleloPara(ex, 0, im->tamanho, 0, CalcularContribuicoes, &p);
+			double soltos = JuntarParciais(p.parciais, numTrabalhadores);
+			p.base = (1 - amortecimento + amortecimento * soltos) / numVertices;
+
+			ParaleloPara(ex, 0, im->tamanho, 0, PuxarPontuacoes, &p);
+			iteracoes++;
+
+			if (JuntarParciais(p.parciais, numTrabalhadores) < tolerancia)
+			{
+				break;
+			}
+		}
+	}
+
+	free(p.contribuicao);
+	free(p.inversoGrau);
+	free(p.parciais);
+	ApagarImagemGrafo(inversaPropria);
+
+	return iteracoes;
+}
+
+/**
+ * @brief Dados partilhados pelo cálculo da centralidade de grau.
+ *
+ */
+typedef struct PedidoGrau
+{
+	const ImagemGrafo* im;		 ///< Imagem do grafo.
+	const ImagemGrafo* inversa;	 ///< Imagem inversa (NULL se entrada for NULL).
+	double* saida;				 ///< Valores com as ligações que saem (pode ser NULL).
+	double* entrada;			 ///< Valores com as ligações que chegam (pode ser NULL).
+	double escala;				 ///< 1 / número de outros vértices.
+
+} PedidoGrau;
+
+/**
+ * @brief Calcula a centralidade de grau de um intervalo de vértices.
+ *
+ * @param contexto Apontador para o pedido.
+ * @param inicio Primeiro vértice.
+ * @param fim Vértice a seguir ao último.
+ * @param trabalhador Número do trabalhador (não usado).
+ */
+static void CalcularGraus(void* contexto, int inicio, int fim, int trabalhador)
+{
+	PedidoGrau* p = (PedidoGrau*)contexto;
+
+	for (int v = inicio; v < fim; v++)
+	{
+		if (p->saida != NULL)
+		{
+			p->saida[v] = (p->im->inicio[v + 1] - p->im->inicio[v]) * p->escala;
+		}
+
+		if (p->entrada != NULL)
+		{
+			p->entrada[v] = (p->inversa->inicio[v + 1] - p->inversa->inicio[v]) * p->escala;
+		}
+	}
+}
+
+/**
+ * @brief Calcula a centralidade de grau dos vértices de uma imagem.
+ *
+ * @param im Apontador para a imagem do grafo.
+ * @param inversa Apontador para a imagem inversa de im (NULL para ser criada e apagada pela função, se entrada não for NULL).
+ * @param ex Apontador para o executor (NULL para calcular só na thread que chama).
+ * @param saida Array com espaço para im->tamanho valores, calculados com as ligações que saem (pode ser NULL).
+ * @param entrada Array com espaço para im->tamanho valores, calculados com as ligações que chegam (pode ser NULL).
+ * @return true se os valores foram calculados, false se faltou memória.
+ */
+bool CentralidadeGrau(ImagemGrafo* im, ImagemGrafo* inversa, ExecutorParalelo* ex, double saida[], double entrada[])
+{
+	if (im == NULL || (inversa != NULL && inversa->tamanho != im->tamanho))
+	{
+		return false;
+	}
+
+	ImagemGrafo* inversaPropria = NULL;
+	bool inf;
+
+	if (entrada != NULL && inversa == NULL)
+	{
+		inversa = inversaPropria = InverterImagemGrafo(im, &inf);
+
+		if (inversa == NULL)
+		{
+			return false;
+		}
+	}
+
+	PedidoGrau p = { im, inversa, saida, entrada, im->numVertices > 1 ? 1.0 / (im->numVertices - 1) : 0 };
+	ParaleloPara(ex, 0, im->tamanho, 0, CalcularGraus, &p);
+	ApagarImagemGrafo(inversaPropria);
+
+	return true;
+}
+
+/**
+ * @brief Estado partilhado por CentralidadeProximidade com os trabalhadores do executor.
+ *
+ */
+typedef struct PedidoProximidade
+{
+	ImagemGrafo* im;			///< Imagem pesquisada.
+	int* origens;				///< Origens (NULL para os ids 0 a numOrigens - 1).
+	double* proximidade;		///< Valor de cada origem.
+	EspacoCaminhos** espacos;	///< Espaço de trabalho de cada trabalhador (o do trabalhador 0 tem os potenciais; os outros são criados no primeiro uso).
+	atomic_bool falhou;			///< Indica que faltou memória para um espaço de trabalho.
+
+} PedidoProximidade;
+
+/**
+ * @brief Calcula a centralidade de proximidade de um intervalo de origens.
+ *
+ * Depois de uma pesquisa completa os vértices alterados são exatamente os alcançados, pelo que a
+ * soma das distâncias só percorre esses vértices. Uma soma que não seja positiva, só possível com
+ * pesos negativos, dá NAN.
+ *
+ * @param contexto Apontador para o pedido.
+ * @param inicio Primeira origem do intervalo.
+ * @param fim Origem a seguir à última.
+ * @param trabalhador Número do trabalhador.
+ */
+static void CalcularProximidades(void* contexto, int inicio, int fim, int trabalhador)
+{
+	PedidoProximidade* p = (PedidoProximidade*)contexto;
+	EspacoCaminhos* e = p->espacos[trabalhador];
+	double outros = p->im->numVertices - 1;
+	bool inf;
+
+	if (e == NULL)
+	{
+		e = p->espacos[trabalhador] = CriarEspacoImagem(p->im, &inf);
+
+		//Os potenciais de Johnson, se existirem, são os do espaço do trabalhador 0
+		if (e == NULL || !CopiarPotenciaisEspaco(e, p->espacos[0]))
+		{
+			atomic_store(&p->falhou, true);
+			return;
+		}
+	}
+
+	for (int i = inicio; i < fim; i++)
+	{
+		DijkstraImagem(p->im, e, p->origens != NULL ? p->origens[i] : i, -1);
+		double total = 0;
+
+		for (int k = 0; k < e->numTocados; k++)
+		{
+			total += (double)e->distancias[e->tocados[k]];
+		}
+
+		double alcancados = e->numTocados - 1;
+
+		if (alcancados <= 0)
+		{
+			p->proximidade[i] = 0;
+		}
+		else
+		{
+			p->proximidade[i] = total > 0 ? (alcancados / outros) * (alcancados / total) : NAN;
+		}
+	}
+}
+
+/**
+ * @brief Calcula a centralidade de proximidade de várias origens numa imagem, em paralelo.
+ *
+ * Tal como em DistanciasVariasOrigens, cada trabalhador cria o seu espaço de trabalho na primeira
+ * origem que recebe e reutiliza-o nas seguintes, e os potenciais de Johnson são calculados uma vez
+ * e copiados para todos os espaços.
+ *
+ * @param im Apontador para a imagem do grafo.
+ * @param ex Apontador para o executor (NULL para calcular tudo na thread que chama).
+ * @param origens Array com as origens (NULL para usar os ids 0 a numOrigens - 1).
+ * @param numOrigens Número de origens.
+ * @param proximidade Array com espaço para numOrigens valores, pela ordem das origens.
+ * @return true se os valores foram calculados, false se faltou memória ou a imagem tem um ciclo negativo.
+ */
+bool CentralidadeProximidade(ImagemGrafo* im, ExecutorParalelo* ex, int origens[], int numOrigens, double proximidade[])
+{
+	if (im == NULL || proximidade == NULL || numOrigens < 0)
+	{
+		return false;
+	}
+
+	int numTrabalhadores = NumeroTrabalhadores(ex);
+	PedidoProximidade p;
+	p.im = im;
+	p.origens = origens;
+	p.proximidade = proximidade;
+	p.espacos = (EspacoCaminhos**)calloc(numTrabalhadores, sizeof(EspacoCaminhos*));
+	atomic_init(&p.falhou, false);
+
+	if (p.espacos == NULL)
+	{
+		return false;
+	}
+
+	bool inf, ciclo;
+	p.espacos[0] = CriarEspacoImagem(im, &inf);
+
+	if (p.espacos[0] == NULL || !JohnsonImagem(im, p.espacos[0], &ciclo))
+	{
+		ApagarEspacoCaminhos(p.espacos[0]);
+		free(p.espacos);
+		return false;
+	}
+
+	ParaleloPara(ex, 0, numOrigens, 1, CalcularProximidades, &p);
+
+	for (int w = 0; w < numTrabalhadores; w++)
+	{
+		ApagarEspacoCaminhos(p.espacos[w]);
+	}
+
+	free(p.espacos);
+	return !atomic_load(&p.falhou);
+}
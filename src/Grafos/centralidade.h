@@ -0,0 +1,90 @@
+/**
+ * @file centralidade.h
+ * @author Hugo Cruz (a23010)
+ * @brief Ficheiro de cabeçalho das medidas de centralidade dos vértices de um grafo.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef CENTRALIDADE_H
+#define CENTRALIDADE_H
+
+#include "caminhos.h"
+
+/**
+ * @def AMORTECIMENTO_PAGERANK
+ * @brief Probabilidade de seguir uma ligação em vez de saltar para um vértice qualquer.
+ */
+#define AMORTECIMENTO_PAGERANK 0.85
+
+/**
+ * @def TOLERANCIA_PAGERANK
+ * @brief Soma das variações das pontuações abaixo da qual o PageRank é dado como convergido.
+ */
+#define TOLERANCIA_PAGERANK 1e-6
+
+/**
+ * @def MAX_ITERACOES_PAGERANK
+ * @brief Número máximo de iterações do PageRank.
+ */
+#define MAX_ITERACOES_PAGERANK 100
+
+/**
+ * @brief Calcula o PageRank dos vértices de uma imagem, com as iterações repartidas pelos trabalhadores de um executor.
+ *
+ * Os pesos não contam: cada vértice reparte a sua pontuação em partes iguais pelas ligações que
+ * saem dele, e a pontuação dos vértices sem ligações é repartida por todos os vértices. Cada
+ * iteração calcula a nova pontuação de cada vértice a partir das ligações que chegam a ele, lidas
+ * da imagem inversa, pelo que cada vértice só é escrito por um trabalhador. As pontuações somam 1.
+ *
+ * @param im Apontador para a imagem do grafo.
+ * @param inversa Apontador para a imagem inversa de im (NULL para ser criada e apagada pela função).
+ * @param ex Apontador para o executor (NULL para calcular só na thread que chama).
+ * @param amortecimento Probabilidade de seguir uma ligação (normalmente AMORTECIMENTO_PAGERANK).
+ * @param tolerancia Soma das variações das pontuações numa iteração abaixo da qual as iterações param.
+ * @param maxIteracoes Número máximo de iterações.
+ * @param pontuacao Array com espaço para im->tamanho pontuações (0 nos ids sem vértice).
+ * @return int Número de iterações feitas (-1 se faltou memória ou os argumentos são inválidos).
+ */
+int PageRank(ImagemGrafo *im, ImagemGrafo *inversa, ExecutorParalelo *ex, double amortecimento, double tolerancia,
+	int maxIteracoes, double pontuacao[]);
+
+/**
+ * @brief Calcula a centralidade de grau dos vértices de uma imagem.
+ *
+ * A centralidade de grau de um vértice é o seu número de ligações a dividir pelo número de outros
+ * vértices do grafo.
+ *
+ * @param im Apontador para a imagem do grafo.
+ * @param inversa Apontador para a imagem inversa de im (NULL para ser criada e apagada pela função, se entrada não for NULL).
+ * @param ex Apontador para o executor (NULL para calcular só na thread que chama).
+ * @param saida Array com espaço para im->tamanho valores, calculados com as ligações que saem (pode ser NULL).
+ * @param entrada Array com espaço para im->tamanho valores, calculados com as ligações que chegam (pode ser NULL).
+ * @return true se os valores foram calculados, false se faltou memória.
+ */
+bool CentralidadeGrau(ImagemGrafo *im, ImagemGrafo *inversa, ExecutorParalelo *ex, double saida[], double entrada[]);
+
+/**
+ * @brief Calcula a centralidade de proximidade de várias origens numa imagem, em paralelo.
+ *
+ * Para uma origem que alcança r vértices (incluindo ela própria) de um grafo com n vértices, a
+ * uma distância total D, o valor é ((r - 1) / (n - 1)) * ((r - 1) / D), a fórmula de Wasserman e
+ * Faust, que num grafo fortemente conexo é o inverso da distância média e continua a comparar
+ * bem vértices de grafos sem essa propriedade. Uma origem que não alcança nenhum vértice tem 0.
+ * Com pesos negativos as distâncias são calculadas com os potenciais de Johnson e D pode ser 0 ou
+ * negativa; a fórmula deixa de medir a proximidade e o valor dessa origem é NAN. Um ciclo
+ * negativo torna as distâncias indefinidas e nenhum valor é calculado.
+ *
+ * @param im Apontador para a imagem do grafo.
+ * @param ex Apontador para o executor (NULL para calcular tudo na thread que chama).
+ * @param origens Array com as origens (NULL para usar os ids 0 a numOrigens - 1).
+ * @param numOrigens Número de origens.
+ * @param proximidade Array com espaço para numOrigens valores, pela ordem das origens.
+ * @return true se os valores foram calculados, false se faltou memória ou a imagem tem um ciclo negativo.
+ */
+bool CentralidadeProximidade(ImagemGrafo *im, ExecutorParalelo *ex, int origens[], int numOrigens, double proximidade[]);
+
+#endif
@@ -0,0 +1,737 @@
+/**
+ * @file compacto.c
+ * @author Hugo Cruz (a23010)
+ * @brief Implementação das imagens de um grafo com as adjacências comprimidas.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include <stdio.h>
+#include "compacto.h"
+
+ /**
+  * @brief Adjacência de um vértice antes de ser comprimida.
+  *
+  */
+typedef struct ParCompacto
+{
+	int destino;	 ///< Destino da adjacência.
+	PesoAresta peso; ///< Peso da adjacência.
+
+} ParCompacto;
+
+/**
+ * @brief Buffer de bytes que cresce à medida que os blocos são escritos.
+ *
+ */
+typedef struct Codificador
+{
+	unsigned char* dados; ///< Bytes escritos.
+	long long tamanho;	  ///< Número de bytes escritos.
+	long long capacidade; ///< Número de bytes alocados.
+
+} Codificador;
+
+/**
+ * @brief Compara duas adjacências pelo destino e depois pelo peso, para qsort.
+ *
+ * @param a Apontador para a primeira adjacência.
+ * @param b Apontador para a segunda adjacência.
+ * @return int Negativo, zero ou positivo, como em qsort.
+ */
+static int CompararPares(const void* a, const void* b)
+{
+	const ParCompacto* x = (const ParCompacto*)a;
+	const ParCompacto* y = (const ParCompacto*)b;
+
+	if (x->destino != y->destino)
+	{
+		return (x->destino > y->destino) - (x->destino < y->destino);
+	}
+
+	return (x->peso > y->peso) - (x->peso < y->peso);
+}
+
+/**
+ * @brief Converte um inteiro com sinal em zigzag (0, -1, 1, -2, ... passam a 0, 1, 2, 3, ...).
+ *
+ * @param valor Inteiro a converter.
+ * @return unsigned int Número em zigzag.
+ */
+static unsigned int FazerZigzag(int valor)
+{
+	return ((unsigned int)valor << 1) ^ (unsigned int)(valor >> 31);
+}
+
+/**
+ * @brief Escreve um número em varint no fim do buffer.
+ *
+ * @param c Apontador para o codificador (tem de ter pelo menos 5 bytes livres).
+ * @param valor Número a escrever.
+ */
+static void EscreverVarint(Codificador* c, unsigned int valor)
+{
+	while (valor >= 0x80)
+	{
+		c->dados[c->tamanho++] = (unsigned char)(valor | 0x80);
+		valor >>= 7;
+	}
+
+	c->dados[c->tamanho++] = (unsigned char)valor;
+}
+
+/**
+ * @brief Comprime as adjacências de um vértice no fim do buffer.
+ *
+ * @param c Apontador para o codificador.
+ * @param u Vértice de origem.
+ * @param pares Adjacências do vértice (são ordenadas pela função).
+ * @param n Número de adjacências.
+ * @return true se o buffer tinha ou conseguiu espaço para o bloco.
+ */
+static bool CodificarVertice(Codificador* c, int u, ParCompacto pares[], int n)
+{
+	//Cada número ocupa no máximo 5 bytes: o grau e dois números por adjacência
+	long long necessario = c->tamanho + 5 + 10LL * n;
+
+	if (necessario > c->capacidade)
+	{
+		long long capacidade = c->capacidade * 2 > necessario ? c->capacidade * 2 : necessario;
+		unsigned char* dados = (unsigned char*)realloc(c->dados, (size_t)capacidade);
+
+		if (dados == NULL)
+		{
+			return false;
+		}
+
+		c->dados = dados;
+		c->capacidade = capacidade;
+	}
+
+	qsort(pares, n, sizeof(ParCompacto), CompararPares);
+
+	EscreverVarint(c, (unsigned int)n);
+
+	int anterior = u;
+
+	for (int i = 0; i < n; i++)
+	{
+		if (i == 0)
+		{
+			EscreverVarint(c, FazerZigzag(pares[i].destino - u));
+		}
+		else
+		{
+			EscreverVarint(c, (unsigned int)(pares[i].destino - anterior));
+		}
+
+		EscreverVarint(c, FazerZigzag(pares[i].peso));
+		anterior = pares[i].destino;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Cria uma imagem comprimida vazia com os arrays de vértices alocados.
+ *
+ * @param tamanho Número de posições indexadas.
+ * @return ImagemCompacta* Apontador para a imagem, ou NULL se não houver memória.
+ */
+static ImagemCompacta* AlocarImagemCompacta(int tamanho)
+{
+	ImagemCompacta* im = (ImagemCompacta*)calloc(1, sizeof(ImagemCompacta));
+
+	if (im == NULL)
+	{
+		return NULL;
+	}
+
+	int n = tamanho > 0 ? tamanho : 1;
+
+	im->tamanho = tamanho;
+	im->existe = (bool*)calloc(n, sizeof(bool));
+	im->inicio = (long long*)calloc(n + 1, sizeof(long long));
+
+	if (im->existe == NULL || im->inicio == NULL)
+	{
+		ApagarImagemCompacta(im);
+		return NULL;
+	}
+
+	return im;
+}
+
+/**
+ * @brief Comprime uma imagem de um grafo.
+ *
+ * @param im Apontador para a imagem.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para a imagem comprimida.
+ */
+ImagemCompacta* ComprimirImagemGrafo(ImagemGrafo* im, bool* inf)
+{
+	*inf = false;
+
+	if (im == NULL)
+	{
+		return NULL;
+	}
+
+	ImagemCompacta* c = AlocarImagemCompacta(im->tamanho);
+	int maiorGrau = 0;
+
+	for (int u = 0; u < im->tamanho; u++)
+	{
+		int grau = im->inicio[u + 1] - im->inicio[u];
+		if (grau > maiorGrau) maiorGrau = grau;
+	}
+
+	ParCompacto* pares = (ParCompacto*)malloc(sizeof(ParCompacto) * (maiorGrau > 0 ? maiorGrau : 1));
+	Codificador cod = { NULL, 0, 0 };
+
+	if (c == NULL || pares == NULL)
+	{
+		ApagarImagemCompacta(c);
+		free(pares);
+		return NULL;
+	}
+
+	c->versao = im->versao;
+	c->numVertices = im->numVertices;
+	c->numArestas = im->numArestas;
+
+	for (int u = 0; u < im->tamanho; u++)
+	{
+		c->existe[u] = im->existe[u];
+		c->inicio[u] = cod.tamanho;
+
+		if (!im->existe[u])
+		{
+			continue;
+		}
+
+		int n = 0;
+
+		for (int i = im->inicio[u]; i < im->inicio[u + 1]; i++)
+		{
+			pares[n].destino = im->destinos[i];
+			pares[n].peso = im->pesos[i];
+			n++;
+		}
+
+		if (!CodificarVertice(&cod, u, pares, n))
+		{
+			free(cod.dados);
+			free(pares);
+			ApagarImagemCompacta(c);
+			return NULL;
+		}
+	}
+
+	c->inicio[im->tamanho] = cod.tamanho;
+	free(pares);
+
+	//Liberta o espaço que sobrou no fim do buffer
+	c->dados = cod.tamanho > 0 ? (unsigned char*)realloc(cod.dados, (size_t)cod.tamanho) : cod.dados;
+
+	if (c->dados == NULL)
+	{
+		c->dados = cod.dados;
+	}
+
+	*inf = true;
+	return c;
+}
+
+/**
+ * @brief Cria uma imagem comprimida com as ligações atuais de um grafo.
+ *
+ * @param g Apontador para o grafo.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para a imagem comprimida.
+ */
+ImagemCompacta* CriarImagemCompacta(Grafo* g, bool* inf)
+{
+	ImagemGrafo* im = CriarImagemGrafo(g, inf);
+
+	if (im == NULL)
+	{
+		return NULL;
+	}
+
+	ImagemCompacta* c = ComprimirImagemGrafo(im, inf);
+	ApagarImagemGrafo(im);
+	return c;
+}
+
+/**
+ * @brief Liberta a memória alocada para uma imagem comprimida.
+ *
+ * @param im Apontador para a imagem a eliminar.
+ */
+void ApagarImagemCompacta(ImagemCompacta* im)
+{
+	if (im == NULL)
+	{
+		return;
+	}
+
+	free(im->existe);
+	free(im->inicio);
+	free(im->dados);
+	free(im);
+}
+
+/**
+ * @brief Devolve a memória ocupada por uma imagem comprimida.
+ *
+ * @param im Apontador para a imagem.
+ * @return size_t Número de bytes alocados.
+ */
+size_t MemoriaImagemCompacta(ImagemCompacta* im)
+{
+	if (im == NULL)
+	{
+		return 0;
+	}
+
+	return sizeof(ImagemCompacta) + (size_t)im->tamanho * (sizeof(bool) + sizeof(long long)) +
+		sizeof(long long) + (size_t)im->inicio[im->tamanho];
+}
+
+/**
+ * @brief Cria uma imagem comprimida diretamente a partir dos ficheiros binários do grafo.
+ *
+ * Os ficheiros são os criados por GuardaGrafo. As adjacências são lidas e comprimidas um vértice
+ * de cada vez, sem criar a lista de vértices e adjacências, pelo que grafos que não cabem em
+ * memória nesse formato podem ser carregados.
+ *
+ * Falha se a imagem ultrapassar o orçamento definido com DefinirOrcamentoMemoria; os dados
+ * codificados são verificados antes de cada bloco.
+ *
+ * @param vertices Nome do ficheiro de vértices.
+ * @param adjacencias Nome do ficheiro de adjacências.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para a imagem comprimida, ou NULL em caso de erro.
+ */
+ImagemCompacta* ConverterFicheirosCompacta(char* vertices, char* adjacencias, bool* inf)
+{
+	*inf = false;
+
+	FILE* fv = fopen(vertices, "rb");
+	FILE* fa = fopen(adjacencias, "rb");
+	VerticeFile auxVF;
+	AdjacenteFile auxAF;
+	int* ids = NULL;
+	int numIds = 0, capacidadeIds = 0, maior = -1;
+	bool ok = fv != NULL && fa != NULL &&
+		fread(&auxVF, sizeof(auxVF), 1, fv) == 1 && auxVF.id == -7 &&
+		fread(&auxAF, sizeof(auxAF), 1, fa) == 1 && auxAF.id == -8;
+
+	//Os ids dos vértices são lidos primeiro, pela ordem do ficheiro de adjacências
+	while (ok && fread(&auxVF, sizeof(auxVF), 1, fv) == 1)
+	{
+		if (numIds == capacidadeIds)
+		{
+			capacidadeIds = capacidadeIds > 0 ? capacidadeIds * 2 : 1024;
+			int* aux = (int*)realloc(ids, sizeof(int) * capacidadeIds);
+
+			if (aux == NULL)
+			{
+				ok = false;
+				break;
+			}
+
+			ids = aux;
+		}
+
+		ids[numIds++] = auxVF.id;
+		if (auxVF.id > maior) maior = auxVF.id;
+	}
+
+	//Com orçamento de memória a imagem e os dados codificados não o podem ultrapassar
+	size_t base = sizeof(ImagemCompacta) + ((size_t)maior + 2) * (sizeof(bool) + sizeof(long long)) + (size_t)numIds * sizeof(int);
+	ok = ok && CabeNoOrcamentoMemoria(base);
+
+	ImagemCompacta* c = ok ? AlocarImagemCompacta(maior + 1) : NULL;
+	int capacidadePares = 1024;
+	ParCompacto* pares = (ParCompacto*)malloc(sizeof(ParCompacto) * capacidadePares);
+	Codificador cod = { NULL, 0, 0 };
+
+	ok = ok && c != NULL && pares != NULL;
+
+	//Os vértices com id negativo ficam fora da imagem, tal como em CriarImagemGrafo
+	for (int i = 0; ok && i < numIds; i++)
+	{
+		if (ids[i] >= 0)
+		{
+			c->existe[ids[i]] = true;
+		}
+	}
+
+	//Cada bloco do ficheiro de adjacências termina com -1
+	for (int i = 0; ok && i < numIds; i++)
+	{
+		int n = 0;
+
+		while (ok && fread(&auxAF, sizeof(auxAF), 1, fa) == 1 && auxAF.id != -1)
+		{
+			//Tal como nas imagens, só ficam as ligações verdadeiras
+			if (ids[i] < 0 || auxAF.peso == 0 || auxAF.id < 0 || auxAF.id > maior || !c->existe[auxAF.id])
+			{
+				continue;
+			}
+
+			if (!PESO_VALIDO(auxAF.peso))
+			{
+				ok = false;
+				break;
+			}
+
+			if (n == capacidadePares)
+			{
+				capacidadePares *= 2;
+				ParCompacto* aux = (ParCompacto*)realloc(pares, sizeof(ParCompacto) * capacidadePares);
+
+				if (aux == NULL)
+				{
+					ok = false;
+					break;
+				}
+
+				pares = aux;
+			}
+
+			pares[n].destino = auxAF.id;
+			pares[n].peso = (PesoAresta)auxAF.peso;
+			n++;
+		}
+
+		if (ids[i] < 0)
+		{
+			continue;
+		}
+
+		//O bloco de cada vértice é lido a partir de inicio, pelo que a ordem dos blocos não importa
+		c->inicio[ids[i]] = cod.tamanho;
+		c->numVertices++;
+		c->numArestas += n;
+		ok = ok && CabeNoOrcamentoMemoria(base + (size_t)cod.tamanho + 5 + 10 * (size_t)n) &&
+			CodificarVertice(&cod, ids[i], pares, n);
+	}
+
+	if (fv != NULL) fclose(fv);
+	if (fa != NULL) fclose(fa);
+	free(ids);
+	free(pares);
+
+	if (!ok)
+	{
+		free(cod.dados);
+		ApagarImagemCompacta(c);
+		return NULL;
+	}
+
+	//Os ids sem vértice apontam para o bloco seguinte, como nas imagens
+	c->inicio[c->tamanho] = cod.tamanho;
+
+	for (int u = c->tamanho - 1; u >= 0; u--)
+	{
+		if (!c->existe[u])
+		{
+			c->inicio[u] = c->inicio[u + 1];
+		}
+	}
+
+	c->dados = cod.dados;
+	*inf = true;
+	return c;
+}
+
+/**
+ * @brief Guarda uma imagem comprimida num ficheiro binário.
+ *
+ * O ficheiro tem um cabeçalho com o valor -11, os tamanhos, os vértices existentes, as posições
+ * dos blocos e os blocos tal como estão em memória, pelo que é carregado sem descodificar.
+ *
+ * @param im Apontador para a imagem.
+ * @param file Nome do ficheiro.
+ * @return true se a imagem foi guardada.
+ */
+bool GuardaImagemCompacta(ImagemCompacta* im, char* file)
+{
+	if (im == NULL)
+	{
+		return false;
+	}
+
+	FILE* ficheiro = fopen(file, "wb");
+
+	if (ficheiro == NULL)
+	{
+		return false;
+	}
+
+	int cabecalho[3] = { -11, im->tamanho, im->numVertices };
+	long long bytes = im->inicio[im->tamanho];
+
+	bool ok = fwrite(cabecalho, sizeof(int), 3, ficheiro) == 3 &&
+		fwrite(&im->numArestas, sizeof(long long), 1, ficheiro) == 1 &&
+		fwrite(im->existe, sizeof(bool), im->tamanho, ficheiro) == (size_t)im->tamanho &&
+		fwrite(im->inicio, sizeof(long long), (size_t)im->tamanho + 1, ficheiro) == (size_t)im->tamanho + 1 &&
+		fwrite(im->dados, 1, (size_t)bytes, ficheiro) == (size_t)bytes;
+
+	return fclose(ficheiro) == 0 && ok;
+}
+
+/**
+ * @brief Lê um número em varint sem passar de um limite.
+ *
+ * @param p Apontador para a posição de leitura.
+ * @param fim Posição a seguir ao último byte que pode ser lido.
+ * @param valor Apontador onde fica o número lido.
+ * @return true se o número terminou antes do limite e cabe em 32 bits.
+ */
+static bool LerVarintLimitado(const unsigned char** p, const unsigned char* fim, unsigned int* valor)
+{
+	const unsigned char* q = *p;
+	unsigned int lido = 0;
+
+	for (int deslocamento = 0; deslocamento < 35; deslocamento += 7)
+	{
+		if (q >= fim || (deslocamento == 28 && *q > 0x0F))
+		{
+			return false;
+		}
+
+		lido |= (unsigned int)(*q & 0x7F) << deslocamento;
+
+		if (!(*q++ & 0x80))
+		{
+			*valor = lido;
+			*p = q;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * @brief Verifica uma imagem comprimida lida de um ficheiro, descodificando todos os blocos.
+ *
+ * ProximaAdjacenciaCompacta não faz verificações, pelo que um ficheiro truncado ou corrompido
+ * levaria as travessias a ler e escrever fora dos arrays. Os blocos têm de ser seguidos e estar
+ * dentro dos dados, os ids sem vértice têm blocos vazios, e cada bloco tem de terminar no início
+ * do seguinte com todos os destinos em vértices da imagem e pesos válidos.
+ *
+ * @param im Apontador para a imagem.
+ * @return true se a imagem pode ser percorrida.
+ */
+static bool ValidarImagemCompacta(ImagemCompacta* im)
+{
+	const unsigned char* existe = (const unsigned char*)im->existe;
+	long long numArestas = 0;
+	int numVertices = 0;
+
+	if (im->inicio[0] != 0)
+	{
+		return false;
+	}
+
+	//Primeiro os blocos seguidos, para nenhum passar do fim dos dados, e os valores de bool lidos do ficheiro
+	for (int u = 0; u < im->tamanho; u++)
+	{
+		if (existe[u] > 1 || im->inicio[u + 1] < im->inicio[u] || (existe[u] == 0 && im->inicio[u + 1] != im->inicio[u]))
+		{
+			return false;
+		}
+	}
+
+	for (int u = 0; u < im->tamanho; u++)
+	{
+		if (!im->existe[u])
+		{
+			continue;
+		}
+
+		const unsigned char* p = im->dados + im->inicio[u];
+		const unsigned char* fim = im->dados + im->inicio[u + 1];
+		unsigned int grau, diferenca, peso;
+		long long destino = u;
+
+		if (!LerVarintLimitado(&p, fim, &grau) || grau > INT_MAX)
+		{
+			return false;
+		}
+
+		for (unsigned int i = 0; i < grau; i++)
+		{
+			if (!LerVarintLimitado(&p, fim, &diferenca) || !LerVarintLimitado(&p, fim, &peso))
+			{
+				return false;
+			}
+
+			//Só a primeira diferença pode ser negativa, como em ProximaAdjacenciaCompacta
+			if (i == 0)
+			{
+				destino += DesfazerZigzag(diferenca);
+			}
+			else if (diferenca <= INT_MAX)
+			{
+				destino += (int)diferenca;
+			}
+			else
+			{
+				return false;
+			}
+
+			int valor = DesfazerZigzag(peso);
+
+			if (destino < 0 || destino >= im->tamanho || !im->existe[destino] || valor == 0 || !PESO_VALIDO(valor))
+			{
+				return false;
+			}
+		}
+
+		if (p != fim)
+		{
+			return false;
+		}
+
+		numArestas += grau;
+		numVertices++;
+	}
+
+	return numArestas == im->numArestas && numVertices == im->numVertices;
+}
+
+/**
+ * @brief Carrega uma imagem comprimida de um ficheiro criado com GuardaImagemCompacta.
+ *
+ * Falha, antes de alocar, se a imagem ultrapassar o orçamento definido com DefinirOrcamentoMemoria.
+ * Todos os blocos são descodificados uma vez ao carregar, e o ficheiro é recusado se algum bloco
+ * sair dos dados ou tiver um destino que não é vértice da imagem.
+ *
+ * @param file Nome do ficheiro.
+ * @return ImagemCompacta* Apontador para a imagem carregada, ou NULL em caso de erro.
+ */
+ImagemCompacta* CarregaImagemCompacta(char* file)
+{
+	FILE* ficheiro = fopen(file, "rb");
+
+	if (ficheiro == NULL)
+	{
+		return NULL;
+	}
+
+	int cabecalho[3];
+	ImagemCompacta* im = NULL;
+
+	//Se o cabeçalho não for -11 não é um ficheiro de imagem comprimida
+	if (fread(cabecalho, sizeof(int), 3, ficheiro) == 3 && cabecalho[0] == -11 && cabecalho[1] >= 0 &&
+		CabeNoOrcamentoMemoria(sizeof(ImagemCompacta) + ((size_t)cabecalho[1] + 1) * (sizeof(bool) + sizeof(long long))))
+	{
+		im = AlocarImagemCompacta(cabecalho[1]);
+	}
+
+	bool ok = im != NULL;
+
+	if (ok)
+	{
+		im->numVertices = cabecalho[2];
+		ok = fread(&im->numArestas, sizeof(long long), 1, ficheiro) == 1 &&
+			fread(im->existe, sizeof(bool), im->tamanho, ficheiro) == (size_t)im->tamanho &&
+			fread(im->inicio, sizeof(long long), (size_t)im->tamanho + 1, ficheiro) == (size_t)im->tamanho + 1 &&
+			im->inicio[im->tamanho] >= 0;
+	}
+
+	if (ok)
+	{
+		long long bytes = im->inicio[im->tamanho];
+		ok = CabeNoOrcamentoMemoria(MemoriaImagemCompacta(im));
+		im->dados = ok ? (unsigned char*)malloc(bytes > 0 ? (size_t)bytes : 1) : NULL;
+		ok = im->dados != NULL && fread(im->dados, 1, (size_t)bytes, ficheiro) == (size_t)bytes;
+	}
+
+	//As travessias confiam nos blocos, pelo que são todos verificados antes de a imagem ser usada
+	ok = ok && ValidarImagemCompacta(im);
+
+	fclose(ficheiro);
+
+	if (!ok)
+	{
+		ApagarImagemCompacta(im);
+		return NULL;
+	}
+
+	return im;
+}
+
+/**
+ * @brief Pesquisa em largura sobre uma imagem comprimida.
+ *
+ * Com um destino a pesquisa para assim que ele é alcançado, e os vértices que ficaram por visitar
+ * ficam com -1.
+ *
+ * @param im Apontador para a imagem.
+ * @param origem Vértice de origem.
+ * @param destino Vértice onde a pesquisa pode parar (-1 para visitar todos os vértices alcançáveis).
+ * @param nivel Array com im->tamanho elementos onde fica o número de ligações desde a origem (-1 se não alcançado).
+ * @return int Número de vértices alcançados, ou -1 em caso de erro.
+ */
+int LarguraCompacta(ImagemCompacta* im, int origem, int destino, int nivel[])
+{
+	if (im == NULL || nivel == NULL || origem < 0 || origem >= im->tamanho || !im->existe[origem] ||
+		destino < -1 || destino >= im->tamanho)
+	{
+		return -1;
+	}
+
+	int* fila = (int*)malloc(sizeof(int) * im->tamanho);
+
+	if (fila == NULL)
+	{
+		return -1;
+	}
+
+	for (int i = 0; i < im->tamanho; i++)
+	{
+		nivel[i] = -1;
+	}
+
+	int frente = 0, fim = 0;
+	fila[fim++] = origem;
+	nivel[origem] = 0;
+
+	while (frente < fim && (destino < 0 || nivel[destino] < 0))
+	{
+		int u = fila[frente++];
+		CursorCompacto c;
+		int w;
+		PesoAresta peso;
+
+		IniciarCursorCompacto(im, u, &c);
+
+		//As adjacências são descodificadas à medida que são visitadas
+		while (ProximaAdjacenciaCompacta(&c, &w, &peso))
+		{
+			if (nivel[w] == -1)
+			{
+				nivel[w] = nivel[u] + 1;
+				fila[fim++] = w;
+
+				if (w == destino)
+				{
+					break;
+				}
+			}
+		}
+	}
+
+	free(fila);
+	return fim;
+}
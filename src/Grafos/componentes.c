@@ -0,0 +1,551 @@
+/**
+ * @file componentes.c
+ * @author Hugo Cruz (a23010)
+ * @brief Implementação das componentes conexas e fortemente conexas de um grafo.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include <stdlib.h>
+#include "componentes.h"
+
+/**
+ * @brief Estado da união de conjuntos, partilhado pelos trabalhadores.
+ *
+ * Cada vértice aponta para outro vértice da mesma árvore com id menor ou igual, pelo que a raiz
+ * de cada árvore é o menor id da sua componente.
+ */
+typedef struct UniaoComponentes
+{
+	const ImagemGrafo* im;		 ///< Imagem do grafo.
+	const ImagemGrafo* inversa;	 ///< Imagem inversa (NULL se não houver).
+	atomic_int* pai;			 ///< Pai de cada vértice na floresta.
+	int ronda;					 ///< Posição da ligação unida em cada vértice, na primeira fase.
+	int maior;					 ///< Raiz da componente cujos vértices são ignorados (-1 para nenhuma).
+
+} UniaoComponentes;
+
+/**
+ * @brief Lê o pai de um vértice.
+ *
+ * @param pai Array dos pais.
+ * @param v Vértice.
+ * @return int Pai do vértice.
+ */
+static inline int LerPai(atomic_int* pai, int v)
+{
+	return atomic_load_explicit(&pai[v], memory_order_relaxed);
+}
+
+/**
+ * @brief Junta as árvores de dois vértices, pendurando a raiz maior na menor.
+ *
+ * Se outro trabalhador mudar o pai da raiz entretanto, a troca falha e a junção é repetida a
+ * partir dos novos pais.
+ *
+ * @param pai Array dos pais.
+ * @param u Primeiro vértice.
+ * @param v Segundo vértice.
+ */
+static void Unir(atomic_int* pai, int u, int v)
+{
+	int p1 = LerPai(pai, u);
+	int p2 = LerPai(pai, v);
+
+	while (p1 != p2)
+	{
+		int alto = p1 > p2 ? p1 : p2;
+		int baixo = p1 + (p2 - alto);
+		int paiAlto = LerPai(pai, alto);
+
+		if (paiAlto == baixo)
+		{
+			break;
+		}
+
+		if (paiAlto == alto &&
+			atomic_compare_exchange_strong_explicit(&pai[alto], &paiAlto, baixo, memory_order_relaxed, memory_order_relaxed))
+		{
+			break;
+		}
+
+		p1 = LerPai(pai, LerPai(pai, alto));
+		p2 = LerPai(pai, baixo);
+	}
+}
+
+/**
+ * @brief Põe um intervalo de vértices como raízes de árvores só com eles.
+ *
+ * @param contexto Apontador para o estado da união.
+ * @param inicio Primeiro vértice.
+ * @param fim Vértice a seguir ao último.
+ * @param trabalhador Número do trabalhador (não usado).
+ */
+static void IniciarPais(void* contexto, int inicio, int fim, int trabalhador)
+{
+	UniaoComponentes* u = (UniaoComponentes*)contexto;
+
+	for (int v = inicio; v < fim; v++)
+	{
+		atomic_store_explicit(&u->pai[v], v, memory_order_relaxed);
+	}
+}
+
+/**
+ * @brief Une cada vértice de um intervalo ao destino da sua ligação na posição da ronda.
+ *
+ * @param contexto Apontador para o estado da união.
+ * @param inicio Primeiro vértice.
+ * @param fim Vértice a seguir ao último.
+ * @param trabalhador Número do trabalhador (não usado).
+ */
+static void UnirRonda(void* contexto, int inicio, int fim, int trabalhador)
+{
+	UniaoComponentes* u = (UniaoComponentes*)contexto;
+	const ImagemGrafo* im = u->im;
+
+	for (int v = inicio; v < fim; v++)
+	{
+		int k = im->inicio[v] + u->ronda;
+
+		if (k < im->inicio[v + 1])
+		{
+			Unir(u->pai, v, im->destinos[k]);
+		}
+	}
+}
+
+/**
+ * @brief Une as ligações restantes dos vértices de um intervalo que não estão na maior componente.
+ *
+ * As ligações que saem de um vértice da maior componente não são percorridas; as que chegam a
+ * vértices de fora dela são encontradas do outro lado, na imagem inversa.
+ *
+ * @param contexto Apontador para o estado da união.
+ * @param inicio Primeiro vértice.
+ * @param fim Vértice a seguir ao último.
+ * @param trabalhador Número do trabalhador (não usado).
+ */
+static void UnirRestantes(void* contexto, int inicio, int fim, int trabalhador)
+{
+	UniaoComponentes* u = (UniaoComponentes*)contexto;
+	const ImagemGrafo* im = u->im;
+	const ImagemGrafo* inversa = u->inversa;
+
+	for (int v = inicio; v < fim; v++)
+	{
+		if (u->maior >= 0 && LerPai(u->pai, v) == u->maior)
+		{
+			continue;
+		}
+
+		for (int k = im->inicio[v] + RONDAS_VIZINHOS; k < im->inicio[v + 1]; k++)
+		{
+			Unir(u->pai, v, im->destinos[k]);
+		}
+
+		if (u->maior >= 0)
+		{
+			for (int k = inversa->inicio[v]; k < inversa->inicio[v + 1]; k++)
+			{
+				Unir(u->pai, v, inversa->destinos[k]);
+			}
+		}
+	}
+}
+
+/**
+ * @brief Liga cada vértice de um intervalo diretamente à raiz da sua árvore.
+ *
+ * @param contexto Apontador para o estado da união.
+ * @param inicio Primeiro vértice.
+ * @param fim Vértice a seguir ao último.
+ * @param trabalhador Número do trabalhador (não usado).
+ */
+static void Comprimir(void* contexto, int inicio, int fim, int trabalhador)
+{
+	atomic_int* pai = ((UniaoComponentes*)contexto)->pai;
+
+	for (int v = inicio; v < fim; v++)
+	{
+		int p = LerPai(pai, v);
+		int avo = LerPai(pai, p);
+
+		while (p != avo)
+		{
+			atomic_store_explicit(&pai[v], avo, memory_order_relaxed);
+			p = avo;
+			avo = LerPai(pai, p);
+		}
+	}
+}
+
+/**
+ * @brief Compara dois inteiros (para qsort).
+ *
+ * @param a Apontador para o primeiro inteiro.
+ * @param b Apontador para o segundo inteiro.
+ * @return int Negativo, zero ou positivo conforme a ordem.
+ */
+static int CompararInteiros(const void* a, const void* b)
+{
+	int x = *(const int*)a;
+	int y = *(const int*)b;
+
+	return (x > y) - (x < y);
+}
+
+/**
+ * @brief Escolhe a raiz mais frequente numa amostra de vértices do grafo.
+ *
+ * @param im Apontador para a imagem.
+ * @param pai Array dos pais, já comprimido.
+ * @return int Raiz mais frequente (-1 se o grafo não tiver vértices).
+ */
+static int RaizMaisFrequente(const ImagemGrafo* im, atomic_int* pai)
+{
+	int amostras[AMOSTRAS_COMPONENTES];
+	int n = 0;
+	unsigned int estado = 2463534242u;
+
+	if (im->numVertices == 0)
+	{
+		return -1;
+	}
+
+	//Os ids sem vértice são descartados, com um limite de tentativas para grafos muito esparsos em ids
+	for (int tentativas = 0; n < AMOSTRAS_COMPONENTES && tentativas < 4 * AMOSTRAS_COMPONENTES; tentativas++)
+	{
+		estado ^= estado << 13;
+		estado ^= estado >> 17;
+		estado ^= estado << 5;
+		int v = (int)(estado % (unsigned int)im->tamanho);
+
+		if (im->existe[v])
+		{
+			amostras[n++] = LerPai(pai, v);
+		}
+	}
+
+	if (n == 0)
+	{
+		return -1;
+	}
+
+	qsort(amostras, n, sizeof(int), CompararInteiros);
+
+	int melhor = amostras[0], contagemMelhor = 0;
+
+	for (int i = 0, j; i < n; i = j)
+	{
+		for (j = i; j < n && amostras[j] == amostras[i]; j++);
+
+		if (j - i > contagemMelhor)
+		{
+			melhor = amostras[i];
+			contagemMelhor = j - i;
+		}
+	}
+
+	return melhor;
+}
+
+/**
+ * @brief Aloca um conjunto de componentes vazio.
+ *
+ * @param tamanho Número de posições indexadas.
+ * @return Componentes* Apontador para as componentes (NULL se não houver memória).
+ */
+static Componentes* NovasComponentes(int tamanho)
+{
+	Componentes* c = (Componentes*)calloc(1, sizeof(Componentes));
+
+	if (c == NULL)
+	{
+		return NULL;
+	}
+
+	c->tamanho = tamanho;
+	c->componente = (int*)malloc(sizeof(int) * (tamanho > 0 ? tamanho : 1));
+
+	if (c->componente == NULL)
+	{
+		free(c);
+		return NULL;
+	}
+
+	return c;
+}
+
+/**
+ * @brief Conta os vértices de cada componente, depois de todos os vértices terem componente.
+ *
+ * @param c Apontador para as componentes.
+ * @return true se havia memória para as contagens.
+ */
+static bool ContarMembros(Componentes* c)
+{
+	c->numMembros = (int*)calloc(c->numComponentes > 0 ? c->numComponentes : 1, sizeof(int));
+
+	if (c->numMembros == NULL)
+	{
+		return false;
+	}
+
+	for (int v = 0; v < c->tamanho; v++)
+	{
+		if (c->componente[v] >= 0)
+		{
+			c->numMembros[c->componente[v]]++;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * @brief Calcula as componentes conexas de uma imagem, ignorando o sentido das ligações.
+ *
+ * As uniões de cada fase são feitas em paralelo e cada fase termina com a compressão das árvores,
+ * para que a fase seguinte encontre as raízes num só passo. No fim as raízes são numeradas por
+ * ordem crescente de id, pelo que a numeração não depende do número de trabalhadores.
+ *
+ * @param im Apontador para a imagem do grafo.
+ * @param inversa Apontador para a imagem inversa de im (NULL para ser criada e apagada pela função).
+ * @param ex Apontador para o executor (NULL para calcular só na thread que chama).
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Componentes* Apontador para as componentes criadas.
+ */
+Componentes* ComponentesConexas(ImagemGrafo* im, ImagemGrafo* inversa, ExecutorParalelo* ex, bool* inf)
+{
+	*inf = false;
+
+	if (im == NULL || (inversa != NULL && inversa->tamanho != im->tamanho))
+	{
+		return NULL;
+	}
+
+	Componentes* c = NovasComponentes(im->tamanho);
+	atomic_int* pai = (atomic_int*)malloc(sizeof(atomic_int) * (im->tamanho > 0 ? im->tamanho : 1));
+
+	if (c == NULL || pai == NULL)
+	{
+		ApagarComponentes(c);
+		free(pai);
+		return NULL;
+	}
+
+	UniaoComponentes u = { im, inversa, pai, 0, -1 };
+	ParaleloPara(ex, 0, im->tamanho, 0, IniciarPais, &u);
+
+	for (u.ronda = 0; u.ronda < RONDAS_VIZINHOS; u.ronda++)
+	{
+		ParaleloPara(ex, 0, im->tamanho, 0, UnirRonda, &u);
+		ParaleloPara(ex, 0, im->tamanho, 0, Comprimir, &u);
+	}
+
+	//Sem memória para a imagem inversa todos os vértices percorrem as suas ligações
+	ImagemGrafo* inversaPropria = NULL;
+
+	if (u.inversa == NULL)
+	{
+		bool criada;
+		inversaPropria = InverterImagemGrafo(im, &criada);
+		u.inversa = inversaPropria;
+	}
+
+	u.maior = u.inversa != NULL ? RaizMaisFrequente(im, pai) : -1;
+	ParaleloPara(ex, 0, im->tamanho, 0, UnirRestantes, &u);
+	ParaleloPara(ex, 0, im->tamanho, 0, Comprimir, &u);
+	ApagarImagemGrafo(inversaPropria);
+
+	//A raiz é o menor id da árvore, pelo que é numerada antes dos outros vértices da componente
+	for (int v = 0; v < im->tamanho; v++)
+	{
+		if (!im->existe[v])
+		{
+			c->componente[v] = -1;
+		}
+		else
+		{
+			int raiz = LerPai(pai, v);
+			c->componente[v] = raiz == v ? c->numComponentes++ : c->componente[raiz];
+		}
+	}
+
+	free(pai);
+
+	if (!ContarMembros(c))
+	{
+		ApagarComponentes(c);
+		return NULL;
+	}
+
+	*inf = true;
+	return c;
+}
+
+/**
+ * @brief Calcula as componentes fortemente conexas de uma imagem com o algoritmo de Tarjan.
+ *
+ * Cada vértice recebe um índice pela ordem em que é visitado e baixo guarda o menor índice
+ * alcançável a partir da sua subárvore por vértices ainda na pilha de Tarjan. Um vértice com
+ * baixo igual ao seu índice é a raiz de uma componente, formada por ele e pelos vértices acima
+ * dele na pilha. Um vértice visitado está na pilha de Tarjan enquanto não tiver componente.
+ *
+ * @param im Apontador para a imagem do grafo.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Componentes* Apontador para as componentes criadas.
+ */
+Componentes* ComponentesFortes(ImagemGrafo* im, bool* inf)
+{
+	*inf = false;
+
+	if (im == NULL)
+	{
+		return NULL;
+	}
+
+	int n = im->tamanho > 0 ? im->tamanho : 1;
+	Componentes* c = NovasComponentes(im->tamanho);
+	int* indice = (int*)malloc(sizeof(int) * n);
+	int* baixo = (int*)malloc(sizeof(int) * n);
+	int* posicao = (int*)malloc(sizeof(int) * n);
+	int* pilha = (int*)malloc(sizeof(int) * n);
+	int* chamadas = (int*)malloc(sizeof(int) * n);
+
+	if (c == NULL || indice == NULL || baixo == NULL || posicao == NULL || pilha == NULL || chamadas == NULL)
+	{
+		ApagarComponentes(c);
+		free(indice);
+		free(baixo);
+		free(posicao);
+		free(pilha);
+		free(chamadas);
+		return NULL;
+	}
+
+	for (int v = 0; v < im->tamanho; v++)
+	{
+		indice[v] = -1;
+		c->componente[v] = -1;
+	}
+
+	int contador = 0, topoPilha = 0;
+
+	for (int raiz = 0; raiz < im->tamanho; raiz++)
+	{
+		if (!im->existe[raiz] || indice[raiz] >= 0)
+		{
+			continue;
+		}
+
+		int numChamadas = 0;
+		indice[raiz] = baixo[raiz] = contador++;
+		posicao[raiz] = im->inicio[raiz];
+		pilha[topoPilha++] = raiz;
+		chamadas[numChamadas++] = raiz;
+
+		while (numChamadas > 0)
+		{
+			int v = chamadas[numChamadas - 1];
+
+			if (posicao[v] < im->inicio[v + 1])
+			{
+				int w = im->destinos[posicao[v]++];
+
+				if (indice[w] < 0)
+				{
+					indice[w] = baixo[w] = contador++;
+					posicao[w] = im->inicio[w];
+					pilha[topoPilha++] = w;
+					chamadas[numChamadas++] = w;
+				}
+				else if (c->componente[w] < 0 && indice[w] < baixo[v])
+				{
+					baixo[v] = indice[w];
+				}
+
+				continue;
+			}
+
+			//Todas as ligações de v foram vistas: regressa ao vértice que o visitou
+			numChamadas--;
+
+			if (numChamadas > 0)
+			{
+				int u = chamadas[numChamadas - 1];
+
+				if (baixo[v] < baixo[u])
+				{
+					baixo[u] = baixo[v];
+				}
+			}
+
+			if (baixo[v] == indice[v])
+			{
+				int w;
+
+				do
+				{
+					w = pilha[--topoPilha];
+					c->componente[w] = c->numComponentes;
+				} while (w != v);
+
+				c->numComponentes++;
+			}
+		}
+	}
+
+	free(indice);
+	free(baixo);
+	free(posicao);
+	free(pilha);
+	free(chamadas);
+
+	if (!ContarMembros(c))
+	{
+		ApagarComponentes(c);
+		return NULL;
+	}
+
+	*inf = true;
+	return c;
+}
+
+/**
+ * @brief Liberta a memória de um conjunto de componentes.
+ *
+ * @param c Apontador para as componentes (pode ser NULL).
+ */
+void ApagarComponentes(Componentes* c)
+{
+	if (c == NULL)
+	{
+		return;
+	}
+
+	free(c->componente);
+	free(c->numMembros);
+	free(c);
+}
+
+/**
+ * @brief Devolve a memória ocupada por um conjunto de componentes.
+ *
+ * @param c Apontador para as componentes.
+ * @return size_t Número de bytes alocados.
+ */
+size_t MemoriaComponentes(Componentes* c)
+{
+	if (c == NULL)
+	{
+		return 0;
+	}
+
+	return sizeof(Componentes) + sizeof(int) * (size_t)(c->tamanho > 0 ? c->tamanho : 1) +
+		sizeof(int) * (size_t)(c->numComponentes > 0 ? c->numComponentes : 1);
+}
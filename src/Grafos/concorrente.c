@@ -0,0 +1,322 @@
+/**
+ * @file concorrente.c
+ * @author Hugo Cruz (a23010)
+ * @brief Implementação da construção de um grafo por várias threads ao mesmo tempo.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include <threads.h>
+#include "concorrente.h"
+
+/**
+ * @def ESPERA_ATIVA_FAIXA
+ * @brief Número de tentativas de obter um bloqueio antes de ceder o processador.
+ */
+#define ESPERA_ATIVA_FAIXA 64
+
+ /**
+  * @brief Obtém o bloqueio da faixa de um vértice.
+  *
+  * As secções protegidas são muito curtas (acrescentar um elemento a uma lista), por isso a
+  * thread espera ativamente; se a espera se prolongar (a thread com o bloqueio foi suspensa)
+  * cede o processador em vez de o ocupar até ao fim da sua fatia de tempo.
+  *
+  * @param gc Apontador para a construção.
+  * @param id Identificador do vértice.
+  */
+static void BloquearFaixa(GrafoConcorrente* gc, int id)
+{
+	FaixaBloqueio* f = &gc->faixas[id % FAIXAS_CONCORRENTES];
+
+	int tentativas = 0;
+
+	while (atomic_flag_test_and_set_explicit(&f->ocupada, memory_order_acquire))
+	{
+		if (++tentativas >= ESPERA_ATIVA_FAIXA)
+		{
+			thrd_yield();
+			tentativas = 0;
+		}
+	}
+}
+
+/**
+ * @brief Liberta o bloqueio da faixa de um vértice.
+ *
+ * @param gc Apontador para a construção.
+ * @param id Identificador do vértice.
+ */
+static void DesbloquearFaixa(GrafoConcorrente* gc, int id)
+{
+	atomic_flag_clear_explicit(&gc->faixas[id % FAIXAS_CONCORRENTES].ocupada, memory_order_release);
+}
+
+/**
+ * @brief Inicia a construção concorrente de um grafo.
+ *
+ * Os vértices e adjacências que o grafo já tem são mantidos. Até a construção ser concluída o
+ * grafo só pode ser alterado com as funções deste módulo.
+ *
+ * @param g Apontador para o grafo.
+ * @param capacidade Número de ids que podem ser usados (todos os ids têm de estar entre 0 e capacidade - 1).
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para a construção iniciada.
+ */
+GrafoConcorrente* IniciarConstrucaoConcorrente(Grafo* g, int capacidade, bool* inf)
+{
+	*inf = false;
+
+	//As adjacências novas são juntadas às listas
+	if (g == NULL || capacidade < 1 || !ExpandirMatrizGrafo(g))
+	{
+		return NULL;
+	}
+
+	//Os vértices que já existem também têm de caber no índice
+	for (Vertice* v = g->inicioGrafo; v != NULL; v = v->nextV)
+	{
+		if (v->id >= capacidade)
+		{
+			return NULL;
+		}
+	}
+
+	GrafoConcorrente* gc = (GrafoConcorrente*)malloc(sizeof(GrafoConcorrente));
+
+	if (gc == NULL)
+	{
+		return NULL;
+	}
+
+	gc->g = g;
+	gc->capacidade = capacidade;
+	gc->indice = (_Atomic(Vertice*)*)malloc(sizeof(_Atomic(Vertice*)) * capacidade);
+	gc->fins = (Adjacente**)calloc(capacidade, sizeof(Adjacente*));
+
+	if (gc->indice == NULL || gc->fins == NULL)
+	{
+		free(gc->indice);
+		free(gc->fins);
+		free(gc);
+		return NULL;
+	}
+
+	for (int i = 0; i < capacidade; i++)
+	{
+		atomic_init(&gc->indice[i], NULL);
+	}
+
+	for (int i = 0; i < FAIXAS_CONCORRENTES; i++)
+	{
+		atomic_flag_clear(&gc->faixas[i].ocupada);
+	}
+
+	//Indexa os vértices existentes e guarda o fim de cada lista de adjacências
+	for (Vertice* v = g->inicioGrafo; v != NULL; v = v->nextV)
+	{
+		if (v->id < 0)
+		{
+			continue;
+		}
+
+		Adjacente* fim = v->nextA;
+
+		while (fim != NULL && fim->next != NULL)
+		{
+			fim = fim->next;
+		}
+
+		gc->fins[v->id] = fim;
+		atomic_store(&gc->indice[v->id], v);
+	}
+
+	*inf = true;
+	return gc;
+}
+
+/**
+ * @brief Insere um vértice; pode ser chamada por várias threads ao mesmo tempo.
+ *
+ * @param gc Apontador para a construção.
+ * @param id Identificador do vértice.
+ * @param inf Apontador para um bool que fica false se o id for inválido ou já existir.
+ * @return Apontador para a construção.
+ */
+GrafoConcorrente* InserirVerticeConcorrente(GrafoConcorrente* gc, int id, bool* inf)
+{
+	*inf = false;
+
+	if (gc == NULL || id < 0 || id >= gc->capacidade)
+	{
+		return gc;
+	}
+
+	Vertice* novo = CriarVertice(id);
+
+	if (novo == NULL)
+	{
+		return gc;
+	}
+
+	//Só uma thread consegue trocar a posição vazia pelo novo vértice
+	Vertice* vazio = NULL;
+
+	if (!atomic_compare_exchange_strong(&gc->indice[id], &vazio, novo))
+	{
+		ApagarVertice(novo);
+		return gc;
+	}
+
+	*inf = true;
+	return gc;
+}
+
+/**
+ * @brief Insere uma adjacência; pode ser chamada por várias threads ao mesmo tempo.
+ *
+ * Os dois vértices têm de ter sido inseridos antes da chamada. As adjacências inseridas pela
+ * mesma thread com a mesma origem ficam pela ordem de inserção.
+ *
+ * @param gc Apontador para a construção.
+ * @param origem Vértice de origem.
+ * @param destino Vértice de destino.
+ * @param peso Peso da adjacência.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para a construção.
+ */
+GrafoConcorrente* InserirAdjConcorrente(GrafoConcorrente* gc, int origem, int destino, int peso, bool* inf)
+{
+	*inf = false;
+
+	if (gc == NULL || origem < 0 || origem >= gc->capacidade || destino < 0 || destino >= gc->capacidade || !PESO_VALIDO(peso))
+	{
+		return gc;
+	}
+
+	Vertice* v = atomic_load(&gc->indice[origem]);
+
+	if (v == NULL || atomic_load(&gc->indice[destino]) == NULL)
+	{
+		return gc;
+	}
+
+	//A adjacência é criada fora do bloqueio para a secção protegida ser mínima
+	Adjacente* nova = CriarAdjacencia(destino, peso, inf);
+
+	if (nova == NULL)
+	{
+		*inf = false;
+		return gc;
+	}
+
+	BloquearFaixa(gc, origem);
+
+	if (gc->fins[origem] == NULL)
+	{
+		v->nextA = nova;
+	}
+	else
+	{
+		gc->fins[origem]->next = nova;
+	}
+
+	gc->fins[origem] = nova;
+
+	DesbloquearFaixa(gc, origem);
+
+	*inf = true;
+	return gc;
+}
+
+/**
+ * @brief Conclui a construção concorrente e devolve o grafo.
+ *
+ * Tem de ser chamada depois de todas as threads terminarem. A lista de vértices é reconstruída
+ * por ordem de id, o índice de entradas é reconstruído se estiver ativo, e a memória da
+ * construção é libertada.
+ *
+ * @param gc Apontador para a construção.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para o grafo.
+ */
+Grafo* ConcluirConstrucaoConcorrente(GrafoConcorrente* gc, bool* inf)
+{
+	*inf = false;
+
+	if (gc == NULL)
+	{
+		return NULL;
+	}
+
+	Grafo* g = gc->g;
+
+	//Os vértices com id negativo não estão no índice e ficam no início da lista
+	Vertice* inicio = NULL;
+	Vertice* fim = NULL;
+	Vertice* aux = g->inicioGrafo;
+
+	while (aux != NULL && aux->id < 0)
+	{
+		fim = aux;
+		aux = aux->nextV;
+	}
+
+	if (fim != NULL)
+	{
+		inicio = g->inicioGrafo;
+		fim->nextV = NULL;
+	}
+
+	//O índice já está ordenado pelo id, basta ligar os vértices por essa ordem
+	for (int i = 0; i < gc->capacidade; i++)
+	{
+		Vertice* v = atomic_load(&gc->indice[i]);
+
+		if (v == NULL)
+		{
+			continue;
+		}
+
+		v->antV = fim;
+		v->nextV = NULL;
+
+		if (fim == NULL)
+		{
+			inicio = v;
+		}
+		else
+		{
+			fim->nextV = v;
+		}
+
+		fim = v;
+	}
+
+	g->inicioGrafo = inicio;
+	g->versao++;
+
+	//As threads não atualizam os contadores de memória
+	RecontarMemoriaGrafo(g);
+
+	free(gc->indice);
+	free(gc->fins);
+	free(gc);
+
+	*inf = true;
+
+	//As adjacências novas foram juntadas no fim das listas
+	if (g->adjOrdenadas)
+	{
+		g = OrdenarAdjacenciasGrafo(g, inf);
+	}
+
+	if (g->indice != NULL)
+	{
+		g = ConfigurarIndiceEntradasGrafo(g, true, inf);
+	}
+
+	return g;
+}
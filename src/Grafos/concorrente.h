@@ -0,0 +1,106 @@
+/**
+ * @file concorrente.h
+ * @author Hugo Cruz (a23010)
+ * @brief Ficheiro de cabeçalho para a construção de um grafo por várias threads ao mesmo tempo.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef CONCORRENTE_H
+#define CONCORRENTE_H
+
+#include <stdatomic.h>
+#include "grafo.h"
+
+/**
+ * @def FAIXAS_CONCORRENTES
+ * @brief Número de bloqueios usados para proteger as listas de adjacências (cada vértice usa o bloqueio id % FAIXAS_CONCORRENTES).
+ */
+#define FAIXAS_CONCORRENTES 1024
+
+/**
+ * @brief Bloqueio de uma faixa de vértices.
+ *
+ * Cada bloqueio ocupa uma linha de cache para que threads em faixas diferentes não disputem a
+ * mesma linha.
+ */
+typedef struct FaixaBloqueio
+{
+	atomic_flag ocupada;						  ///< Indica se uma thread tem o bloqueio.
+	char preenchimento[64 - sizeof(atomic_flag)]; ///< Completa a linha de cache.
+
+} FaixaBloqueio;
+
+/**
+ * @brief Estrutura de um grafo em construção concorrente.
+ *
+ * Os vértices são registados num índice de tamanho fixo com uma troca atómica, sem bloqueios. As
+ * adjacências são acrescentadas ao fim da lista da origem com o bloqueio da faixa dessa origem,
+ * pelo que threads que inserem adjacências de vértices diferentes quase nunca esperam umas pelas
+ * outras. A lista de vértices do grafo só é atualizada quando a construção é concluída.
+ */
+typedef struct GrafoConcorrente
+{
+	Grafo *g;									 ///< Grafo em construção.
+	int capacidade;								 ///< Número de ids do índice (os ids válidos vão de 0 a capacidade - 1).
+	_Atomic(Vertice *) *indice;					 ///< Vértice com cada id (NULL se não existir).
+	Adjacente **fins;							 ///< Última adjacência da lista de cada vértice.
+	FaixaBloqueio faixas[FAIXAS_CONCORRENTES];	 ///< Bloqueios das listas de adjacências.
+
+} GrafoConcorrente;
+
+/**
+ * @brief Inicia a construção concorrente de um grafo.
+ *
+ * Os vértices e adjacências que o grafo já tem são mantidos. Até a construção ser concluída o
+ * grafo só pode ser alterado com as funções deste módulo.
+ *
+ * @param g Apontador para o grafo.
+ * @param capacidade Número de ids que podem ser usados (todos os ids têm de estar entre 0 e capacidade - 1).
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para a construção iniciada.
+ */
+GrafoConcorrente *IniciarConstrucaoConcorrente(Grafo *g, int capacidade, bool *inf);
+
+/**
+ * @brief Insere um vértice; pode ser chamada por várias threads ao mesmo tempo.
+ *
+ * @param gc Apontador para a construção.
+ * @param id Identificador do vértice.
+ * @param inf Apontador para um bool que fica false se o id for inválido ou já existir.
+ * @return Apontador para a construção.
+ */
+GrafoConcorrente *InserirVerticeConcorrente(GrafoConcorrente *gc, int id, bool *inf);
+
+/**
+ * @brief Insere uma adjacência; pode ser chamada por várias threads ao mesmo tempo.
+ *
+ * Os dois vértices têm de ter sido inseridos antes da chamada. As adjacências inseridas pela
+ * mesma thread com a mesma origem ficam pela ordem de inserção.
+ *
+ * @param gc Apontador para a construção.
+ * @param origem Vértice de origem.
+ * @param destino Vértice de destino.
+ * @param peso Peso da adjacência.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para a construção.
+ */
+GrafoConcorrente *InserirAdjConcorrente(GrafoConcorrente *gc, int origem, int destino, int peso, bool *inf);
+
+/**
+ * @brief Conclui a construção concorrente e devolve o grafo.
+ *
+ * Tem de ser chamada depois de todas as threads terminarem. A lista de vértices é reconstruída
+ * por ordem de id, o índice de entradas é reconstruído se estiver ativo, e a memória da
+ * construção é libertada.
+ *
+ * @param gc Apontador para a construção.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para o grafo.
+ */
+Grafo *ConcluirConstrucaoConcorrente(GrafoConcorrente *gc, bool *inf);
+
+#endif
@@ -0,0 +1,80 @@
+/**
+ * @file estatisticas.c
+ * @author Hugo Cruz (a23010)
+ * @brief Implementação dos contadores de trabalho dos algoritmos e das leituras e escritas.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include <string.h>
+#include "estatisticas.h"
+
+#ifdef GRAFOS_ESTATISTICAS
+LOCAL_THREAD EstatisticasGrafos estatisticasThread;
+#endif
+
+/**
+ * @brief Indica se a biblioteca foi compilada com os contadores.
+ *
+ * @return true se GRAFOS_ESTATISTICAS estava definido, false caso contrário.
+ */
+bool EstatisticasAtivas(void)
+{
+#ifdef GRAFOS_ESTATISTICAS
+	return true;
+#else
+	return false;
+#endif
+}
+
+/**
+ * @brief Devolve uma cópia dos contadores da thread atual.
+ *
+ * @return EstatisticasGrafos Contadores acumulados desde a última limpeza (zeros sem GRAFOS_ESTATISTICAS).
+ */
+EstatisticasGrafos ObterEstatisticas(void)
+{
+#ifdef GRAFOS_ESTATISTICAS
+	return estatisticasThread;
+#else
+	EstatisticasGrafos vazias;
+	memset(&vazias, 0, sizeof(vazias));
+	return vazias;
+#endif
+}
+
+/**
+ * @brief Põe a zero os contadores da thread atual.
+ *
+ */
+void LimparEstatisticas(void)
+{
+#ifdef GRAFOS_ESTATISTICAS
+	memset(&estatisticasThread, 0, sizeof(estatisticasThread));
+#endif
+}
+
+/**
+ * @brief Soma os contadores de b aos de a.
+ *
+ * @param a Apontador para os contadores acumulados.
+ * @param b Contadores a somar.
+ */
+void SomarEstatisticas(EstatisticasGrafos* a, EstatisticasGrafos b)
+{
+	if (a == NULL)
+	{
+		return;
+	}
+
+	a->verticesFixados += b.verticesFixados;
+	a->arestasRelaxadas += b.arestasRelaxadas;
+	a->operacoesFila += b.operacoesFila;
+	a->verticesPercorridos += b.verticesPercorridos;
+	a->adjacenciasPercorridas += b.adjacenciasPercorridas;
+	a->alocacoes += b.alocacoes;
+	a->bytesLidos += b.bytesLidos;
+	a->bytesEscritos += b.bytesEscritos;
+}
@@ -0,0 +1,199 @@
+/**
+ * @file fila.c
+ * @author Hugo Cruz (a23010)
+ * @brief Implementação da fila de prioridade (heap binário) usada nos algoritmos de caminhos.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include "fila.h"
+#include "estatisticas.h"
+
+ /**
+  * @brief Cria uma fila de prioridade vazia.
+  *
+  * @param capacidade Número inicial de elementos que cabem na fila.
+  * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+  * @return Apontador para a fila criada.
+  */
+FilaPrioridade* CriarFilaPrioridade(int capacidade, bool* inf)
+{
+	*inf = false;
+
+	if (capacidade < 1)
+	{
+		capacidade = 1;
+	}
+
+	FilaPrioridade* aux = (FilaPrioridade*)malloc(sizeof(FilaPrioridade));
+
+	if (aux == NULL)
+	{
+		return NULL;
+	}
+
+	aux->elementos = (ElementoFila*)malloc(sizeof(ElementoFila) * capacidade);
+
+	if (aux->elementos == NULL)
+	{
+		free(aux);
+		return NULL;
+	}
+
+	aux->tamanho = 0;
+	aux->capacidade = capacidade;
+
+	*inf = true;
+	return aux;
+}
+
+/**
+ * @brief Liberta a memória alocada para uma fila de prioridade.
+ *
+ * @param f Apontador para a fila a eliminar.
+ */
+void ApagarFilaPrioridade(FilaPrioridade* f)
+{
+	if (f == NULL)
+	{
+		return;
+	}
+
+	free(f->elementos);
+	free(f);
+}
+
+/**
+ * @brief Retira todos os elementos da fila sem libertar a memória.
+ *
+ * @param f Apontador para a fila.
+ */
+void LimparFila(FilaPrioridade* f)
+{
+	if (f != NULL)
+	{
+		f->tamanho = 0;
+	}
+}
+
+/**
+ * @brief Verifica se a fila está vazia.
+ *
+ * @param f Apontador para a fila.
+ * @return true se a fila não tiver elementos, e false caso contrário.
+ */
+bool FilaVazia(FilaPrioridade* f)
+{
+	return f == NULL || f->tamanho == 0;
+}
+
+/**
+ * @brief Insere um elemento na fila de prioridade.
+ *
+ * @param f Apontador para a fila.
+ * @param vertice Identificador do vértice.
+ * @param distancia Prioridade do elemento.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para a fila.
+ */
+FilaPrioridade* InserirFila(FilaPrioridade* f, int vertice, Distancia distancia, bool* inf)
+{
+	*inf = false;
+
+	if (f == NULL)
+	{
+		return NULL;
+	}
+
+	//Duplica a capacidade quando o array está cheio
+	if (f->tamanho == f->capacidade)
+	{
+		ElementoFila* novo = (ElementoFila*)realloc(f->elementos, sizeof(ElementoFila) * f->capacidade * 2);
+
+		if (novo == NULL)
+		{
+			return f;
+		}
+
+		f->elementos = novo;
+		f->capacidade *= 2;
+	}
+
+	CONTAR_ESTATISTICA(operacoesFila, 1);
+
+	//Sobe o novo elemento até o pai ter menor prioridade
+	int i = f->tamanho++;
+
+	while (i > 0)
+	{
+		int pai = (i - 1) / 2;
+
+		if (f->elementos[pai].distancia <= distancia)
+		{
+			break;
+		}
+
+		f->elementos[i] = f->elementos[pai];
+		i = pai;
+	}
+
+	f->elementos[i].distancia = distancia;
+	f->elementos[i].vertice = vertice;
+
+	*inf = true;
+	return f;
+}
+
+/**
+ * @brief Retira o elemento com menor prioridade.
+ *
+ * @param f Apontador para a fila.
+ * @param e Apontador onde o elemento retirado é guardado.
+ * @return true se foi retirado um elemento, e false se a fila estava vazia.
+ */
+bool RetirarMinimoFila(FilaPrioridade* f, ElementoFila* e)
+{
+	if (FilaVazia(f))
+	{
+		return false;
+	}
+
+	CONTAR_ESTATISTICA(operacoesFila, 1);
+	*e = f->elementos[0];
+
+	//Coloca o último elemento na raiz e desce-o até respeitar o heap
+	ElementoFila ultimo = f->elementos[--f->tamanho];
+	int i = 0;
+
+	while (true)
+	{
+		int filho = 2 * i + 1;
+
+		if (filho >= f->tamanho)
+		{
+			break;
+		}
+
+		if (filho + 1 < f->tamanho && f->elementos[filho + 1].distancia < f->elementos[filho].distancia)
+		{
+			filho++;
+		}
+
+		if (ultimo.distancia <= f->elementos[filho].distancia)
+		{
+			break;
+		}
+
+		f->elementos[i] = f->elementos[filho];
+		i = filho;
+	}
+
+	if (f->tamanho > 0)
+	{
+		f->elementos[i] = ultimo;
+	}
+
+	return true;
+}
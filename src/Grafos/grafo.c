@@ -1,275 +1,1195 @@
-/**
- * @file grafo.c
- * @author Hugo Cruz (a23010)
- * @brief Ficheiro de implementação das funções que manipulam a estrutura de dados Grafo.
- * @version 156.1
- * @date 2024-05-24
- *
- * @copyright Copyright (c) 2024
- *
- */
-#include "grafo.h"
-
- /**
-  * @brief Apaga um grafo e limpa a memória alocada.
-  *
-  * Esta função apaga um grafo e liberta a memória alocada. Ela percorre todos os
-  * vértices e adjacências do grafo, apagando-os um a um
-  *
-  * @param g Apontador para o grafo a ser apagado
-  */
-void ApagaGrafo(Grafo* g)
-{
-	if (g == NULL)
-		return;
-
-	Vertice* v = g->inicioGrafo;
-
-	//Apagar todos os vertices e adjacências
-	while (v != NULL)
-	{
-		Adjacente* a = v->nextA;
-		while (a != NULL)
-		{
-			Adjacente* temp = a;
-			a = a->next;
-			ApagarAdjacencia(temp);
-		}
-
-		Vertice* tempV = v;
-		v = v->nextV;
-		ApagarVertice(tempV);
-	}
-
-	free(g);
-}
-
-/**
- * @brief Cria um novo grafo.
- *
- * Esta função cria um novo grafo. Ela aloca memória para um novo grafo e
- * retorna um apontador para o grafo criado.
- *
- * @param inf Apontador para uma variável booleana que será definida como true se a criação do grafo for bem-sucedida, e false caso contrário.
- * @return Apontador para o novo grafo criado.
- */
-Grafo* CriarGrafo(bool* inf)
-{
-	*inf = false;
-
-	Grafo* aux = (Grafo*)malloc(sizeof(Grafo)); //Aloca memória para um grafo
-
-	if (aux == NULL)
-	{
-		*inf = false;
-		return NULL;
-	}
-
-	aux->inicioGrafo = NULL;
-
-	*inf = true;
-	return aux;
-}
-
-/**
- * @brief Insere um novo vértice no grafo
- *
- * Esta função insere um novo vértice no grafo. Ela verifica se o valor do novo
- * vértice já existe e, em seguida, insere-o no fim da lista de vertices.
- *
- * @param g Apontador para o grafo onde o vértice será inserido.
- * @param novo O valor do novo vértice a ser inserido.
- * @param inf Apontador para uma variável booleana que será definida como true se a inserção for bem-sucedida, e false caso contrário.
- * @return Apontador para o grafo com o novo vértice inserido.
- */
-Grafo* InserirVerticeGrafo(Grafo* g, int novo, bool* inf)
-{
-	*inf = false;
-
-	if (g == NULL)
-	{
-		return NULL;
-	}
-	else
-	{
-		//Insere o novo vértice na lista de vertices do grafo
-		g->inicioGrafo = InserirVerticeLista(g->inicioGrafo, novo, &inf);
-
-		if (g->inicioGrafo != NULL)
-		{
-			*inf = true;
-		}
-	}
-
-	return g;
-}
-
-/**
- * @brief Insere uma nova aresta no grafo.
- *
- * Esta função insere uma nova aresta no grafo. Ela verifica se os vértices de
- * origem e destino são válidos e, em seguida, insere a aresta entre eles.
- *
- * @param g Apontador para o grafo onde a aresta será inserida.
- * @param origem O valor do vértice de origem da aresta.
- * @param destino O valor do vértice de destino da aresta.
- * @param peso O peso da aresta a ser inserida.
- * @param inf Apontador para uma variável booleana que será definida como true se a inserção for bem-sucedida, e false caso contrário.
- * @return Apontador para o grafo com a nova aresta inserida.
- */
-Grafo* InserirAdjGrafo(Grafo* g, int origem, int destino, int peso, bool* inf)
-{
-	*inf = false;
-
-	if (g == NULL)
-	{
-		return NULL;
-	}
-	
-	//Coloca se no posição de origem 
-	Vertice* origemVertice = ColocaNumaPosicaoLista(g->inicioGrafo, origem, &inf);
-
-	if (origemVertice == NULL)
-	{
-		*inf = false;
-		return g;
-	}
-
-	//Coloca se no posição de destino
-	Vertice* destinoVertice = ColocaNumaPosicaoLista(g->inicioGrafo, destino, &inf);
-
-	if (destinoVertice == NULL)
-	{
-		*inf = false;
-		return g;
-	}
-
-	//Insere uma adjacência
-	origemVertice->nextA = InserirAdjacenciaLista(origemVertice->nextA, destino, peso, &inf);
-
-	return g;
-}
-
-/**
- * @brief Elimina um vértice do grafo.
- *
- * Esta função elimina um vértice do grafo. Ela verifica se o vértice a
- * ser eliminado existe e, em seguida, remove-o do grafo.
- *
- * @param g Apontador para o grafo do qual o vértice será eliminado.
- * @param id O valor do vértice a ser eliminado.
- * @param inf Apontador para uma variável booleana que será definida como true se a eliminação for bem-sucedida, e false caso contrário.
- * @return Apontador para o grafo com o vértice eliminado.
- */
-Grafo* EliminaVerticeGrafo(Grafo* g, int id, bool* inf)
-{
-	*inf = false;
-
-	if (g == NULL )
-	{
-		return NULL;
-	}
-
-	//Elimina o vértice da lista de vertices do grafo
-	g->inicioGrafo = EliminarVertice(g->inicioGrafo, id, &inf);
-	//Apaga todas as adjacências relacionadas com o id
-	g->inicioGrafo = EliminarTodasAdjacenciasVertice(g->inicioGrafo, id, &inf);
-	
-	return g;
-}
-
-/**
- * @brief Elimina uma aresta do grafo.
- *
- * Esta função elimina uma aresta do grafo. Ela verifica se a aresta a ser eliminada
- * existe e, em seguida, remove-a do grafo.
- *
- * @param g Apontador para o grafo do qual a aresta será eliminada.
- * @param origem O valor do vértice de origem da aresta.
- * @param destino O valor do vértice de destino da aresta.
- * @param inf Apontador para uma variável booleana que será definida como true se a eliminação for bem-sucedida, e false caso contrário.
- * @return Apontador para o grafo com a aresta eliminada.
- */
-Grafo* EliminaAdjGrafo(Grafo* g, int origem, int destino, bool* inf)
-{
-	*inf = false;
-
-	if (g == NULL)
-	{
-		return NULL;
-	}
-
-	//Coloca se no posição de origem
-	Vertice* origemVertice = ColocaNumaPosicaoLista(g->inicioGrafo, origem, &inf);
-
-	if (origemVertice == NULL)
-	{
-		*inf = false;
-		return g;
-	}
-
-	//Coloca se no posição de destino
-	Vertice* destinoVertice = ColocaNumaPosicaoLista(g->inicioGrafo, destino, &inf);
-
-	if (destinoVertice == NULL)
-	{
-		*inf = false;
-		return g;
-	}
-
-	//Apaga um adjacência entre dois vértices
-	origemVertice->nextA = EliminaUmaAdj(origemVertice->nextA, destino, &inf);
-
-	return g;
-}
-
-/**
- * @brief Verifica se existe uma aresta entre dois vértices.
- *
- *  Esta função verifica se existe uma aresta entre dois vértices. Ela percorre todos os vértices e
- *  adjacências do grafo, procurando uma aresta entre os vértices de origem e destino.
- *
- * @param inicio Apontador para o primeiro vértice do grafo.
- * @param origem O valor do vértice de origem da aresta.
- * @param destino O valor do vértice de destino da aresta.
- * @return bool  Retorna true se existe uma aresta entre os vértices origem e destino, e false caso contrário.
- */
-bool ExisteAdjDoisVertices(Vertice* inicio, int origem, int destino)
-{
-	if (inicio == NULL )
-	{
-		return false;
-	}
-
-	if (ExisteVertice(inicio, origem))
-	{
-		Vertice* auxV = inicio;
-
-		while (auxV)
-		{
-			Adjacente* auxA = auxV->nextA;
-
-			while (auxA)
-			{
-				//Procura dois vértices e  informa se os mesmos existem
-				if (auxV->id == origem && auxA->id == destino)
-				{
-					if (auxA->peso > 0)
-					{
-						return true;
-					}
-				}
-
-				auxA = auxA->next;
-			}
-
-			auxV = auxV->nextV;
-		}
-
-		return false;
-	}
-	else
-	{
-		return false;
-	}
-}
\ No newline at end of file
+/**
+ * @file grafo.c
+ * @author Hugo Cruz (a23010)
+ * @brief Ficheiro de implementação das funções que manipulam a estrutura de dados Grafo.
+ * @version 156.1
+ * @date 2024-05-24
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include "grafo.h"
+#include "largura.h"
+
+/**
+ * @brief Memória máxima, em bytes, que um carregamento pode usar (0 se não houver limite).
+ */
+static size_t orcamentoMemoria = 0;
+
+/**
+ * @brief Liberta a lista de adjacências de entrada de um vértice.
+ *
+ * @param v Apontador para o vértice
+ */
+static void ApagarEntradas(Vertice* v)
+{
+	Adjacente* a = v->entradaA;
+
+	while (a != NULL)
+	{
+		Adjacente* temp = a;
+		a = a->next;
+		ApagarAdjacencia(temp);
+	}
+
+	v->entradaA = NULL;
+}
+
+/**
+ * @brief Elimina uma entrada com uma dada origem e peso.
+ *
+ * Com adjacências repetidas entre os mesmos vértices o peso indica qual das entradas corresponde
+ * à adjacência eliminada.
+ *
+ * @param inicio Apontador para o início da lista de entradas
+ * @param origem Vértice de origem da adjacência
+ * @param peso Peso da adjacência
+ * @return Apontador para o início da lista de entradas
+ */
+static Adjacente* EliminaEntrada(Adjacente* inicio, int origem, int peso)
+{
+	Adjacente* aux = inicio;
+	Adjacente* ant = NULL;
+
+	while (aux && (aux->id != origem || aux->peso != peso))
+	{
+		ant = aux;
+		aux = aux->next;
+	}
+
+	if (aux == NULL)
+	{
+		return inicio;
+	}
+
+	if (ant == NULL)
+	{
+		inicio = aux->next;
+	}
+	else
+	{
+		ant->next = aux->next;
+	}
+
+	ApagarAdjacencia(aux);
+	return inicio;
+}
+
+/**
+ * @brief Garante que o índice de vértices tem uma posição para um id.
+ *
+ * @param g Apontador para o grafo com o índice ativo
+ * @param id Identificador do vértice
+ * @return true se o índice tem a posição, e false se o id for negativo ou não houver memória
+ */
+static bool GarantirIndiceGrafo(Grafo* g, int id)
+{
+	if (id < 0)
+	{
+		return false;
+	}
+
+	if (id < g->tamanhoIndice)
+	{
+		return true;
+	}
+
+	//Cresce para o dobro para que inserções seguidas não realoquem sempre
+	int tamanho = g->tamanhoIndice * 2 > id ? g->tamanhoIndice * 2 : id + 1;
+	Vertice** indice = (Vertice**)realloc(g->indice, sizeof(Vertice*) * tamanho);
+
+	if (indice == NULL)
+	{
+		return false;
+	}
+
+	for (int i = g->tamanhoIndice; i < tamanho; i++)
+	{
+		indice[i] = NULL;
+	}
+
+	AjustarMemoriaGrafo(g, 0, 0, (long long)(tamanho - g->tamanhoIndice) * (long long)sizeof(Vertice*));
+	g->indice = indice;
+	g->tamanhoIndice = tamanho;
+	return true;
+}
+
+/**
+ * @brief Procura um vértice pelo id.
+ *
+ * Com o índice de entradas ativo a procura é direta, caso contrário percorre a lista de vértices.
+ *
+ * @param g Apontador para o grafo
+ * @param id Identificador do vértice
+ * @param inf Apontador para um bool que indica se o vértice foi encontrado
+ * @return Apontador para o vértice ou NULL se não existir
+ */
+static Vertice* ProcurarVerticeGrafo(Grafo* g, int id, bool* inf)
+{
+	if (g->indice == NULL)
+	{
+		return ColocaNumaPosicaoLista(g->inicioGrafo, id, inf);
+	}
+
+	Vertice* v = id >= 0 && id < g->tamanhoIndice ? g->indice[id] : NULL;
+	*inf = v != NULL;
+	return v;
+}
+
+ /**
+  * @brief Apaga um grafo e limpa a memória alocada.
+  *
+  * Esta função apaga um grafo e liberta a memória alocada. Ela percorre todos os
+  * vértices e adjacências do grafo, apagando-os um a um
+  *
+  * @param g Apontador para o grafo a ser apagado
+  */
+void ApagaGrafo(Grafo* g)
+{
+	if (g == NULL)
+		return;
+
+	Vertice* v = g->inicioGrafo;
+
+	//Apagar todos os vertices e adjacências
+	while (v != NULL)
+	{
+		Adjacente* a = v->nextA;
+		while (a != NULL)
+		{
+			Adjacente* temp = a;
+			a = a->next;
+			ApagarAdjacencia(temp);
+		}
+
+		ApagarEntradas(v);
+
+		Vertice* tempV = v;
+		v = v->nextV;
+		ApagarVertice(tempV);
+	}
+
+	ApagarCacheCaminhos(g->cache);
+	ApagarMatrizAdjacencia(g->matriz);
+	ApagarEspacoLargura(g->espacoAlcance);
+	ApagarImagemGrafo(g->imagemAlcance);
+	free(g->indice);
+	free(g);
+}
+
+/**
+ * @brief Cria um novo grafo.
+ *
+ * Esta função cria um novo grafo. Ela aloca memória para um novo grafo e
+ * retorna um apontador para o grafo criado.
+ *
+ * @param inf Apontador para uma variável booleana que será definida como true se a criação do grafo for bem-sucedida, e false caso contrário.
+ * @return Apontador para o novo grafo criado.
+ */
+Grafo* CriarGrafo(bool* inf)
+{
+	*inf = false;
+
+	Grafo* aux = (Grafo*)malloc(sizeof(Grafo)); //Aloca memória para um grafo
+
+	if (aux == NULL)
+	{
+		*inf = false;
+		return NULL;
+	}
+
+	aux->inicioGrafo = NULL;
+	aux->versao = 0;
+	aux->cache = NULL;
+	aux->orcamentoCache = CACHE_ORCAMENTO_PADRAO;
+	aux->indice = NULL;
+	aux->tamanhoIndice = 0;
+	aux->matriz = NULL;
+	aux->adjOrdenadas = false;
+	aux->imagemAlcance = NULL;
+	aux->espacoAlcance = NULL;
+	aux->versaoAlcance = 0;
+	aux->memoriaAlcance = 0;
+	aux->memoria = (MemoriaGrafo){ 0 };
+	aux->memoria.vertices = sizeof(Grafo);
+	aux->memoria.pico = sizeof(Grafo);
+
+	*inf = true;
+	return aux;
+}
+
+/**
+ * @brief Insere um novo vértice no grafo
+ *
+ * Esta função insere um novo vértice no grafo. Ela verifica se o valor do novo
+ * vértice já existe e, em seguida, insere-o no fim da lista de vertices.
+ *
+ * @param g Apontador para o grafo onde o vértice será inserido.
+ * @param novo O valor do novo vértice a ser inserido.
+ * @param inf Apontador para uma variável booleana que será definida como true se a inserção for bem-sucedida, e false caso contrário.
+ * @return Apontador para o grafo com o novo vértice inserido.
+ */
+Grafo* InserirVerticeGrafo(Grafo* g, int novo, bool* inf)
+{
+	*inf = false;
+
+	if (g == NULL)
+	{
+		return NULL;
+	}
+	else
+	{
+		//Com o índice ativo é preciso uma posição para o novo id
+		if (g->indice != NULL && !GarantirIndiceGrafo(g, novo))
+		{
+			return g;
+		}
+
+		//Insere o novo vértice na lista de vertices do grafo
+		g->inicioGrafo = InserirVerticeLista(g->inicioGrafo, novo, inf);
+
+		if (*inf)
+		{
+			if (g->indice != NULL)
+			{
+				bool aux;
+				g->indice[novo] = ColocaNumaPosicaoLista(g->inicioGrafo, novo, &aux);
+			}
+
+			AjustarMemoriaGrafo(g, sizeof(Vertice), 0, 0);
+			g->versao++;
+		}
+	}
+
+	return g;
+}
+
+/**
+ * @brief Insere uma aresta numa lista ordenada, ou atualiza o peso se o destino já existir.
+ *
+ * @param g Apontador para o grafo, com as listas ordenadas.
+ * @param origem Vértice de origem.
+ * @param destino Vértice de destino.
+ * @param peso Peso da aresta.
+ * @param inf Apontador para uma variável booleana que será definida como true se a inserção for bem-sucedida, e false caso contrário.
+ * @return Apontador para o grafo.
+ */
+static Grafo* InserirAdjOrdenadaGrafo(Grafo* g, Vertice* origem, Vertice* destino, int peso, bool* inf)
+{
+	Adjacente* entrada = NULL;
+
+	if (g->indice != NULL)
+	{
+		entrada = CriarAdjacencia(origem->id, peso, inf);
+
+		if (entrada == NULL)
+		{
+			*inf = false;
+			return g;
+		}
+	}
+
+	bool nova;
+	origem->nextA = InserirAdjacenciaOrdenada(origem->nextA, destino->id, peso, &nova, inf);
+
+	if (!*inf)
+	{
+		ApagarAdjacencia(entrada);
+		return g;
+	}
+
+	if (nova)
+	{
+		AjustarMemoriaGrafo(g, 0, sizeof(Adjacente), entrada != NULL ? sizeof(Adjacente) : 0);
+	}
+
+	if (entrada != NULL && nova)
+	{
+		entrada->next = destino->entradaA;
+		destino->entradaA = entrada;
+	}
+	else if (entrada != NULL)
+	{
+		//A entrada da adjacência que já existia passa a ter o peso novo
+		for (Adjacente* a = destino->entradaA; a != NULL; a = a->next)
+		{
+			if (a->id == origem->id)
+			{
+				a->peso = peso;
+				break;
+			}
+		}
+
+		ApagarAdjacencia(entrada);
+	}
+
+	g->versao++;
+	return g;
+}
+
+/**
+ * @brief Insere uma nova aresta no grafo.
+ *
+ * Esta função insere uma nova aresta no grafo. Ela verifica se os vértices de
+ * origem e destino são válidos e, em seguida, insere a aresta entre eles.
+ *
+ * @param g Apontador para o grafo onde a aresta será inserida.
+ * @param origem O valor do vértice de origem da aresta.
+ * @param destino O valor do vértice de destino da aresta.
+ * @param peso O peso da aresta a ser inserida (tem de caber em PesoAresta, ver tipos.h).
+ * @param inf Apontador para uma variável booleana que será definida como true se a inserção for bem-sucedida, e false caso contrário.
+ * @return Apontador para o grafo com a nova aresta inserida.
+ */
+Grafo* InserirAdjGrafo(Grafo* g, int origem, int destino, int peso, bool* inf)
+{
+	*inf = false;
+
+	if (g == NULL)
+	{
+		return NULL;
+	}
+
+	//O peso tem de caber no tipo PesoAresta escolhido na compilação
+	if (!PESO_VALIDO(peso) || !ExpandirMatrizGrafo(g))
+	{
+		return g;
+	}
+	
+	//Coloca se no posição de origem 
+	Vertice* origemVertice = ProcurarVerticeGrafo(g, origem, inf);
+
+	if (origemVertice == NULL)
+	{
+		*inf = false;
+		return g;
+	}
+
+	//Coloca se no posição de destino
+	Vertice* destinoVertice = ProcurarVerticeGrafo(g, destino, inf);
+
+	if (destinoVertice == NULL)
+	{
+		*inf = false;
+		return g;
+	}
+
+	//Com as listas ordenadas um destino repetido só atualiza o peso
+	if (g->adjOrdenadas)
+	{
+		return InserirAdjOrdenadaGrafo(g, origemVertice, destinoVertice, peso, inf);
+	}
+
+	//Com o índice ativo a entrada é criada antes para não ficar uma adjacência sem entrada
+	Adjacente* entrada = NULL;
+
+	if (g->indice != NULL)
+	{
+		entrada = CriarAdjacencia(origem, peso, inf);
+
+		if (entrada == NULL)
+		{
+			*inf = false;
+			return g;
+		}
+	}
+
+	//Insere uma adjacência
+	origemVertice->nextA = InserirAdjacenciaLista(origemVertice->nextA, destino, peso, inf);
+
+	if (*inf)
+	{
+		if (entrada != NULL)
+		{
+			entrada->next = destinoVertice->entradaA;
+			destinoVertice->entradaA = entrada;
+		}
+
+		AjustarMemoriaGrafo(g, 0, sizeof(Adjacente), entrada != NULL ? sizeof(Adjacente) : 0);
+		g->versao++;
+	}
+	else
+	{
+		ApagarAdjacencia(entrada);
+	}
+
+	return g;
+}
+
+/**
+ * @brief Elimina um vértice usando o índice de entradas.
+ *
+ * Só são visitados os vértices que têm adjacências para o vértice eliminado e os destinos das
+ * adjacências que saem dele, pelo que o custo depende do grau do vértice e não do tamanho do grafo.
+ *
+ * @param g Apontador para o grafo, com o índice de entradas ativo.
+ * @param id O valor do vértice a ser eliminado.
+ * @param inf Apontador para uma variável booleana que será definida como true se a eliminação for bem-sucedida, e false caso contrário.
+ * @return Apontador para o grafo.
+ */
+static Grafo* EliminaVerticeIndexado(Grafo* g, int id, bool* inf)
+{
+	bool aux;
+	Vertice* v = ProcurarVerticeGrafo(g, id, inf);
+
+	if (v == NULL)
+	{
+		return g;
+	}
+
+	//Adjacências e entradas apagadas, para os contadores de memória
+	long long adjacencias = 0, entradas = 0;
+
+	//Apaga as adjacências que chegam ao vértice, uma por cada entrada
+	for (Adjacente* e = v->entradaA; e != NULL; e = e->next)
+	{
+		Vertice* origem = e->id != id ? ProcurarVerticeGrafo(g, e->id, &aux) : NULL;
+
+		if (origem != NULL)
+		{
+			origem->nextA = EliminaUmaAdj(origem->nextA, id, &aux);
+			adjacencias += aux;
+		}
+
+		entradas++;
+	}
+
+	//Apaga as entradas que o vértice criou nos seus destinos
+	for (Adjacente* a = v->nextA; a != NULL; a = a->next)
+	{
+		Vertice* destino = a->id != id ? ProcurarVerticeGrafo(g, a->id, &aux) : NULL;
+
+		if (destino != NULL)
+		{
+			destino->entradaA = EliminaEntrada(destino->entradaA, id, a->peso);
+			entradas++;
+		}
+
+		adjacencias++;
+	}
+
+	g->inicioGrafo = DesligarVertice(g->inicioGrafo, v);
+	g->indice[id] = NULL;
+	AjustarMemoriaGrafo(g, -(long long)sizeof(Vertice), -adjacencias * (long long)sizeof(Adjacente),
+		-entradas * (long long)sizeof(Adjacente));
+
+	v->nextA = ElimanaTodasAdj(v->nextA, &aux);
+	ApagarEntradas(v);
+	ApagarVertice(v);
+
+	g->versao++;
+	*inf = true;
+	return g;
+}
+
+/**
+ * @brief Elimina um vértice do grafo.
+ *
+ * Esta função elimina um vértice do grafo. Ela verifica se o vértice a
+ * ser eliminado existe e, em seguida, remove-o do grafo. Com o índice de entradas
+ * ativo só são visitados os vizinhos do vértice.
+ *
+ * @param g Apontador para o grafo do qual o vértice será eliminado.
+ * @param id O valor do vértice a ser eliminado.
+ * @param inf Apontador para uma variável booleana que será definida como true se a eliminação for bem-sucedida, e false caso contrário.
+ * @return Apontador para o grafo com o vértice eliminado.
+ */
+Grafo* EliminaVerticeGrafo(Grafo* g, int id, bool* inf)
+{
+	*inf = false;
+
+	if (g == NULL )
+	{
+		return NULL;
+	}
+
+	if (!ExpandirMatrizGrafo(g))
+	{
+		return g;
+	}
+
+	if (g->indice != NULL)
+	{
+		return EliminaVerticeIndexado(g, id, inf);
+	}
+
+	//As adjacências do vértice são contadas antes de serem apagadas com ele
+	Vertice* v = ColocaNumaPosicaoLista(g->inicioGrafo, id, inf);
+	long long adjacencias = 0;
+
+	for (Adjacente* a = v != NULL ? v->nextA : NULL; a != NULL; a = a->next)
+	{
+		adjacencias++;
+	}
+
+	//Elimina o vértice da lista de vertices do grafo
+	g->inicioGrafo = EliminarVertice(g->inicioGrafo, id, inf);
+
+	if (*inf == false)
+	{
+		return g;
+	}
+
+	//Apaga todas as adjacências relacionadas com o id, incluindo as repetidas
+	for (Vertice* aux = g->inicioGrafo; aux != NULL; aux = aux->nextV)
+	{
+		bool apagada;
+
+		do
+		{
+			aux->nextA = EliminaUmaAdj(aux->nextA, id, &apagada);
+			adjacencias += apagada;
+		} while (apagada);
+	}
+
+	AjustarMemoriaGrafo(g, -(long long)sizeof(Vertice), -adjacencias * (long long)sizeof(Adjacente), 0);
+	g->versao++;
+
+	return g;
+}
+
+/**
+ * @brief Elimina uma aresta do grafo.
+ *
+ * Esta função elimina uma aresta do grafo. Ela verifica se a aresta a ser eliminada
+ * existe e, em seguida, remove-a do grafo.
+ *
+ * @param g Apontador para o grafo do qual a aresta será eliminada.
+ * @param origem O valor do vértice de origem da aresta.
+ * @param destino O valor do vértice de destino da aresta.
+ * @param inf Apontador para uma variável booleana que será definida como true se a eliminação for bem-sucedida, e false caso contrário.
+ * @return Apontador para o grafo com a aresta eliminada.
+ */
+Grafo* EliminaAdjGrafo(Grafo* g, int origem, int destino, bool* inf)
+{
+	*inf = false;
+
+	if (g == NULL)
+	{
+		return NULL;
+	}
+
+	if (!ExpandirMatrizGrafo(g))
+	{
+		return g;
+	}
+
+	//Coloca se no posição de origem
+	Vertice* origemVertice = ProcurarVerticeGrafo(g, origem, inf);
+
+	if (origemVertice == NULL)
+	{
+		*inf = false;
+		return g;
+	}
+
+	//Coloca se no posição de destino
+	Vertice* destinoVertice = ProcurarVerticeGrafo(g, destino, inf);
+
+	if (destinoVertice == NULL)
+	{
+		*inf = false;
+		return g;
+	}
+
+	//Guarda o peso da adjacência que vai ser apagada para eliminar a entrada correspondente
+	Adjacente* aux = origemVertice->nextA;
+
+	while (aux && aux->id != destino)
+	{
+		aux = aux->next;
+	}
+
+	int peso = aux != NULL ? aux->peso : 0;
+
+	//Apaga um adjacência entre dois vértices
+	origemVertice->nextA = EliminaUmaAdj(origemVertice->nextA, destino, inf);
+
+	if (*inf)
+	{
+		if (g->indice != NULL)
+		{
+			destinoVertice->entradaA = EliminaEntrada(destinoVertice->entradaA, origem, peso);
+		}
+
+		AjustarMemoriaGrafo(g, 0, -(long long)sizeof(Adjacente), g->indice != NULL ? -(long long)sizeof(Adjacente) : 0);
+		g->versao++;
+	}
+
+	return g;
+}
+
+/**
+ * @brief Verifica se existe uma aresta entre dois vértices.
+ *
+ *  Esta função verifica se existe uma aresta entre dois vértices. Ela percorre todos os vértices e
+ *  adjacências do grafo, procurando uma aresta entre os vértices de origem e destino.
+ *
+ * @param inicio Apontador para o primeiro vértice do grafo.
+ * @param origem O valor do vértice de origem da aresta.
+ * @param destino O valor do vértice de destino da aresta.
+ * @return bool  Retorna true se existe uma aresta entre os vértices origem e destino, e false caso contrário.
+ */
+bool ExisteAdjDoisVertices(Vertice* inicio, int origem, int destino)
+{
+	if (inicio == NULL )
+	{
+		return false;
+	}
+
+	if (ExisteVertice(inicio, origem))
+	{
+		Vertice* auxV = inicio;
+
+		while (auxV)
+		{
+			Adjacente* auxA = auxV->nextA;
+
+			while (auxA)
+			{
+				//Procura dois vértices e  informa se os mesmos existem
+				if (auxV->id == origem && auxA->id == destino)
+				{
+					//Peso 0 indica que não existe ligação, pesos negativos são válidos
+					if (auxA->peso != 0)
+					{
+						return true;
+					}
+				}
+
+				auxA = auxA->next;
+			}
+
+			auxV = auxV->nextV;
+		}
+
+		return false;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+/**
+ * @brief Configura a cache de caminhos mais curtos de um grafo.
+ *
+ * Esta função altera a memória máxima que a cache de caminhos do grafo pode ocupar. Um orçamento
+ * de 0 desativa a cache e descarta as árvores guardadas.
+ *
+ * @param g Apontador para o grafo.
+ * @param orcamento Memória máxima, em bytes, da cache.
+ * @param inf Apontador para uma variável booleana que será definida como true se a configuração for bem-sucedida, e false caso contrário.
+ * @return Apontador para o grafo.
+ */
+Grafo* ConfigurarCacheGrafo(Grafo* g, size_t orcamento, bool* inf)
+{
+	*inf = false;
+
+	if (g == NULL)
+	{
+		return NULL;
+	}
+
+	g->orcamentoCache = orcamento;
+
+	//A cache só é criada na primeira pesquisa, aqui apenas se ajusta a existente
+	if (orcamento == 0)
+	{
+		LimparCacheCaminhos(g->cache);
+	}
+
+	AlterarOrcamentoCache(g->cache, orcamento);
+
+	*inf = true;
+	return g;
+}
+
+/**
+ * @brief Devolve as estatísticas da cache de caminhos de um grafo.
+ *
+ * @param g Apontador para o grafo.
+ * @return EstatisticasCache Acertos, falhas e memória da cache (tudo a 0 se a cache não existir).
+ */
+EstatisticasCache ObterEstatisticasCacheGrafo(Grafo* g)
+{
+	EstatisticasCache e = { 0 };
+
+	if (g == NULL)
+	{
+		return e;
+	}
+
+	e.orcamento = g->orcamentoCache;
+
+	if (g->cache != NULL)
+	{
+		e.acertos = g->cache->acertos;
+		e.falhas = g->cache->falhas;
+		e.entradas = g->cache->entradas;
+		e.ocupado = g->cache->ocupado;
+	}
+
+	return e;
+}
+
+/**
+ * @brief Ativa ou desativa o índice de entradas de um grafo.
+ *
+ * Com o índice ativo cada vértice guarda as adjacências que chegam a ele (entradaA) e o grafo
+ * guarda um array com o vértice de cada id. As funções InserirAdjGrafo e EliminaAdjGrafo mantêm o
+ * índice, e EliminaVerticeGrafo passa a visitar apenas os vizinhos do vértice eliminado em vez de
+ * todas as adjacências do grafo. O índice também permite pesquisas no sentido inverso.
+ * Os ids dos vértices têm de ser não negativos enquanto o índice estiver ativo.
+ *
+ * @param g Apontador para o grafo.
+ * @param ativo true para construir o índice, false para o apagar.
+ * @param inf Apontador para uma variável booleana que será definida como true se a configuração for bem-sucedida, e false caso contrário.
+ * @return Apontador para o grafo.
+ */
+Grafo* ConfigurarIndiceEntradasGrafo(Grafo* g, bool ativo, bool* inf)
+{
+	*inf = false;
+
+	if (g == NULL)
+	{
+		return NULL;
+	}
+
+	//Desativar apaga as entradas e o índice
+	if (!ativo || g->indice != NULL)
+	{
+		for (Vertice* v = g->inicioGrafo; v != NULL; v = v->nextV)
+		{
+			ApagarEntradas(v);
+		}
+
+		free(g->indice);
+		g->indice = NULL;
+		g->tamanhoIndice = 0;
+		RecontarMemoriaGrafo(g);
+
+		if (!ativo)
+		{
+			*inf = true;
+			return g;
+		}
+	}
+
+	//As entradas são criadas a partir das listas de adjacências
+	if (!ExpandirMatrizGrafo(g))
+	{
+		return g;
+	}
+
+	//Primeira passagem: indexa os vértices pelo id
+	for (Vertice* v = g->inicioGrafo; v != NULL; v = v->nextV)
+	{
+		if (!GarantirIndiceGrafo(g, v->id))
+		{
+			free(g->indice);
+			g->indice = NULL;
+			g->tamanhoIndice = 0;
+			RecontarMemoriaGrafo(g);
+			return g;
+		}
+
+		g->indice[v->id] = v;
+	}
+
+	//Garante que o índice existe mesmo num grafo sem vértices
+	if (g->indice == NULL && !GarantirIndiceGrafo(g, 0))
+	{
+		return g;
+	}
+
+	//Segunda passagem: cria uma entrada no destino de cada adjacência
+	for (Vertice* v = g->inicioGrafo; v != NULL; v = v->nextV)
+	{
+		for (Adjacente* a = v->nextA; a != NULL; a = a->next)
+		{
+			Vertice* destino = a->id >= 0 && a->id < g->tamanhoIndice ? g->indice[a->id] : NULL;
+
+			if (destino == NULL)
+			{
+				continue;
+			}
+
+			Adjacente* entrada = CriarAdjacencia(v->id, a->peso, inf);
+
+			//Sem memória o índice fica desativado
+			if (entrada == NULL)
+			{
+				ConfigurarIndiceEntradasGrafo(g, false, inf);
+				*inf = false;
+				return g;
+			}
+
+			entrada->next = destino->entradaA;
+			destino->entradaA = entrada;
+		}
+	}
+
+	RecontarMemoriaGrafo(g);
+	*inf = true;
+	return g;
+}
+
+/**
+ * @brief Devolve as adjacências que chegam a um vértice.
+ *
+ * Cada elemento da lista tem o id do vértice de origem e o peso da adjacência.
+ *
+ * @param g Apontador para o grafo.
+ * @param id Identificador do vértice.
+ * @return Apontador para a primeira entrada, ou NULL se não existirem entradas ou o índice estiver desativado.
+ */
+Adjacente* EntradasVertice(Grafo* g, int id)
+{
+	bool inf;
+
+	if (g == NULL || g->indice == NULL)
+	{
+		return NULL;
+	}
+
+	Vertice* v = ProcurarVerticeGrafo(g, id, &inf);
+	return v != NULL ? v->entradaA : NULL;
+}
+
+/**
+ * @brief Passa as adjacências guardadas na matriz densa para as listas de adjacências.
+ *
+ * As funções que alteram as adjacências, e as que precisam das listas, chamam esta função antes
+ * de as usar. As adjacências de cada vértice ficam pela ordem das colunas e a versão do grafo
+ * não muda, porque as ligações são as mesmas.
+ *
+ * @param g Apontador para o grafo.
+ * @return true se as adjacências estão todas nas listas, e false se não houver memória (a matriz é mantida).
+ */
+bool ExpandirMatrizGrafo(Grafo* g)
+{
+	if (g == NULL || g->matriz == NULL)
+	{
+		return true;
+	}
+
+	MatrizAdjacencia* m = g->matriz;
+	bool inf = true;
+	long long criadas = 0;
+
+	//Com a matriz ativa as listas estão vazias, pelo que cada lista é criada do início
+	for (Vertice* v = g->inicioGrafo; v != NULL && inf; v = v->nextV)
+	{
+		if (v->id < 0 || v->id >= m->tamanho)
+		{
+			continue;
+		}
+
+		Adjacente** fim = &v->nextA;
+
+		for (int w = ProximaLigacaoMatriz(m, v->id, 0); w >= 0 && inf; w = ProximaLigacaoMatriz(m, v->id, w + 1))
+		{
+			*fim = CriarAdjacencia(w, PesoLigacaoMatriz(m, v->id, w), &inf);
+
+			if (*fim != NULL)
+			{
+				fim = &(*fim)->next;
+				criadas++;
+			}
+		}
+	}
+
+	//Sem memória as listas criadas são apagadas e o grafo continua na matriz
+	if (!inf)
+	{
+		for (Vertice* v = g->inicioGrafo; v != NULL; v = v->nextV)
+		{
+			while (v->nextA != NULL)
+			{
+				Adjacente* a = v->nextA;
+				v->nextA = a->next;
+				ApagarAdjacencia(a);
+			}
+		}
+
+		return false;
+	}
+
+	//As listas e a matriz chegam a existir ao mesmo tempo, o que conta para o pico
+	AjustarMemoriaGrafo(g, 0, criadas * (long long)sizeof(Adjacente), 0);
+	AjustarMemoriaGrafo(g, 0, -(long long)MemoriaMatrizAdjacencia(m), 0);
+	ApagarMatrizAdjacencia(m);
+	g->matriz = NULL;
+	return true;
+}
+
+/**
+ * @brief Ativa ou desativa as listas de adjacências ordenadas de um grafo.
+ *
+ * Com a opção ativa cada lista de adjacências fica ordenada pelo destino e sem destinos
+ * repetidos: ao ativar, as listas são ordenadas e as adjacências repetidas são juntadas (fica o
+ * peso da última inserida), e depois InserirAdjGrafo com um destino que já existe só atualiza o
+ * peso. As imagens criadas a partir do grafo ficam também ordenadas, o que permite procurar uma
+ * adjacência por pesquisa binária e intersetar vizinhanças por junção (ver imagem.h).
+ *
+ * @param g Apontador para o grafo.
+ * @param ativo true para manter as listas ordenadas, false para voltar a inserir no fim das listas.
+ * @param inf Apontador para uma variável booleana que será definida como true se a configuração for bem-sucedida, e false caso contrário.
+ * @return Apontador para o grafo.
+ */
+Grafo* ConfigurarAdjOrdenadasGrafo(Grafo* g, bool ativo, bool* inf)
+{
+	*inf = false;
+
+	if (g == NULL)
+	{
+		return NULL;
+	}
+
+	g->adjOrdenadas = ativo;
+
+	if (!ativo)
+	{
+		*inf = true;
+		return g;
+	}
+
+	return OrdenarAdjacenciasGrafo(g, inf);
+}
+
+/**
+ * @brief Ordena as listas de adjacências de um grafo e junta os destinos repetidos.
+ *
+ * As listas que já estão ordenadas só são percorridas. As funções que alteram várias listas de
+ * uma vez (lotes, construção concorrente, renumeração) chamam esta função quando a opção de
+ * listas ordenadas está ativa.
+ *
+ * @param g Apontador para o grafo.
+ * @param inf Apontador para uma variável booleana que será definida como true se a ordenação for bem-sucedida, e false caso contrário.
+ * @return Apontador para o grafo.
+ */
+Grafo* OrdenarAdjacenciasGrafo(Grafo* g, bool* inf)
+{
+	*inf = false;
+
+	if (g == NULL)
+	{
+		return NULL;
+	}
+
+	//As linhas da matriz já estão ordenadas e não têm repetidos
+	if (g->matriz != NULL)
+	{
+		*inf = true;
+		return g;
+	}
+
+	int removidas = 0;
+
+	for (Vertice* v = g->inicioGrafo; v != NULL; v = v->nextV)
+	{
+		v->nextA = OrdenarListaAdjacencias(v->nextA, &removidas);
+	}
+
+	*inf = true;
+
+	//Juntar repetidos altera as ligações do grafo e deixa entradas a mais no índice
+	if (removidas > 0)
+	{
+		AjustarMemoriaGrafo(g, 0, -(long long)removidas * (long long)sizeof(Adjacente), 0);
+		g->versao++;
+
+		if (g->indice != NULL)
+		{
+			g = ConfigurarIndiceEntradasGrafo(g, true, inf);
+		}
+	}
+
+	return g;
+}
+
+/**
+ * @brief Verifica se existe uma ligação entre dois vértices de um grafo.
+ *
+ * O vértice de origem é obtido pelo índice, se estiver ativo, e a lista de adjacências só é
+ * percorrida até ao destino, ou até ao primeiro destino maior se as listas estiverem ordenadas.
+ * Num grafo em matriz a consulta é direta.
+ *
+ * @param g Apontador para o grafo.
+ * @param origem O valor do vértice de origem.
+ * @param destino O valor do vértice de destino.
+ * @return true se existir uma adjacência com peso diferente de 0, e false caso contrário.
+ */
+bool ExisteAdjGrafo(Grafo* g, int origem, int destino)
+{
+	bool inf;
+
+	if (g == NULL)
+	{
+		return false;
+	}
+
+	if (g->matriz != NULL)
+	{
+		MatrizAdjacencia* m = g->matriz;
+		return origem >= 0 && origem < m->tamanho && destino >= 0 && destino < m->tamanho &&
+			PesoLigacaoMatriz(m, origem, destino) != 0;
+	}
+
+	Vertice* v = ProcurarVerticeGrafo(g, origem, &inf);
+
+	if (v == NULL)
+	{
+		return false;
+	}
+
+	for (Adjacente* a = v->nextA; a != NULL; a = a->next)
+	{
+		if (a->id == destino && a->peso != 0)
+		{
+			return true;
+		}
+
+		if (g->adjOrdenadas && a->id >= destino)
+		{
+			return false;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * @brief Devolve a memória ocupada por um grafo, por categoria.
+ *
+ * Os contadores são mantidos pelas funções que alteram o grafo, pelo que o custo é constante. O
+ * pico inclui a memória ocupada entre chamadas desta função, por exemplo por inserções seguidas
+ * de eliminações.
+ *
+ * @param g Apontador para o grafo.
+ * @return MemoriaGrafo Memória ocupada (tudo a 0 se o grafo não existir).
+ */
+MemoriaGrafo ContabilizarMemoriaGrafo(Grafo* g)
+{
+	MemoriaGrafo m = { 0 };
+
+	if (g == NULL)
+	{
+		return m;
+	}
+
+	AjustarMemoriaGrafo(g, 0, 0, 0);
+
+	m = g->memoria;
+	m.caches = ObterEstatisticasCacheGrafo(g).ocupado + g->memoriaAlcance;
+	m.total = m.vertices + m.adjacencias + m.indices + m.caches;
+	return m;
+}
+
+/**
+ * @brief Soma variações aos contadores de memória de um grafo e atualiza o pico.
+ *
+ * É usada pelos módulos que alocam ou libertam vértices e adjacências diretamente (lotes,
+ * carregamentos) e, com variações a 0, depois de a cache de caminhos ou a imagem de alcance crescerem.
+ *
+ * @param g Apontador para o grafo.
+ * @param vertices Variação, em bytes, dos vértices.
+ * @param adjacencias Variação, em bytes, das listas de adjacências e da matriz densa.
+ * @param indices Variação, em bytes, do array de vértices por id e das listas de entradas.
+ */
+void AjustarMemoriaGrafo(Grafo* g, long long vertices, long long adjacencias, long long indices)
+{
+	if (g == NULL)
+	{
+		return;
+	}
+
+	MemoriaGrafo* m = &g->memoria;
+
+	m->vertices = (size_t)((long long)m->vertices + vertices);
+	m->adjacencias = (size_t)((long long)m->adjacencias + adjacencias);
+	m->indices = (size_t)((long long)m->indices + indices);
+
+	size_t total = m->vertices + m->adjacencias + m->indices + (g->cache != NULL ? g->cache->ocupado : 0) + g->memoriaAlcance;
+
+	if (total > m->pico)
+	{
+		m->pico = total;
+	}
+}
+
+/**
+ * @brief Volta a contar a memória de um grafo percorrendo todas as listas, e atualiza o pico.
+ *
+ * O custo é linear no tamanho do grafo. É usada pelas operações que já percorrem o grafo inteiro
+ * e só acrescentam memória, como a construção concorrente e a reconstrução do índice de entradas.
+ *
+ * @param g Apontador para o grafo.
+ */
+void RecontarMemoriaGrafo(Grafo* g)
+{
+	if (g == NULL)
+	{
+		return;
+	}
+
+	MemoriaGrafo* m = &g->memoria;
+
+	m->vertices = sizeof(Grafo);
+	m->adjacencias = 0;
+	m->indices = 0;
+
+	for (Vertice* v = g->inicioGrafo; v != NULL; v = v->nextV)
+	{
+		m->vertices += sizeof(Vertice);
+
+		for (Adjacente* a = v->nextA; a != NULL; a = a->next)
+		{
+			m->adjacencias += sizeof(Adjacente);
+		}
+
+		for (Adjacente* a = v->entradaA; a != NULL; a = a->next)
+		{
+			m->indices += sizeof(Adjacente);
+		}
+	}
+
+	if (g->indice != NULL)
+	{
+		m->indices += (size_t)g->tamanhoIndice * sizeof(Vertice*);
+	}
+
+	m->adjacencias += MemoriaMatrizAdjacencia(g->matriz);
+	AjustarMemoriaGrafo(g, 0, 0, 0);
+}
+
+/**
+ * @brief Define a memória máxima que um carregamento pode usar.
+ *
+ * @param bytes Memória máxima, em bytes (0 retira o limite).
+ */
+void DefinirOrcamentoMemoria(size_t bytes)
+{
+	orcamentoMemoria = bytes;
+}
+
+/**
+ * @brief Devolve o orçamento de memória dos carregamentos.
+ *
+ * @return size_t Memória máxima, em bytes (0 se não houver limite).
+ */
+size_t ObterOrcamentoMemoria(void)
+{
+	return orcamentoMemoria;
+}
+
+/**
+ * @brief Verifica se uma quantidade de memória cabe no orçamento dos carregamentos.
+ *
+ * @param bytes Memória necessária, em bytes.
+ * @return true se não houver orçamento ou se bytes não o ultrapassar, e false caso contrário.
+ */
+bool CabeNoOrcamentoMemoria(size_t bytes)
+{
+	return orcamentoMemoria == 0 || bytes <= orcamentoMemoria;
+}
@@ -0,0 +1,502 @@
+/**
+ * @file imagem.c
+ * @author Hugo Cruz (a23010)
+ * @brief Implementação das imagens imutáveis de um grafo em formato compacto (CSR).
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include <string.h>
+#include "imagem.h"
+
+ /**
+  * @brief Verifica se uma adjacência é uma ligação que deve ficar na imagem.
+  *
+  * @param im Apontador para a imagem, com os vértices já marcados.
+  * @param a Apontador para a adjacência.
+  * @return true se o peso for diferente de 0 e o destino existir.
+  */
+static bool LigacaoImagem(ImagemGrafo* im, Adjacente* a)
+{
+	return a->peso != 0 && a->id >= 0 && a->id < im->tamanho && im->existe[a->id];
+}
+
+/**
+ * @brief Copia as ligações de um vértice guardadas na matriz densa do grafo.
+ *
+ * @param im Apontador para a imagem, com os vértices já marcados.
+ * @param m Apontador para a matriz do grafo.
+ * @param u Vértice de origem.
+ * @param posicao Primeira posição a escrever em destinos e pesos (-1 para apenas contar).
+ * @return int Número de ligações do vértice.
+ */
+static int LigacoesMatrizImagem(ImagemGrafo* im, MatrizAdjacencia* m, int u, int posicao)
+{
+	int n = 0;
+
+	if (u >= m->tamanho)
+	{
+		return 0;
+	}
+
+	for (int w = ProximaLigacaoMatriz(m, u, 0); w >= 0; w = ProximaLigacaoMatriz(m, u, w + 1))
+	{
+		if (w < im->tamanho && im->existe[w])
+		{
+			if (posicao >= 0)
+			{
+				im->destinos[posicao + n] = w;
+				im->pesos[posicao + n] = PesoLigacaoMatriz(m, u, w);
+			}
+
+			n++;
+		}
+	}
+
+	return n;
+}
+
+/**
+ * @brief Cria uma imagem com as ligações atuais de um grafo.
+ *
+ * As adjacências são copiadas em duas passagens: a primeira conta as ligações de cada vértice e a
+ * segunda copia os pares (destino, peso) para a posição final. Se o grafo estiver numa matriz
+ * densa, as ligações são lidas dos conjuntos de bits de cada linha.
+ *
+ * @param g Apontador para o grafo.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para a imagem criada.
+ */
+ImagemGrafo* CriarImagemGrafo(Grafo* g, bool* inf)
+{
+	*inf = false;
+
+	if (g == NULL)
+	{
+		return NULL;
+	}
+
+	ImagemGrafo* im = (ImagemGrafo*)calloc(1, sizeof(ImagemGrafo));
+
+	if (im == NULL)
+	{
+		return NULL;
+	}
+
+	int maior = -1;
+
+	for (Vertice* v = g->inicioGrafo; v != NULL; v = v->nextV)
+	{
+		if (v->id > maior) maior = v->id;
+	}
+
+	im->versao = g->versao;
+	im->tamanho = maior + 1;
+
+	int n = im->tamanho > 0 ? im->tamanho : 1;
+	im->existe = (bool*)calloc(n, sizeof(bool));
+	im->inicio = (int*)calloc(n + 1, sizeof(int));
+
+	if (im->existe == NULL || im->inicio == NULL)
+	{
+		ApagarImagemGrafo(im);
+		return NULL;
+	}
+
+	for (Vertice* v = g->inicioGrafo; v != NULL; v = v->nextV)
+	{
+		if (v->id >= 0)
+		{
+			im->existe[v->id] = true;
+			im->numVertices++;
+		}
+	}
+
+	//Primeira passagem: conta as ligações de cada vértice
+	for (Vertice* v = g->inicioGrafo; v != NULL; v = v->nextV)
+	{
+		if (v->id < 0)
+		{
+			continue;
+		}
+
+		if (g->matriz != NULL)
+		{
+			im->inicio[v->id + 1] = LigacoesMatrizImagem(im, g->matriz, v->id, -1);
+			continue;
+		}
+
+		for (Adjacente* a = v->nextA; a != NULL; a = a->next)
+		{
+			if (LigacaoImagem(im, a))
+			{
+				im->inicio[v->id + 1]++;
+			}
+		}
+	}
+
+	for (int i = 0; i < im->tamanho; i++)
+	{
+		im->inicio[i + 1] += im->inicio[i];
+	}
+
+	im->numArestas = im->inicio[im->tamanho > 0 ? im->tamanho : 0];
+	im->destinos = (int*)malloc(sizeof(int) * (im->numArestas > 0 ? im->numArestas : 1));
+	im->pesos = (PesoAresta*)malloc(sizeof(PesoAresta) * (im->numArestas > 0 ? im->numArestas : 1));
+
+	if (im->destinos == NULL || im->pesos == NULL)
+	{
+		ApagarImagemGrafo(im);
+		return NULL;
+	}
+
+	//Segunda passagem: copia os pares (destino, peso)
+	for (Vertice* v = g->inicioGrafo; v != NULL; v = v->nextV)
+	{
+		if (v->id < 0)
+		{
+			continue;
+		}
+
+		int posicao = im->inicio[v->id];
+
+		if (g->matriz != NULL)
+		{
+			LigacoesMatrizImagem(im, g->matriz, v->id, posicao);
+			continue;
+		}
+
+		for (Adjacente* a = v->nextA; a != NULL; a = a->next)
+		{
+			if (LigacaoImagem(im, a))
+			{
+				im->destinos[posicao] = a->id;
+				im->pesos[posicao] = a->peso;
+				posicao++;
+			}
+		}
+	}
+
+	//Verifica se cada vértice tem os destinos por ordem crescente
+	im->ordenada = true;
+
+	for (int u = 0; u < im->tamanho && im->ordenada; u++)
+	{
+		for (int i = im->inicio[u] + 1; i < im->inicio[u + 1]; i++)
+		{
+			if (im->destinos[i - 1] >= im->destinos[i])
+			{
+				im->ordenada = false;
+				break;
+			}
+		}
+	}
+
+	*inf = true;
+	return im;
+}
+
+/**
+ * @brief Cria a imagem inversa de outra imagem, com o sentido de todas as ligações trocado.
+ *
+ * As ligações são distribuídas por destino numa ordenação por contagem: primeiro conta-se quantas
+ * chegam a cada vértice e depois cada uma é copiada para a posição do seu destino. Como as origens
+ * são percorridas por ordem crescente, as entradas de cada vértice ficam também por ordem.
+ *
+ * @param im Apontador para a imagem.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para a imagem inversa criada.
+ */
+ImagemGrafo* InverterImagemGrafo(ImagemGrafo* im, bool* inf)
+{
+	*inf = false;
+
+	if (im == NULL)
+	{
+		return NULL;
+	}
+
+	ImagemGrafo* inv = (ImagemGrafo*)calloc(1, sizeof(ImagemGrafo));
+
+	if (inv == NULL)
+	{
+		return NULL;
+	}
+
+	int n = im->tamanho > 0 ? im->tamanho : 1;
+	inv->versao = im->versao;
+	inv->tamanho = im->tamanho;
+	inv->numVertices = im->numVertices;
+	inv->numArestas = im->numArestas;
+	inv->existe = (bool*)malloc(sizeof(bool) * n);
+	inv->inicio = (int*)calloc(n + 1, sizeof(int));
+	inv->destinos = (int*)malloc(sizeof(int) * (im->numArestas > 0 ? im->numArestas : 1));
+	inv->pesos = (PesoAresta*)malloc(sizeof(PesoAresta) * (im->numArestas > 0 ? im->numArestas : 1));
+
+	if (inv->existe == NULL || inv->inicio == NULL || inv->destinos == NULL || inv->pesos == NULL)
+	{
+		ApagarImagemGrafo(inv);
+		return NULL;
+	}
+
+	memcpy(inv->existe, im->existe, sizeof(bool) * n);
+
+	//Conta as entradas de cada vértice, já deslocadas de uma posição para a soma acumulada
+	for (int i = 0; i < im->numArestas; i++)
+	{
+		inv->inicio[im->destinos[i] + 1]++;
+	}
+
+	for (int i = 0; i < im->tamanho; i++)
+	{
+		inv->inicio[i + 1] += inv->inicio[i];
+	}
+
+	//inicio[v] avança à medida que as entradas de v são copiadas e no fim é reposto
+	for (int u = 0; u < im->tamanho; u++)
+	{
+		for (int i = im->inicio[u]; i < im->inicio[u + 1]; i++)
+		{
+			int posicao = inv->inicio[im->destinos[i]]++;
+			inv->destinos[posicao] = u;
+			inv->pesos[posicao] = im->pesos[i];
+		}
+	}
+
+	for (int i = im->tamanho; i > 0; i--)
+	{
+		inv->inicio[i] = inv->inicio[i - 1];
+	}
+
+	inv->inicio[0] = 0;
+
+	//As entradas já estão por ordem; só ligações repetidas na imagem original dão origens repetidas
+	inv->ordenada = true;
+
+	for (int v = 0; v < inv->tamanho && inv->ordenada; v++)
+	{
+		for (int i = inv->inicio[v] + 1; i < inv->inicio[v + 1]; i++)
+		{
+			if (inv->destinos[i - 1] == inv->destinos[i])
+			{
+				inv->ordenada = false;
+				break;
+			}
+		}
+	}
+
+	*inf = true;
+	return inv;
+}
+
+/**
+ * @brief Liberta a memória alocada para uma imagem.
+ *
+ * @param im Apontador para a imagem a eliminar.
+ */
+void ApagarImagemGrafo(ImagemGrafo* im)
+{
+	if (im == NULL)
+	{
+		return;
+	}
+
+	free(im->existe);
+	free(im->inicio);
+	free(im->destinos);
+	free(im->pesos);
+	free(im);
+}
+
+/**
+ * @brief Devolve a memória ocupada por uma imagem de um grafo.
+ *
+ * @param im Apontador para a imagem.
+ * @return size_t Número de bytes alocados.
+ */
+size_t MemoriaImagemGrafo(ImagemGrafo* im)
+{
+	if (im == NULL)
+	{
+		return 0;
+	}
+
+	size_t n = im->tamanho > 0 ? (size_t)im->tamanho : 1;
+	size_t m = im->numArestas > 0 ? (size_t)im->numArestas : 1;
+
+	return sizeof(ImagemGrafo) + n * sizeof(bool) + (n + 1) * sizeof(int) + m * (sizeof(int) + sizeof(PesoAresta));
+}
+
+/**
+ * @brief Procura a adjacência entre dois vértices numa imagem.
+ *
+ * Numa imagem ordenada a procura é binária, em O(log d); caso contrário as adjacências da
+ * origem são percorridas.
+ *
+ * @param im Apontador para a imagem.
+ * @param origem Vértice de origem.
+ * @param destino Vértice de destino.
+ * @return int Posição da adjacência em destinos e pesos, ou -1 se não existir.
+ */
+int ProcurarAdjImagem(ImagemGrafo* im, int origem, int destino)
+{
+	if (im == NULL || origem < 0 || origem >= im->tamanho)
+	{
+		return -1;
+	}
+
+	int inicio = im->inicio[origem], fim = im->inicio[origem + 1];
+
+	if (!im->ordenada)
+	{
+		for (int i = inicio; i < fim; i++)
+		{
+			if (im->destinos[i] == destino)
+			{
+				return i;
+			}
+		}
+
+		return -1;
+	}
+
+	//Pesquisa binária entre inicio e fim - 1
+	while (inicio < fim)
+	{
+		int meio = inicio + (fim - inicio) / 2;
+
+		if (im->destinos[meio] < destino)
+		{
+			inicio = meio + 1;
+		}
+		else
+		{
+			fim = meio;
+		}
+	}
+
+	return inicio < im->inicio[origem + 1] && im->destinos[inicio] == destino ? inicio : -1;
+}
+
+/**
+ * @brief Procura a primeira posição com um destino maior ou igual, por pesquisa exponencial.
+ *
+ * Os saltos dobram a partir de inicio até ultrapassar o valor, e a pesquisa binária só é feita
+ * no último salto, pelo que o custo depende da distância percorrida e não do tamanho da lista.
+ *
+ * @param destinos Array ordenado.
+ * @param inicio Primeira posição a considerar.
+ * @param fim Posição a seguir à última.
+ * @param valor Destino procurado.
+ * @return int Primeira posição com destino maior ou igual a valor (fim se não existir).
+ */
+static int Galopar(const int destinos[], int inicio, int fim, int valor)
+{
+	int salto = 1;
+	int anterior = inicio;
+
+	while (inicio < fim && destinos[inicio] < valor)
+	{
+		anterior = inicio + 1;
+		inicio += salto;
+		salto *= 2;
+	}
+
+	if (inicio > fim)
+	{
+		inicio = fim;
+	}
+
+	while (anterior < inicio)
+	{
+		int meio = anterior + (inicio - anterior) / 2;
+
+		if (destinos[meio] < valor)
+		{
+			anterior = meio + 1;
+		}
+		else
+		{
+			inicio = meio;
+		}
+	}
+
+	return inicio;
+}
+
+/**
+ * @brief Calcula os vizinhos comuns de dois vértices de uma imagem ordenada.
+ *
+ * As duas listas de destinos são percorridas em simultâneo. Se uma for muito maior do que a
+ * outra, cada destino da lista menor é procurado na maior por pesquisa exponencial (galloping),
+ * a partir da posição do anterior, em vez de percorrer a lista maior toda.
+ *
+ * @param im Apontador para a imagem (tem de estar ordenada).
+ * @param u Primeiro vértice.
+ * @param v Segundo vértice.
+ * @param comuns Array onde ficam os vizinhos comuns, por ordem crescente (pode ser NULL para apenas contar); tem de ter espaço para o menor dos dois graus.
+ * @return int Número de vizinhos comuns, ou -1 se a imagem não estiver ordenada ou os vértices não existirem.
+ */
+int IntersetarVizinhosImagem(ImagemGrafo* im, int u, int v, int comuns[])
+{
+	if (im == NULL || !im->ordenada || u < 0 || u >= im->tamanho || v < 0 || v >= im->tamanho ||
+		!im->existe[u] || !im->existe[v])
+	{
+		return -1;
+	}
+
+	const int* d = im->destinos;
+	int i = im->inicio[u], fimI = im->inicio[u + 1];
+	int j = im->inicio[v], fimJ = im->inicio[v + 1];
+	int n = 0;
+
+	//A lista percorrida elemento a elemento é a menor
+	if (fimI - i > fimJ - j)
+	{
+		int aux = i;
+		i = j;
+		j = aux;
+		aux = fimI;
+		fimI = fimJ;
+		fimJ = aux;
+	}
+
+	//Com graus muito diferentes compensa saltar na lista maior
+	bool galopar = (long long)(fimI - i) * 16 < fimJ - j;
+
+	while (i < fimI && j < fimJ)
+	{
+		if (galopar)
+		{
+			j = Galopar(d, j, fimJ, d[i]);
+
+			if (j < fimJ && d[j] == d[i])
+			{
+				if (comuns != NULL) comuns[n] = d[i];
+				n++;
+				j++;
+			}
+
+			i++;
+		}
+		else if (d[i] < d[j])
+		{
+			i++;
+		}
+		else if (d[i] > d[j])
+		{
+			j++;
+		}
+		else
+		{
+			if (comuns != NULL) comuns[n] = d[i];
+			n++;
+			i++;
+			j++;
+		}
+	}
+
+	return n;
+}
@@ -0,0 +1,369 @@
+/**
+ * @file kcaminhos.c
+ * @author Hugo Cruz (a23010)
+ * @brief Implementação do cálculo dos k caminhos mais curtos sem ciclos (algoritmo de Yen).
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include <string.h>
+#include "kcaminhos.h"
+#include "bellmanford.h"
+
+ /**
+  * @brief Estrutura de um caminho usado durante o algoritmo de Yen.
+  *
+  * pesos[i] é o peso da adjacência entre vertices[i] e vertices[i + 1].
+  */
+typedef struct CaminhoK
+{
+	Distancia custo;	///< Soma dos pesos do caminho.
+	int numVertices;	///< Número de vértices do caminho.
+	int* vertices;		///< Vértices do caminho, da origem ao destino.
+	PesoAresta* pesos;	///< Pesos das adjacências do caminho.
+
+} CaminhoK;
+
+/**
+ * @brief Liberta a memória alocada para um caminho.
+ *
+ * @param c Apontador para o caminho a eliminar
+ */
+static void ApagarCaminhoK(CaminhoK* c)
+{
+	if (c == NULL)
+	{
+		return;
+	}
+
+	free(c->vertices);
+	free(c->pesos);
+	free(c);
+}
+
+/**
+ * @brief Cria um caminho a partir de uma raiz e do resultado de uma pesquisa.
+ *
+ * O caminho criado tem os primeiros tamRaiz vértices da raiz seguidos do caminho mais curto
+ * calculado no espaço de trabalho até ao destino.
+ *
+ * @param e Espaço de trabalho com o resultado da pesquisa
+ * @param raiz Caminho de onde são copiados os primeiros vértices (NULL se tamRaiz for 0)
+ * @param tamRaiz Número de vértices copiados da raiz
+ * @param destino Vértice de destino
+ * @return CaminhoK* Apontador para o caminho criado ou NULL se não houver memória
+ */
+static CaminhoK* ExtrairCaminhoK(EspacoCaminhos* e, CaminhoK* raiz, int tamRaiz, int destino)
+{
+	int numDesvio = 0;
+
+	//Conta os vértices do desvio percorrendo os antecessores
+	for (int atual = destino; atual != -1; atual = e->verticeAnt[atual])
+	{
+		numDesvio++;
+	}
+
+	CaminhoK* c = (CaminhoK*)malloc(sizeof(CaminhoK));
+
+	if (c == NULL)
+	{
+		return NULL;
+	}
+
+	c->numVertices = tamRaiz + numDesvio;
+	c->vertices = (int*)malloc(sizeof(int) * c->numVertices);
+	c->pesos = (PesoAresta*)malloc(sizeof(PesoAresta) * c->numVertices);
+
+	if (c->vertices == NULL || c->pesos == NULL)
+	{
+		ApagarCaminhoK(c);
+		return NULL;
+	}
+
+	if (tamRaiz > 0)
+	{
+		memcpy(c->vertices, raiz->vertices, sizeof(int) * tamRaiz);
+		memcpy(c->pesos, raiz->pesos, sizeof(PesoAresta) * tamRaiz);
+	}
+
+	//Preenche o desvio do fim para o início
+	int i = c->numVertices - 1;
+
+	c->pesos[i] = 0;
+
+	for (int atual = destino; atual != -1; atual = e->verticeAnt[atual])
+	{
+		c->vertices[i] = atual;
+
+		//O peso até à origem do desvio já vem da raiz
+		if (e->verticeAnt[atual] != -1)
+		{
+			c->pesos[i - 1] = e->pesoAnt[atual];
+		}
+
+		i--;
+	}
+
+	c->custo = e->distancias[destino];
+	return c;
+}
+
+/**
+ * @brief Verifica se dois caminhos têm os mesmos vértices.
+ *
+ * @param a Primeiro caminho
+ * @param b Segundo caminho
+ * @return true se os caminhos forem iguais, e false caso contrário
+ */
+static bool CaminhosIguais(CaminhoK* a, CaminhoK* b)
+{
+	return a->numVertices == b->numVertices &&
+		memcmp(a->vertices, b->vertices, sizeof(int) * a->numVertices) == 0;
+}
+
+/**
+ * @brief Copia os caminhos encontrados para um conjunto compacto.
+ *
+ * @param caminhos Array de caminhos ordenados por custo
+ * @param total Número de caminhos
+ * @return ConjuntoCaminhos* Apontador para o conjunto criado ou NULL se não houver memória
+ */
+static ConjuntoCaminhos* CriarConjuntoCaminhos(CaminhoK** caminhos, int total)
+{
+	ConjuntoCaminhos* c = (ConjuntoCaminhos*)malloc(sizeof(ConjuntoCaminhos));
+
+	if (c == NULL)
+	{
+		return NULL;
+	}
+
+	int numVertices = 0;
+
+	for (int i = 0; i < total; i++)
+	{
+		numVertices += caminhos[i]->numVertices;
+	}
+
+	c->total = total;
+	c->custos = (Distancia*)malloc(sizeof(Distancia) * (total > 0 ? total : 1));
+	c->inicio = (int*)malloc(sizeof(int) * (total + 1));
+	c->vertices = (int*)malloc(sizeof(int) * (numVertices > 0 ? numVertices : 1));
+
+	if (c->custos == NULL || c->inicio == NULL || c->vertices == NULL)
+	{
+		ApagarConjuntoCaminhos(c);
+		return NULL;
+	}
+
+	c->inicio[0] = 0;
+
+	for (int i = 0; i < total; i++)
+	{
+		c->custos[i] = caminhos[i]->custo;
+		memcpy(c->vertices + c->inicio[i], caminhos[i]->vertices, sizeof(int) * caminhos[i]->numVertices);
+		c->inicio[i + 1] = c->inicio[i] + caminhos[i]->numVertices;
+	}
+
+	return c;
+}
+
+/**
+ * @brief Calcula os k caminhos mais curtos sem ciclos entre dois vértices.
+ *
+ * Esta função implementa o algoritmo de Yen. O primeiro caminho é o caminho mais curto; cada
+ * caminho seguinte é obtido desviando o anterior a partir de cada um dos seus vértices. Os
+ * desvios são calculados com DijkstraRestrito sobre um único espaço de trabalho, excluindo os
+ * vértices e as adjacências já usados em vez de copiar o grafo. Se o grafo tiver pesos negativos,
+ * o espaço de trabalho recebe primeiro os potenciais de Johnson; com um ciclo negativo não há
+ * caminhos mais curtos e a função falha.
+ *
+ * @param g Apontador para o grafo
+ * @param origem Vértice de origem
+ * @param destino Vértice de destino
+ * @param k Número máximo de caminhos a calcular
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida
+ * @return ConjuntoCaminhos* Conjunto com até k caminhos (total 0 se não existir caminho) ou NULL em caso de erro ou de ciclo negativo
+ */
+ConjuntoCaminhos* KCaminhosMaisCurtos(Grafo* g, int origem, int destino, int k, bool* inf)
+{
+	*inf = false;
+
+	if (g == NULL || k < 1)
+	{
+		return NULL;
+	}
+
+	EspacoCaminhos* e = CriarEspacoCaminhos(g, inf);
+	bool cicloNegativo;
+
+	if (e == NULL)
+	{
+		return NULL;
+	}
+
+	//Sem potenciais os desvios ignorariam as adjacências com peso negativo
+	if (ExistemPesosNegativos(g) && !Johnson(g, e, &cicloNegativo))
+	{
+		ApagarEspacoCaminhos(e);
+		*inf = false;
+		return NULL;
+	}
+
+	CaminhoK** encontrados = (CaminhoK**)malloc(sizeof(CaminhoK*) * k); //Caminhos já escolhidos
+	int* bloqueados = (int*)malloc(sizeof(int) * k);
+	CaminhoK** candidatos = NULL; //Desvios ainda não escolhidos
+	int numEncontrados = 0, numCandidatos = 0, capacidade = 0;
+	bool erro = encontrados == NULL || bloqueados == NULL;
+
+	//O primeiro caminho é o caminho mais curto
+	if (!erro && DijkstraRestrito(g, e, origem, destino, NULL, 0) != DISTANCIA_INFINITA)
+	{
+		encontrados[0] = ExtrairCaminhoK(e, NULL, 0, destino);
+		erro = encontrados[0] == NULL;
+		numEncontrados = erro ? 0 : 1;
+	}
+
+	while (!erro && numEncontrados > 0 && numEncontrados < k)
+	{
+		CaminhoK* anterior = encontrados[numEncontrados - 1];
+		Distancia custoRaiz = 0;
+
+		//Calcula um desvio a partir de cada vértice do caminho anterior
+		for (int i = 0; i < anterior->numVertices - 1 && !erro; i++)
+		{
+			int numBloqueados = 0;
+
+			//Os caminhos com a mesma raiz não podem voltar a usar a adjacência seguinte
+			for (int j = 0; j < numEncontrados; j++)
+			{
+				CaminhoK* p = encontrados[j];
+
+				if (p->numVertices > i + 1 && memcmp(p->vertices, anterior->vertices, sizeof(int) * (i + 1)) == 0)
+				{
+					bloqueados[numBloqueados++] = p->vertices[i + 1];
+				}
+			}
+
+			//Os vértices da raiz não podem ser repetidos no desvio
+			for (int j = 0; j < i; j++)
+			{
+				e->bloqueado[anterior->vertices[j]] = true;
+			}
+
+			Distancia distancia = DijkstraRestrito(g, e, anterior->vertices[i], destino, bloqueados, numBloqueados);
+
+			for (int j = 0; j < i; j++)
+			{
+				e->bloqueado[anterior->vertices[j]] = false;
+			}
+
+			if (distancia != DISTANCIA_INFINITA)
+			{
+				CaminhoK* novo = ExtrairCaminhoK(e, anterior, i, destino);
+
+				if (novo == NULL)
+				{
+					erro = true;
+					break;
+				}
+
+				novo->custo = custoRaiz + distancia;
+
+				bool repetido = false;
+
+				for (int j = 0; j < numCandidatos && !repetido; j++)
+				{
+					repetido = CaminhosIguais(candidatos[j], novo);
+				}
+
+				if (repetido)
+				{
+					ApagarCaminhoK(novo);
+				}
+				else
+				{
+					//Aumenta o array de candidatos quando está cheio
+					if (numCandidatos == capacidade)
+					{
+						int novaCapacidade = capacidade > 0 ? capacidade * 2 : 16;
+						CaminhoK** aux = (CaminhoK**)realloc(candidatos, sizeof(CaminhoK*) * novaCapacidade);
+
+						if (aux == NULL)
+						{
+							ApagarCaminhoK(novo);
+							erro = true;
+							break;
+						}
+
+						candidatos = aux;
+						capacidade = novaCapacidade;
+					}
+
+					candidatos[numCandidatos++] = novo;
+				}
+			}
+
+			custoRaiz += anterior->pesos[i];
+		}
+
+		if (erro || numCandidatos == 0)
+		{
+			break;
+		}
+
+		//Escolhe o candidato mais barato, e em caso de empate o que tem menos vértices
+		int melhor = 0;
+
+		for (int j = 1; j < numCandidatos; j++)
+		{
+			if (candidatos[j]->custo < candidatos[melhor]->custo ||
+				(candidatos[j]->custo == candidatos[melhor]->custo && candidatos[j]->numVertices < candidatos[melhor]->numVertices))
+			{
+				melhor = j;
+			}
+		}
+
+		encontrados[numEncontrados++] = candidatos[melhor];
+		candidatos[melhor] = candidatos[--numCandidatos];
+	}
+
+	ConjuntoCaminhos* resultado = erro ? NULL : CriarConjuntoCaminhos(encontrados, numEncontrados);
+
+	for (int j = 0; j < numEncontrados; j++)
+	{
+		ApagarCaminhoK(encontrados[j]);
+	}
+
+	for (int j = 0; j < numCandidatos; j++)
+	{
+		ApagarCaminhoK(candidatos[j]);
+	}
+
+	free(encontrados);
+	free(candidatos);
+	free(bloqueados);
+	ApagarEspacoCaminhos(e);
+
+	*inf = resultado != NULL;
+	return resultado;
+}
+
+/**
+ * @brief Liberta a memória alocada para um conjunto de caminhos.
+ *
+ * @param c Apontador para o conjunto a eliminar
+ */
+void ApagarConjuntoCaminhos(ConjuntoCaminhos* c)
+{
+	if (c == NULL)
+	{
+		return;
+	}
+
+	free(c->custos);
+	free(c->inicio);
+	free(c->vertices);
+	free(c);
+}
@@ -0,0 +1,470 @@
+/**
+ * @file largura.c
+ * @author Hugo Cruz (a23010)
+ * @brief Implementação da pesquisa em largura paralela com mudança de direção.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include <string.h>
+#include "largura.h"
+
+/**
+ * @def TAMANHO_LOTE_LARGURA
+ * @brief Número de vértices que um trabalhador junta antes de reservar espaço na fronteira seguinte.
+ */
+#define TAMANHO_LOTE_LARGURA 256
+
+/**
+ * @def MIN_ARESTAS_PARALELO
+ * @brief Abaixo deste número de ligações a percorrer, um nível é calculado só na thread que chama.
+ *
+ * Nos grafos com diâmetro grande (grelhas, redes de estradas) há milhares de níveis com fronteiras
+ * de poucos vértices, em que acordar os trabalhadores custaria mais do que o próprio nível.
+ */
+#define MIN_ARESTAS_PARALELO 4096
+
+/**
+ * @brief Estado de um nível da pesquisa, partilhado pelos trabalhadores.
+ *
+ */
+typedef struct PassoLargura
+{
+	EspacoLargura* e;			 ///< Espaço de trabalho.
+	int nivel;					 ///< Nível dos vértices da fronteira seguinte.
+	int* destino;				 ///< Lista onde são juntados os vértices (fronteira seguinte ou conversão).
+	atomic_int tamanhoDestino;	 ///< Número de vértices já juntados em destino.
+	atomic_llong arestas;		 ///< Soma dos graus dos vértices da fronteira seguinte.
+
+} PassoLargura;
+
+/**
+ * @brief Devolve o número de ligações que saem de um vértice.
+ *
+ * @param im Apontador para a imagem.
+ * @param v Vértice.
+ * @return int Número de ligações.
+ */
+static inline int GrauImagem(const ImagemGrafo* im, int v)
+{
+	return im->inicio[v + 1] - im->inicio[v];
+}
+
+/**
+ * @brief Copia um lote de vértices para o fim da lista do passo.
+ *
+ * O espaço é reservado com uma única soma atómica por lote, em vez de uma por vértice.
+ *
+ * @param p Apontador para o passo.
+ * @param lote Vértices a copiar.
+ * @param n Número de vértices.
+ */
+static void DespejarLote(PassoLargura* p, const int lote[], int n)
+{
+	if (n > 0)
+	{
+		int posicao = atomic_fetch_add_explicit(&p->tamanhoDestino, n, memory_order_relaxed);
+		memcpy(p->destino + posicao, lote, sizeof(int) * n);
+	}
+}
+
+/**
+ * @brief Calcula um intervalo da fronteira de cima para baixo.
+ *
+ * Um destino só é do primeiro trabalhador que liga o seu bit em visitados, pelo que cada vértice
+ * entra uma única vez na fronteira seguinte.
+ *
+ * @param contexto Apontador para o passo.
+ * @param inicio Primeira posição da fronteira.
+ * @param fim Posição a seguir à última.
+ * @param trabalhador Número do trabalhador (não usado).
+ */
+static void PassoCimaBaixo(void* contexto, int inicio, int fim, int trabalhador)
+{
+	PassoLargura* p = (PassoLargura*)contexto;
+	EspacoLargura* e = p->e;
+	const ImagemGrafo* im = e->imagem;
+	int lote[TAMANHO_LOTE_LARGURA];
+	int n = 0;
+	long long arestas = 0;
+
+	for (int i = inicio; i < fim; i++)
+	{
+		int u = e->fila[i];
+
+		for (int k = im->inicio[u]; k < im->inicio[u + 1]; k++)
+		{
+			int v = im->destinos[k];
+			_Atomic(PalavraBits)* palavra = &e->visitados[v / BITS_PALAVRA];
+			PalavraBits bit = 1ULL << (v % BITS_PALAVRA);
+
+			//A leitura simples evita a escrita atómica nos vértices já visitados, que são a maioria
+			if ((atomic_load_explicit(palavra, memory_order_relaxed) & bit) ||
+				(atomic_fetch_or_explicit(palavra, bit, memory_order_relaxed) & bit))
+			{
+				continue;
+			}
+
+			e->nivel[v] = p->nivel;
+			e->verticeAnt[v] = u;
+			arestas += GrauImagem(im, v);
+			lote[n++] = v;
+
+			if (n == TAMANHO_LOTE_LARGURA)
+			{
+				DespejarLote(p, lote, n);
+				n = 0;
+			}
+		}
+	}
+
+	DespejarLote(p, lote, n);
+	atomic_fetch_add_explicit(&p->arestas, arestas, memory_order_relaxed);
+}
+
+/**
+ * @brief Calcula um intervalo de palavras dos conjuntos de bits de baixo para cima.
+ *
+ * Cada palavra de visitados e da fronteira seguinte só é escrita pelo trabalhador que a calcula,
+ * pelo que não são precisas operações atómicas de leitura e escrita.
+ *
+ * @param contexto Apontador para o passo.
+ * @param inicio Primeira palavra.
+ * @param fim Palavra a seguir à última.
+ * @param trabalhador Número do trabalhador (não usado).
+ */
+static void PassoBaixoCima(void* contexto, int inicio, int fim, int trabalhador)
+{
+	PassoLargura* p = (PassoLargura*)contexto;
+	EspacoLargura* e = p->e;
+	const ImagemGrafo* im = e->imagem;
+	const ImagemGrafo* inv = e->inversa;
+	int novos = 0;
+	long long arestas = 0;
+
+	for (int i = inicio; i < fim; i++)
+	{
+		PalavraBits visitadas = atomic_load_explicit(&e->visitados[i], memory_order_relaxed);
+		PalavraBits porVisitar = ~visitadas;
+		PalavraBits encontradas = 0;
+
+		//Os bits depois do último vértice não correspondem a vértices
+		if (i == e->palavras - 1 && im->tamanho % BITS_PALAVRA != 0)
+		{
+			porVisitar &= (1ULL << (im->tamanho % BITS_PALAVRA)) - 1;
+		}
+
+		while (porVisitar != 0)
+		{
+			int b = PrimeiroBit(porVisitar);
+			int v = i * BITS_PALAVRA + b;
+			porVisitar &= porVisitar - 1;
+
+			for (int k = inv->inicio[v]; k < inv->inicio[v + 1]; k++)
+			{
+				int u = inv->destinos[k];
+
+				if ((atomic_load_explicit(&e->fronteira[u / BITS_PALAVRA], memory_order_relaxed) >> (u % BITS_PALAVRA)) & 1)
+				{
+					e->nivel[v] = p->nivel;
+					e->verticeAnt[v] = u;
+					encontradas |= 1ULL << b;
+					arestas += GrauImagem(im, v);
+					break;
+				}
+			}
+		}
+
+		atomic_store_explicit(&e->proxima[i], encontradas, memory_order_relaxed);
+
+		if (encontradas != 0)
+		{
+			atomic_store_explicit(&e->visitados[i], visitadas | encontradas, memory_order_relaxed);
+			novos += ContarBits(encontradas);
+		}
+	}
+
+	atomic_fetch_add_explicit(&p->tamanhoDestino, novos, memory_order_relaxed);
+	atomic_fetch_add_explicit(&p->arestas, arestas, memory_order_relaxed);
+}
+
+/**
+ * @brief Limpa um intervalo de palavras da fronteira em bits.
+ *
+ * @param contexto Apontador para o passo.
+ * @param inicio Primeira palavra.
+ * @param fim Palavra a seguir à última.
+ * @param trabalhador Número do trabalhador (não usado).
+ */
+static void LimparFronteira(void* contexto, int inicio, int fim, int trabalhador)
+{
+	EspacoLargura* e = ((PassoLargura*)contexto)->e;
+
+	for (int i = inicio; i < fim; i++)
+	{
+		atomic_store_explicit(&e->fronteira[i], 0, memory_order_relaxed);
+	}
+}
+
+/**
+ * @brief Marca na fronteira em bits um intervalo da fronteira em lista.
+ *
+ * @param contexto Apontador para o passo.
+ * @param inicio Primeira posição da lista.
+ * @param fim Posição a seguir à última.
+ * @param trabalhador Número do trabalhador (não usado).
+ */
+static void MarcarFronteira(void* contexto, int inicio, int fim, int trabalhador)
+{
+	EspacoLargura* e = ((PassoLargura*)contexto)->e;
+
+	for (int i = inicio; i < fim; i++)
+	{
+		int v = e->fila[i];
+		atomic_fetch_or_explicit(&e->fronteira[v / BITS_PALAVRA], 1ULL << (v % BITS_PALAVRA), memory_order_relaxed);
+	}
+}
+
+/**
+ * @brief Junta na lista do passo os vértices de um intervalo de palavras da fronteira em bits.
+ *
+ * @param contexto Apontador para o passo.
+ * @param inicio Primeira palavra.
+ * @param fim Palavra a seguir à última.
+ * @param trabalhador Número do trabalhador (não usado).
+ */
+static void ListarFronteira(void* contexto, int inicio, int fim, int trabalhador)
+{
+	PassoLargura* p = (PassoLargura*)contexto;
+	int lote[TAMANHO_LOTE_LARGURA];
+	int n = 0;
+
+	for (int i = inicio; i < fim; i++)
+	{
+		PalavraBits bits = atomic_load_explicit(&p->e->fronteira[i], memory_order_relaxed);
+
+		while (bits != 0)
+		{
+			lote[n++] = i * BITS_PALAVRA + PrimeiroBit(bits);
+			bits &= bits - 1;
+
+			if (n == TAMANHO_LOTE_LARGURA)
+			{
+				DespejarLote(p, lote, n);
+				n = 0;
+			}
+		}
+	}
+
+	DespejarLote(p, lote, n);
+}
+
+/**
+ * @brief Cria um espaço de trabalho para pesquisas em largura numa imagem.
+ *
+ * @param im Apontador para a imagem do grafo.
+ * @param inversa Apontador para a imagem inversa de im, partilhada (NULL para o espaço a criar quando for precisa).
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return EspacoLargura* Apontador para o espaço de trabalho criado.
+ */
+EspacoLargura* CriarEspacoLargura(ImagemGrafo* im, ImagemGrafo* inversa, bool* inf)
+{
+	*inf = false;
+
+	if (im == NULL || (inversa != NULL && inversa->tamanho != im->tamanho))
+	{
+		return NULL;
+	}
+
+	EspacoLargura* e = (EspacoLargura*)calloc(1, sizeof(EspacoLargura));
+
+	if (e == NULL)
+	{
+		return NULL;
+	}
+
+	int n = im->tamanho > 0 ? im->tamanho : 1;
+	e->imagem = im;
+	e->inversa = inversa;
+	e->palavras = (n + BITS_PALAVRA - 1) / BITS_PALAVRA;
+	e->visitados = (_Atomic(PalavraBits)*)calloc(e->palavras, sizeof(PalavraBits));
+	e->fronteira = (_Atomic(PalavraBits)*)calloc(e->palavras, sizeof(PalavraBits));
+	e->proxima = (_Atomic(PalavraBits)*)calloc(e->palavras, sizeof(PalavraBits));
+	e->fila = (int*)malloc(sizeof(int) * n);
+	e->proximaFila = (int*)malloc(sizeof(int) * n);
+	e->nivel = (int*)malloc(sizeof(int) * n);
+	e->verticeAnt = (int*)malloc(sizeof(int) * n);
+
+	if (e->visitados == NULL || e->fronteira == NULL || e->proxima == NULL || e->fila == NULL ||
+		e->proximaFila == NULL || e->nivel == NULL || e->verticeAnt == NULL)
+	{
+		ApagarEspacoLargura(e);
+		return NULL;
+	}
+
+	*inf = true;
+	return e;
+}
+
+/**
+ * @brief Liberta a memória de um espaço de trabalho de pesquisas em largura.
+ *
+ * @param e Apontador para o espaço de trabalho (pode ser NULL).
+ */
+void ApagarEspacoLargura(EspacoLargura* e)
+{
+	if (e == NULL)
+	{
+		return;
+	}
+
+	if (e->inversaPropria)
+	{
+		ApagarImagemGrafo(e->inversa);
+	}
+
+	free((void*)e->visitados);
+	free((void*)e->fronteira);
+	free((void*)e->proxima);
+	free(e->fila);
+	free(e->proximaFila);
+	free(e->nivel);
+	free(e->verticeAnt);
+	free(e);
+}
+
+/**
+ * @brief Devolve a memória ocupada por um espaço de trabalho de pesquisas em largura.
+ *
+ * @param e Apontador para o espaço de trabalho.
+ * @return size_t Número de bytes alocados, incluindo a imagem inversa se pertencer ao espaço.
+ */
+size_t MemoriaEspacoLargura(EspacoLargura* e)
+{
+	if (e == NULL)
+	{
+		return 0;
+	}
+
+	size_t n = e->imagem->tamanho > 0 ? (size_t)e->imagem->tamanho : 1;
+
+	return sizeof(EspacoLargura) + 3 * sizeof(PalavraBits) * (size_t)e->palavras + 4 * sizeof(int) * n +
+		(e->inversaPropria ? MemoriaImagemGrafo(e->inversa) : 0);
+}
+
+/**
+ * @brief Pesquisa em largura com mudança de direção, com os níveis repartidos pelos trabalhadores de um executor.
+ *
+ * A escolha do sentido segue a heurística de Beamer: passa a baixo para cima quando as ligações
+ * da fronteira ultrapassam 1/ALFA_LARGURA das ligações dos vértices por visitar (as que a procura
+ * de baixo para cima teria de percorrer, no pior caso) e volta a cima para baixo quando a
+ * fronteira fica pequena e a diminuir. Se não houver memória para a imagem inversa a pesquisa
+ * continua de cima para baixo.
+ *
+ * @param e Apontador para o espaço de trabalho.
+ * @param ex Apontador para o executor (NULL para pesquisar só na thread que chama).
+ * @param origem Vértice de origem.
+ * @param destino Vértice onde a pesquisa pode parar (-1 para visitar todos os vértices alcançáveis).
+ * @return int Número de ligações do caminho mais curto até ao destino (-1 se não existir caminho, se destino for -1 ou em caso de erro).
+ */
+int LarguraDirecional(EspacoLargura* e, ExecutorParalelo* ex, int origem, int destino)
+{
+	if (e == NULL)
+	{
+		return -1;
+	}
+
+	ImagemGrafo* im = e->imagem;
+	e->numAlcancados = 0;
+	e->passosBaixoCima = 0;
+
+	for (int i = 0; i < e->palavras; i++)
+	{
+		atomic_store_explicit(&e->visitados[i], 0, memory_order_relaxed);
+	}
+
+	if (origem < 0 || origem >= im->tamanho || !im->existe[origem] || destino < -1 || destino >= im->tamanho)
+	{
+		return -1;
+	}
+
+	atomic_store_explicit(&e->visitados[origem / BITS_PALAVRA], 1ULL << (origem % BITS_PALAVRA), memory_order_relaxed);
+	e->nivel[origem] = 0;
+	e->verticeAnt[origem] = -1;
+	e->fila[0] = origem;
+	e->numAlcancados = 1;
+
+	PassoLargura p;
+	p.e = e;
+	p.nivel = 0;
+	p.destino = NULL;
+	atomic_init(&p.tamanhoDestino, 0);
+	atomic_init(&p.arestas, 0);
+
+	int tamanhoFronteira = 1, fronteiraAnterior = 0;
+	long long arestasFronteira = GrauImagem(im, origem);
+	long long arestasPorVisitar = im->numArestas - arestasFronteira;
+	bool baixoCima = false;
+
+	while (tamanhoFronteira > 0 && NivelLargura(e, destino) < 0)
+	{
+		atomic_store(&p.tamanhoDestino, 0);
+		atomic_store(&p.arestas, 0);
+
+		if (!baixoCima && arestasFronteira > arestasPorVisitar / ALFA_LARGURA)
+		{
+			if (e->inversa == NULL)
+			{
+				bool inf;
+				e->inversa = InverterImagemGrafo(im, &inf);
+				e->inversaPropria = e->inversa != NULL;
+			}
+
+			if (e->inversa != NULL)
+			{
+				ParaleloPara(ex, 0, e->palavras, 0, LimparFronteira, &p);
+				ParaleloPara(ex, 0, tamanhoFronteira, 0, MarcarFronteira, &p);
+				baixoCima = true;
+			}
+		}
+		else if (baixoCima && tamanhoFronteira < im->tamanho / BETA_LARGURA && tamanhoFronteira < fronteiraAnterior)
+		{
+			p.destino = e->fila;
+			ParaleloPara(ex, 0, e->palavras, 0, ListarFronteira, &p);
+			atomic_store(&p.tamanhoDestino, 0);
+			baixoCima = false;
+		}
+
+		p.nivel++;
+
+		if (baixoCima)
+		{
+			ParaleloPara(ex, 0, e->palavras, 0, PassoBaixoCima, &p);
+
+			_Atomic(PalavraBits)* aux = e->fronteira;
+			e->fronteira = e->proxima;
+			e->proxima = aux;
+			e->passosBaixoCima++;
+		}
+		else
+		{
+			//Um nível com poucas ligações não compensa acordar os trabalhadores
+			p.destino = e->proximaFila;
+			ParaleloPara(arestasFronteira < MIN_ARESTAS_PARALELO ? NULL : ex, 0, tamanhoFronteira, 0, PassoCimaBaixo, &p);
+
+			int* aux = e->fila;
+			e->fila = e->proximaFila;
+			e->proximaFila = aux;
+		}
+
+		fronteiraAnterior = tamanhoFronteira;
+		tamanhoFronteira = atomic_load(&p.tamanhoDestino);
+		arestasFronteira = atomic_load(&p.arestas);
+		arestasPorVisitar -= arestasFronteira;
+		e->numAlcancados += tamanhoFronteira;
+	}
+
+	return destino >= 0 ? NivelLargura(e, destino) : -1;
+}
@@ -0,0 +1,121 @@
+/**
+ * @file largura.h
+ * @author Hugo Cruz (a23010)
+ * @brief Ficheiro de cabeçalho da pesquisa em largura paralela com mudança de direção.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef LARGURA_H
+#define LARGURA_H
+
+#include "imagem.h"
+#include "matriz.h"
+#include "paralelo.h"
+
+/**
+ * @def ALFA_LARGURA
+ * @brief A pesquisa passa a ser feita de baixo para cima quando as ligações da fronteira são mais do que 1/ALFA_LARGURA das ligações dos vértices por visitar.
+ */
+#define ALFA_LARGURA 14
+
+/**
+ * @def BETA_LARGURA
+ * @brief A pesquisa volta a ser feita de cima para baixo quando a fronteira tem menos de 1/BETA_LARGURA dos vértices e está a diminuir.
+ */
+#define BETA_LARGURA 24
+
+/**
+ * @brief Estrutura com a memória de trabalho da pesquisa em largura.
+ *
+ * Cada nível é calculado num de dois sentidos. De cima para baixo, a fronteira é uma lista e as
+ * ligações de cada vértice da fronteira marcam os destinos ainda não visitados. De baixo para
+ * cima, a fronteira é um conjunto de bits e cada vértice por visitar procura nas ligações que
+ * chegam a ele um vértice da fronteira, parando no primeiro; quando a fronteira tem uma grande
+ * parte das ligações do grafo, como nos níveis centrais de um grafo com graus em lei de potência,
+ * a maior parte dessas procuras termina logo. As ligações que chegam a cada vértice são lidas de
+ * uma imagem inversa, criada no primeiro passo de baixo para cima.
+ *
+ * Os níveis e os antecessores só são válidos para os vértices marcados em visitados, que é o
+ * único array reinicializado em cada pesquisa.
+ */
+typedef struct EspacoLargura
+{
+	ImagemGrafo *imagem;			///< Imagem pesquisada.
+	ImagemGrafo *inversa;			///< Imagem com as ligações invertidas (NULL até ser precisa).
+	bool inversaPropria;			///< Indica se a imagem inversa pertence ao espaço.
+	int palavras;					///< Número de palavras dos conjuntos de bits.
+	_Atomic(PalavraBits) *visitados; ///< Vértices alcançados pela última pesquisa.
+	_Atomic(PalavraBits) *fronteira; ///< Fronteira em bits, nos passos de baixo para cima.
+	_Atomic(PalavraBits) *proxima;	///< Fronteira seguinte em bits.
+	int *fila;						///< Fronteira em lista, nos passos de cima para baixo.
+	int *proximaFila;				///< Fronteira seguinte em lista.
+	int *nivel;						///< Número de ligações desde a origem de cada vértice visitado.
+	int *verticeAnt;				///< Antecessor de cada vértice visitado (-1 na origem).
+	int numAlcancados;				///< Número de vértices alcançados pela última pesquisa, incluindo a origem.
+	int passosBaixoCima;			///< Número de níveis da última pesquisa calculados de baixo para cima.
+
+} EspacoLargura;
+
+/**
+ * @brief Cria um espaço de trabalho para pesquisas em largura numa imagem.
+ *
+ * @param im Apontador para a imagem do grafo.
+ * @param inversa Apontador para a imagem inversa de im, partilhada (NULL para o espaço a criar quando for precisa).
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return EspacoLargura* Apontador para o espaço de trabalho criado.
+ */
+EspacoLargura *CriarEspacoLargura(ImagemGrafo *im, ImagemGrafo *inversa, bool *inf);
+
+/**
+ * @brief Liberta a memória de um espaço de trabalho de pesquisas em largura.
+ *
+ * @param e Apontador para o espaço de trabalho (pode ser NULL).
+ */
+void ApagarEspacoLargura(EspacoLargura *e);
+
+/**
+ * @brief Devolve a memória ocupada por um espaço de trabalho de pesquisas em largura.
+ *
+ * @param e Apontador para o espaço de trabalho.
+ * @return size_t Número de bytes alocados, incluindo a imagem inversa se pertencer ao espaço.
+ */
+size_t MemoriaEspacoLargura(EspacoLargura *e);
+
+/**
+ * @brief Pesquisa em largura com mudança de direção, com os níveis repartidos pelos trabalhadores de um executor.
+ *
+ * Cada nível começa quando o anterior está completo. Com mais de um trabalhador os níveis são
+ * sempre os mesmos, mas o antecessor de um vértice pode ser qualquer vértice do nível anterior
+ * ligado a ele.
+ *
+ * @param e Apontador para o espaço de trabalho.
+ * @param ex Apontador para o executor (NULL para pesquisar só na thread que chama).
+ * @param origem Vértice de origem.
+ * @param destino Vértice onde a pesquisa pode parar (-1 para visitar todos os vértices alcançáveis).
+ * @return int Número de ligações do caminho mais curto até ao destino (-1 se não existir caminho, se destino for -1 ou em caso de erro).
+ */
+int LarguraDirecional(EspacoLargura *e, ExecutorParalelo *ex, int origem, int destino);
+
+/**
+ * @brief Devolve o nível de um vértice na última pesquisa.
+ *
+ * @param e Apontador para o espaço de trabalho.
+ * @param v Vértice.
+ * @return int Número de ligações desde a origem (-1 se o vértice não foi alcançado).
+ */
+static inline int NivelLargura(const EspacoLargura *e, int v)
+{
+	if (v < 0 || v >= e->imagem->tamanho ||
+		!((atomic_load_explicit(&e->visitados[v / BITS_PALAVRA], memory_order_relaxed) >> (v % BITS_PALAVRA)) & 1))
+	{
+		return -1;
+	}
+
+	return e->nivel[v];
+}
+
+#endif
@@ -0,0 +1,686 @@
+/**
+ * @file lote.c
+ * @author Hugo Cruz (a23010)
+ * @brief Implementação dos lotes de alterações aplicados a um grafo de uma só vez.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include "lote.h"
+
+ /**
+  * @brief Cria um lote de alterações vazio.
+  *
+  * @param capacidade Número inicial de alterações que cabem no lote.
+  * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+  * @return Apontador para o lote criado.
+  */
+LoteAlteracoes* CriarLoteAlteracoes(int capacidade, bool* inf)
+{
+	*inf = false;
+
+	if (capacidade < 1)
+	{
+		capacidade = 1;
+	}
+
+	LoteAlteracoes* l = (LoteAlteracoes*)malloc(sizeof(LoteAlteracoes));
+
+	if (l == NULL)
+	{
+		return NULL;
+	}
+
+	l->alteracoes = (Alteracao*)malloc(sizeof(Alteracao) * capacidade);
+
+	if (l->alteracoes == NULL)
+	{
+		free(l);
+		return NULL;
+	}
+
+	l->numAlteracoes = 0;
+	l->capacidade = capacidade;
+	l->aplicadas = 0;
+
+	*inf = true;
+	return l;
+}
+
+/**
+ * @brief Liberta a memória alocada para um lote de alterações.
+ *
+ * @param l Apontador para o lote a eliminar.
+ */
+void ApagarLoteAlteracoes(LoteAlteracoes* l)
+{
+	if (l == NULL)
+	{
+		return;
+	}
+
+	free(l->alteracoes);
+	free(l);
+}
+
+/**
+ * @brief Retira todas as alterações do lote sem libertar a memória.
+ *
+ * @param l Apontador para o lote.
+ */
+void LimparLoteAlteracoes(LoteAlteracoes* l)
+{
+	if (l != NULL)
+	{
+		l->numAlteracoes = 0;
+		l->aplicadas = 0;
+	}
+}
+
+/**
+ * @brief Acrescenta uma alteração ao fim do lote.
+ *
+ * @param l Apontador para o lote.
+ * @param tipo Tipo da alteração.
+ * @param origem Vértice alterado, ou origem da adjacência.
+ * @param destino Destino da adjacência.
+ * @param peso Peso da adjacência.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para o lote.
+ */
+static LoteAlteracoes* AdicionarAlteracao(LoteAlteracoes* l, TipoAlteracao tipo, int origem, int destino, int peso, bool* inf)
+{
+	*inf = false;
+
+	if (l == NULL)
+	{
+		return NULL;
+	}
+
+	//Duplica a capacidade quando o array está cheio
+	if (l->numAlteracoes == l->capacidade)
+	{
+		Alteracao* novo = (Alteracao*)realloc(l->alteracoes, sizeof(Alteracao) * l->capacidade * 2);
+
+		if (novo == NULL)
+		{
+			return l;
+		}
+
+		l->alteracoes = novo;
+		l->capacidade *= 2;
+	}
+
+	Alteracao* a = &l->alteracoes[l->numAlteracoes];
+	a->tipo = tipo;
+	a->origem = origem;
+	a->destino = destino;
+	a->peso = peso;
+	a->ordem = l->numAlteracoes++;
+
+	*inf = true;
+	return l;
+}
+
+/**
+ * @brief Regista a inserção de um vértice.
+ *
+ * @param l Apontador para o lote.
+ * @param id Identificador do vértice (não negativo).
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para o lote.
+ */
+LoteAlteracoes* InserirVerticeLote(LoteAlteracoes* l, int id, bool* inf)
+{
+	return AdicionarAlteracao(l, ALTERACAO_INSERIR_VERTICE, id, -1, 0, inf);
+}
+
+/**
+ * @brief Regista a eliminação de um vértice.
+ *
+ * @param l Apontador para o lote.
+ * @param id Identificador do vértice.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para o lote.
+ */
+LoteAlteracoes* EliminaVerticeLote(LoteAlteracoes* l, int id, bool* inf)
+{
+	return AdicionarAlteracao(l, ALTERACAO_ELIMINAR_VERTICE, id, -1, 0, inf);
+}
+
+/**
+ * @brief Regista a inserção de uma adjacência.
+ *
+ * @param l Apontador para o lote.
+ * @param origem Vértice de origem.
+ * @param destino Vértice de destino.
+ * @param peso Peso da adjacência.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para o lote.
+ */
+LoteAlteracoes* InserirAdjLote(LoteAlteracoes* l, int origem, int destino, int peso, bool* inf)
+{
+	if (!PESO_VALIDO(peso))
+	{
+		*inf = false;
+		return l;
+	}
+
+	return AdicionarAlteracao(l, ALTERACAO_INSERIR_ADJ, origem, destino, peso, inf);
+}
+
+/**
+ * @brief Regista a eliminação de uma adjacência.
+ *
+ * @param l Apontador para o lote.
+ * @param origem Vértice de origem.
+ * @param destino Vértice de destino.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para o lote.
+ */
+LoteAlteracoes* EliminaAdjLote(LoteAlteracoes* l, int origem, int destino, bool* inf)
+{
+	return AdicionarAlteracao(l, ALTERACAO_ELIMINAR_ADJ, origem, destino, 0, inf);
+}
+
+/**
+ * @brief Compara duas alterações para as ordenar por fase e vértice de origem.
+ *
+ * As eliminações de adjacências ficam também ordenadas pelo destino. Em caso de empate mantém-se
+ * a ordem em que as alterações foram registadas.
+ *
+ * @param a Apontador para a primeira alteração.
+ * @param b Apontador para a segunda alteração.
+ * @return int Negativo, zero ou positivo, como em qsort.
+ */
+static int CompararAlteracoes(const void* a, const void* b)
+{
+	const Alteracao* x = (const Alteracao*)a;
+	const Alteracao* y = (const Alteracao*)b;
+
+	if (x->tipo != y->tipo) return x->tipo < y->tipo ? -1 : 1;
+	if (x->origem != y->origem) return x->origem < y->origem ? -1 : 1;
+
+	if (x->tipo == ALTERACAO_ELIMINAR_ADJ && x->destino != y->destino)
+	{
+		return x->destino < y->destino ? -1 : 1;
+	}
+
+	return x->ordem < y->ordem ? -1 : (x->ordem > y->ordem);
+}
+
+/**
+ * @brief Apaga um vértice retirado do grafo e todas as suas listas.
+ *
+ * @param g Apontador para o grafo, cujos contadores de memória são atualizados.
+ * @param v Apontador para o vértice.
+ */
+static void DescartarVertice(Grafo* g, Vertice* v)
+{
+	bool inf;
+	long long adjacencias = 0, entradas = 0;
+
+	for (Adjacente* a = v->nextA; a != NULL; a = a->next)
+	{
+		adjacencias++;
+	}
+
+	v->nextA = ElimanaTodasAdj(v->nextA, &inf);
+
+	while (v->entradaA != NULL)
+	{
+		Adjacente* temp = v->entradaA;
+		v->entradaA = temp->next;
+		ApagarAdjacencia(temp);
+		entradas++;
+	}
+
+	ApagarVertice(v);
+	AjustarMemoriaGrafo(g, -(long long)sizeof(Vertice), -adjacencias * (long long)sizeof(Adjacente),
+		-entradas * (long long)sizeof(Adjacente));
+}
+
+/**
+ * @brief Junta os vértices novos à lista de vértices e retira os vértices eliminados.
+ *
+ * A lista de vértices está ordenada pelo id e as inserções estão ordenadas pelo mesmo critério,
+ * pelo que basta uma passagem para construir a nova lista.
+ *
+ * @param g Apontador para o grafo.
+ * @param inserir Inserções de vértices, ordenadas pelo id.
+ * @param numInserir Número de inserções.
+ * @param vertices Array com o vértice de cada id, atualizado com as alterações.
+ * @param eliminado Array que indica os ids dos vértices eliminados.
+ * @param aplicadas Apontador para o contador de alterações com efeito.
+ * @return true se todos os vértices foram criados, e false se faltou memória.
+ */
+static bool JuntarVertices(Grafo* g, Alteracao inserir[], int numInserir, Vertice* vertices[], bool eliminado[], int* aplicadas)
+{
+	Vertice* inicio = NULL;
+	Vertice* fim = NULL;
+	Vertice* aux = g->inicioGrafo;
+	bool correu = true;
+	int k = 0;
+
+	while (aux != NULL || k < numInserir)
+	{
+		Vertice* proximo = NULL;
+
+		if (aux != NULL && (k >= numInserir || aux->id <= inserir[k].origem))
+		{
+			//Vértice já existente: mantém-se, a menos que esteja marcado como eliminado
+			Vertice* atual = aux;
+			aux = aux->nextV;
+
+			if (atual->id >= 0 && eliminado[atual->id])
+			{
+				vertices[atual->id] = NULL;
+				DescartarVertice(g, atual);
+				continue;
+			}
+
+			proximo = atual;
+		}
+		else
+		{
+			//Vértice novo, ignorado se o id for inválido ou já estiver na nova lista
+			int id = inserir[k++].origem;
+
+			if (id < 0 || (fim != NULL && fim->id == id))
+			{
+				continue;
+			}
+
+			proximo = CriarVertice(id);
+
+			if (proximo == NULL)
+			{
+				correu = false;
+				continue;
+			}
+
+			vertices[id] = proximo;
+			AjustarMemoriaGrafo(g, sizeof(Vertice), 0, 0);
+			(*aplicadas)++;
+		}
+
+		proximo->antV = fim;
+		proximo->nextV = NULL;
+
+		if (fim == NULL)
+		{
+			inicio = proximo;
+		}
+		else
+		{
+			fim->nextV = proximo;
+		}
+
+		fim = proximo;
+	}
+
+	g->inicioGrafo = inicio;
+	return correu;
+}
+
+/**
+ * @brief Retira de todas as listas as adjacências para vértices eliminados.
+ *
+ * @param g Apontador para o grafo.
+ * @param eliminado Array que indica os ids dos vértices eliminados.
+ * @param tamanho Número de elementos de eliminado.
+ */
+static void CompactarAdjacenciasEliminadas(Grafo* g, bool eliminado[], int tamanho)
+{
+	long long apagadas = 0;
+
+	for (Vertice* v = g->inicioGrafo; v != NULL; v = v->nextV)
+	{
+		Adjacente* ant = NULL;
+		Adjacente* a = v->nextA;
+
+		while (a != NULL)
+		{
+			Adjacente* proximo = a->next;
+
+			if (a->id >= 0 && a->id < tamanho && eliminado[a->id])
+			{
+				if (ant == NULL)
+				{
+					v->nextA = proximo;
+				}
+				else
+				{
+					ant->next = proximo;
+				}
+
+				ApagarAdjacencia(a);
+				apagadas++;
+			}
+			else
+			{
+				ant = a;
+			}
+
+			a = proximo;
+		}
+	}
+
+	AjustarMemoriaGrafo(g, 0, -apagadas * (long long)sizeof(Adjacente), 0);
+}
+
+/**
+ * @brief Elimina as adjacências de uma origem numa única passagem pela sua lista.
+ *
+ * Por cada alteração é eliminada a primeira adjacência ainda não eliminada com esse destino, tal
+ * como em EliminaAdjGrafo.
+ *
+ * @param v Apontador para o vértice de origem.
+ * @param eliminar Eliminações desta origem, ordenadas pelo destino.
+ * @param numEliminar Número de eliminações.
+ * @param vertices Array com o vértice de cada id.
+ * @param tamanho Número de elementos de vertices.
+ * @param destinos Array auxiliar com pelo menos numEliminar posições.
+ * @param contagens Array auxiliar com pelo menos numEliminar posições.
+ * @return int Número de adjacências eliminadas.
+ */
+static int EliminarAdjacenciasOrigem(Vertice* v, Alteracao eliminar[], int numEliminar, Vertice* vertices[], int tamanho, int destinos[], int contagens[])
+{
+	int unicos = 0;
+
+	//Agrupa os destinos repetidos e ignora os destinos que não existem
+	for (int i = 0; i < numEliminar; i++)
+	{
+		int d = eliminar[i].destino;
+
+		if (d < 0 || d >= tamanho || vertices[d] == NULL)
+		{
+			continue;
+		}
+
+		if (unicos > 0 && destinos[unicos - 1] == d)
+		{
+			contagens[unicos - 1]++;
+		}
+		else
+		{
+			destinos[unicos] = d;
+			contagens[unicos++] = 1;
+		}
+	}
+
+	int eliminadas = 0;
+	Adjacente* ant = NULL;
+	Adjacente* a = v->nextA;
+
+	while (a != NULL && eliminadas < numEliminar)
+	{
+		Adjacente* proximo = a->next;
+
+		//Pesquisa binária do destino da adjacência
+		int esq = 0, dir = unicos - 1, encontrado = -1;
+
+		while (esq <= dir)
+		{
+			int meio = esq + (dir - esq) / 2;
+
+			if (destinos[meio] == a->id)
+			{
+				encontrado = meio;
+				break;
+			}
+
+			if (destinos[meio] < a->id) esq = meio + 1;
+			else dir = meio - 1;
+		}
+
+		if (encontrado >= 0 && contagens[encontrado] > 0)
+		{
+			contagens[encontrado]--;
+			eliminadas++;
+
+			if (ant == NULL)
+			{
+				v->nextA = proximo;
+			}
+			else
+			{
+				ant->next = proximo;
+			}
+
+			ApagarAdjacencia(a);
+		}
+		else
+		{
+			ant = a;
+		}
+
+		a = proximo;
+	}
+
+	return eliminadas;
+}
+
+/**
+ * @brief Aplica um lote de alterações a um grafo.
+ *
+ * As alterações são ordenadas pelo tipo e pelo vértice de origem e aplicadas por fases:
+ * eliminação de vértices, inserção de vértices, eliminação de adjacências e inserção de
+ * adjacências. Os vértices eliminados são primeiro marcados e só depois retirados, numa única
+ * passagem pela lista de vértices que também junta os vértices novos, e numa única passagem pelas
+ * adjacências que retira as que apontam para eles. Cada lista de adjacências é percorrida no
+ * máximo uma vez por fase, pelo que o custo é linear no tamanho do grafo e do lote, em vez de uma
+ * procura na lista de vértices por cada alteração.
+ *
+ * As alterações sem efeito (vértice repetido ou inexistente, adjacência com extremos inexistentes)
+ * são ignoradas. Um vértice eliminado e inserido no mesmo lote fica sem adjacências anteriores.
+ *
+ * @param g Apontador para o grafo.
+ * @param l Apontador para o lote; l->aplicadas fica com o número de alterações com efeito.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para o grafo.
+ */
+Grafo* AplicarLoteGrafo(Grafo* g, LoteAlteracoes* l, bool* inf)
+{
+	*inf = false;
+
+	if (g == NULL)
+	{
+		return NULL;
+	}
+
+	//O lote é aplicado sobre as listas de adjacências
+	if (l == NULL || !ExpandirMatrizGrafo(g))
+	{
+		return g;
+	}
+
+	l->aplicadas = 0;
+
+	if (l->numAlteracoes == 0)
+	{
+		*inf = true;
+		return g;
+	}
+
+	Alteracao* alt = l->alteracoes;
+	int n = l->numAlteracoes;
+
+	qsort(alt, n, sizeof(Alteracao), CompararAlteracoes);
+
+	//Os arrays auxiliares são indexados pelo id, até ao maior id do grafo ou do lote
+	int maior = -1;
+
+	for (Vertice* v = g->inicioGrafo; v != NULL; v = v->nextV)
+	{
+		if (v->id > maior) maior = v->id;
+	}
+
+	for (int i = 0; i < n; i++)
+	{
+		if (alt[i].origem > maior) maior = alt[i].origem;
+		if (alt[i].destino > maior) maior = alt[i].destino;
+	}
+
+	int tamanho = maior + 1;
+	Vertice** vertices = (Vertice**)calloc(tamanho > 0 ? tamanho : 1, sizeof(Vertice*));
+	bool* eliminado = (bool*)calloc(tamanho > 0 ? tamanho : 1, sizeof(bool));
+	int* destinos = (int*)malloc(sizeof(int) * n);
+	int* contagens = (int*)malloc(sizeof(int) * n);
+
+	if (vertices == NULL || eliminado == NULL || destinos == NULL || contagens == NULL)
+	{
+		free(vertices);
+		free(eliminado);
+		free(destinos);
+		free(contagens);
+		return g;
+	}
+
+	for (Vertice* v = g->inicioGrafo; v != NULL; v = v->nextV)
+	{
+		if (v->id >= 0)
+		{
+			vertices[v->id] = v;
+		}
+	}
+
+	bool correu = true;
+	int i = 0;
+
+	//Fase 1: marca os vértices eliminados
+	int numEliminados = 0;
+
+	for (; i < n && alt[i].tipo == ALTERACAO_ELIMINAR_VERTICE; i++)
+	{
+		int id = alt[i].origem;
+
+		if (id >= 0 && vertices[id] != NULL && !eliminado[id])
+		{
+			eliminado[id] = true;
+			numEliminados++;
+		}
+	}
+
+	l->aplicadas += numEliminados;
+
+	//Fase 2: uma passagem pela lista de vértices junta os novos e retira os marcados
+	int j = i;
+
+	while (j < n && alt[j].tipo == ALTERACAO_INSERIR_VERTICE)
+	{
+		j++;
+	}
+
+	if (numEliminados > 0 || j > i)
+	{
+		correu = JuntarVertices(g, alt + i, j - i, vertices, eliminado, &l->aplicadas);
+	}
+
+	if (numEliminados > 0)
+	{
+		CompactarAdjacenciasEliminadas(g, eliminado, tamanho);
+	}
+
+	//Fase 3: eliminação de adjacências, uma passagem por lista de cada origem
+	for (i = j; i < n && alt[i].tipo == ALTERACAO_ELIMINAR_ADJ; i = j)
+	{
+		int origem = alt[i].origem;
+
+		for (j = i; j < n && alt[j].tipo == ALTERACAO_ELIMINAR_ADJ && alt[j].origem == origem; j++);
+
+		Vertice* v = origem >= 0 ? vertices[origem] : NULL;
+
+		if (v != NULL)
+		{
+			int eliminadas = EliminarAdjacenciasOrigem(v, alt + i, j - i, vertices, tamanho, destinos, contagens);
+			AjustarMemoriaGrafo(g, 0, -(long long)eliminadas * (long long)sizeof(Adjacente), 0);
+			l->aplicadas += eliminadas;
+		}
+	}
+
+	//Fase 4: inserção de adjacências no fim de cada lista, pela ordem em que foram registadas
+	for (i = j; i < n; i = j)
+	{
+		int origem = alt[i].origem;
+
+		for (j = i; j < n && alt[j].origem == origem; j++);
+
+		Vertice* v = origem >= 0 ? vertices[origem] : NULL;
+
+		if (v == NULL)
+		{
+			continue;
+		}
+
+		Adjacente* fim = v->nextA;
+
+		while (fim != NULL && fim->next != NULL)
+		{
+			fim = fim->next;
+		}
+
+		for (int k = i; k < j; k++)
+		{
+			int d = alt[k].destino;
+			bool aux;
+
+			if (d < 0 || vertices[d] == NULL)
+			{
+				continue;
+			}
+
+			Adjacente* nova = CriarAdjacencia(d, alt[k].peso, &aux);
+
+			if (nova == NULL)
+			{
+				correu = false;
+				continue;
+			}
+
+			if (fim == NULL)
+			{
+				v->nextA = nova;
+			}
+			else
+			{
+				fim->next = nova;
+			}
+
+			fim = nova;
+			AjustarMemoriaGrafo(g, 0, sizeof(Adjacente), 0);
+			l->aplicadas++;
+		}
+	}
+
+	free(vertices);
+	free(eliminado);
+	free(destinos);
+	free(contagens);
+
+	//As adjacências novas foram juntadas no fim das listas
+	if (g->adjOrdenadas && l->aplicadas > 0)
+	{
+		bool aux;
+		g = OrdenarAdjacenciasGrafo(g, &aux);
+		correu = correu && aux;
+	}
+
+	if (l->aplicadas > 0)
+	{
+		g->versao++;
+
+		//O índice de entradas é reconstruído uma vez em vez de ser mantido em cada alteração
+		if (g->indice != NULL)
+		{
+			bool aux;
+			g = ConfigurarIndiceEntradasGrafo(g, true, &aux);
+			correu = correu && aux;
+		}
+	}
+
+	*inf = correu;
+	return g;
+}
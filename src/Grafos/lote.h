@@ -0,0 +1,147 @@
+/**
+ * @file lote.h
+ * @author Hugo Cruz (a23010)
+ * @brief Ficheiro de cabeçalho para os lotes de alterações aplicados a um grafo de uma só vez.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef LOTE_H
+#define LOTE_H
+
+#include "grafo.h"
+
+/**
+ * @brief Tipos de alteração de um lote.
+ *
+ * A ordem dos valores é a ordem pela qual as alterações são aplicadas.
+ */
+typedef enum TipoAlteracao
+{
+	ALTERACAO_ELIMINAR_VERTICE, ///< Elimina um vértice e todas as suas adjacências.
+	ALTERACAO_INSERIR_VERTICE,	///< Insere um vértice.
+	ALTERACAO_ELIMINAR_ADJ,		///< Elimina uma adjacência entre dois vértices.
+	ALTERACAO_INSERIR_ADJ		///< Insere uma adjacência entre dois vértices.
+
+} TipoAlteracao;
+
+/**
+ * @brief Estrutura de uma alteração de um lote.
+ *
+ */
+typedef struct Alteracao
+{
+	TipoAlteracao tipo; ///< Tipo da alteração.
+	int origem;			///< Vértice alterado, ou origem da adjacência.
+	int destino;		///< Destino da adjacência (não usado nas alterações de vértices).
+	int peso;			///< Peso da adjacência a inserir.
+	int ordem;			///< Posição da alteração no lote, pela ordem em que foi registada.
+
+} Alteracao;
+
+/**
+ * @brief Estrutura de um lote de alterações.
+ *
+ * As alterações são apenas registadas; só quando o lote é aplicado é que o grafo é percorrido, uma
+ * única vez para todas as alterações.
+ */
+typedef struct LoteAlteracoes
+{
+	Alteracao *alteracoes; ///< Array com as alterações registadas.
+	int numAlteracoes;	   ///< Número de alterações registadas.
+	int capacidade;		   ///< Número de alterações que cabem no array.
+	int aplicadas;		   ///< Número de alterações que tiveram efeito na última aplicação.
+
+} LoteAlteracoes;
+
+/**
+ * @brief Cria um lote de alterações vazio.
+ *
+ * @param capacidade Número inicial de alterações que cabem no lote.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para o lote criado.
+ */
+LoteAlteracoes *CriarLoteAlteracoes(int capacidade, bool *inf);
+
+/**
+ * @brief Liberta a memória alocada para um lote de alterações.
+ *
+ * @param l Apontador para o lote a eliminar.
+ */
+void ApagarLoteAlteracoes(LoteAlteracoes *l);
+
+/**
+ * @brief Retira todas as alterações do lote sem libertar a memória.
+ *
+ * @param l Apontador para o lote.
+ */
+void LimparLoteAlteracoes(LoteAlteracoes *l);
+
+/**
+ * @brief Regista a inserção de um vértice.
+ *
+ * @param l Apontador para o lote.
+ * @param id Identificador do vértice (não negativo).
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para o lote.
+ */
+LoteAlteracoes *InserirVerticeLote(LoteAlteracoes *l, int id, bool *inf);
+
+/**
+ * @brief Regista a eliminação de um vértice.
+ *
+ * @param l Apontador para o lote.
+ * @param id Identificador do vértice.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para o lote.
+ */
+LoteAlteracoes *EliminaVerticeLote(LoteAlteracoes *l, int id, bool *inf);
+
+/**
+ * @brief Regista a inserção de uma adjacência.
+ *
+ * @param l Apontador para o lote.
+ * @param origem Vértice de origem.
+ * @param destino Vértice de destino.
+ * @param peso Peso da adjacência.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para o lote.
+ */
+LoteAlteracoes *InserirAdjLote(LoteAlteracoes *l, int origem, int destino, int peso, bool *inf);
+
+/**
+ * @brief Regista a eliminação de uma adjacência.
+ *
+ * @param l Apontador para o lote.
+ * @param origem Vértice de origem.
+ * @param destino Vértice de destino.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para o lote.
+ */
+LoteAlteracoes *EliminaAdjLote(LoteAlteracoes *l, int origem, int destino, bool *inf);
+
+/**
+ * @brief Aplica um lote de alterações a um grafo.
+ *
+ * As alterações são ordenadas pelo tipo e pelo vértice de origem e aplicadas por fases:
+ * eliminação de vértices, inserção de vértices, eliminação de adjacências e inserção de
+ * adjacências. Os vértices eliminados são primeiro marcados e só depois retirados, numa única
+ * passagem pela lista de vértices que também junta os vértices novos, e numa única passagem pelas
+ * adjacências que retira as que apontam para eles. Cada lista de adjacências é percorrida no
+ * máximo uma vez por fase, pelo que o custo é linear no tamanho do grafo e do lote, em vez de uma
+ * procura na lista de vértices por cada alteração.
+ *
+ * As alterações sem efeito (vértice repetido ou inexistente, adjacência com extremos inexistentes)
+ * são ignoradas. Um vértice eliminado e inserido no mesmo lote fica sem adjacências anteriores.
+ *
+ * @param g Apontador para o grafo.
+ * @param l Apontador para o lote; l->aplicadas fica com o número de alterações com efeito.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para o grafo.
+ */
+Grafo *AplicarLoteGrafo(Grafo *g, LoteAlteracoes *l, bool *inf);
+
+#endif
@@ -0,0 +1,365 @@
+/**
+ * @file mapa.c
+ * @author Hugo Cruz (a23010)
+ * @brief Implementação da conversão entre ids externos de 64 bits e ids internos densos.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include <stdio.h>
+#include "mapa.h"
+
+ /**
+  * @brief Calcula a posição de um id externo na tabela de dispersão.
+  *
+  * Mistura os 64 bits do id (função final do splitmix64), para que chaves seguidas ou com os
+  * bits baixos iguais fiquem espalhadas pela tabela.
+  *
+  * @param externo Id externo.
+  * @param tamanhoTabela Número de posições da tabela (potência de 2).
+  * @return int Posição inicial do id na tabela.
+  */
+static int Dispersao(long long externo, int tamanhoTabela)
+{
+	unsigned long long x = (unsigned long long)externo;
+
+	x ^= x >> 30;
+	x *= 0xbf58476d1ce4e5b9ULL;
+	x ^= x >> 27;
+	x *= 0x94d049bb133111ebULL;
+	x ^= x >> 31;
+
+	return (int)(x & (unsigned long long)(tamanhoTabela - 1));
+}
+
+/**
+ * @brief Procura a posição da tabela com um id externo, ou a posição vazia onde deve ficar.
+ *
+ * @param m Apontador para o mapa.
+ * @param externo Id externo.
+ * @return int Posição na tabela.
+ */
+static int ProcurarPosicao(MapaIds* m, long long externo)
+{
+	int i = Dispersao(externo, m->tamanhoTabela);
+
+	while (m->tabela[i] != -1 && m->externos[m->tabela[i]] != externo)
+	{
+		i = (i + 1) & (m->tamanhoTabela - 1);
+	}
+
+	return i;
+}
+
+/**
+ * @brief Cria uma tabela de dispersão nova com o tamanho indicado e volta a inserir todos os ids.
+ *
+ * @param m Apontador para o mapa.
+ * @param tamanhoTabela Novo número de posições (potência de 2).
+ * @return true se a tabela foi criada.
+ */
+static bool RedimensionarTabela(MapaIds* m, int tamanhoTabela)
+{
+	int* tabela = (int*)malloc(sizeof(int) * tamanhoTabela);
+
+	if (tabela == NULL)
+	{
+		return false;
+	}
+
+	for (int i = 0; i < tamanhoTabela; i++)
+	{
+		tabela[i] = -1;
+	}
+
+	free(m->tabela);
+	m->tabela = tabela;
+	m->tamanhoTabela = tamanhoTabela;
+
+	for (int i = 0; i < m->numIds; i++)
+	{
+		m->tabela[ProcurarPosicao(m, m->externos[i])] = i;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Cria um mapa de ids vazio.
+ *
+ * @param capacidade Número de ids previsto (o mapa cresce se for ultrapassado).
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para o mapa criado.
+ */
+MapaIds* CriarMapaIds(int capacidade, bool* inf)
+{
+	*inf = false;
+
+	if (capacidade < 1)
+	{
+		capacidade = 1;
+	}
+
+	MapaIds* m = (MapaIds*)malloc(sizeof(MapaIds));
+
+	if (m == NULL)
+	{
+		return NULL;
+	}
+
+	m->numIds = 0;
+	m->capacidade = capacidade;
+	m->externos = (long long*)malloc(sizeof(long long) * capacidade);
+	m->tabela = NULL;
+
+	//A tabela tem pelo menos o dobro das posições dos ids previstos
+	int tamanhoTabela = 16;
+
+	while (tamanhoTabela < capacidade * 2)
+	{
+		tamanhoTabela *= 2;
+	}
+
+	if (m->externos == NULL || !RedimensionarTabela(m, tamanhoTabela))
+	{
+		ApagarMapaIds(m);
+		return NULL;
+	}
+
+	*inf = true;
+	return m;
+}
+
+/**
+ * @brief Liberta a memória alocada para um mapa de ids.
+ *
+ * @param m Apontador para o mapa a eliminar.
+ */
+void ApagarMapaIds(MapaIds* m)
+{
+	if (m == NULL)
+	{
+		return;
+	}
+
+	free(m->externos);
+	free(m->tabela);
+	free(m);
+}
+
+/**
+ * @brief Devolve o id interno de um id externo.
+ *
+ * @param m Apontador para o mapa.
+ * @param externo Id externo.
+ * @return int Id interno, ou -1 se o id externo não estiver registado.
+ */
+int ObterIdInterno(MapaIds* m, long long externo)
+{
+	if (m == NULL)
+	{
+		return -1;
+	}
+
+	return m->tabela[ProcurarPosicao(m, externo)];
+}
+
+/**
+ * @brief Devolve o id externo de um id interno.
+ *
+ * @param m Apontador para o mapa.
+ * @param interno Id interno.
+ * @param inf Apontador para um bool que fica false se o id interno não existir.
+ * @return long long Id externo.
+ */
+long long ObterIdExterno(MapaIds* m, int interno, bool* inf)
+{
+	*inf = false;
+
+	if (m == NULL || interno < 0 || interno >= m->numIds)
+	{
+		return -1;
+	}
+
+	*inf = true;
+	return m->externos[interno];
+}
+
+/**
+ * @brief Regista um id externo e devolve o seu id interno.
+ *
+ * Se o id externo já estiver registado devolve o id interno que já tem.
+ *
+ * @param m Apontador para o mapa.
+ * @param externo Id externo.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return int Id interno, ou -1 em caso de erro.
+ */
+int RegistarIdExterno(MapaIds* m, long long externo, bool* inf)
+{
+	*inf = false;
+
+	if (m == NULL)
+	{
+		return -1;
+	}
+
+	int posicao = ProcurarPosicao(m, externo);
+
+	if (m->tabela[posicao] != -1)
+	{
+		*inf = true;
+		return m->tabela[posicao];
+	}
+
+	if (m->numIds == m->capacidade)
+	{
+		long long* externos = (long long*)realloc(m->externos, sizeof(long long) * m->capacidade * 2);
+
+		if (externos == NULL)
+		{
+			return -1;
+		}
+
+		m->externos = externos;
+		m->capacidade *= 2;
+	}
+
+	//Mantém a tabela no máximo meio cheia para as sequências de colisões serem curtas
+	if ((m->numIds + 1) * 2 > m->tamanhoTabela)
+	{
+		if (!RedimensionarTabela(m, m->tamanhoTabela * 2))
+		{
+			return -1;
+		}
+
+		posicao = ProcurarPosicao(m, externo);
+	}
+
+	m->externos[m->numIds] = externo;
+	m->tabela[posicao] = m->numIds;
+
+	*inf = true;
+	return m->numIds++;
+}
+
+/**
+ * @brief Insere no grafo um vértice identificado pelo id externo.
+ *
+ * @param g Apontador para o grafo.
+ * @param m Apontador para o mapa.
+ * @param externo Id externo do vértice.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para o grafo.
+ */
+Grafo* InserirVerticeExterno(Grafo* g, MapaIds* m, long long externo, bool* inf)
+{
+	int interno = RegistarIdExterno(m, externo, inf);
+
+	if (!*inf)
+	{
+		return g;
+	}
+
+	return InserirVerticeGrafo(g, interno, inf);
+}
+
+/**
+ * @brief Insere uma adjacência entre dois vértices identificados pelos ids externos.
+ *
+ * @param g Apontador para o grafo.
+ * @param m Apontador para o mapa.
+ * @param origem Id externo do vértice de origem.
+ * @param destino Id externo do vértice de destino.
+ * @param peso Peso da adjacência.
+ * @param inf Apontador para um bool que fica false se algum dos ids não estiver registado.
+ * @return Apontador para o grafo.
+ */
+Grafo* InserirAdjExterno(Grafo* g, MapaIds* m, long long origem, long long destino, int peso, bool* inf)
+{
+	int o = ObterIdInterno(m, origem);
+	int d = ObterIdInterno(m, destino);
+
+	if (o == -1 || d == -1)
+	{
+		*inf = false;
+		return g;
+	}
+
+	return InserirAdjGrafo(g, o, d, peso, inf);
+}
+
+/**
+ * @brief Guarda um mapa de ids num ficheiro binário.
+ *
+ * O ficheiro tem um cabeçalho com o valor -9 seguido dos ids externos por ordem do id interno.
+ *
+ * @param m Apontador para o mapa.
+ * @param file Nome do ficheiro.
+ * @return true se o mapa foi guardado.
+ */
+bool GuardaMapaIds(MapaIds* m, char* file)
+{
+	if (m == NULL)
+	{
+		return false;
+	}
+
+	FILE* ficheiro = fopen(file, "wb");
+
+	if (ficheiro == NULL)
+	{
+		return false;
+	}
+
+	long long cabecalho = -9;
+	bool ok = fwrite(&cabecalho, sizeof(long long), 1, ficheiro) == 1 &&
+		fwrite(m->externos, sizeof(long long), m->numIds, ficheiro) == (size_t)m->numIds;
+
+	return fclose(ficheiro) == 0 && ok;
+}
+
+/**
+ * @brief Carrega um mapa de ids de um ficheiro binário criado com GuardaMapaIds.
+ *
+ * @param file Nome do ficheiro.
+ * @return MapaIds* Apontador para o mapa carregado, ou NULL em caso de erro.
+ */
+MapaIds* CarregaMapaIds(char* file)
+{
+	bool inf;
+	FILE* ficheiro = fopen(file, "rb");
+
+	if (ficheiro == NULL)
+	{
+		return NULL;
+	}
+
+	long long externo;
+
+	//Se o cabeçalho não for -9 não é um ficheiro de mapa
+	if (fread(&externo, sizeof(long long), 1, ficheiro) != 1 || externo != -9)
+	{
+		fclose(ficheiro);
+		return NULL;
+	}
+
+	MapaIds* m = CriarMapaIds(1024, &inf);
+
+	while (m != NULL && fread(&externo, sizeof(long long), 1, ficheiro) == 1)
+	{
+		int interno = RegistarIdExterno(m, externo, &inf);
+
+		//Um id repetido mudaria os ids internos seguintes
+		if (!inf || interno != m->numIds - 1)
+		{
+			ApagarMapaIds(m);
+			m = NULL;
+		}
+	}
+
+	fclose(ficheiro);
+	return m;
+}
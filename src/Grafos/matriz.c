@@ -0,0 +1,268 @@
+/**
+ * @file matriz.c
+ * @author Hugo Cruz (a23010)
+ * @brief Implementação da matriz de adjacências usada nos grafos densos.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include "matriz.h"
+
+ /**
+  * @brief Cria uma matriz de adjacências sem ligações.
+  *
+  * @param tamanho Número de linhas e de colunas.
+  * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+  * @return Apontador para a matriz criada.
+  */
+MatrizAdjacencia* CriarMatrizAdjacencia(int tamanho, bool* inf)
+{
+	*inf = false;
+
+	if (tamanho < 0)
+	{
+		return NULL;
+	}
+
+	MatrizAdjacencia* m = (MatrizAdjacencia*)calloc(1, sizeof(MatrizAdjacencia));
+
+	if (m == NULL)
+	{
+		return NULL;
+	}
+
+	size_t n = tamanho > 0 ? (size_t)tamanho : 1;
+
+	m->tamanho = tamanho;
+	m->palavrasLinha = (int)((n + BITS_PALAVRA - 1) / BITS_PALAVRA);
+	m->pesos = (PesoAresta*)calloc(n * n, sizeof(PesoAresta));
+	m->bits = (PalavraBits*)calloc(n * m->palavrasLinha, sizeof(PalavraBits));
+
+	if (m->pesos == NULL || m->bits == NULL)
+	{
+		ApagarMatrizAdjacencia(m);
+		return NULL;
+	}
+
+	*inf = true;
+	return m;
+}
+
+/**
+ * @brief Liberta a memória alocada para uma matriz de adjacências.
+ *
+ * @param m Apontador para a matriz a eliminar.
+ */
+void ApagarMatrizAdjacencia(MatrizAdjacencia* m)
+{
+	if (m == NULL)
+	{
+		return;
+	}
+
+	free(m->pesos);
+	free(m->bits);
+	free(m);
+}
+
+/**
+ * @brief Devolve a memória ocupada por uma matriz de adjacências.
+ *
+ * @param m Apontador para a matriz.
+ * @return size_t Número de bytes alocados.
+ */
+size_t MemoriaMatrizAdjacencia(MatrizAdjacencia* m)
+{
+	if (m == NULL)
+	{
+		return 0;
+	}
+
+	size_t n = m->tamanho > 0 ? (size_t)m->tamanho : 1;
+	return sizeof(MatrizAdjacencia) + n * n * sizeof(PesoAresta) + n * m->palavrasLinha * sizeof(PalavraBits);
+}
+
+/**
+ * @brief Define o peso da ligação entre dois vértices.
+ *
+ * @param m Apontador para a matriz.
+ * @param origem Vértice de origem.
+ * @param destino Vértice de destino.
+ * @param peso Peso da ligação (0 retira a ligação).
+ * @return true se a célula existe na matriz, e false caso contrário.
+ */
+bool DefinirLigacaoMatriz(MatrizAdjacencia* m, int origem, int destino, PesoAresta peso)
+{
+	if (m == NULL || origem < 0 || origem >= m->tamanho || destino < 0 || destino >= m->tamanho)
+	{
+		return false;
+	}
+
+	PesoAresta* celula = &m->pesos[(size_t)origem * m->tamanho + destino];
+	PalavraBits* palavra = &m->bits[(size_t)origem * m->palavrasLinha + destino / BITS_PALAVRA];
+	PalavraBits bit = 1ULL << (destino % BITS_PALAVRA);
+
+	//Retira a ligação anterior das contagens
+	if (*celula != 0)
+	{
+		m->numArestas--;
+		if (*celula < 0) m->numNegativos--;
+	}
+
+	*celula = peso;
+
+	if (peso != 0)
+	{
+		*palavra |= bit;
+		m->numArestas++;
+		if (peso < 0) m->numNegativos++;
+	}
+	else
+	{
+		*palavra &= ~bit;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Percorre a matriz em largura a partir de uma origem, com conjuntos de bits.
+ *
+ * @param m Apontador para a matriz.
+ * @param origem Vértice de origem (entre 0 e m->tamanho - 1).
+ * @param visitados Conjunto com m->palavrasLinha palavras onde ficam os vértices alcançados.
+ * @param nivel Array onde fica o nível de cada vértice alcançado (NULL se não for pedido).
+ * @return int Número de vértices alcançados, ou -1 se não houver memória.
+ */
+static int PercorrerMatriz(MatrizAdjacencia* m, int origem, PalavraBits visitados[], int nivel[])
+{
+	int palavras = m->palavrasLinha;
+	PalavraBits* fronteira = (PalavraBits*)calloc(palavras, sizeof(PalavraBits));
+	PalavraBits* proxima = (PalavraBits*)calloc(palavras, sizeof(PalavraBits));
+
+	if (fronteira == NULL || proxima == NULL)
+	{
+		free(fronteira);
+		free(proxima);
+		return -1;
+	}
+
+	for (int i = 0; i < palavras; i++)
+	{
+		visitados[i] = 0;
+	}
+
+	visitados[origem / BITS_PALAVRA] |= 1ULL << (origem % BITS_PALAVRA);
+	fronteira[origem / BITS_PALAVRA] |= 1ULL << (origem % BITS_PALAVRA);
+
+	int alcancados = 1;
+	int distancia = 0;
+	bool continuar = true;
+
+	while (continuar)
+	{
+		distancia++;
+
+		for (int i = 0; i < palavras; i++)
+		{
+			proxima[i] = 0;
+		}
+
+		//A fronteira seguinte é a união das linhas dos vértices da fronteira
+		for (int i = 0; i < palavras; i++)
+		{
+			for (PalavraBits p = fronteira[i]; p != 0; p &= p - 1)
+			{
+				const PalavraBits* linha = LinhaMatriz(m, i * BITS_PALAVRA + PrimeiroBit(p));
+
+				for (int j = 0; j < palavras; j++)
+				{
+					proxima[j] |= linha[j];
+				}
+			}
+		}
+
+		continuar = false;
+
+		for (int i = 0; i < palavras; i++)
+		{
+			PalavraBits novos = proxima[i] & ~visitados[i];
+
+			fronteira[i] = novos;
+			visitados[i] |= novos;
+
+			if (novos != 0)
+			{
+				continuar = true;
+				alcancados += ContarBits(novos);
+
+				for (PalavraBits p = novos; nivel != NULL && p != 0; p &= p - 1)
+				{
+					nivel[i * BITS_PALAVRA + PrimeiroBit(p)] = distancia;
+				}
+			}
+		}
+	}
+
+	free(fronteira);
+	free(proxima);
+	return alcancados;
+}
+
+/**
+ * @brief Calcula os vértices alcançáveis a partir de uma origem.
+ *
+ * A pesquisa avança por níveis: a fronteira seguinte é a união das linhas dos vértices da
+ * fronteira, sem os vértices já visitados, calculada uma palavra de cada vez.
+ *
+ * @param m Apontador para a matriz.
+ * @param origem Vértice de origem.
+ * @param alcancados Conjunto com m->palavrasLinha palavras onde ficam os vértices alcançados (inclui a origem).
+ * @return int Número de vértices alcançados, ou -1 em caso de erro.
+ */
+int AlcancaveisMatriz(MatrizAdjacencia* m, int origem, PalavraBits alcancados[])
+{
+	if (m == NULL || alcancados == NULL || origem < 0 || origem >= m->tamanho)
+	{
+		return -1;
+	}
+
+	return PercorrerMatriz(m, origem, alcancados, NULL);
+}
+
+/**
+ * @brief Pesquisa em largura sobre uma matriz de adjacências.
+ *
+ * @param m Apontador para a matriz.
+ * @param origem Vértice de origem.
+ * @param nivel Array com m->tamanho elementos onde fica o número de ligações desde a origem (-1 se não alcançado).
+ * @return int Número de vértices alcançados, ou -1 em caso de erro.
+ */
+int LarguraMatriz(MatrizAdjacencia* m, int origem, int nivel[])
+{
+	if (m == NULL || nivel == NULL || origem < 0 || origem >= m->tamanho)
+	{
+		return -1;
+	}
+
+	PalavraBits* visitados = (PalavraBits*)malloc(sizeof(PalavraBits) * m->palavrasLinha);
+
+	if (visitados == NULL)
+	{
+		return -1;
+	}
+
+	for (int i = 0; i < m->tamanho; i++)
+	{
+		nivel[i] = -1;
+	}
+
+	nivel[origem] = 0;
+
+	int alcancados = PercorrerMatriz(m, origem, visitados, nivel);
+
+	free(visitados);
+	return alcancados;
+}
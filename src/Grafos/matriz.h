@@ -0,0 +1,211 @@
+/**
+ * @file matriz.h
+ * @author Hugo Cruz (a23010)
+ * @brief Ficheiro de cabeçalho para a matriz de adjacências usada nos grafos densos.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef MATRIZ_H
+#define MATRIZ_H
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include "tipos.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @def DENSIDADE_MATRIZ
+ * @brief Fração de ligações a partir da qual um grafo carregado de uma matriz fica em matriz.
+ *
+ * Abaixo deste valor as listas de adjacências ocupam menos memória do que a matriz.
+ */
+#define DENSIDADE_MATRIZ 0.25
+
+/**
+ * @def BITS_PALAVRA
+ * @brief Número de bits de uma palavra dos conjuntos de bits.
+ */
+#define BITS_PALAVRA 64
+
+/**
+ * @brief Palavra dos conjuntos de bits.
+ */
+typedef unsigned long long PalavraBits;
+
+/**
+ * @brief Estrutura de uma matriz de adjacências.
+ *
+ * Os pesos estão guardados por linhas, uma linha por vértice de origem, e cada linha tem também
+ * um conjunto de bits com as colunas que são ligações. As pesquisas em largura e de alcance
+ * trabalham só com os bits, 64 destinos de cada vez.
+ */
+typedef struct MatrizAdjacencia
+{
+	int tamanho;			///< Número de linhas e de colunas (maior id + 1).
+	int palavrasLinha;		///< Número de palavras do conjunto de bits de cada linha.
+	long long numArestas;	///< Número de ligações (células com peso diferente de 0).
+	long long numNegativos;	///< Número de ligações com peso negativo.
+	PesoAresta *pesos;		///< Pesos de todas as células, por linhas (0 se não houver ligação).
+	PalavraBits *bits;		///< Conjuntos de bits das ligações de cada linha, seguidos.
+
+} MatrizAdjacencia;
+
+/**
+ * @brief Devolve a posição do bit menos significativo de uma palavra.
+ *
+ * @param p Palavra diferente de 0.
+ * @return int Posição do bit (0 a 63).
+ */
+static inline int PrimeiroBit(PalavraBits p)
+{
+#if defined(_MSC_VER)
+	unsigned long posicao;
+	_BitScanForward64(&posicao, p);
+	return (int)posicao;
+#else
+	return __builtin_ctzll(p);
+#endif
+}
+
+/**
+ * @brief Devolve o número de bits a 1 de uma palavra.
+ *
+ * @param p Palavra.
+ * @return int Número de bits a 1.
+ */
+static inline int ContarBits(PalavraBits p)
+{
+#if defined(_MSC_VER)
+	return (int)__popcnt64(p);
+#else
+	return __builtin_popcountll(p);
+#endif
+}
+
+/**
+ * @brief Devolve o conjunto de bits das ligações de um vértice.
+ *
+ * @param m Apontador para a matriz.
+ * @param u Vértice de origem (entre 0 e m->tamanho - 1).
+ * @return const PalavraBits* Apontador para as m->palavrasLinha palavras da linha.
+ */
+static inline const PalavraBits *LinhaMatriz(const MatrizAdjacencia *m, int u)
+{
+	return m->bits + (size_t)u * m->palavrasLinha;
+}
+
+/**
+ * @brief Devolve o peso da ligação entre dois vértices.
+ *
+ * @param m Apontador para a matriz.
+ * @param origem Vértice de origem (entre 0 e m->tamanho - 1).
+ * @param destino Vértice de destino (entre 0 e m->tamanho - 1).
+ * @return PesoAresta Peso da ligação (0 se não existir).
+ */
+static inline PesoAresta PesoLigacaoMatriz(const MatrizAdjacencia *m, int origem, int destino)
+{
+	return m->pesos[(size_t)origem * m->tamanho + destino];
+}
+
+/**
+ * @brief Procura a próxima ligação de um vértice a partir de uma coluna.
+ *
+ * Permite percorrer as ligações de uma linha por ordem crescente do destino:
+ * for (int w = ProximaLigacaoMatriz(m, u, 0); w >= 0; w = ProximaLigacaoMatriz(m, u, w + 1)).
+ *
+ * @param m Apontador para a matriz.
+ * @param u Vértice de origem (entre 0 e m->tamanho - 1).
+ * @param coluna Primeira coluna a considerar.
+ * @return int Destino da próxima ligação, ou -1 se não existir.
+ */
+static inline int ProximaLigacaoMatriz(const MatrizAdjacencia *m, int u, int coluna)
+{
+	const PalavraBits *linha = LinhaMatriz(m, u);
+
+	if (coluna >= m->tamanho)
+	{
+		return -1;
+	}
+
+	int i = coluna / BITS_PALAVRA;
+	PalavraBits p = linha[i] & (~0ULL << (coluna % BITS_PALAVRA));
+
+	while (p == 0)
+	{
+		if (++i == m->palavrasLinha)
+		{
+			return -1;
+		}
+
+		p = linha[i];
+	}
+
+	return i * BITS_PALAVRA + PrimeiroBit(p);
+}
+
+/**
+ * @brief Cria uma matriz de adjacências sem ligações.
+ *
+ * @param tamanho Número de linhas e de colunas.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para a matriz criada.
+ */
+MatrizAdjacencia *CriarMatrizAdjacencia(int tamanho, bool *inf);
+
+/**
+ * @brief Liberta a memória alocada para uma matriz de adjacências.
+ *
+ * @param m Apontador para a matriz a eliminar.
+ */
+void ApagarMatrizAdjacencia(MatrizAdjacencia *m);
+
+/**
+ * @brief Devolve a memória ocupada por uma matriz de adjacências.
+ *
+ * @param m Apontador para a matriz.
+ * @return size_t Número de bytes alocados.
+ */
+size_t MemoriaMatrizAdjacencia(MatrizAdjacencia *m);
+
+/**
+ * @brief Define o peso da ligação entre dois vértices.
+ *
+ * @param m Apontador para a matriz.
+ * @param origem Vértice de origem.
+ * @param destino Vértice de destino.
+ * @param peso Peso da ligação (0 retira a ligação).
+ * @return true se a célula existe na matriz, e false caso contrário.
+ */
+bool DefinirLigacaoMatriz(MatrizAdjacencia *m, int origem, int destino, PesoAresta peso);
+
+/**
+ * @brief Calcula os vértices alcançáveis a partir de uma origem.
+ *
+ * A pesquisa avança por níveis: a fronteira seguinte é a união das linhas dos vértices da
+ * fronteira, sem os vértices já visitados, calculada uma palavra de cada vez.
+ *
+ * @param m Apontador para a matriz.
+ * @param origem Vértice de origem.
+ * @param alcancados Conjunto com m->palavrasLinha palavras onde ficam os vértices alcançados (inclui a origem).
+ * @return int Número de vértices alcançados, ou -1 em caso de erro.
+ */
+int AlcancaveisMatriz(MatrizAdjacencia *m, int origem, PalavraBits alcancados[]);
+
+/**
+ * @brief Pesquisa em largura sobre uma matriz de adjacências.
+ *
+ * @param m Apontador para a matriz.
+ * @param origem Vértice de origem.
+ * @param nivel Array com m->tamanho elementos onde fica o número de ligações desde a origem (-1 se não alcançado).
+ * @return int Número de vértices alcançados, ou -1 em caso de erro.
+ */
+int LarguraMatriz(MatrizAdjacencia *m, int origem, int nivel[]);
+
+#endif
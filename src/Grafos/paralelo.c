@@ -0,0 +1,564 @@
+/**
+ * @file paralelo.c
+ * @author Hugo Cruz (a23010)
+ * @brief Implementação do executor paralelo com roubo de trabalho.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "paralelo.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#ifndef LOCAL_THREAD
+#if defined(_MSC_VER)
+#define LOCAL_THREAD __declspec(thread)
+#else
+#define LOCAL_THREAD _Thread_local
+#endif
+#endif
+
+/**
+ * @def ESPERA_ATIVA_FILA
+ * @brief Número de tentativas de obter o bloqueio de uma fila antes de ceder o processador.
+ */
+#define ESPERA_ATIVA_FILA 64
+
+/**
+ * @def PARTES_POR_TRABALHADOR
+ * @brief Número de partes por trabalhador em que um trabalho é dividido quando o grão não é indicado.
+ */
+#define PARTES_POR_TRABALHADOR 16
+
+/**
+ * @brief Executor em que a thread atual está a trabalhar (NULL se não estiver em nenhum).
+ */
+static LOCAL_THREAD ExecutorParalelo* executorAtual;
+
+/**
+ * @brief Número do trabalhador da thread atual no executor executorAtual.
+ */
+static LOCAL_THREAD int trabalhadorAtual;
+
+/**
+ * @brief Argumento de cada thread do executor.
+ *
+ */
+typedef struct ArgumentoTrabalhador
+{
+	ExecutorParalelo* ex; ///< Executor.
+	int trabalhador;	  ///< Número do trabalhador.
+
+} ArgumentoTrabalhador;
+
+/**
+ * @brief Devolve o número de processadores disponíveis.
+ *
+ * @return int Número de processadores (1 se não for possível saber).
+ */
+int NumeroProcessadores(void)
+{
+#if defined(_WIN32)
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#elif defined(_SC_NPROCESSORS_ONLN)
+	long n = sysconf(_SC_NPROCESSORS_ONLN);
+	return n > 0 ? (int)n : 1;
+#else
+	return 1;
+#endif
+}
+
+/**
+ * @brief Obtém o bloqueio da fila de um trabalhador.
+ *
+ * @param t Apontador para o trabalhador.
+ */
+static void BloquearFila(TrabalhadorParalelo* t)
+{
+	int tentativas = 0;
+
+	while (atomic_flag_test_and_set_explicit(&t->ocupada, memory_order_acquire))
+	{
+		if (++tentativas >= ESPERA_ATIVA_FILA)
+		{
+			thrd_yield();
+			tentativas = 0;
+		}
+	}
+}
+
+/**
+ * @brief Liberta o bloqueio da fila de um trabalhador.
+ *
+ * @param t Apontador para o trabalhador.
+ */
+static void DesbloquearFila(TrabalhadorParalelo* t)
+{
+	atomic_flag_clear_explicit(&t->ocupada, memory_order_release);
+}
+
+/**
+ * @brief Indica se a fila de um trabalhador está vazia, sem obter o bloqueio.
+ *
+ * @param t Apontador para o trabalhador.
+ * @return true se não há intervalos na fila.
+ */
+static bool FilaVazia(TrabalhadorParalelo* t)
+{
+	return atomic_load_explicit(&t->base, memory_order_relaxed) <= atomic_load_explicit(&t->topo, memory_order_relaxed);
+}
+
+/**
+ * @brief Retira um intervalo de uma fila, pelo fim (o dono) ou pelo início (quem rouba).
+ *
+ * Quando a fila fica vazia as posições voltam ao início do array.
+ *
+ * @param t Apontador para o trabalhador dono da fila (com o bloqueio obtido).
+ * @param doFim true para retirar o último intervalo, false para retirar o primeiro.
+ * @param i Apontador para o intervalo retirado.
+ * @return true se havia um intervalo na fila.
+ */
+static bool RetirarIntervalo(TrabalhadorParalelo* t, bool doFim, Intervalo* i)
+{
+	int topo = atomic_load_explicit(&t->topo, memory_order_relaxed);
+	int base = atomic_load_explicit(&t->base, memory_order_relaxed);
+
+	if (base <= topo)
+	{
+		return false;
+	}
+
+	if (doFim)
+	{
+		*i = t->intervalos[--base];
+	}
+	else
+	{
+		*i = t->intervalos[topo++];
+	}
+
+	if (base == topo)
+	{
+		topo = base = 0;
+	}
+
+	atomic_store_explicit(&t->topo, topo, memory_order_relaxed);
+	atomic_store_explicit(&t->base, base, memory_order_relaxed);
+	return true;
+}
+
+/**
+ * @brief Acrescenta um intervalo ao fim da fila do próprio trabalhador.
+ *
+ * @param t Apontador para o trabalhador.
+ * @param i Intervalo a acrescentar.
+ * @return true se o intervalo coube na fila.
+ */
+static bool PorIntervalo(TrabalhadorParalelo* t, Intervalo i)
+{
+	BloquearFila(t);
+	int base = atomic_load_explicit(&t->base, memory_order_relaxed);
+	bool coube = base < MAX_INTERVALOS_FILA;
+
+	if (coube)
+	{
+		t->intervalos[base] = i;
+		atomic_store_explicit(&t->base, base + 1, memory_order_relaxed);
+	}
+
+	DesbloquearFila(t);
+	return coube;
+}
+
+/**
+ * @brief Procura um intervalo: primeiro na própria fila, depois nas filas dos outros trabalhadores.
+ *
+ * As vítimas são percorridas a partir de uma posição aleatória, para que os trabalhadores sem
+ * trabalho não roubem todos ao mesmo. Uma fila cujo bloqueio esteja ocupado é saltada.
+ *
+ * @param ex Apontador para o executor.
+ * @param w Número do trabalhador que procura.
+ * @param i Apontador para o intervalo encontrado.
+ * @return true se foi encontrado um intervalo.
+ */
+static bool ProcurarIntervalo(ExecutorParalelo* ex, int w, Intervalo* i)
+{
+	TrabalhadorParalelo* proprio = &ex->trabalhadores[w];
+
+	if (!FilaVazia(proprio))
+	{
+		BloquearFila(proprio);
+		bool encontrou = RetirarIntervalo(proprio, true, i);
+		DesbloquearFila(proprio);
+
+		if (encontrou)
+		{
+			return true;
+		}
+	}
+
+	int n = ex->numTrabalhadores;
+	proprio->semente = proprio->semente * 1103515245u + 12345u;
+	int inicio = (int)((proprio->semente >> 16) % (unsigned int)n);
+
+	for (int k = 0; k < n; k++)
+	{
+		int v = (inicio + k) % n;
+		TrabalhadorParalelo* vitima = &ex->trabalhadores[v];
+
+		if (v == w || FilaVazia(vitima)
+			|| atomic_flag_test_and_set_explicit(&vitima->ocupada, memory_order_acquire))
+		{
+			continue;
+		}
+
+		bool encontrou = RetirarIntervalo(vitima, false, i);
+		DesbloquearFila(vitima);
+
+		if (encontrou)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * @brief Executa um intervalo, um grão de cada vez.
+ *
+ * Antes de cada grão, se a fila do trabalhador estiver vazia, metade do que falta passa para a
+ * fila, onde pode ser roubada; se ninguém a roubar, o próprio trabalhador volta a buscá-la.
+ *
+ * @param ex Apontador para o executor.
+ * @param w Número do trabalhador.
+ * @param i Intervalo a executar.
+ */
+static void ExecutarIntervalo(ExecutorParalelo* ex, int w, Intervalo i)
+{
+	TrabalhadorParalelo* t = &ex->trabalhadores[w];
+	int grao = ex->grao;
+
+	while (i.inicio < i.fim)
+	{
+		if (i.fim - i.inicio > grao && FilaVazia(t))
+		{
+			int meio = i.inicio + (i.fim - i.inicio) / 2;
+
+			if (PorIntervalo(t, (Intervalo){ meio, i.fim }))
+			{
+				i.fim = meio;
+			}
+		}
+
+		int fim = i.fim - i.inicio > grao ? i.inicio + grao : i.fim;
+		ex->funcao(ex->contexto, i.inicio, fim, w);
+#ifdef GRAFOS_ESTATISTICAS
+		//Os contadores das threads do executor passam para o trabalhador antes de o intervalo contar como executado
+		if (w > 0)
+		{
+			SomarEstatisticas(&t->estatisticas, estatisticasThread);
+			LimparEstatisticas();
+		}
+#endif
+		atomic_fetch_sub_explicit(&ex->restantes, fim - i.inicio, memory_order_acq_rel);
+		i.inicio = fim;
+	}
+}
+
+/**
+ * @brief Trabalha no trabalho atual até todos os seus índices estarem executados.
+ *
+ * @param ex Apontador para o executor.
+ * @param w Número do trabalhador.
+ */
+static void Trabalhar(ExecutorParalelo* ex, int w)
+{
+	Intervalo i;
+
+	while (atomic_load_explicit(&ex->restantes, memory_order_acquire) > 0)
+	{
+		if (ProcurarIntervalo(ex, w, &i))
+		{
+			ExecutarIntervalo(ex, w, i);
+		}
+		else
+		{
+			thrd_yield();
+		}
+	}
+}
+
+/**
+ * @brief Função das threads do executor: espera por cada trabalho e ajuda a executá-lo.
+ *
+ * Uma thread que acorde atrasada pode encontrar o trabalho já concluído, caso em que sai logo de
+ * Trabalhar e volta a esperar.
+ *
+ * @param arg Apontador para o argumento da thread (libertado pela própria thread).
+ * @return int 0.
+ */
+static int ExecutarThread(void* arg)
+{
+	ArgumentoTrabalhador a = *(ArgumentoTrabalhador*)arg;
+	ExecutorParalelo* ex = a.ex;
+	unsigned long vista = 0;
+	free(arg);
+
+	executorAtual = ex;
+	trabalhadorAtual = a.trabalhador;
+
+	while (true)
+	{
+		mtx_lock(&ex->trinco);
+
+		while (!ex->terminar && ex->geracao == vista)
+		{
+			cnd_wait(&ex->novoTrabalho, &ex->trinco);
+		}
+
+		if (ex->terminar)
+		{
+			mtx_unlock(&ex->trinco);
+			break;
+		}
+
+		vista = ex->geracao;
+		mtx_unlock(&ex->trinco);
+
+		Trabalhar(ex, a.trabalhador);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Cria um executor paralelo.
+ *
+ * @param numTrabalhadores Número de trabalhadores, incluindo a thread que chama (0 para um por processador).
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return ExecutorParalelo* Apontador para o executor criado.
+ */
+ExecutorParalelo* CriarExecutorParalelo(int numTrabalhadores, bool* inf)
+{
+	*inf = false;
+
+	if (numTrabalhadores < 0)
+	{
+		return NULL;
+	}
+
+	if (numTrabalhadores == 0)
+	{
+		numTrabalhadores = NumeroProcessadores();
+	}
+
+	ExecutorParalelo* ex = (ExecutorParalelo*)calloc(1, sizeof(ExecutorParalelo));
+
+	if (ex == NULL)
+	{
+		return NULL;
+	}
+
+	ex->trabalhadores = (TrabalhadorParalelo*)calloc(numTrabalhadores, sizeof(TrabalhadorParalelo));
+
+	if (ex->trabalhadores == NULL || mtx_init(&ex->exclusivo, mtx_plain) != thrd_success)
+	{
+		free(ex->trabalhadores);
+		free(ex);
+		return NULL;
+	}
+
+	mtx_init(&ex->trinco, mtx_plain);
+	cnd_init(&ex->novoTrabalho);
+	atomic_init(&ex->restantes, 0);
+
+	for (int w = 0; w < numTrabalhadores; w++)
+	{
+		TrabalhadorParalelo* t = &ex->trabalhadores[w];
+		atomic_flag_clear(&t->ocupada);
+		atomic_init(&t->topo, 0);
+		atomic_init(&t->base, 0);
+		t->semente = 2654435761u * (unsigned int)(w + 1);
+	}
+
+	//O trabalhador 0 é a thread que chama ParaleloPara; só os restantes têm thread própria
+	for (int w = 1; w < numTrabalhadores; w++)
+	{
+		ArgumentoTrabalhador* a = (ArgumentoTrabalhador*)malloc(sizeof(ArgumentoTrabalhador));
+
+		if (a != NULL)
+		{
+			a->ex = ex;
+			a->trabalhador = w;
+		}
+
+		if (a == NULL || thrd_create(&ex->trabalhadores[w].thread, ExecutarThread, a) != thrd_success)
+		{
+			free(a);
+			ex->numTrabalhadores = w;
+			ApagarExecutorParalelo(ex);
+			return NULL;
+		}
+	}
+
+	ex->numTrabalhadores = numTrabalhadores;
+	*inf = true;
+	return ex;
+}
+
+/**
+ * @brief Termina as threads de um executor e liberta a sua memória.
+ *
+ * @param ex Apontador para o executor (pode ser NULL).
+ */
+void ApagarExecutorParalelo(ExecutorParalelo* ex)
+{
+	if (ex == NULL)
+	{
+		return;
+	}
+
+	mtx_lock(&ex->trinco);
+	ex->terminar = true;
+	cnd_broadcast(&ex->novoTrabalho);
+	mtx_unlock(&ex->trinco);
+
+	for (int w = 0; w < ex->numTrabalhadores; w++)
+	{
+		if (w > 0)
+		{
+			thrd_join(ex->trabalhadores[w].thread, NULL);
+		}
+
+		free(ex->trabalhadores[w].rascunho);
+	}
+
+	mtx_destroy(&ex->exclusivo);
+	mtx_destroy(&ex->trinco);
+	cnd_destroy(&ex->novoTrabalho);
+	free(ex->trabalhadores);
+	free(ex);
+}
+
+/**
+ * @brief Devolve o número de trabalhadores de um executor.
+ *
+ * @param ex Apontador para o executor (NULL equivale a um executor com um só trabalhador).
+ * @return int Número de trabalhadores.
+ */
+int NumeroTrabalhadores(ExecutorParalelo* ex)
+{
+	return ex != NULL ? ex->numTrabalhadores : 1;
+}
+
+/**
+ * @brief Executa uma função sobre todos os índices de [inicio, fim), repartidos pelos trabalhadores.
+ *
+ * Sem grão indicado, o trabalho é dividido em PARTES_POR_TRABALHADOR partes por trabalhador: as
+ * partes são pequenas o bastante para equilibrar a carga e grandes o bastante para que o custo de
+ * cada chamada da função não conte.
+ * Com GRAFOS_ESTATISTICAS, os contadores do trabalho feito pelas threads do executor são somados
+ * aos da thread que chama, como se fosse ela a fazer todo o trabalho.
+ *
+ * @param ex Apontador para o executor (NULL executa tudo na thread que chama, como trabalhador 0).
+ * @param inicio Primeiro índice.
+ * @param fim Índice a seguir ao último.
+ * @param grao Número de índices por chamada da função (0 para ser o executor a escolher).
+ * @param funcao Função a executar.
+ * @param contexto Dados passados à função.
+ */
+void ParaleloPara(ExecutorParalelo* ex, int inicio, int fim, int grao, FuncaoIntervalo funcao, void* contexto)
+{
+	if (fim <= inicio || funcao == NULL)
+	{
+		return;
+	}
+
+	//Sem threads auxiliares, ou dentro de uma função do mesmo executor, não há nada a repartir
+	if (ex == NULL || ex->numTrabalhadores == 1 || executorAtual == ex)
+	{
+		funcao(contexto, inicio, fim, ex != NULL && executorAtual == ex ? trabalhadorAtual : 0);
+		return;
+	}
+
+	mtx_lock(&ex->exclusivo);
+
+	long long n = (long long)fim - inicio;
+
+	if (grao <= 0)
+	{
+		long long partes = (long long)ex->numTrabalhadores * PARTES_POR_TRABALHADOR;
+		grao = (int)(n / partes > 0 ? n / partes : 1);
+	}
+
+	//Os campos do trabalho ficam visíveis às outras threads pelo bloqueio da fila do trabalhador 0
+	ex->funcao = funcao;
+	ex->contexto = contexto;
+	ex->grao = grao;
+	atomic_store(&ex->restantes, n);
+	PorIntervalo(&ex->trabalhadores[0], (Intervalo){ inicio, fim });
+
+	mtx_lock(&ex->trinco);
+	ex->geracao++;
+	cnd_broadcast(&ex->novoTrabalho);
+	mtx_unlock(&ex->trinco);
+
+	ExecutorParalelo* anterior = executorAtual;
+	int trabalhadorAnterior = trabalhadorAtual;
+	executorAtual = ex;
+	trabalhadorAtual = 0;
+
+	Trabalhar(ex, 0);
+
+#ifdef GRAFOS_ESTATISTICAS
+	//Todos os intervalos foram executados, pelo que os contadores dos outros trabalhadores estão completos
+	for (int w = 1; w < ex->numTrabalhadores; w++)
+	{
+		SomarEstatisticas(&estatisticasThread, ex->trabalhadores[w].estatisticas);
+		memset(&ex->trabalhadores[w].estatisticas, 0, sizeof(EstatisticasGrafos));
+	}
+#endif
+
+	executorAtual = anterior;
+	trabalhadorAtual = trabalhadorAnterior;
+	mtx_unlock(&ex->exclusivo);
+}
+
+/**
+ * @brief Devolve a memória de rascunho de um trabalhador, com pelo menos o tamanho pedido.
+ *
+ * @param ex Apontador para o executor.
+ * @param trabalhador Número do trabalhador.
+ * @param tamanho Número de bytes pretendido.
+ * @return void* Apontador para o rascunho (NULL se não houver memória).
+ */
+void* RascunhoTrabalhador(ExecutorParalelo* ex, int trabalhador, size_t tamanho)
+{
+	if (ex == NULL || trabalhador < 0 || trabalhador >= ex->numTrabalhadores)
+	{
+		return NULL;
+	}
+
+	TrabalhadorParalelo* t = &ex->trabalhadores[trabalhador];
+
+	if (tamanho > t->tamanhoRascunho)
+	{
+		//O conteúdo anterior não é preservado, pelo que não vale a pena copiá-lo com realloc
+		free(t->rascunho);
+		t->rascunho = malloc(tamanho);
+		t->tamanhoRascunho = t->rascunho != NULL ? tamanho : 0;
+	}
+
+	return t->rascunho;
+}
@@ -0,0 +1,555 @@
+/**
+ * @file reordenar.c
+ * @author Hugo Cruz (a23010)
+ * @brief Implementação da renumeração dos vértices de um grafo por localidade.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include <string.h>
+#include "reordenar.h"
+
+ /**
+  * @brief Ligações de um grafo tratadas como não dirigidas, em arrays contíguos.
+  *
+  */
+typedef struct Vizinhanca
+{
+	int tamanho;   ///< Número de posições indexadas.
+	bool* existe;  ///< Indica os ids que correspondem a vértices.
+	int* inicio;   ///< Posição do primeiro vizinho de cada vértice (tamanho + 1 elementos).
+	int* vizinhos; ///< Vizinhos de todos os vértices.
+
+} Vizinhanca;
+
+/**
+ * @brief Vértice acompanhado do seu grau, para ordenar com qsort sem estado partilhado entre threads.
+ *
+ */
+typedef struct GrauVertice
+{
+	int grau; ///< Grau do vértice.
+	int id;	  ///< Id do vértice.
+
+} GrauVertice;
+
+/**
+ * @brief Compara dois vértices pelo grau crescente e depois pelo id.
+ *
+ * @param a Apontador para o primeiro GrauVertice.
+ * @param b Apontador para o segundo GrauVertice.
+ * @return int Negativo, zero ou positivo, como em qsort.
+ */
+static int CompararGrauCrescente(const void* a, const void* b)
+{
+	const GrauVertice* x = (const GrauVertice*)a;
+	const GrauVertice* y = (const GrauVertice*)b;
+
+	if (x->grau != y->grau)
+	{
+		return x->grau < y->grau ? -1 : 1;
+	}
+
+	return x->id < y->id ? -1 : (x->id > y->id);
+}
+
+/**
+ * @brief Compara dois vértices pelo grau decrescente e depois pelo id.
+ *
+ * @param a Apontador para o primeiro GrauVertice.
+ * @param b Apontador para o segundo GrauVertice.
+ * @return int Negativo, zero ou positivo, como em qsort.
+ */
+static int CompararGrauDecrescente(const void* a, const void* b)
+{
+	return CompararGrauCrescente(b, a);
+}
+
+/**
+ * @brief Ordena um array de ids pelo grau dos vértices.
+ *
+ * @param ids Array de ids a ordenar.
+ * @param num Número de ids.
+ * @param grau Grau de cada vértice.
+ * @param pares Array auxiliar com espaço para num elementos.
+ * @param decrescente true para ordenar por grau decrescente.
+ */
+static void OrdenarPorGrau(int ids[], int num, const int grau[], GrauVertice pares[], bool decrescente)
+{
+	for (int i = 0; i < num; i++)
+	{
+		pares[i].grau = grau[ids[i]];
+		pares[i].id = ids[i];
+	}
+
+	qsort(pares, num, sizeof(GrauVertice), decrescente ? CompararGrauDecrescente : CompararGrauCrescente);
+
+	for (int i = 0; i < num; i++)
+	{
+		ids[i] = pares[i].id;
+	}
+}
+
+/**
+ * @brief Cria a vizinhança não dirigida de um grafo a partir de uma imagem.
+ *
+ * @param im Apontador para a imagem.
+ * @param n Apontador para a vizinhança a preencher.
+ * @return true se a memória foi alocada.
+ */
+static bool CriarVizinhanca(ImagemGrafo* im, Vizinhanca* n)
+{
+	n->tamanho = im->tamanho;
+	n->existe = im->existe;
+	n->inicio = (int*)calloc(im->tamanho + 1, sizeof(int));
+	n->vizinhos = (int*)malloc(sizeof(int) * (2 * im->numArestas + 1));
+
+	if (n->inicio == NULL || n->vizinhos == NULL)
+	{
+		free(n->inicio);
+		free(n->vizinhos);
+		return false;
+	}
+
+	//Conta as ligações de cada vértice nos dois sentidos
+	for (int u = 0; u < im->tamanho; u++)
+	{
+		for (int i = im->inicio[u]; i < im->inicio[u + 1]; i++)
+		{
+			n->inicio[u + 1]++;
+			n->inicio[im->destinos[i] + 1]++;
+		}
+	}
+
+	for (int u = 0; u < im->tamanho; u++)
+	{
+		n->inicio[u + 1] += n->inicio[u];
+	}
+
+	int* posicao = (int*)malloc(sizeof(int) * (im->tamanho + 1));
+
+	if (posicao == NULL)
+	{
+		free(n->inicio);
+		free(n->vizinhos);
+		return false;
+	}
+
+	memcpy(posicao, n->inicio, sizeof(int) * (im->tamanho + 1));
+
+	for (int u = 0; u < im->tamanho; u++)
+	{
+		for (int i = im->inicio[u]; i < im->inicio[u + 1]; i++)
+		{
+			n->vizinhos[posicao[u]++] = im->destinos[i];
+			n->vizinhos[posicao[im->destinos[i]]++] = u;
+		}
+	}
+
+	free(posicao);
+	return true;
+}
+
+/**
+ * @brief Numera os vértices por pesquisas em largura, uma por componente.
+ *
+ * Em Cuthill-McKee cada componente começa no vértice de menor grau e os vizinhos são visitados
+ * por grau crescente; no fim a ordem é invertida. Na ordem de pesquisa em largura simples cada
+ * componente começa no menor id e os vizinhos são visitados pela ordem das ligações.
+ *
+ * @param n Apontador para a vizinhança.
+ * @param rcm true para Reverse Cuthill-McKee.
+ * @param novoId Array onde fica o novo id de cada vértice.
+ * @return true se a memória foi alocada.
+ */
+static bool NumerarPorLargura(Vizinhanca* n, bool rcm, int novoId[])
+{
+	int* fila = (int*)malloc(sizeof(int) * (n->tamanho + 1));
+	int* candidatos = (int*)malloc(sizeof(int) * (n->tamanho + 1));
+	int* grau = (int*)malloc(sizeof(int) * (n->tamanho + 1));
+	GrauVertice* pares = (GrauVertice*)malloc(sizeof(GrauVertice) * (n->tamanho + 1));
+
+	if (fila == NULL || candidatos == NULL || grau == NULL || pares == NULL)
+	{
+		free(fila);
+		free(candidatos);
+		free(grau);
+		free(pares);
+		return false;
+	}
+
+	int numCandidatos = 0;
+
+	for (int u = 0; u < n->tamanho; u++)
+	{
+		grau[u] = n->inicio[u + 1] - n->inicio[u];
+		novoId[u] = -1;
+
+		if (n->existe[u])
+		{
+			candidatos[numCandidatos++] = u;
+		}
+	}
+
+	//Os inícios de componente são escolhidos pela ordem dos candidatos
+	if (rcm)
+	{
+		OrdenarPorGrau(candidatos, numCandidatos, grau, pares, false);
+	}
+
+	int numerados = 0;
+
+	for (int c = 0; c < numCandidatos; c++)
+	{
+		if (novoId[candidatos[c]] != -1)
+		{
+			continue;
+		}
+
+		int frente = numerados;
+		fila[numerados] = candidatos[c];
+		novoId[candidatos[c]] = numerados++;
+
+		while (frente < numerados)
+		{
+			int u = fila[frente++];
+			int primeiro = numerados;
+
+			for (int i = n->inicio[u]; i < n->inicio[u + 1]; i++)
+			{
+				int w = n->vizinhos[i];
+
+				if (novoId[w] == -1)
+				{
+					fila[numerados] = w;
+					novoId[w] = numerados++;
+				}
+			}
+
+			//Os vizinhos acabados de juntar à fila passam a estar por grau crescente
+			if (rcm && numerados - primeiro > 1)
+			{
+				OrdenarPorGrau(fila + primeiro, numerados - primeiro, grau, pares, false);
+
+				for (int i = primeiro; i < numerados; i++)
+				{
+					novoId[fila[i]] = i;
+				}
+			}
+		}
+	}
+
+	if (rcm)
+	{
+		for (int i = 0; i < numerados; i++)
+		{
+			novoId[fila[i]] = numerados - 1 - i;
+		}
+	}
+
+	free(fila);
+	free(candidatos);
+	free(grau);
+	free(pares);
+	return true;
+}
+
+/**
+ * @brief Numera os vértices por grau decrescente.
+ *
+ * @param n Apontador para a vizinhança.
+ * @param novoId Array onde fica o novo id de cada vértice.
+ * @return true se a memória foi alocada.
+ */
+static bool NumerarPorGrau(Vizinhanca* n, int novoId[])
+{
+	int* vertices = (int*)malloc(sizeof(int) * (n->tamanho + 1));
+	int* grau = (int*)malloc(sizeof(int) * (n->tamanho + 1));
+	GrauVertice* pares = (GrauVertice*)malloc(sizeof(GrauVertice) * (n->tamanho + 1));
+
+	if (vertices == NULL || grau == NULL || pares == NULL)
+	{
+		free(vertices);
+		free(grau);
+		free(pares);
+		return false;
+	}
+
+	int numVertices = 0;
+
+	for (int u = 0; u < n->tamanho; u++)
+	{
+		grau[u] = n->inicio[u + 1] - n->inicio[u];
+		novoId[u] = -1;
+
+		if (n->existe[u])
+		{
+			vertices[numVertices++] = u;
+		}
+	}
+
+	OrdenarPorGrau(vertices, numVertices, grau, pares, true);
+
+	for (int i = 0; i < numVertices; i++)
+	{
+		novoId[vertices[i]] = i;
+	}
+
+	free(vertices);
+	free(grau);
+	free(pares);
+	return true;
+}
+
+/**
+ * @brief Calcula uma nova numeração dos vértices de um grafo.
+ *
+ * As ligações são tratadas como não dirigidas. Os vértices vizinhos recebem ids próximos, pelo
+ * que as distâncias e os antecessores que os algoritmos leem e escrevem juntos ficam nas mesmas
+ * linhas de cache. Os novos ids são seguidos, de 0 a número de vértices - 1.
+ *
+ * @param g Apontador para o grafo.
+ * @param ordem Ordem pretendida.
+ * @param tamanho Apontador onde fica o número de posições do array devolvido (maior id + 1).
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return int* Array com o novo id de cada id atual (-1 nos ids sem vértice), ou NULL em caso de erro.
+ */
+int* CalcularOrdemVertices(Grafo* g, OrdemVertices ordem, int* tamanho, bool* inf)
+{
+	*inf = false;
+	*tamanho = 0;
+
+	ImagemGrafo* im = CriarImagemGrafo(g, inf);
+
+	if (!*inf)
+	{
+		return NULL;
+	}
+
+	*inf = false;
+
+	Vizinhanca n;
+	int* novoId = (int*)malloc(sizeof(int) * (im->tamanho + 1));
+
+	if (novoId == NULL || !CriarVizinhanca(im, &n))
+	{
+		free(novoId);
+		ApagarImagemGrafo(im);
+		return NULL;
+	}
+
+	bool ok = ordem == ORDEM_GRAU ? NumerarPorGrau(&n, novoId) : NumerarPorLargura(&n, ordem == ORDEM_RCM, novoId);
+
+	*tamanho = im->tamanho;
+
+	free(n.inicio);
+	free(n.vizinhos);
+	ApagarImagemGrafo(im);
+
+	if (!ok)
+	{
+		free(novoId);
+		*tamanho = 0;
+		return NULL;
+	}
+
+	*inf = true;
+	return novoId;
+}
+
+/**
+ * @brief Compara dois vértices pelo id, para qsort.
+ *
+ * @param a Apontador para o primeiro vértice.
+ * @param b Apontador para o segundo vértice.
+ * @return int Negativo, zero ou positivo, como em qsort.
+ */
+static int CompararVertices(const void* a, const void* b)
+{
+	int x = (*(Vertice* const*)a)->id, y = (*(Vertice* const*)b)->id;
+	return (x > y) - (x < y);
+}
+
+/**
+ * @brief Renumera os vértices e as adjacências de um grafo.
+ *
+ * Os ids são trocados no próprio grafo e a lista de vértices é reordenada pelos novos ids. Deve
+ * ser chamada antes de criar imagens do grafo ou de o guardar.
+ *
+ * @param g Apontador para o grafo.
+ * @param novoId Novo id de cada id atual, como devolvido por CalcularOrdemVertices.
+ * @param tamanho Número de posições de novoId.
+ * @param inf Apontador para um bool que fica false se novoId não der um id diferente a cada vértice.
+ * @return Apontador para o grafo.
+ */
+Grafo* RenumerarGrafo(Grafo* g, int novoId[], int tamanho, bool* inf)
+{
+	*inf = false;
+
+	//Os ids são alterados nas listas de adjacências
+	if (g == NULL || novoId == NULL || !ExpandirMatrizGrafo(g))
+	{
+		return g;
+	}
+
+	int numVertices = 0;
+
+	for (Vertice* v = g->inicioGrafo; v != NULL; v = v->nextV)
+	{
+		numVertices++;
+	}
+
+	Vertice** vertices = (Vertice**)malloc(sizeof(Vertice*) * (numVertices + 1));
+	bool* usado = (bool*)calloc(tamanho + 1, sizeof(bool));
+
+	if (vertices == NULL || usado == NULL)
+	{
+		free(vertices);
+		free(usado);
+		return g;
+	}
+
+	//Confirma que todos os vértices recebem um id diferente antes de alterar o grafo
+	int k = 0;
+
+	for (Vertice* v = g->inicioGrafo; v != NULL; v = v->nextV)
+	{
+		int id = v->id >= 0 && v->id < tamanho ? novoId[v->id] : -1;
+
+		if (id < 0 || id >= tamanho || usado[id])
+		{
+			free(vertices);
+			free(usado);
+			return g;
+		}
+
+		usado[id] = true;
+		vertices[k++] = v;
+	}
+
+	free(usado);
+
+	for (int i = 0; i < numVertices; i++)
+	{
+		vertices[i]->id = novoId[vertices[i]->id];
+
+		//InserirAdjGrafo só aceita destinos existentes, por isso todos os destinos têm um novo id
+		for (Adjacente* a = vertices[i]->nextA; a != NULL; a = a->next)
+		{
+			if (a->id >= 0 && a->id < tamanho && novoId[a->id] != -1)
+			{
+				a->id = novoId[a->id];
+			}
+		}
+	}
+
+	qsort(vertices, numVertices, sizeof(Vertice*), CompararVertices);
+
+	for (int i = 0; i < numVertices; i++)
+	{
+		vertices[i]->antV = i > 0 ? vertices[i - 1] : NULL;
+		vertices[i]->nextV = i + 1 < numVertices ? vertices[i + 1] : NULL;
+	}
+
+	g->inicioGrafo = numVertices > 0 ? vertices[0] : NULL;
+	g->versao++;
+	free(vertices);
+
+	*inf = true;
+
+	//Os destinos mudaram de id, pelo que as listas deixam de estar ordenadas
+	if (g->adjOrdenadas)
+	{
+		g = OrdenarAdjacenciasGrafo(g, inf);
+	}
+
+	if (g->indice != NULL)
+	{
+		g = ConfigurarIndiceEntradasGrafo(g, true, inf);
+	}
+
+	return g;
+}
+
+/**
+ * @brief Aplica a um mapa de ids externos a renumeração feita com RenumerarGrafo.
+ *
+ * Os ids do mapa que já não têm vértice no grafo, por exemplo depois de eliminar vértices, têm
+ * novoId -1 ou ficam fora de novoId; esses recebem ids seguidos a seguir ao maior novo id dos
+ * vértices, pela ordem atual, para o mapa continuar a usar os ids de 0 a numIds - 1.
+ *
+ * @param m Apontador para o mapa.
+ * @param novoId Novo id de cada id interno atual.
+ * @param tamanho Número de posições de novoId.
+ * @param inf Apontador para um bool que fica false se faltar memória ou se o grafo tiver vértices que não estão no mapa (o mapa não é alterado).
+ * @return Apontador para o mapa.
+ */
+MapaIds* RenumerarMapaIds(MapaIds* m, int novoId[], int tamanho, bool* inf)
+{
+	*inf = false;
+
+	if (m == NULL || (novoId == NULL && tamanho > 0))
+	{
+		return m;
+	}
+
+	//Os ids sem vértice no grafo ficam a seguir ao maior novo id dos vértices
+	int proximo = 0;
+
+	for (int i = 0; i < tamanho; i++)
+	{
+		if (novoId[i] >= proximo)
+		{
+			proximo = novoId[i] + 1;
+		}
+	}
+
+	long long* externos = (long long*)malloc(sizeof(long long) * m->capacidade);
+	int* novo = (int*)malloc(sizeof(int) * (m->numIds + 1));
+	bool* usado = (bool*)calloc(m->numIds + 1, sizeof(bool));
+
+	if (externos == NULL || novo == NULL || usado == NULL)
+	{
+		free(externos);
+		free(novo);
+		free(usado);
+		return m;
+	}
+
+	for (int i = 0; i < m->numIds; i++)
+	{
+		novo[i] = i < tamanho && novoId[i] >= 0 ? novoId[i] : proximo++;
+
+		//Um id fora do mapa ou repetido indica que o grafo tem vértices que o mapa não conhece
+		if (novo[i] >= m->numIds || usado[novo[i]])
+		{
+			free(externos);
+			free(novo);
+			free(usado);
+			return m;
+		}
+
+		usado[novo[i]] = true;
+		externos[novo[i]] = m->externos[i];
+	}
+
+	free(usado);
+
+	//A posição de cada id externo na tabela não muda, só o id interno guardado nela
+	free(m->externos);
+	m->externos = externos;
+
+	for (int i = 0; i < m->tamanhoTabela; i++)
+	{
+		if (m->tabela[i] != -1)
+		{
+			m->tabela[i] = novo[m->tabela[i]];
+		}
+	}
+
+	free(novo);
+	*inf = true;
+	return m;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file reordenar.h
+ * @author Hugo Cruz (a23010)
+ * @brief Ficheiro de cabeçalho para a renumeração dos vértices de um grafo por localidade.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef REORDENAR_H
+#define REORDENAR_H
+
+#include "imagem.h"
+#include "mapa.h"
+
+/**
+ * @brief Ordens em que os vértices podem ser renumerados.
+ *
+ */
+typedef enum OrdemVertices
+{
+	ORDEM_RCM,	///< Reverse Cuthill-McKee: pesquisa em largura por grau crescente, com a ordem final invertida.
+	ORDEM_BFS,	///< Pesquisa em largura a partir do menor id de cada componente.
+	ORDEM_GRAU	///< Grau decrescente, para os vértices mais usados ficarem juntos no início.
+
+} OrdemVertices;
+
+/**
+ * @brief Calcula uma nova numeração dos vértices de um grafo.
+ *
+ * As ligações são tratadas como não dirigidas. Os vértices vizinhos recebem ids próximos, pelo
+ * que as distâncias e os antecessores que os algoritmos leem e escrevem juntos ficam nas mesmas
+ * linhas de cache. Os novos ids são seguidos, de 0 a número de vértices - 1.
+ *
+ * @param g Apontador para o grafo.
+ * @param ordem Ordem pretendida.
+ * @param tamanho Apontador onde fica o número de posições do array devolvido (maior id + 1).
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return int* Array com o novo id de cada id atual (-1 nos ids sem vértice), ou NULL em caso de erro.
+ */
+int *CalcularOrdemVertices(Grafo *g, OrdemVertices ordem, int *tamanho, bool *inf);
+
+/**
+ * @brief Renumera os vértices e as adjacências de um grafo.
+ *
+ * Os ids são trocados no próprio grafo e a lista de vértices é reordenada pelos novos ids. Deve
+ * ser chamada antes de criar imagens do grafo ou de o guardar.
+ *
+ * @param g Apontador para o grafo.
+ * @param novoId Novo id de cada id atual, como devolvido por CalcularOrdemVertices.
+ * @param tamanho Número de posições de novoId.
+ * @param inf Apontador para um bool que fica false se novoId não der um id diferente a cada vértice.
+ * @return Apontador para o grafo.
+ */
+Grafo *RenumerarGrafo(Grafo *g, int novoId[], int tamanho, bool *inf);
+
+/**
+ * @brief Aplica a um mapa de ids externos a renumeração feita com RenumerarGrafo.
+ *
+ * Os ids do mapa que já não têm vértice no grafo, por exemplo depois de eliminar vértices, têm
+ * novoId -1 ou ficam fora de novoId; esses recebem ids seguidos a seguir ao maior novo id dos
+ * vértices, pela ordem atual, para o mapa continuar a usar os ids de 0 a numIds - 1.
+ *
+ * @param m Apontador para o mapa.
+ * @param novoId Novo id de cada id interno atual.
+ * @param tamanho Número de posições de novoId.
+ * @param inf Apontador para um bool que fica false se faltar memória ou se o grafo tiver vértices que não estão no mapa (o mapa não é alterado).
+ * @return Apontador para o mapa.
+ */
+MapaIds *RenumerarMapaIds(MapaIds *m, int novoId[], int tamanho, bool *inf);
+
+#endif
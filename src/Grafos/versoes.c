@@ -0,0 +1,271 @@
+/**
+ * @file versoes.c
+ * @author Hugo Cruz (a23010)
+ * @brief Implementação da publicação de versões de um grafo lidas sem bloqueios por várias threads.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include <limits.h>
+#include "versoes.h"
+
+ /**
+  * @brief Cria um gestor de versões e publica a primeira imagem do grafo.
+  *
+  * @param g Apontador para o grafo.
+  * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+  * @return Apontador para o gestor criado.
+  */
+GestorVersoes* CriarGestorVersoes(Grafo* g, bool* inf)
+{
+	*inf = false;
+
+	if (g == NULL)
+	{
+		return NULL;
+	}
+
+	GestorVersoes* gv = (GestorVersoes*)malloc(sizeof(GestorVersoes));
+
+	if (gv == NULL)
+	{
+		return NULL;
+	}
+
+	ImagemGrafo* im = CriarImagemGrafo(g, inf);
+
+	if (im == NULL)
+	{
+		free(gv);
+		return NULL;
+	}
+
+	atomic_init(&gv->atual, im);
+	atomic_init(&gv->epoca, 1); //A época 0 indica um leitor sem versão fixada
+
+	for (int i = 0; i < MAX_LEITORES_VERSOES; i++)
+	{
+		atomic_init(&gv->leitores[i].epoca, 0);
+		atomic_init(&gv->leitores[i].ocupado, false);
+	}
+
+	gv->retiradas = NULL;
+	gv->numRetiradas = 0;
+	gv->capacidadeRetiradas = 0;
+
+	*inf = true;
+	return gv;
+}
+
+/**
+ * @brief Liberta o gestor e todas as imagens.
+ *
+ * Só pode ser chamada quando nenhuma thread leitora tiver uma versão fixada.
+ *
+ * @param gv Apontador para o gestor a eliminar.
+ */
+void ApagarGestorVersoes(GestorVersoes* gv)
+{
+	if (gv == NULL)
+	{
+		return;
+	}
+
+	for (int i = 0; i < gv->numRetiradas; i++)
+	{
+		ApagarImagemGrafo(gv->retiradas[i].imagem);
+	}
+
+	ApagarImagemGrafo(atomic_load(&gv->atual));
+	free(gv->retiradas);
+	free(gv);
+}
+
+/**
+ * @brief Atribui uma posição de leitor à thread que chama a função.
+ *
+ * @param gv Apontador para o gestor.
+ * @return int Identificador do leitor, ou -1 se já existirem MAX_LEITORES_VERSOES leitores.
+ */
+int RegistarLeitor(GestorVersoes* gv)
+{
+	if (gv == NULL)
+	{
+		return -1;
+	}
+
+	for (int i = 0; i < MAX_LEITORES_VERSOES; i++)
+	{
+		bool livre = false;
+
+		if (atomic_compare_exchange_strong(&gv->leitores[i].ocupado, &livre, true))
+		{
+			atomic_store(&gv->leitores[i].epoca, 0);
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Liberta a posição de um leitor.
+ *
+ * @param gv Apontador para o gestor.
+ * @param leitor Identificador devolvido por RegistarLeitor.
+ */
+void RemoverLeitor(GestorVersoes* gv, int leitor)
+{
+	if (gv == NULL || leitor < 0 || leitor >= MAX_LEITORES_VERSOES)
+	{
+		return;
+	}
+
+	atomic_store(&gv->leitores[leitor].epoca, 0);
+	atomic_store(&gv->leitores[leitor].ocupado, false);
+}
+
+/**
+ * @brief Fixa a imagem atual para leitura.
+ *
+ * A imagem devolvida não é apagada enquanto o leitor não chamar SoltarVersao. A função não usa
+ * bloqueios: apenas anuncia a época do leitor e lê a imagem atual.
+ *
+ * @param gv Apontador para o gestor.
+ * @param leitor Identificador do leitor.
+ * @return ImagemGrafo* Imagem fixada.
+ */
+ImagemGrafo* FixarVersao(GestorVersoes* gv, int leitor)
+{
+	if (gv == NULL || leitor < 0 || leitor >= MAX_LEITORES_VERSOES)
+	{
+		return NULL;
+	}
+
+	//A época tem de ser anunciada antes de ler a imagem: se a imagem lida já tiver sido
+	//substituída, a época anunciada é anterior à troca e impede que seja apagada
+	atomic_store(&gv->leitores[leitor].epoca, atomic_load(&gv->epoca));
+	return atomic_load(&gv->atual);
+}
+
+/**
+ * @brief Indica que o leitor deixou de usar a imagem fixada.
+ *
+ * @param gv Apontador para o gestor.
+ * @param leitor Identificador do leitor.
+ */
+void SoltarVersao(GestorVersoes* gv, int leitor)
+{
+	if (gv == NULL || leitor < 0 || leitor >= MAX_LEITORES_VERSOES)
+	{
+		return;
+	}
+
+	atomic_store(&gv->leitores[leitor].epoca, 0);
+}
+
+/**
+ * @brief Publica uma nova imagem do grafo.
+ *
+ * Só a thread escritora pode chamar esta função. A imagem é criada antes da troca, pelo que os
+ * leitores nunca esperam pela escritora. As imagens substituídas cujo período de graça já
+ * terminou são apagadas.
+ *
+ * @param gv Apontador para o gestor.
+ * @param g Apontador para o grafo, alterado apenas pela thread escritora.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para o gestor.
+ */
+GestorVersoes* PublicarVersao(GestorVersoes* gv, Grafo* g, bool* inf)
+{
+	*inf = false;
+
+	if (gv == NULL || g == NULL)
+	{
+		return gv;
+	}
+
+	//Garante espaço para a imagem que vai ser substituída antes de publicar a nova
+	if (gv->numRetiradas == gv->capacidadeRetiradas)
+	{
+		int capacidade = gv->capacidadeRetiradas > 0 ? gv->capacidadeRetiradas * 2 : 8;
+		VersaoRetirada* novo = (VersaoRetirada*)realloc(gv->retiradas, sizeof(VersaoRetirada) * capacidade);
+
+		if (novo == NULL)
+		{
+			return gv;
+		}
+
+		gv->retiradas = novo;
+		gv->capacidadeRetiradas = capacidade;
+	}
+
+	ImagemGrafo* im = CriarImagemGrafo(g, inf);
+
+	if (im == NULL)
+	{
+		return gv;
+	}
+
+	//Os leitores que anunciarem a nova época já só conseguem obter a nova imagem
+	ImagemGrafo* antiga = atomic_exchange(&gv->atual, im);
+	unsigned long epoca = atomic_fetch_add(&gv->epoca, 1) + 1;
+
+	gv->retiradas[gv->numRetiradas].imagem = antiga;
+	gv->retiradas[gv->numRetiradas].epoca = epoca;
+	gv->numRetiradas++;
+
+	RecolherVersoes(gv);
+
+	*inf = true;
+	return gv;
+}
+
+/**
+ * @brief Apaga as imagens substituídas que já nenhum leitor pode estar a usar.
+ *
+ * Só a thread escritora pode chamar esta função.
+ *
+ * @param gv Apontador para o gestor.
+ * @return int Número de imagens apagadas.
+ */
+int RecolherVersoes(GestorVersoes* gv)
+{
+	if (gv == NULL || gv->numRetiradas == 0)
+	{
+		return 0;
+	}
+
+	//Menor época anunciada pelos leitores com uma versão fixada
+	unsigned long minima = ULONG_MAX;
+
+	for (int i = 0; i < MAX_LEITORES_VERSOES; i++)
+	{
+		unsigned long epoca = atomic_load(&gv->leitores[i].epoca);
+
+		if (epoca != 0 && epoca < minima)
+		{
+			minima = epoca;
+		}
+	}
+
+	int apagadas = 0, mantidas = 0;
+
+	for (int i = 0; i < gv->numRetiradas; i++)
+	{
+		if (gv->retiradas[i].epoca <= minima)
+		{
+			ApagarImagemGrafo(gv->retiradas[i].imagem);
+			apagadas++;
+		}
+		else
+		{
+			gv->retiradas[mantidas++] = gv->retiradas[i];
+		}
+	}
+
+	gv->numRetiradas = mantidas;
+	return apagadas;
+}
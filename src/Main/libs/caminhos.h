@@ -11,7 +11,57 @@
 #ifndef CAMINHOS_H
 #define CAMINHOS_H
 
+#include <limits.h>
 #include "grafo.h"
+#include "fila.h"
+#include "compacto.h"
+#include "paralelo.h"
+
+/**
+ * @brief Estrutura de um caminho entre dois vértices.
+ *
+ * Os arrays são alocados com o tamanho exato do caminho. pesos[i] é o peso da adjacência entre
+ * vertices[i] e vertices[i + 1], pelo que só os primeiros numVertices - 1 pesos são usados.
+ */
+typedef struct Caminho
+{
+	int numVertices;	///< Número de vértices do caminho.
+	Distancia custo;	///< Distância total do caminho.
+	int *vertices;		///< Vértices do caminho, da origem ao destino.
+	PesoAresta *pesos;	///< Pesos das adjacências do caminho (NULL se não forem pedidos).
+
+} Caminho;
+
+/**
+ * @brief Estrutura com a memória de trabalho do algoritmo de Dijkstra.
+ *
+ * O espaço de trabalho guarda um índice dos vértices pelo seu id e todos os arrays usados numa
+ * pesquisa, para que várias pesquisas seguidas sobre o mesmo grafo não voltem a alocar memória
+ * nem a percorrer a lista de vértices. As adjacências são lidas de uma imagem do grafo com arrays
+ * contíguos de pares (destino, peso), pelo que a relaxação não volta a percorrer listas ligadas.
+ * Apenas as posições alteradas por uma pesquisa são reinicializadas na pesquisa seguinte. Depois
+ * de calcular os potenciais com a função Johnson, as pesquisas no espaço de trabalho aceitam pesos
+ * negativos.
+ */
+typedef struct EspacoCaminhos
+{
+	int tamanho;				///< Número de elementos dos arrays (maior id + 1).
+	unsigned long versao;		///< Versão do grafo para a qual o índice foi construído.
+	Grafo *grafo;				///< Grafo para o qual o índice foi construído (NULL se o espaço pesquisa uma imagem partilhada).
+	ImagemGrafo *imagem;		///< Imagem do grafo com as adjacências em arrays contíguos.
+	bool imagemPropria;			///< Indica se a imagem pertence ao espaço (false se for partilhada).
+	ImagemCompacta *compacta;	///< Imagem comprimida pesquisada em vez de imagem (NULL se não for usada).
+	Distancia *distancias;		///< Distância da origem a cada vértice (DISTANCIA_INFINITA se não alcançado).
+	int *verticeAnt;			///< Antecessor de cada vértice (-1 se não existir).
+	PesoAresta *pesoAnt;		///< Peso da adjacência usada para chegar a cada vértice.
+	bool *visitado;				///< Indica os vértices cuja distância já é final.
+	bool *bloqueado;			///< Vértices excluídos da pesquisa, geridos por quem a chama.
+	int *tocados;				///< Vértices alterados pela última pesquisa.
+	int numTocados;				///< Número de elementos em tocados.
+	FilaPrioridade *fila;		///< Fila de prioridade da pesquisa.
+	Distancia *potencial;		///< Potenciais de Johnson para pesos negativos (NULL se não forem usados).
+
+} EspacoCaminhos;
 
 /**
  * @brief Inicializa os arrays de distâncias.
@@ -19,8 +69,9 @@
  * Esta função inicializa os arrays de distâncias, atribuindo a cada elemento o valor máximo de um inteiro.
  * 
  * @param dis Array de distâncias a ser inicializado.
+ * @param n Número de elementos do array.
  */
-void InicializarArrays(int* dis[]);
+void InicializarArrays(Distancia dis[], int n);
 
 /**
  * @brief Conta o número de vértices num grafo.
@@ -32,6 +83,17 @@ void InicializarArrays(int* dis[]);
  */
 int ContadorVertices(Grafo* g);
 
+/**
+ * @brief Calcula o tamanho dos arrays indexados pelo id dos vértices.
+ *
+ * Esta função percorre a lista de vértices e retorna o maior id mais um, que é o número
+ * de elementos que os arrays de distâncias e antecessores precisam de ter.
+ *
+ * @param g O grafo a ser analisado.
+ * @return int O tamanho dos arrays (0 se o grafo estiver vazio).
+ */
+int TamanhoArraysCaminhos(Grafo* g);
+
 /**
  * @brief Encontra a o vértice com a distância mínima
  * 
@@ -40,38 +102,98 @@ int ContadorVertices(Grafo* g);
  * 
  * @param distancia Array com as distâncias acumuladas de cada vértice.
  * @param visitado Array que indica se um vértice foi ou não visitado.
- * @param n Número total de vértices.
- * @return int O id do vértice com a distância mínima.
+ * @param n Número de elementos dos arrays.
+ * @return int O id do vértice com a distância mínima ou -1 se não restar nenhum vértice alcançável.
  */
-int DistanciaMinima(int distancia[], bool visitado[], int n);
+int DistanciaMinima(Distancia distancia[], bool visitado[], int n);
 
 /**
  * @brief Algoritmo de Dijkstra
  *
  * Esta função implementa o algoritmo de Dijkstra, que é usado para encontrar os caminhos mais curtos de um vértice de origem para todos os outros vértices num grafo.
+ * O algoritmo assume pesos não negativos; para grafos com pesos negativos deve ser usada a função BellmanFord.
+ * A pesquisa é feita com DijkstraRestrito, que relaxa as adjacências a partir de arrays contíguos.
  *
  * @param g Apontador para o grafo no qual o algoritmo de Dijkstra será executado
  * @param origem O vértice de origem para o qual os caminhos mais curtos serão calculados
  * @param distanciasFinais Array que será preenchido com as distâncias mais curtas da origem para cada vértice
+ * @param verticeAnt Array que será preenchido com os antecessores de cada vértice
+ *
+ * Os dois arrays têm de ter pelo menos TamanhoArraysCaminhos(g) elementos.
+ */
+void Dijkstra(Grafo* g, int origem, Distancia distanciasFinais[], int verticeAnt[]);
+
+/**
+ * @brief Calcula a árvore de caminhos mais curtos de uma origem.
+ *
+ * Esta função cria uma árvore de caminhos com o tamanho adequado ao grafo e preenche-a com o
+ * algoritmo de Dijkstra, ou com o algoritmo de Bellman-Ford se o grafo tiver pesos negativos.
+ * A árvore não é guardada na cache.
+ *
+ * @param g Apontador para o grafo
+ * @param origem O vértice de origem
+ * @return ArvoreCaminhos* Apontador para a árvore calculada ou NULL em caso de erro ou de ciclo negativo
+ */
+ArvoreCaminhos* CalcularArvoreCaminhos(Grafo* g, int origem);
+
+/**
+ * @brief Obtém a árvore de caminhos mais curtos de uma origem, usando a cache do grafo.
+ *
+ * Esta função procura a árvore na cache do grafo e só executa o algoritmo de Dijkstra se a árvore
+ * não existir ou se o grafo tiver sido alterado desde que foi calculada. A árvore devolvida deve
+ * ser entregue a LibertarArvoreCaminhos quando deixar de ser usada.
+ *
+ * @param g Apontador para o grafo
+ * @param origem O vértice de origem
+ * @return ArvoreCaminhos* Apontador para a árvore ou NULL em caso de erro
+ */
+ArvoreCaminhos* ObterArvoreCaminhos(Grafo* g, int origem);
+
+/**
+ * @brief Obtém a árvore de caminhos mais curtos de uma origem, usando a cache do grafo, indicando se falhou por um ciclo negativo.
+ *
+ * Igual a ObterArvoreCaminhos, para quem precisa de distinguir um ciclo negativo alcançável a
+ * partir da origem de uma falta de memória.
+ *
+ * @param g Apontador para o grafo
+ * @param origem O vértice de origem
+ * @param cicloNegativo Apontador para um bool que fica true se for encontrado um ciclo negativo
+ * @return ArvoreCaminhos* Apontador para a árvore ou NULL em caso de erro ou de ciclo negativo
+ */
+ArvoreCaminhos* ObterArvoreCaminhosCiclo(Grafo* g, int origem, bool* cicloNegativo);
+
+/**
+ * @brief Liberta uma árvore obtida com ObterArvoreCaminhos.
+ *
+ * A árvore só é apagada se não pertencer à cache do grafo.
+ *
+ * @param a Apontador para a árvore
  */
-void Dijkstra(Grafo* g, int origem, int distanciasFinais[]);
+void LibertarArvoreCaminhos(ArvoreCaminhos* a);
 
 /**
  * @brief Calcula a distância mínima entre dois vértices num grafo
  *
- * Esta função calcula a distância mínima entre dois vértices num grafo. O grafo, o vértice de origem e o
- * vértice de destino são passados como argumentos. A função retorna a distância mínima entre os vértices de origem e destino.
+ * Esta função calcula a distância mínima entre dois vértices num grafo. Como com pesos negativos
+ * qualquer valor pode ser uma distância, a falta de caminho é indicada com DISTANCIA_INFINITA e um
+ * ciclo negativo alcançável a partir da origem, que impede haver distâncias mínimas, é indicado
+ * em cicloNegativo.
  *
  * @param g Apontador para o grafo onde a operação será realizada
  * @param origem Vértice de origem
  * @param destino Vértice de destino
- * @return int A distância mínima entre os vértices de origem e destino.
+ * @param cicloNegativo Apontador para um bool que fica true se for encontrado um ciclo negativo
+ * @return Distancia A distância mínima entre os vértices de origem e destino (DISTANCIA_INFINITA se não existir caminho, em caso de erro ou de ciclo negativo).
  */
-int DistanciaMinimaEntreVertices(Grafo* g, int origem, int destino);
+Distancia DistanciaMinimaEntreVertices(Grafo* g, int origem, int destino, bool* cicloNegativo);
 
 /**
  * @brief Verifica se existe um caminho entre dois vértices num grafo
  *
+ * Os pesos, mesmo negativos, não contam: num grafo denso a pesquisa é feita com os conjuntos de
+ * bits da matriz e nos restantes com uma pesquisa em largura que para no destino, sobre uma imagem
+ * guardada no grafo até à alteração seguinte.
+ *
  * @param g Apontador para o grafo onde a operação será realizada
  * @param origem Vértice de origem
  * @param destino Vértice de destino
@@ -83,9 +205,217 @@ bool ExisteCaminhoGrafo(Grafo* g, int origem, int destino);
 /**
  * @brief Cria um grafo com os caminhos mais curto para cada vertice
  *
+ * Se o grafo tiver pesos negativos, os pesos são ajustados com os potenciais de Johnson para que
+ * cada origem continue a ser calculada com o algoritmo de Dijkstra. Cada distância passa a ser o
+ * peso de uma adjacência e o peso 0 indica que não há caminho, pelo que o grafo não é criado se
+ * alguma distância não couber em PesoAresta (com GRAFOS_PESO_16, 16 bits) ou se dois vértices
+ * diferentes estiverem à distância 0.
+ *
  * @param g Apontador para o grafo original
- * @return Grafo* Apontador para o novo grafo criado
+ * @return Grafo* Apontador para o novo grafo criado, ou NULL se existir um ciclo negativo, se faltar memória ou se alguma distância não puder ser guardada como peso
  */
 Grafo* CriarGrafoCaminhoMaisCurto(Grafo* g);
 
+/**
+ * @brief Cria um espaço de trabalho para o algoritmo de Dijkstra.
+ *
+ * Esta função aloca os arrays de trabalho com o tamanho adequado ao grafo e indexa os vértices
+ * pelo id. O espaço pode ser reutilizado em várias pesquisas; se o grafo for alterado, o índice
+ * é reconstruído automaticamente na pesquisa seguinte.
+ *
+ * @param g Apontador para o grafo
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida
+ * @return EspacoCaminhos* Apontador para o espaço de trabalho criado
+ */
+EspacoCaminhos* CriarEspacoCaminhos(Grafo* g, bool* inf);
+
+/**
+ * @brief Liberta a memória alocada para um espaço de trabalho.
+ *
+ * @param e Apontador para o espaço de trabalho a eliminar
+ */
+void ApagarEspacoCaminhos(EspacoCaminhos* e);
+
+/**
+ * @brief Devolve a memória ocupada por um espaço de trabalho.
+ *
+ * A imagem do grafo só é contada se pertencer ao espaço; as imagens partilhadas e as imagens
+ * comprimidas são de quem as criou.
+ *
+ * @param e Apontador para o espaço de trabalho
+ * @return size_t Número de bytes alocados
+ */
+size_t MemoriaEspacoCaminhos(EspacoCaminhos* e);
+
+/**
+ * @brief Algoritmo de Dijkstra com vértices e adjacências excluídos.
+ *
+ * Esta função calcula os caminhos mais curtos a partir da origem usando uma fila de prioridade e
+ * o espaço de trabalho. Os vértices marcados em e->bloqueado não são usados, e as adjacências que
+ * saem da origem para os destinos bloqueados também são ignoradas. Assim é possível calcular
+ * desvios sem copiar o grafo. Tal como no resto da biblioteca, adjacências com peso 0 não são
+ * consideradas ligações; as adjacências com peso negativo só são usadas se o espaço de trabalho
+ * tiver potenciais de Johnson.
+ *
+ * Os resultados ficam em e->distancias, e->verticeAnt e e->pesoAnt até à pesquisa seguinte.
+ *
+ * @param g Apontador para o grafo
+ * @param e Apontador para o espaço de trabalho
+ * @param origem O vértice de origem
+ * @param destino O vértice onde a pesquisa pode parar (-1 para calcular todos os vértices)
+ * @param destinosBloqueados Destinos das adjacências da origem que não podem ser usadas (pode ser NULL)
+ * @param numBloqueados Número de elementos em destinosBloqueados
+ * @return Distancia A distância da origem ao destino (DISTANCIA_INFINITA se não existir caminho ou se destino for -1)
+ */
+Distancia DijkstraRestrito(Grafo* g, EspacoCaminhos* e, int origem, int destino, int destinosBloqueados[], int numBloqueados);
+
+/**
+ * @brief Cria um espaço de trabalho para pesquisas numa imagem partilhada.
+ *
+ * @param im Apontador para a imagem do grafo
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida
+ * @return EspacoCaminhos* Apontador para o espaço de trabalho criado
+ */
+EspacoCaminhos* CriarEspacoImagem(ImagemGrafo* im, bool* inf);
+
+/**
+ * @brief Algoritmo de Dijkstra sobre uma imagem do grafo.
+ *
+ * Esta função não lê nem altera o grafo: só lê a imagem, que é imutável, e escreve no espaço de
+ * trabalho. Várias threads podem pesquisar a mesma imagem ao mesmo tempo, desde que cada uma
+ * use o seu próprio espaço de trabalho. Se o espaço estava associado a outra imagem passa a usar
+ * esta. As adjacências com peso negativo não são usadas.
+ *
+ * @param im Apontador para a imagem do grafo
+ * @param e Apontador para o espaço de trabalho
+ * @param origem O vértice de origem
+ * @param destino O vértice onde a pesquisa pode parar (-1 para calcular todos os vértices)
+ * @return Distancia A distância da origem ao destino (DISTANCIA_INFINITA se não existir caminho ou se destino for -1)
+ */
+Distancia DijkstraImagem(ImagemGrafo* im, EspacoCaminhos* e, int origem, int destino);
+
+/**
+ * @brief Cria um espaço de trabalho para pesquisas numa imagem comprimida.
+ *
+ * @param im Apontador para a imagem comprimida
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida
+ * @return EspacoCaminhos* Apontador para o espaço de trabalho criado
+ */
+EspacoCaminhos* CriarEspacoCompacta(ImagemCompacta* im, bool* inf);
+
+/**
+ * @brief Algoritmo de Dijkstra sobre uma imagem comprimida do grafo.
+ *
+ * As adjacências de cada vértice são descodificadas durante a relaxação, sem passar para arrays.
+ * Tal como em DijkstraImagem, a imagem só é lida, pelo que várias threads podem pesquisar a mesma
+ * imagem com espaços de trabalho diferentes, e as adjacências com peso negativo não são usadas.
+ *
+ * @param im Apontador para a imagem comprimida
+ * @param e Apontador para o espaço de trabalho
+ * @param origem O vértice de origem
+ * @param destino O vértice onde a pesquisa pode parar (-1 para calcular todos os vértices)
+ * @return Distancia A distância da origem ao destino (DISTANCIA_INFINITA se não existir caminho ou se destino for -1)
+ */
+Distancia DijkstraCompacta(ImagemCompacta* im, EspacoCaminhos* e, int origem, int destino);
+
+/**
+ * @brief Calcula os k vértices mais próximos de uma origem.
+ *
+ * A pesquisa para quando k vértices, sem contar a origem, tiverem a distância final. Os vértices
+ * ficam por ordem crescente de distância, e os empates são resolvidos pelo menor id, pelo que o
+ * resultado é o mesmo numa imagem e numa imagem comprimida. As distâncias ficam em e->distancias.
+ * Não pode ser usada com potenciais de Johnson.
+ *
+ * @param e Apontador para o espaço de trabalho, já associado a uma imagem (CriarEspacoImagem, CriarEspacoCompacta ou uma pesquisa anterior)
+ * @param origem O vértice de origem
+ * @param k Número máximo de vértices a devolver
+ * @param vizinhos Array com espaço para k vértices
+ * @return int Número de vértices escritos em vizinhos (menor que k se não houver mais vértices alcançáveis), ou -1 em caso de erro
+ */
+int VerticesMaisProximos(EspacoCaminhos* e, int origem, int k, int vizinhos[]);
+
+/**
+ * @brief Calcula as distâncias de várias origens a todos os vértices de uma imagem, em paralelo.
+ *
+ * Cada origem é uma pesquisa completa de Dijkstra; as origens são repartidas pelos trabalhadores
+ * do executor, cada um com o seu espaço de trabalho. A linha i de distancias, com im->tamanho
+ * elementos a partir da posição i * im->tamanho, recebe as distâncias da origem i. Uma origem que
+ * não seja um vértice da imagem fica com a linha toda a DISTANCIA_INFINITA. Com pesos negativos as
+ * pesquisas usam os potenciais de Johnson, calculados uma vez e partilhados pelos trabalhadores;
+ * se a imagem tiver um ciclo negativo nenhuma distância é calculada.
+ *
+ * @param im Apontador para a imagem do grafo
+ * @param ex Apontador para o executor (NULL para calcular tudo na thread que chama)
+ * @param origens Array com as origens (NULL para usar os ids 0 a numOrigens - 1, o que com numOrigens igual a im->tamanho dá as distâncias entre todos os pares)
+ * @param numOrigens Número de origens
+ * @param distancias Array com espaço para numOrigens * im->tamanho distâncias
+ * @return true se as distâncias foram calculadas, false se faltou memória ou a imagem tem um ciclo negativo
+ */
+bool DistanciasVariasOrigens(ImagemGrafo* im, ExecutorParalelo* ex, int origens[], int numOrigens, Distancia distancias[]);
+
+/**
+ * @brief Conta os vértices do caminho até um destino.
+ *
+ * Esta função percorre os antecessores a partir do destino e devolve o número de vértices do
+ * caminho, que é o tamanho do buffer necessário para CopiarCaminho.
+ *
+ * @param verticeAnt Array com os antecessores de cada vértice
+ * @param tamanho Número de elementos de verticeAnt
+ * @param destino Vértice de destino
+ * @return int Número de vértices do caminho, ou -1 se o destino for inválido ou os antecessores tiverem um ciclo
+ */
+int TamanhoCaminho(int verticeAnt[], int tamanho, int destino);
+
+/**
+ * @brief Copia o caminho até um destino para um buffer do chamador.
+ *
+ * Esta função escreve os vértices do caminho, da origem ao destino, no buffer. Se o buffer não
+ * tiver espaço suficiente nada é escrito e é devolvido o tamanho necessário, como em snprintf.
+ *
+ * @param verticeAnt Array com os antecessores de cada vértice
+ * @param tamanho Número de elementos de verticeAnt
+ * @param destino Vértice de destino
+ * @param buffer Array onde os vértices são escritos (pode ser NULL se capacidade for 0)
+ * @param capacidade Número de elementos do buffer
+ * @return int Número de vértices do caminho, ou -1 se o caminho for inválido
+ */
+int CopiarCaminho(int verticeAnt[], int tamanho, int destino, int buffer[], int capacidade);
+
+/**
+ * @brief Reconstrói o caminho até um destino a partir de uma árvore de caminhos.
+ *
+ * Esta função aloca um caminho com o tamanho exato. Numa árvore de caminhos mais curtos o peso
+ * de cada adjacência é a diferença entre as distâncias dos seus vértices, por isso os pesos podem
+ * ser obtidos sem voltar a percorrer o grafo.
+ *
+ * @param a Apontador para a árvore de caminhos
+ * @param destino Vértice de destino
+ * @param comPesos Indica se o array de pesos deve ser preenchido
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida
+ * @return Caminho* Apontador para o caminho, ou NULL se o destino não for alcançável ou não houver memória
+ */
+Caminho* ReconstruirCaminho(ArvoreCaminhos* a, int destino, bool comPesos, bool* inf);
+
+/**
+ * @brief Calcula o caminho mais curto entre dois vértices.
+ *
+ * Esta função obtém a árvore de caminhos da origem (usando a cache do grafo) e reconstrói o
+ * caminho até ao destino.
+ *
+ * @param g Apontador para o grafo
+ * @param origem Vértice de origem
+ * @param destino Vértice de destino
+ * @param comPesos Indica se o array de pesos deve ser preenchido
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida
+ * @return Caminho* Apontador para o caminho, ou NULL se não existir caminho
+ */
+Caminho* ObterCaminho(Grafo* g, int origem, int destino, bool comPesos, bool* inf);
+
+/**
+ * @brief Liberta a memória alocada para um caminho.
+ *
+ * @param c Apontador para o caminho a eliminar
+ */
+void ApagarCaminho(Caminho* c);
+
 #endif
@@ -0,0 +1,226 @@
+/**
+ * @file compacto.h
+ * @author Hugo Cruz (a23010)
+ * @brief Ficheiro de cabeçalho para as imagens de um grafo com as adjacências comprimidas.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef COMPACTO_H
+#define COMPACTO_H
+
+#include "imagem.h"
+
+/**
+ * @brief Estrutura de uma imagem comprimida de um grafo.
+ *
+ * As adjacências de cada vértice são ordenadas pelo destino e guardadas num bloco de bytes: o
+ * grau, e depois, para cada adjacência, a diferença para o destino anterior e o peso. Todos os
+ * números são escritos em varint (7 bits por byte, o bit mais alto indica que o número continua),
+ * e os números que podem ser negativos (a primeira diferença, relativa ao próprio vértice, e o
+ * peso) são primeiro convertidos em zigzag. Com os vértices numerados por localidade a maioria
+ * das adjacências ocupa 2 a 3 bytes, em vez de uma estrutura Adjacente alocada por aresta.
+ *
+ * Tal como ImagemGrafo, só guarda as ligações verdadeiras e não é alterada depois de criada.
+ */
+typedef struct ImagemCompacta
+{
+	unsigned long versao;	///< Versão do grafo a partir da qual a imagem foi criada.
+	int tamanho;			///< Número de posições indexadas (maior id + 1).
+	int numVertices;		///< Número de vértices do grafo.
+	long long numArestas;	///< Número de adjacências guardadas.
+	bool *existe;			///< Indica os ids que correspondem a vértices do grafo.
+	long long *inicio;		///< Posição do bloco de cada vértice em dados (tamanho + 1 elementos).
+	unsigned char *dados;	///< Blocos de adjacências de todos os vértices.
+
+} ImagemCompacta;
+
+/**
+ * @brief Posição de leitura das adjacências de um vértice de uma imagem comprimida.
+ *
+ */
+typedef struct CursorCompacto
+{
+	const unsigned char *p; ///< Próximo byte a ler.
+	int restantes;			///< Número de adjacências ainda por ler.
+	int destino;			///< Destino da última adjacência lida (o próprio vértice antes da primeira).
+	bool primeira;			///< Indica se ainda não foi lida nenhuma adjacência.
+
+} CursorCompacto;
+
+/**
+ * @brief Lê um número em varint e avança a posição de leitura.
+ *
+ * @param p Apontador para a posição de leitura.
+ * @return unsigned int Número lido.
+ */
+static inline unsigned int LerVarint(const unsigned char **p)
+{
+	const unsigned char *q = *p;
+	unsigned int valor = *q & 0x7F;
+	int deslocamento = 7;
+
+	while (*q++ & 0x80)
+	{
+		valor |= (unsigned int)(*q & 0x7F) << deslocamento;
+		deslocamento += 7;
+	}
+
+	*p = q;
+	return valor;
+}
+
+/**
+ * @brief Converte um número em zigzag no inteiro com sinal original.
+ *
+ * @param valor Número em zigzag.
+ * @return int Inteiro original.
+ */
+static inline int DesfazerZigzag(unsigned int valor)
+{
+	return (int)(valor >> 1) ^ -(int)(valor & 1);
+}
+
+/**
+ * @brief Prepara a leitura das adjacências de um vértice.
+ *
+ * @param im Apontador para a imagem.
+ * @param u Vértice (tem de existir na imagem).
+ * @param c Apontador para o cursor a preparar.
+ */
+static inline void IniciarCursorCompacto(const ImagemCompacta *im, int u, CursorCompacto *c)
+{
+	c->p = im->dados + im->inicio[u];
+	c->restantes = (int)LerVarint(&c->p);
+	c->destino = u;
+	c->primeira = true;
+}
+
+/**
+ * @brief Lê a adjacência seguinte de um vértice.
+ *
+ * A descodificação é feita durante a travessia, sem copiar o bloco para arrays.
+ *
+ * @param c Apontador para o cursor.
+ * @param destino Apontador onde fica o destino da adjacência.
+ * @param peso Apontador onde fica o peso da adjacência.
+ * @return true se foi lida uma adjacência, e false se já não restarem adjacências.
+ */
+static inline bool ProximaAdjacenciaCompacta(CursorCompacto *c, int *destino, PesoAresta *peso)
+{
+	if (c->restantes == 0)
+	{
+		return false;
+	}
+
+	unsigned int diferenca = LerVarint(&c->p);
+
+	//Só a primeira diferença, relativa ao próprio vértice, pode ser negativa
+	if (c->primeira)
+	{
+		c->destino += DesfazerZigzag(diferenca);
+		c->primeira = false;
+	}
+	else
+	{
+		c->destino += (int)diferenca;
+	}
+
+	c->restantes--;
+	*destino = c->destino;
+	*peso = (PesoAresta)DesfazerZigzag(LerVarint(&c->p));
+	return true;
+}
+
+/**
+ * @brief Comprime uma imagem de um grafo.
+ *
+ * @param im Apontador para a imagem.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para a imagem comprimida.
+ */
+ImagemCompacta *ComprimirImagemGrafo(ImagemGrafo *im, bool *inf);
+
+/**
+ * @brief Cria uma imagem comprimida com as ligações atuais de um grafo.
+ *
+ * @param g Apontador para o grafo.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para a imagem comprimida.
+ */
+ImagemCompacta *CriarImagemCompacta(Grafo *g, bool *inf);
+
+/**
+ * @brief Liberta a memória alocada para uma imagem comprimida.
+ *
+ * @param im Apontador para a imagem a eliminar.
+ */
+void ApagarImagemCompacta(ImagemCompacta *im);
+
+/**
+ * @brief Devolve a memória ocupada por uma imagem comprimida.
+ *
+ * @param im Apontador para a imagem.
+ * @return size_t Número de bytes alocados.
+ */
+size_t MemoriaImagemCompacta(ImagemCompacta *im);
+
+/**
+ * @brief Cria uma imagem comprimida diretamente a partir dos ficheiros binários do grafo.
+ *
+ * Os ficheiros são os criados por GuardaGrafo. As adjacências são lidas e comprimidas um vértice
+ * de cada vez, sem criar a lista de vértices e adjacências, pelo que grafos que não cabem em
+ * memória nesse formato podem ser carregados.
+ *
+ * Falha se a imagem ultrapassar o orçamento definido com DefinirOrcamentoMemoria; os dados
+ * codificados são verificados antes de cada bloco.
+ *
+ * @param vertices Nome do ficheiro de vértices.
+ * @param adjacencias Nome do ficheiro de adjacências.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para a imagem comprimida, ou NULL em caso de erro.
+ */
+ImagemCompacta *ConverterFicheirosCompacta(char *vertices, char *adjacencias, bool *inf);
+
+/**
+ * @brief Guarda uma imagem comprimida num ficheiro binário.
+ *
+ * O ficheiro tem um cabeçalho com o valor -11, os tamanhos, os vértices existentes, as posições
+ * dos blocos e os blocos tal como estão em memória, pelo que é carregado sem descodificar.
+ *
+ * @param im Apontador para a imagem.
+ * @param file Nome do ficheiro.
+ * @return true se a imagem foi guardada.
+ */
+bool GuardaImagemCompacta(ImagemCompacta *im, char *file);
+
+/**
+ * @brief Carrega uma imagem comprimida de um ficheiro criado com GuardaImagemCompacta.
+ *
+ * Falha, antes de alocar, se a imagem ultrapassar o orçamento definido com DefinirOrcamentoMemoria.
+ * Todos os blocos são descodificados uma vez ao carregar, e o ficheiro é recusado se algum bloco
+ * sair dos dados ou tiver um destino que não é vértice da imagem.
+ *
+ * @param file Nome do ficheiro.
+ * @return ImagemCompacta* Apontador para a imagem carregada, ou NULL em caso de erro.
+ */
+ImagemCompacta *CarregaImagemCompacta(char *file);
+
+/**
+ * @brief Pesquisa em largura sobre uma imagem comprimida.
+ *
+ * Com um destino a pesquisa para assim que ele é alcançado, e os vértices que ficaram por visitar
+ * ficam com -1.
+ *
+ * @param im Apontador para a imagem.
+ * @param origem Vértice de origem.
+ * @param destino Vértice onde a pesquisa pode parar (-1 para visitar todos os vértices alcançáveis).
+ * @param nivel Array com im->tamanho elementos onde fica o número de ligações desde a origem (-1 se não alcançado).
+ * @return int Número de vértices alcançados, ou -1 em caso de erro.
+ */
+int LarguraCompacta(ImagemCompacta *im, int origem, int destino, int nivel[]);
+
+#endif
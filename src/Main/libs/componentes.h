@@ -0,0 +1,125 @@
+/**
+ * @file componentes.h
+ * @author Hugo Cruz (a23010)
+ * @brief Ficheiro de cabeçalho das componentes conexas e fortemente conexas de um grafo.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef COMPONENTES_H
+#define COMPONENTES_H
+
+#include "imagem.h"
+#include "paralelo.h"
+
+/**
+ * @def RONDAS_VIZINHOS
+ * @brief Número de ligações de cada vértice unidas antes de escolher a maior componente.
+ */
+#define RONDAS_VIZINHOS 2
+
+/**
+ * @def AMOSTRAS_COMPONENTES
+ * @brief Número de vértices sorteados para escolher a maior componente.
+ */
+#define AMOSTRAS_COMPONENTES 1024
+
+/**
+ * @brief Estrutura com as componentes de um grafo.
+ *
+ * Cada vértice tem o número da sua componente, entre 0 e numComponentes - 1. Os ids que não
+ * correspondem a vértices do grafo ficam com -1.
+ */
+typedef struct Componentes
+{
+	int tamanho;			///< Número de posições indexadas (o mesmo da imagem).
+	int numComponentes;		///< Número de componentes.
+	int *componente;		///< Componente de cada vértice.
+	int *numMembros;		///< Número de vértices de cada componente (numComponentes elementos).
+
+} Componentes;
+
+/**
+ * @brief Calcula as componentes conexas de uma imagem, ignorando o sentido das ligações.
+ *
+ * Usa uma união de conjuntos sem bloqueios, repartida pelos trabalhadores do executor: primeiro
+ * são unidas as RONDAS_VIZINHOS primeiras ligações de cada vértice, o que chega para juntar a
+ * maior componente na maioria dos grafos; depois é escolhida a componente mais frequente numa
+ * amostra de vértices e só as ligações dos vértices fora dela são percorridas. Esta última fase
+ * precisa das ligações que chegam a cada vértice; sem imagem inversa, e se não houver memória
+ * para a criar, são percorridas todas as ligações.
+ *
+ * @param im Apontador para a imagem do grafo.
+ * @param inversa Apontador para a imagem inversa de im (NULL para ser criada e apagada pela função).
+ * @param ex Apontador para o executor (NULL para calcular só na thread que chama).
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Componentes* Apontador para as componentes criadas.
+ */
+Componentes *ComponentesConexas(ImagemGrafo *im, ImagemGrafo *inversa, ExecutorParalelo *ex, bool *inf);
+
+/**
+ * @brief Calcula as componentes fortemente conexas de uma imagem com o algoritmo de Tarjan.
+ *
+ * A pesquisa em profundidade usa uma pilha própria, pelo que não depende do tamanho da pilha da
+ * thread. As componentes ficam numeradas pela ordem em que terminam, ou seja, por ordem
+ * topológica inversa: uma ligação entre duas componentes vai sempre de uma com número maior para
+ * uma com número menor.
+ *
+ * @param im Apontador para a imagem do grafo.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Componentes* Apontador para as componentes criadas.
+ */
+Componentes *ComponentesFortes(ImagemGrafo *im, bool *inf);
+
+/**
+ * @brief Liberta a memória de um conjunto de componentes.
+ *
+ * @param c Apontador para as componentes (pode ser NULL).
+ */
+void ApagarComponentes(Componentes *c);
+
+/**
+ * @brief Devolve a memória ocupada por um conjunto de componentes.
+ *
+ * @param c Apontador para as componentes.
+ * @return size_t Número de bytes alocados.
+ */
+size_t MemoriaComponentes(Componentes *c);
+
+/**
+ * @brief Indica se as componentes permitem que exista caminho entre dois vértices.
+ *
+ * Não há caminho quando os vértices estão em componentes conexas diferentes ou quando a
+ * componente fortemente conexa da origem tem número menor que a do destino. Quando a função
+ * devolve true o caminho só é garantido se os dois vértices estiverem na mesma componente
+ * fortemente conexa.
+ *
+ * @param conexas Apontador para as componentes conexas (pode ser NULL).
+ * @param fortes Apontador para as componentes fortemente conexas (pode ser NULL).
+ * @param origem Vértice de origem.
+ * @param destino Vértice de destino.
+ * @return true se pode existir caminho, ou se algum dos vértices não é conhecido.
+ */
+static inline bool CaminhoPossivel(const Componentes *conexas, const Componentes *fortes, int origem, int destino)
+{
+	if (conexas != NULL && origem >= 0 && origem < conexas->tamanho && destino >= 0 && destino < conexas->tamanho &&
+		conexas->componente[origem] >= 0 && conexas->componente[destino] >= 0 &&
+		conexas->componente[origem] != conexas->componente[destino])
+	{
+		return false;
+	}
+
+	if (fortes != NULL && origem >= 0 && origem < fortes->tamanho && destino >= 0 && destino < fortes->tamanho &&
+		fortes->componente[origem] >= 0 && fortes->componente[destino] >= 0 &&
+		fortes->componente[origem] < fortes->componente[destino])
+	{
+		return false;
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,101 @@
+/**
+ * @file estatisticas.h
+ * @author Hugo Cruz (a23010)
+ * @brief Ficheiro de cabeçalho para os contadores de trabalho dos algoritmos e das leituras e escritas.
+ *
+ * Os contadores só existem quando a biblioteca é compilada com GRAFOS_ESTATISTICAS. Sem essa
+ * opção a macro CONTAR_ESTATISTICA não gera código e as funções devolvem sempre zeros, pelo que
+ * o programa que as usa compila da mesma forma nos dois casos.
+ *
+ * Cada thread tem os seus contadores, que só ela altera; não há sincronização nos ciclos
+ * internos, e o trabalho de uma pesquisa lenta pode ser isolado limpando os contadores antes.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef ESTATISTICAS_H
+#define ESTATISTICAS_H
+
+#include <stdbool.h>
+
+/**
+ * @brief Estrutura com os contadores de trabalho de uma thread.
+ *
+ */
+typedef struct EstatisticasGrafos
+{
+	unsigned long long verticesFixados;			///< Vértices com a distância final fixada no algoritmo de Dijkstra.
+	unsigned long long arestasRelaxadas;		///< Adjacências relaxadas no algoritmo de Dijkstra.
+	unsigned long long operacoesFila;			///< Inserções e remoções na fila de prioridade.
+	unsigned long long verticesPercorridos;		///< Vértices visitados nas procuras lineares (listas e DistanciaMinima).
+	unsigned long long adjacenciasPercorridas;	///< Nós das listas de adjacências percorridos nas inserções.
+	unsigned long long alocacoes;				///< Vértices e adjacências alocados.
+	unsigned long long bytesLidos;				///< Bytes lidos dos ficheiros.
+	unsigned long long bytesEscritos;			///< Bytes escritos nos ficheiros.
+
+} EstatisticasGrafos;
+
+#ifdef GRAFOS_ESTATISTICAS
+
+#if defined(_MSC_VER)
+#define LOCAL_THREAD __declspec(thread)
+#else
+#define LOCAL_THREAD _Thread_local
+#endif
+
+/**
+ * @brief Contadores da thread atual.
+ */
+extern LOCAL_THREAD EstatisticasGrafos estatisticasThread;
+
+/**
+ * @def CONTAR_ESTATISTICA
+ * @brief Soma n ao contador campo da thread atual.
+ */
+#define CONTAR_ESTATISTICA(campo, n) (estatisticasThread.campo += (unsigned long long)(n))
+
+#else
+
+/**
+ * @def CONTAR_ESTATISTICA
+ * @brief Sem GRAFOS_ESTATISTICAS os contadores não existem.
+ */
+#define CONTAR_ESTATISTICA(campo, n) ((void)0)
+
+#endif
+
+/**
+ * @brief Indica se a biblioteca foi compilada com os contadores.
+ *
+ * @return true se GRAFOS_ESTATISTICAS estava definido, false caso contrário.
+ */
+bool EstatisticasAtivas(void);
+
+/**
+ * @brief Devolve uma cópia dos contadores da thread atual.
+ *
+ * @return EstatisticasGrafos Contadores acumulados desde a última limpeza (zeros sem GRAFOS_ESTATISTICAS).
+ */
+EstatisticasGrafos ObterEstatisticas(void);
+
+/**
+ * @brief Põe a zero os contadores da thread atual.
+ *
+ */
+void LimparEstatisticas(void);
+
+/**
+ * @brief Soma os contadores de b aos de a.
+ *
+ * Útil para juntar os contadores de várias threads, que cada uma obtém com ObterEstatisticas.
+ *
+ * @param a Apontador para os contadores acumulados.
+ * @param b Contadores a somar.
+ */
+void SomarEstatisticas(EstatisticasGrafos* a, EstatisticasGrafos b);
+
+#endif
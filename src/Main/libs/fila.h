@@ -0,0 +1,95 @@
+/**
+ * @file fila.h
+ * @author Hugo Cruz (a23010)
+ * @brief Ficheiro de cabeçalho para a fila de prioridade (heap binário) usada nos algoritmos de caminhos.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef FILA_H
+#define FILA_H
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include "tipos.h"
+
+/**
+ * @brief Estrutura de um elemento da fila de prioridade.
+ *
+ */
+typedef struct ElementoFila
+{
+	Distancia distancia;	///< Prioridade do elemento (menor sai primeiro).
+	int vertice;			///< Identificador do vértice.
+
+} ElementoFila;
+
+/**
+ * @brief Estrutura de uma fila de prioridade mínima.
+ *
+ * A fila é um heap binário guardado num array que cresce quando fica cheio. O mesmo vértice pode
+ * estar várias vezes na fila; quem retira os elementos ignora as entradas desatualizadas.
+ */
+typedef struct FilaPrioridade
+{
+	ElementoFila *elementos; ///< Array com o heap.
+	int tamanho;			 ///< Número de elementos na fila.
+	int capacidade;			 ///< Número de elementos que cabem no array.
+
+} FilaPrioridade;
+
+/**
+ * @brief Cria uma fila de prioridade vazia.
+ *
+ * @param capacidade Número inicial de elementos que cabem na fila.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para a fila criada.
+ */
+FilaPrioridade *CriarFilaPrioridade(int capacidade, bool *inf);
+
+/**
+ * @brief Liberta a memória alocada para uma fila de prioridade.
+ *
+ * @param f Apontador para a fila a eliminar.
+ */
+void ApagarFilaPrioridade(FilaPrioridade *f);
+
+/**
+ * @brief Retira todos os elementos da fila sem libertar a memória.
+ *
+ * @param f Apontador para a fila.
+ */
+void LimparFila(FilaPrioridade *f);
+
+/**
+ * @brief Verifica se a fila está vazia.
+ *
+ * @param f Apontador para a fila.
+ * @return true se a fila não tiver elementos, e false caso contrário.
+ */
+bool FilaVazia(FilaPrioridade *f);
+
+/**
+ * @brief Insere um elemento na fila de prioridade.
+ *
+ * @param f Apontador para a fila.
+ * @param vertice Identificador do vértice.
+ * @param distancia Prioridade do elemento.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para a fila.
+ */
+FilaPrioridade *InserirFila(FilaPrioridade *f, int vertice, Distancia distancia, bool *inf);
+
+/**
+ * @brief Retira o elemento com menor prioridade.
+ *
+ * @param f Apontador para a fila.
+ * @param e Apontador onde o elemento retirado é guardado.
+ * @return true se foi retirado um elemento, e false se a fila estava vazia.
+ */
+bool RetirarMinimoFila(FilaPrioridade *f, ElementoFila *e);
+
+#endif
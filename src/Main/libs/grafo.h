@@ -1,128 +1,329 @@
-/**
- * @file grafo.h
- * @author Hugo Cruz (a23010)
- * @brief Ficheiro de cabeçalho para a estrutura de dados Grafo e funcionalidades.
- * @version 88.1
- * @date 2024-05-24
- *
- * @copyright Copyright (c) 2024
- *
- */
-
-#ifndef GRAFO_H
-#define GRAFO_H
-
-/**
- * @def MAX
- * @brief Define um valor.
- *
- *  Esta macro define um valor maximo de 10.
- */
-#define MAX 10
-
-#include "vertices.h"
-
-/**
- * @brief Estrutura de dados para um Grafo.
- *
- * A estrutura Grafo é uma representação de um grafo em memória, onde
- * inicioGrafo é um apontador para o primeiro vértice do grafo.
- *
- *
- */
-typedef struct Grafo
-{
-	Vertice *inicioGrafo; ///< Apontador para o primeiro vértice do grafo.
-
-} Grafo;
-
-/**
- * @brief Apaga um grafo e limpa a memória alocada.
- *
- * Esta função apaga um grafo e liberta a memória alocada. Ela percorre todos os 
- * vértices e adjacências do grafo, apagando-os um a um
- * 
- * @param g Apontador para o grafo a ser apagado
- */
-void ApagaGrafo(Grafo *g);
-
-/**
- * @brief Cria um novo grafo.
- *
- * Esta função cria um novo grafo. Ela aloca memória para um novo grafo e 
- * retorna um apontador para o grafo criado.
- * 
- * @param inf Apontador para uma variável booleana que será definida como true se a criação do grafo for bem-sucedida, e false caso contrário.
- * @return Apontador para o novo grafo criado.
- */
-Grafo *CriarGrafo(bool *inf);
-
-/**
- * @brief Insere um novo vértice no grafo
- *
- * Esta função insere um novo vértice no grafo. Ela verifica se o valor do novo 
- * vértice já existe e, em seguida, insere-o no fim da lista de vertices.
- * 
- * @param g Apontador para o grafo onde o vértice será inserido.
- * @param novo O valor do novo vértice a ser inserido.
- * @param inf Apontador para uma variável booleana que será definida como true se a inserção for bem-sucedida, e false caso contrário.
- * @return Apontador para o grafo com o novo vértice inserido.
- */
-Grafo *InserirVerticeGrafo(Grafo *g, int novo, bool *inf);
-
-/**
- * @brief Insere uma nova aresta no grafo.
- *
- * Esta função insere uma nova aresta no grafo. Ela verifica se os vértices de 
- * origem e destino são válidos e, em seguida, insere a aresta entre eles.
- * 
- * @param g Apontador para o grafo onde a aresta será inserida.
- * @param origem O valor do vértice de origem da aresta.
- * @param destino O valor do vértice de destino da aresta.
- * @param peso O peso da aresta a ser inserida.
- * @param inf Apontador para uma variável booleana que será definida como true se a inserção for bem-sucedida, e false caso contrário.
- * @return Apontador para o grafo com a nova aresta inserida.
- */
-Grafo *InserirAdjGrafo(Grafo *g, int origem, int destino, int peso, bool *inf);
-
-/**
- * @brief Elimina um vértice do grafo.
- *
- * Esta função elimina um vértice do grafo. Ela verifica se o vértice a 
- * ser eliminado existe e, em seguida, remove-o do grafo.
- * 
- * @param g Apontador para o grafo do qual o vértice será eliminado.
- * @param id O valor do vértice a ser eliminado.
- * @param inf Apontador para uma variável booleana que será definida como true se a eliminação for bem-sucedida, e false caso contrário.
- * @return Apontador para o grafo com o vértice eliminado.
- */
-Grafo *EliminaVerticeGrafo(Grafo *g, int id, bool *inf);
-
-/**
- * @brief Elimina uma aresta do grafo.
- *
- * Esta função elimina uma aresta do grafo. Ela verifica se a aresta a ser eliminada
- * existe e, em seguida, remove-a do grafo.
- * 
- * @param g Apontador para o grafo do qual a aresta será eliminada.
- * @param origem O valor do vértice de origem da aresta.
- * @param destino O valor do vértice de destino da aresta.
- * @param inf Apontador para uma variável booleana que será definida como true se a eliminação for bem-sucedida, e false caso contrário.
- * @return Apontador para o grafo com a aresta eliminada.
- */
-Grafo *EliminaAdjGrafo(Grafo *g, int origem, int destino, bool *inf);
-
-/**
- * @brief Verifica se existe uma aresta entre dois vértices.
- *
- *  Esta função verifica se existe uma aresta entre dois vértices. Ela percorre todos os vértices e
- *  adjacências do grafo, procurando uma aresta entre os vértices de origem e destino.
- * 
- * @param inicio Apontador para o primeiro vértice do grafo.
- * @param origem O valor do vértice de origem da aresta.
- * @param destino O valor do vértice de destino da aresta.
- * @return bool  Retorna true se existe uma aresta entre os vértices origem e destino, e false caso contrário.
- */
-bool ExisteAdjDoisVertices(Vertice *inicio, int origem, int destino);
-
-#endif
+/**
+ * @file grafo.h
+ * @author Hugo Cruz (a23010)
+ * @brief Ficheiro de cabeçalho para a estrutura de dados Grafo e funcionalidades.
+ * @version 88.1
+ * @date 2024-05-24
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef GRAFO_H
+#define GRAFO_H
+
+/**
+ * @def MAX
+ * @brief Define um valor.
+ *
+ *  Esta macro define um valor maximo de 10.
+ */
+#define MAX 10
+
+#include "vertices.h"
+#include "cache.h"
+#include "matriz.h"
+
+/**
+ * @brief Estrutura com a memória ocupada por um grafo, em bytes, por categoria.
+ *
+ * Os valores são os tamanhos das estruturas alocadas, sem o custo interno do malloc. O grafo
+ * mantém estes contadores em cada alteração, pelo que o pico é a maior memória ocupada em
+ * qualquer momento e não só nos momentos em que a memória foi contabilizada.
+ *
+ */
+typedef struct MemoriaGrafo
+{
+	size_t vertices;	///< Estrutura do grafo e vértices.
+	size_t adjacencias;	///< Listas de adjacências e matriz densa.
+	size_t indices;		///< Array de vértices por id e listas de entradas do índice.
+	size_t caches;		///< Árvores guardadas na cache de caminhos e imagem das pesquisas de alcance.
+	size_t total;		///< Soma de todas as categorias.
+	size_t pico;		///< Maior total observado desde a criação do grafo.
+
+} MemoriaGrafo;
+
+/**
+ * @brief Estrutura de dados para um Grafo.
+ *
+ * A estrutura Grafo é uma representação de um grafo em memória, onde
+ * inicioGrafo é um apontador para o primeiro vértice do grafo. A versão é incrementada
+ * sempre que o grafo é alterado, o que permite reconhecer resultados guardados na cache
+ * de caminhos que já não correspondem ao grafo. Os grafos densos carregados de um ficheiro CSV
+ * podem ter as adjacências numa matriz em vez das listas; nesse caso as listas de adjacências
+ * estão vazias até à primeira alteração das adjacências (ver ExpandirMatrizGrafo).
+ *
+ */
+typedef struct Grafo
+{
+	Vertice *inicioGrafo;		///< Apontador para o primeiro vértice do grafo.
+	unsigned long versao;		///< Contador de alterações ao grafo.
+	CacheCaminhos *cache;		///< Cache de árvores de caminhos mais curtos (NULL até à primeira pesquisa).
+	size_t orcamentoCache;		///< Memória máxima, em bytes, da cache de caminhos (0 desativa a cache).
+	Vertice **indice;			///< Apontador para o vértice com cada id, mantido com o índice de entradas (NULL se desativado).
+	int tamanhoIndice;			///< Número de posições de indice.
+	MatrizAdjacencia *matriz;	///< Adjacências numa matriz densa, em vez das listas (NULL se não for usada).
+	bool adjOrdenadas;			///< Indica se as listas de adjacências são mantidas ordenadas pelo destino e sem repetidos.
+	MemoriaGrafo memoria;		///< Memória ocupada, atualizada em cada alteração (as caches são lidas da cache de caminhos).
+	struct ImagemGrafo *imagemAlcance;		///< Imagem pesquisada por ExisteCaminhoGrafo (NULL até à primeira pesquisa).
+	struct EspacoLargura *espacoAlcance;	///< Espaço de trabalho das pesquisas em largura sobre imagemAlcance.
+	unsigned long versaoAlcance;			///< Versão do grafo a que imagemAlcance corresponde.
+	size_t memoriaAlcance;					///< Bytes ocupados por imagemAlcance e espacoAlcance.
+
+} Grafo;
+
+/**
+ * @brief Apaga um grafo e limpa a memória alocada.
+ *
+ * Esta função apaga um grafo e liberta a memória alocada. Ela percorre todos os 
+ * vértices e adjacências do grafo, apagando-os um a um
+ * 
+ * @param g Apontador para o grafo a ser apagado
+ */
+void ApagaGrafo(Grafo *g);
+
+/**
+ * @brief Cria um novo grafo.
+ *
+ * Esta função cria um novo grafo. Ela aloca memória para um novo grafo e 
+ * retorna um apontador para o grafo criado.
+ * 
+ * @param inf Apontador para uma variável booleana que será definida como true se a criação do grafo for bem-sucedida, e false caso contrário.
+ * @return Apontador para o novo grafo criado.
+ */
+Grafo *CriarGrafo(bool *inf);
+
+/**
+ * @brief Insere um novo vértice no grafo
+ *
+ * Esta função insere um novo vértice no grafo. Ela verifica se o valor do novo 
+ * vértice já existe e, em seguida, insere-o no fim da lista de vertices.
+ * 
+ * @param g Apontador para o grafo onde o vértice será inserido.
+ * @param novo O valor do novo vértice a ser inserido.
+ * @param inf Apontador para uma variável booleana que será definida como true se a inserção for bem-sucedida, e false caso contrário.
+ * @return Apontador para o grafo com o novo vértice inserido.
+ */
+Grafo *InserirVerticeGrafo(Grafo *g, int novo, bool *inf);
+
+/**
+ * @brief Insere uma nova aresta no grafo.
+ *
+ * Esta função insere uma nova aresta no grafo. Ela verifica se os vértices de 
+ * origem e destino são válidos e, em seguida, insere a aresta entre eles.
+ * 
+ * @param g Apontador para o grafo onde a aresta será inserida.
+ * @param origem O valor do vértice de origem da aresta.
+ * @param destino O valor do vértice de destino da aresta.
+ * @param peso O peso da aresta a ser inserida (tem de caber em PesoAresta, ver tipos.h).
+ * @param inf Apontador para uma variável booleana que será definida como true se a inserção for bem-sucedida, e false caso contrário.
+ * @return Apontador para o grafo com a nova aresta inserida.
+ */
+Grafo *InserirAdjGrafo(Grafo *g, int origem, int destino, int peso, bool *inf);
+
+/**
+ * @brief Elimina um vértice do grafo.
+ *
+ * Esta função elimina um vértice do grafo. Ela verifica se o vértice a 
+ * ser eliminado existe e, em seguida, remove-o do grafo. Com o índice de entradas
+ * ativo só são visitados os vizinhos do vértice.
+ * 
+ * @param g Apontador para o grafo do qual o vértice será eliminado.
+ * @param id O valor do vértice a ser eliminado.
+ * @param inf Apontador para uma variável booleana que será definida como true se a eliminação for bem-sucedida, e false caso contrário.
+ * @return Apontador para o grafo com o vértice eliminado.
+ */
+Grafo *EliminaVerticeGrafo(Grafo *g, int id, bool *inf);
+
+/**
+ * @brief Elimina uma aresta do grafo.
+ *
+ * Esta função elimina uma aresta do grafo. Ela verifica se a aresta a ser eliminada
+ * existe e, em seguida, remove-a do grafo.
+ * 
+ * @param g Apontador para o grafo do qual a aresta será eliminada.
+ * @param origem O valor do vértice de origem da aresta.
+ * @param destino O valor do vértice de destino da aresta.
+ * @param inf Apontador para uma variável booleana que será definida como true se a eliminação for bem-sucedida, e false caso contrário.
+ * @return Apontador para o grafo com a aresta eliminada.
+ */
+Grafo *EliminaAdjGrafo(Grafo *g, int origem, int destino, bool *inf);
+
+/**
+ * @brief Verifica se existe uma aresta entre dois vértices.
+ *
+ *  Esta função verifica se existe uma aresta entre dois vértices. Ela percorre todos os vértices e
+ *  adjacências do grafo, procurando uma aresta entre os vértices de origem e destino.
+ * 
+ * @param inicio Apontador para o primeiro vértice do grafo.
+ * @param origem O valor do vértice de origem da aresta.
+ * @param destino O valor do vértice de destino da aresta.
+ * @return bool  Retorna true se existe uma aresta entre os vértices origem e destino, e false caso contrário.
+ */
+bool ExisteAdjDoisVertices(Vertice *inicio, int origem, int destino);
+
+/**
+ * @brief Configura a cache de caminhos mais curtos de um grafo.
+ *
+ * Esta função altera a memória máxima que a cache de caminhos do grafo pode ocupar. Um orçamento
+ * de 0 desativa a cache e descarta as árvores guardadas.
+ *
+ * @param g Apontador para o grafo.
+ * @param orcamento Memória máxima, em bytes, da cache.
+ * @param inf Apontador para uma variável booleana que será definida como true se a configuração for bem-sucedida, e false caso contrário.
+ * @return Apontador para o grafo.
+ */
+Grafo *ConfigurarCacheGrafo(Grafo *g, size_t orcamento, bool *inf);
+
+/**
+ * @brief Devolve as estatísticas da cache de caminhos de um grafo.
+ *
+ * @param g Apontador para o grafo.
+ * @return EstatisticasCache Acertos, falhas e memória da cache (tudo a 0 se a cache não existir).
+ */
+EstatisticasCache ObterEstatisticasCacheGrafo(Grafo *g);
+
+/**
+ * @brief Ativa ou desativa o índice de entradas de um grafo.
+ *
+ * Com o índice ativo cada vértice guarda as adjacências que chegam a ele (entradaA) e o grafo
+ * guarda um array com o vértice de cada id. As funções InserirAdjGrafo e EliminaAdjGrafo mantêm o
+ * índice, e EliminaVerticeGrafo passa a visitar apenas os vizinhos do vértice eliminado em vez de
+ * todas as adjacências do grafo. O índice também permite pesquisas no sentido inverso.
+ * Os ids dos vértices têm de ser não negativos enquanto o índice estiver ativo.
+ *
+ * @param g Apontador para o grafo.
+ * @param ativo true para construir o índice, false para o apagar.
+ * @param inf Apontador para uma variável booleana que será definida como true se a configuração for bem-sucedida, e false caso contrário.
+ * @return Apontador para o grafo.
+ */
+Grafo *ConfigurarIndiceEntradasGrafo(Grafo *g, bool ativo, bool *inf);
+
+/**
+ * @brief Devolve as adjacências que chegam a um vértice.
+ *
+ * Cada elemento da lista tem o id do vértice de origem e o peso da adjacência.
+ *
+ * @param g Apontador para o grafo.
+ * @param id Identificador do vértice.
+ * @return Apontador para a primeira entrada, ou NULL se não existirem entradas ou o índice estiver desativado.
+ */
+Adjacente *EntradasVertice(Grafo *g, int id);
+
+/**
+ * @brief Passa as adjacências guardadas na matriz densa para as listas de adjacências.
+ *
+ * As funções que alteram as adjacências, e as que precisam das listas, chamam esta função antes
+ * de as usar. As adjacências de cada vértice ficam pela ordem das colunas e a versão do grafo
+ * não muda, porque as ligações são as mesmas.
+ *
+ * @param g Apontador para o grafo.
+ * @return true se as adjacências estão todas nas listas, e false se não houver memória (a matriz é mantida).
+ */
+bool ExpandirMatrizGrafo(Grafo *g);
+
+/**
+ * @brief Ativa ou desativa as listas de adjacências ordenadas de um grafo.
+ *
+ * Com a opção ativa cada lista de adjacências fica ordenada pelo destino e sem destinos
+ * repetidos: ao ativar, as listas são ordenadas e as adjacências repetidas são juntadas (fica o
+ * peso da última inserida), e depois InserirAdjGrafo com um destino que já existe só atualiza o
+ * peso. As imagens criadas a partir do grafo ficam também ordenadas, o que permite procurar uma
+ * adjacência por pesquisa binária e intersetar vizinhanças por junção (ver imagem.h).
+ *
+ * @param g Apontador para o grafo.
+ * @param ativo true para manter as listas ordenadas, false para voltar a inserir no fim das listas.
+ * @param inf Apontador para uma variável booleana que será definida como true se a configuração for bem-sucedida, e false caso contrário.
+ * @return Apontador para o grafo.
+ */
+Grafo *ConfigurarAdjOrdenadasGrafo(Grafo *g, bool ativo, bool *inf);
+
+/**
+ * @brief Ordena as listas de adjacências de um grafo e junta os destinos repetidos.
+ *
+ * As listas que já estão ordenadas só são percorridas. As funções que alteram várias listas de
+ * uma vez (lotes, construção concorrente, renumeração) chamam esta função quando a opção de
+ * listas ordenadas está ativa.
+ *
+ * @param g Apontador para o grafo.
+ * @param inf Apontador para uma variável booleana que será definida como true se a ordenação for bem-sucedida, e false caso contrário.
+ * @return Apontador para o grafo.
+ */
+Grafo *OrdenarAdjacenciasGrafo(Grafo *g, bool *inf);
+
+/**
+ * @brief Verifica se existe uma ligação entre dois vértices de um grafo.
+ *
+ * O vértice de origem é obtido pelo índice, se estiver ativo, e a lista de adjacências só é
+ * percorrida até ao destino, ou até ao primeiro destino maior se as listas estiverem ordenadas.
+ * Num grafo em matriz a consulta é direta.
+ *
+ * @param g Apontador para o grafo.
+ * @param origem O valor do vértice de origem.
+ * @param destino O valor do vértice de destino.
+ * @return true se existir uma adjacência com peso diferente de 0, e false caso contrário.
+ */
+bool ExisteAdjGrafo(Grafo *g, int origem, int destino);
+
+/**
+ * @brief Devolve a memória ocupada por um grafo, por categoria.
+ *
+ * Os contadores são mantidos pelas funções que alteram o grafo, pelo que o custo é constante. O
+ * pico inclui a memória ocupada entre chamadas desta função, por exemplo por inserções seguidas
+ * de eliminações.
+ *
+ * @param g Apontador para o grafo.
+ * @return MemoriaGrafo Memória ocupada (tudo a 0 se o grafo não existir).
+ */
+MemoriaGrafo ContabilizarMemoriaGrafo(Grafo *g);
+
+/**
+ * @brief Soma variações aos contadores de memória de um grafo e atualiza o pico.
+ *
+ * É usada pelos módulos que alocam ou libertam vértices e adjacências diretamente (lotes,
+ * carregamentos) e, com variações a 0, depois de a cache de caminhos ou a imagem de alcance crescerem.
+ *
+ * @param g Apontador para o grafo.
+ * @param vertices Variação, em bytes, dos vértices.
+ * @param adjacencias Variação, em bytes, das listas de adjacências e da matriz densa.
+ * @param indices Variação, em bytes, do array de vértices por id e das listas de entradas.
+ */
+void AjustarMemoriaGrafo(Grafo *g, long long vertices, long long adjacencias, long long indices);
+
+/**
+ * @brief Volta a contar a memória de um grafo percorrendo todas as listas, e atualiza o pico.
+ *
+ * O custo é linear no tamanho do grafo. É usada pelas operações que já percorrem o grafo inteiro
+ * e só acrescentam memória, como a construção concorrente e a reconstrução do índice de entradas.
+ *
+ * @param g Apontador para o grafo.
+ */
+void RecontarMemoriaGrafo(Grafo *g);
+
+/**
+ * @brief Define a memória máxima que um carregamento pode usar.
+ *
+ * As funções que carregam grafos e imagens de ficheiros estimam a memória necessária a partir
+ * do tamanho dos ficheiros, antes de alocar, e falham se a estimativa ultrapassar o orçamento.
+ * O orçamento é do processo e deve ser definido antes de começarem os carregamentos.
+ *
+ * @param bytes Memória máxima, em bytes (0 retira o limite).
+ */
+void DefinirOrcamentoMemoria(size_t bytes);
+
+/**
+ * @brief Devolve o orçamento de memória dos carregamentos.
+ *
+ * @return size_t Memória máxima, em bytes (0 se não houver limite).
+ */
+size_t ObterOrcamentoMemoria(void);
+
+/**
+ * @brief Verifica se uma quantidade de memória cabe no orçamento dos carregamentos.
+ *
+ * @param bytes Memória necessária, em bytes.
+ * @return true se não houver orçamento ou se bytes não o ultrapassar, e false caso contrário.
+ */
+bool CabeNoOrcamentoMemoria(size_t bytes);
+
+#endif
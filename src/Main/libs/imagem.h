@@ -0,0 +1,106 @@
+/**
+ * @file imagem.h
+ * @author Hugo Cruz (a23010)
+ * @brief Ficheiro de cabeçalho para as imagens imutáveis de um grafo em formato compacto (CSR).
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef IMAGEM_H
+#define IMAGEM_H
+
+#include "grafo.h"
+
+/**
+ * @brief Estrutura de uma imagem de um grafo.
+ *
+ * A imagem é uma cópia das ligações do grafo num momento, guardada em arrays contíguos: as
+ * adjacências do vértice v ocupam as posições inicio[v] até inicio[v + 1] - 1 de destinos e pesos.
+ * Só são guardadas as ligações verdadeiras (peso diferente de 0 e destino existente). Depois de
+ * criada a imagem não é alterada, pelo que pode ser lida por várias threads ao mesmo tempo.
+ * As adjacências ficam pela ordem das listas; se o grafo tiver as listas ordenadas, ou estiver
+ * numa matriz, a imagem fica ordenada e as procuras usam pesquisa binária.
+ */
+typedef struct ImagemGrafo
+{
+	unsigned long versao;	///< Versão do grafo a partir da qual a imagem foi criada.
+	int tamanho;			///< Número de posições indexadas (maior id + 1).
+	int numVertices;		///< Número de vértices do grafo.
+	int numArestas;			///< Número de adjacências guardadas.
+	bool *existe;			///< Indica os ids que correspondem a vértices do grafo.
+	int *inicio;			///< Posição da primeira adjacência de cada vértice (tamanho + 1 elementos).
+	int *destinos;			///< Destino de cada adjacência.
+	PesoAresta *pesos;		///< Peso de cada adjacência.
+	bool ordenada;			///< Indica se as adjacências de cada vértice estão ordenadas pelo destino, sem repetidos.
+
+} ImagemGrafo;
+
+/**
+ * @brief Cria uma imagem com as ligações atuais de um grafo.
+ *
+ * @param g Apontador para o grafo.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para a imagem criada.
+ */
+ImagemGrafo *CriarImagemGrafo(Grafo *g, bool *inf);
+
+/**
+ * @brief Cria a imagem inversa de outra imagem, com o sentido de todas as ligações trocado.
+ *
+ * As adjacências do vértice v na imagem inversa são as ligações que chegam a v, com o vértice de
+ * origem em destinos e o mesmo peso, por ordem crescente da origem. Serve as pesquisas que
+ * precisam de percorrer as ligações ao contrário.
+ *
+ * @param im Apontador para a imagem.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para a imagem inversa criada.
+ */
+ImagemGrafo *InverterImagemGrafo(ImagemGrafo *im, bool *inf);
+
+/**
+ * @brief Liberta a memória alocada para uma imagem.
+ *
+ * @param im Apontador para a imagem a eliminar.
+ */
+void ApagarImagemGrafo(ImagemGrafo *im);
+
+/**
+ * @brief Devolve a memória ocupada por uma imagem de um grafo.
+ *
+ * @param im Apontador para a imagem.
+ * @return size_t Número de bytes alocados.
+ */
+size_t MemoriaImagemGrafo(ImagemGrafo *im);
+
+/**
+ * @brief Procura a adjacência entre dois vértices numa imagem.
+ *
+ * Numa imagem ordenada a procura é binária, em O(log d); caso contrário as adjacências da
+ * origem são percorridas.
+ *
+ * @param im Apontador para a imagem.
+ * @param origem Vértice de origem.
+ * @param destino Vértice de destino.
+ * @return int Posição da adjacência em destinos e pesos, ou -1 se não existir.
+ */
+int ProcurarAdjImagem(ImagemGrafo *im, int origem, int destino);
+
+/**
+ * @brief Calcula os vizinhos comuns de dois vértices de uma imagem ordenada.
+ *
+ * As duas listas de destinos são percorridas em simultâneo. Se uma for muito maior do que a
+ * outra, cada destino da lista menor é procurado na maior por pesquisa exponencial (galloping),
+ * a partir da posição do anterior, em vez de percorrer a lista maior toda.
+ *
+ * @param im Apontador para a imagem (tem de estar ordenada).
+ * @param u Primeiro vértice.
+ * @param v Segundo vértice.
+ * @param comuns Array onde ficam os vizinhos comuns, por ordem crescente (pode ser NULL para apenas contar); tem de ter espaço para o menor dos dois graus.
+ * @return int Número de vizinhos comuns, ou -1 se a imagem não estiver ordenada ou os vértices não existirem.
+ */
+int IntersetarVizinhosImagem(ImagemGrafo *im, int u, int v, int comuns[]);
+
+#endif
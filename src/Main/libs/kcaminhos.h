@@ -0,0 +1,59 @@
+/**
+ * @file kcaminhos.h
+ * @author Hugo Cruz (a23010)
+ * @brief Ficheiro de cabeçalho para o cálculo dos k caminhos mais curtos sem ciclos (algoritmo de Yen).
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef KCAMINHOS_H
+#define KCAMINHOS_H
+
+#include "caminhos.h"
+
+/**
+ * @brief Estrutura com um conjunto de caminhos guardados de forma compacta.
+ *
+ * Os vértices de todos os caminhos ficam seguidos no array vertices. O caminho i ocupa as
+ * posições inicio[i] até inicio[i + 1] - 1, pelo que o array inicio tem total + 1 elementos.
+ * Os caminhos estão ordenados por custo crescente.
+ */
+typedef struct ConjuntoCaminhos
+{
+	int total;			///< Número de caminhos.
+	Distancia *custos;	///< Custo de cada caminho.
+	int *inicio;		///< Posição do primeiro vértice de cada caminho em vertices.
+	int *vertices;		///< Vértices de todos os caminhos, da origem ao destino.
+
+} ConjuntoCaminhos;
+
+/**
+ * @brief Calcula os k caminhos mais curtos sem ciclos entre dois vértices.
+ *
+ * Esta função implementa o algoritmo de Yen. O primeiro caminho é o caminho mais curto; cada
+ * caminho seguinte é obtido desviando o anterior a partir de cada um dos seus vértices. Os
+ * desvios são calculados com DijkstraRestrito sobre um único espaço de trabalho, excluindo os
+ * vértices e as adjacências já usados em vez de copiar o grafo. Se o grafo tiver pesos negativos,
+ * o espaço de trabalho recebe primeiro os potenciais de Johnson; com um ciclo negativo não há
+ * caminhos mais curtos e a função falha.
+ *
+ * @param g Apontador para o grafo
+ * @param origem Vértice de origem
+ * @param destino Vértice de destino
+ * @param k Número máximo de caminhos a calcular
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida
+ * @return ConjuntoCaminhos* Conjunto com até k caminhos (total 0 se não existir caminho) ou NULL em caso de erro ou de ciclo negativo
+ */
+ConjuntoCaminhos *KCaminhosMaisCurtos(Grafo *g, int origem, int destino, int k, bool *inf);
+
+/**
+ * @brief Liberta a memória alocada para um conjunto de caminhos.
+ *
+ * @param c Apontador para o conjunto a eliminar
+ */
+void ApagarConjuntoCaminhos(ConjuntoCaminhos *c);
+
+#endif
@@ -0,0 +1,126 @@
+/**
+ * @file mapa.h
+ * @author Hugo Cruz (a23010)
+ * @brief Ficheiro de cabeçalho para a conversão entre ids externos de 64 bits e ids internos densos.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef MAPA_H
+#define MAPA_H
+
+#include "grafo.h"
+
+/**
+ * @brief Estrutura de um mapa de ids externos.
+ *
+ * Os algoritmos usam o id de cada vértice como índice dos seus arrays, pelo que os ids têm de
+ * ser pequenos e seguidos. O mapa atribui a cada id externo (por exemplo uma chave de uma base
+ * de dados) o id interno seguinte, a partir de 0. A conversão de interno para externo é uma
+ * posição do array externos; a de externo para interno usa uma tabela de dispersão com
+ * endereçamento aberto, que guarda os ids internos e nunca fica mais de metade cheia.
+ */
+typedef struct MapaIds
+{
+	long long *externos; ///< Id externo de cada id interno.
+	int numIds;			 ///< Número de ids registados (os ids internos vão de 0 a numIds - 1).
+	int capacidade;		 ///< Número de posições de externos.
+	int *tabela;		 ///< Tabela de dispersão com o id interno de cada posição (-1 se vazia).
+	int tamanhoTabela;	 ///< Número de posições da tabela (potência de 2).
+
+} MapaIds;
+
+/**
+ * @brief Cria um mapa de ids vazio.
+ *
+ * @param capacidade Número de ids previsto (o mapa cresce se for ultrapassado).
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para o mapa criado.
+ */
+MapaIds *CriarMapaIds(int capacidade, bool *inf);
+
+/**
+ * @brief Liberta a memória alocada para um mapa de ids.
+ *
+ * @param m Apontador para o mapa a eliminar.
+ */
+void ApagarMapaIds(MapaIds *m);
+
+/**
+ * @brief Devolve o id interno de um id externo.
+ *
+ * @param m Apontador para o mapa.
+ * @param externo Id externo.
+ * @return int Id interno, ou -1 se o id externo não estiver registado.
+ */
+int ObterIdInterno(MapaIds *m, long long externo);
+
+/**
+ * @brief Devolve o id externo de um id interno.
+ *
+ * @param m Apontador para o mapa.
+ * @param interno Id interno.
+ * @param inf Apontador para um bool que fica false se o id interno não existir.
+ * @return long long Id externo.
+ */
+long long ObterIdExterno(MapaIds *m, int interno, bool *inf);
+
+/**
+ * @brief Regista um id externo e devolve o seu id interno.
+ *
+ * Se o id externo já estiver registado devolve o id interno que já tem.
+ *
+ * @param m Apontador para o mapa.
+ * @param externo Id externo.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return int Id interno, ou -1 em caso de erro.
+ */
+int RegistarIdExterno(MapaIds *m, long long externo, bool *inf);
+
+/**
+ * @brief Insere no grafo um vértice identificado pelo id externo.
+ *
+ * @param g Apontador para o grafo.
+ * @param m Apontador para o mapa.
+ * @param externo Id externo do vértice.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para o grafo.
+ */
+Grafo *InserirVerticeExterno(Grafo *g, MapaIds *m, long long externo, bool *inf);
+
+/**
+ * @brief Insere uma adjacência entre dois vértices identificados pelos ids externos.
+ *
+ * @param g Apontador para o grafo.
+ * @param m Apontador para o mapa.
+ * @param origem Id externo do vértice de origem.
+ * @param destino Id externo do vértice de destino.
+ * @param peso Peso da adjacência.
+ * @param inf Apontador para um bool que fica false se algum dos ids não estiver registado.
+ * @return Apontador para o grafo.
+ */
+Grafo *InserirAdjExterno(Grafo *g, MapaIds *m, long long origem, long long destino, int peso, bool *inf);
+
+/**
+ * @brief Guarda um mapa de ids num ficheiro binário.
+ *
+ * O ficheiro tem um cabeçalho com o valor -9 seguido dos ids externos por ordem do id interno.
+ *
+ * @param m Apontador para o mapa.
+ * @param file Nome do ficheiro.
+ * @return true se o mapa foi guardado.
+ */
+bool GuardaMapaIds(MapaIds *m, char *file);
+
+/**
+ * @brief Carrega um mapa de ids de um ficheiro binário criado com GuardaMapaIds.
+ *
+ * @param file Nome do ficheiro.
+ * @return MapaIds* Apontador para o mapa carregado, ou NULL em caso de erro.
+ */
+MapaIds *CarregaMapaIds(char *file);
+
+#endif
@@ -0,0 +1,168 @@
+/**
+ * @file paralelo.h
+ * @author Hugo Cruz (a23010)
+ * @brief Ficheiro de cabeçalho do executor paralelo partilhado pelos algoritmos da biblioteca.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef PARALELO_H
+#define PARALELO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include <threads.h>
+#include "estatisticas.h"
+
+/**
+ * @def MAX_INTERVALOS_FILA
+ * @brief Número máximo de intervalos pendentes na fila de cada trabalhador.
+ *
+ * Cada divisão corta um intervalo ao meio, pelo que nunca há mais de 32 divisões pendentes por
+ * trabalhador; com a fila cheia o trabalhador deixa de dividir e executa o intervalo inteiro.
+ */
+#define MAX_INTERVALOS_FILA 64
+
+/**
+ * @brief Função executada sobre um intervalo de índices.
+ *
+ * @param contexto Dados passados a ParaleloPara.
+ * @param inicio Primeiro índice do intervalo.
+ * @param fim Índice a seguir ao último.
+ * @param trabalhador Número do trabalhador que executa o intervalo (entre 0 e numTrabalhadores - 1).
+ */
+typedef void (*FuncaoIntervalo)(void* contexto, int inicio, int fim, int trabalhador);
+
+/**
+ * @brief Intervalo de índices [inicio, fim).
+ *
+ */
+typedef struct Intervalo
+{
+	int inicio; ///< Primeiro índice.
+	int fim;	///< Índice a seguir ao último.
+
+} Intervalo;
+
+/**
+ * @brief Estado de um trabalhador do executor.
+ *
+ * O dono tira intervalos do fim da fila (os mais pequenos, divididos há menos tempo) e os outros
+ * trabalhadores roubam do início (os maiores). A fila é protegida por um bloqueio de espera
+ * ativa, já que cada operação só copia um intervalo. O preenchimento final afasta o bloqueio de
+ * um trabalhador dos campos do trabalhador seguinte no array.
+ */
+typedef struct TrabalhadorParalelo
+{
+	atomic_flag ocupada;						  ///< Bloqueio da fila.
+	atomic_int topo;							  ///< Posição do próximo intervalo a roubar.
+	atomic_int base;							  ///< Posição a seguir ao último intervalo da fila.
+	Intervalo intervalos[MAX_INTERVALOS_FILA];	  ///< Intervalos pendentes.
+	void* rascunho;								  ///< Memória de trabalho própria do trabalhador.
+	size_t tamanhoRascunho;						  ///< Número de bytes de rascunho.
+	unsigned int semente;						  ///< Estado do gerador usado para escolher a quem roubar.
+	thrd_t thread;								  ///< Thread do trabalhador (não usada no trabalhador 0).
+	EstatisticasGrafos estatisticas;			  ///< Contadores do trabalho atual ainda não passados à thread que chamou.
+	char preenchimento[64];						  ///< Separa este trabalhador do seguinte.
+
+} TrabalhadorParalelo;
+
+/**
+ * @brief Estrutura de um executor paralelo com roubo de trabalho.
+ *
+ * O executor tem numTrabalhadores trabalhadores: o trabalhador 0 é a thread que chama
+ * ParaleloPara e os restantes são threads criadas com o executor, que dormem entre trabalhos.
+ * Um trabalho começa como um único intervalo na fila do trabalhador 0; cada trabalhador executa
+ * o seu intervalo aos poucos e, sempre que a sua fila fica vazia, põe lá metade do que lhe falta,
+ * que fica disponível para ser roubado. Assim os intervalos só são divididos quando há
+ * trabalhadores sem trabalho, e o tamanho das partes adapta-se ao equilíbrio da carga.
+ */
+typedef struct ExecutorParalelo
+{
+	int numTrabalhadores;				 ///< Número de trabalhadores, incluindo a thread que chama.
+	TrabalhadorParalelo* trabalhadores;	 ///< Trabalhadores.
+
+	FuncaoIntervalo funcao;				 ///< Função do trabalho atual.
+	void* contexto;						 ///< Contexto do trabalho atual.
+	int grao;							 ///< Número de índices executados de cada vez no trabalho atual.
+	atomic_llong restantes;				 ///< Número de índices do trabalho atual ainda por executar.
+
+	mtx_t exclusivo;					 ///< Garante que só uma thread de fora usa o executor de cada vez.
+	mtx_t trinco;						 ///< Protege geracao e terminar.
+	cnd_t novoTrabalho;					 ///< Sinalizada quando há um trabalho novo ou o executor é apagado.
+	unsigned long geracao;				 ///< Número do trabalho atual.
+	bool terminar;						 ///< Indica às threads que devem terminar.
+
+} ExecutorParalelo;
+
+/**
+ * @brief Devolve o número de processadores disponíveis.
+ *
+ * @return int Número de processadores (1 se não for possível saber).
+ */
+int NumeroProcessadores(void);
+
+/**
+ * @brief Cria um executor paralelo.
+ *
+ * @param numTrabalhadores Número de trabalhadores, incluindo a thread que chama (0 para um por processador).
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return ExecutorParalelo* Apontador para o executor criado.
+ */
+ExecutorParalelo* CriarExecutorParalelo(int numTrabalhadores, bool* inf);
+
+/**
+ * @brief Termina as threads de um executor e liberta a sua memória.
+ *
+ * @param ex Apontador para o executor (pode ser NULL).
+ */
+void ApagarExecutorParalelo(ExecutorParalelo* ex);
+
+/**
+ * @brief Devolve o número de trabalhadores de um executor.
+ *
+ * Os algoritmos que guardam estado por trabalhador usam este número para dimensionar os arrays.
+ *
+ * @param ex Apontador para o executor (NULL equivale a um executor com um só trabalhador).
+ * @return int Número de trabalhadores.
+ */
+int NumeroTrabalhadores(ExecutorParalelo* ex);
+
+/**
+ * @brief Executa uma função sobre todos os índices de [inicio, fim), repartidos pelos trabalhadores.
+ *
+ * A função é chamada com intervalos disjuntos que cobrem [inicio, fim) e a chamada só termina
+ * quando todos os índices foram executados. Chamadas de várias threads de fora ao mesmo executor
+ * são feitas uma de cada vez; uma chamada feita dentro de uma função em execução no mesmo
+ * executor executa o intervalo inteiro no próprio trabalhador.
+ * Com GRAFOS_ESTATISTICAS, os contadores do trabalho feito pelas threads do executor são somados
+ * aos da thread que chama, como se fosse ela a fazer todo o trabalho.
+ *
+ * @param ex Apontador para o executor (NULL executa tudo na thread que chama, como trabalhador 0).
+ * @param inicio Primeiro índice.
+ * @param fim Índice a seguir ao último.
+ * @param grao Número de índices por chamada da função (0 para ser o executor a escolher).
+ * @param funcao Função a executar.
+ * @param contexto Dados passados à função.
+ */
+void ParaleloPara(ExecutorParalelo* ex, int inicio, int fim, int grao, FuncaoIntervalo funcao, void* contexto);
+
+/**
+ * @brief Devolve a memória de rascunho de um trabalhador, com pelo menos o tamanho pedido.
+ *
+ * A memória é reutilizada de um trabalho para o outro e só é realocada quando é pedido mais do
+ * que o tamanho atual, caso em que o conteúdo anterior se perde. Só deve ser chamada pelo próprio
+ * trabalhador, dentro da função executada por ParaleloPara.
+ *
+ * @param ex Apontador para o executor.
+ * @param trabalhador Número do trabalhador.
+ * @param tamanho Número de bytes pretendido.
+ * @return void* Apontador para o rascunho (NULL se não houver memória).
+ */
+void* RascunhoTrabalhador(ExecutorParalelo* ex, int trabalhador, size_t tamanho);
+
+#endif
@@ -0,0 +1,99 @@
+/**
+ * @file tipos.h
+ * @author Hugo Cruz (a23010)
+ * @brief Ficheiro de cabeçalho com os tipos dos pesos e das distâncias usados em toda a biblioteca.
+ *
+ * Os tipos são escolhidos na compilação. Por omissão os pesos e as distâncias são int. Com
+ * GRAFOS_PESO_16 os pesos passam a ocupar 2 bytes, o que reduz as imagens e os espaços de
+ * trabalho dos algoritmos. Com GRAFOS_DISTANCIA_64 as distâncias passam a long long, para que
+ * caminhos longos não ultrapassem INT_MAX. Os ficheiros binários guardam sempre os pesos em
+ * int, pelo que o mesmo ficheiro pode ser carregado com qualquer combinação; as inserções com
+ * um peso que não cabe no tipo escolhido falham.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef TIPOS_H
+#define TIPOS_H
+
+#include <limits.h>
+
+#ifdef GRAFOS_PESO_16
+
+/**
+ * @brief Tipo do peso de uma adjacência.
+ */
+typedef short PesoAresta;
+
+/**
+ * @def PESO_MINIMO
+ * @brief Menor peso que pode ser guardado.
+ */
+#define PESO_MINIMO SHRT_MIN
+
+/**
+ * @def PESO_MAXIMO
+ * @brief Maior peso que pode ser guardado.
+ */
+#define PESO_MAXIMO SHRT_MAX
+
+#else
+
+/**
+ * @brief Tipo do peso de uma adjacência.
+ */
+typedef int PesoAresta;
+
+/**
+ * @def PESO_MINIMO
+ * @brief Menor peso que pode ser guardado.
+ */
+#define PESO_MINIMO INT_MIN
+
+/**
+ * @def PESO_MAXIMO
+ * @brief Maior peso que pode ser guardado.
+ */
+#define PESO_MAXIMO INT_MAX
+
+#endif
+
+#ifdef GRAFOS_DISTANCIA_64
+
+/**
+ * @brief Tipo das distâncias acumuladas e dos custos dos caminhos.
+ */
+typedef long long Distancia;
+
+/**
+ * @def DISTANCIA_INFINITA
+ * @brief Distância de um vértice não alcançado.
+ */
+#define DISTANCIA_INFINITA LLONG_MAX
+
+#else
+
+/**
+ * @brief Tipo das distâncias acumuladas e dos custos dos caminhos.
+ */
+typedef int Distancia;
+
+/**
+ * @def DISTANCIA_INFINITA
+ * @brief Distância de um vértice não alcançado.
+ */
+#define DISTANCIA_INFINITA INT_MAX
+
+#endif
+
+/**
+ * @def PESO_VALIDO
+ * @brief Indica se um peso cabe no tipo PesoAresta.
+ */
+#define PESO_VALIDO(p) ((p) >= PESO_MINIMO && (p) <= PESO_MAXIMO)
+
+#endif
@@ -0,0 +1,145 @@
+/**
+ * @file versoes.h
+ * @author Hugo Cruz (a23010)
+ * @brief Ficheiro de cabeçalho para a publicação de versões de um grafo lidas sem bloqueios por várias threads.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef VERSOES_H
+#define VERSOES_H
+
+#include <stdatomic.h>
+#include "imagem.h"
+
+/**
+ * @def MAX_LEITORES_VERSOES
+ * @brief Número máximo de threads leitoras registadas ao mesmo tempo num gestor de versões.
+ */
+#define MAX_LEITORES_VERSOES 64
+
+/**
+ * @brief Estado de uma thread leitora.
+ *
+ * Cada leitor ocupa uma linha de cache para que as threads não escrevam na mesma linha.
+ */
+typedef struct LeitorVersoes
+{
+	atomic_ulong epoca;	 ///< Época anunciada enquanto o leitor tem uma versão fixada (0 se não tiver).
+	atomic_bool ocupado; ///< Indica se a posição está atribuída a uma thread.
+	char preenchimento[64 - sizeof(atomic_ulong) - sizeof(atomic_bool)]; ///< Completa a linha de cache.
+
+} LeitorVersoes;
+
+/**
+ * @brief Versão substituída que ainda pode estar a ser lida.
+ *
+ */
+typedef struct VersaoRetirada
+{
+	ImagemGrafo *imagem; ///< Imagem substituída.
+	unsigned long epoca; ///< Época a partir da qual nenhum leitor novo a pode obter.
+
+} VersaoRetirada;
+
+/**
+ * @brief Estrutura do gestor de versões de um grafo.
+ *
+ * Uma única thread escritora altera o grafo e publica imagens imutáveis dele; as threads leitoras
+ * fixam a imagem atual e pesquisam-na sem bloqueios. A escritora troca a imagem atual de forma
+ * atómica e avança a época; uma imagem substituída só é apagada quando todos os leitores ativos
+ * tiverem anunciado uma época posterior à troca, isto é, depois de um período de graça.
+ */
+typedef struct GestorVersoes
+{
+	_Atomic(ImagemGrafo *) atual;				  ///< Imagem publicada mais recente.
+	atomic_ulong epoca;							  ///< Época global, avançada em cada publicação.
+	LeitorVersoes leitores[MAX_LEITORES_VERSOES]; ///< Estado de cada thread leitora.
+	VersaoRetirada *retiradas;					  ///< Imagens substituídas à espera do período de graça (só a escritora usa).
+	int numRetiradas;							  ///< Número de imagens substituídas.
+	int capacidadeRetiradas;					  ///< Número de elementos que cabem em retiradas.
+
+} GestorVersoes;
+
+/**
+ * @brief Cria um gestor de versões e publica a primeira imagem do grafo.
+ *
+ * @param g Apontador para o grafo.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para o gestor criado.
+ */
+GestorVersoes *CriarGestorVersoes(Grafo *g, bool *inf);
+
+/**
+ * @brief Liberta o gestor e todas as imagens.
+ *
+ * Só pode ser chamada quando nenhuma thread leitora tiver uma versão fixada.
+ *
+ * @param gv Apontador para o gestor a eliminar.
+ */
+void ApagarGestorVersoes(GestorVersoes *gv);
+
+/**
+ * @brief Atribui uma posição de leitor à thread que chama a função.
+ *
+ * @param gv Apontador para o gestor.
+ * @return int Identificador do leitor, ou -1 se já existirem MAX_LEITORES_VERSOES leitores.
+ */
+int RegistarLeitor(GestorVersoes *gv);
+
+/**
+ * @brief Liberta a posição de um leitor.
+ *
+ * @param gv Apontador para o gestor.
+ * @param leitor Identificador devolvido por RegistarLeitor.
+ */
+void RemoverLeitor(GestorVersoes *gv, int leitor);
+
+/**
+ * @brief Fixa a imagem atual para leitura.
+ *
+ * A imagem devolvida não é apagada enquanto o leitor não chamar SoltarVersao. A função não usa
+ * bloqueios: apenas anuncia a época do leitor e lê a imagem atual.
+ *
+ * @param gv Apontador para o gestor.
+ * @param leitor Identificador do leitor.
+ * @return ImagemGrafo* Imagem fixada.
+ */
+ImagemGrafo *FixarVersao(GestorVersoes *gv, int leitor);
+
+/**
+ * @brief Indica que o leitor deixou de usar a imagem fixada.
+ *
+ * @param gv Apontador para o gestor.
+ * @param leitor Identificador do leitor.
+ */
+void SoltarVersao(GestorVersoes *gv, int leitor);
+
+/**
+ * @brief Publica uma nova imagem do grafo.
+ *
+ * Só a thread escritora pode chamar esta função. A imagem é criada antes da troca, pelo que os
+ * leitores nunca esperam pela escritora. As imagens substituídas cujo período de graça já
+ * terminou são apagadas.
+ *
+ * @param gv Apontador para o gestor.
+ * @param g Apontador para o grafo, alterado apenas pela thread escritora.
+ * @param inf Apontador para um bool que indica se a execução foi bem sucedida.
+ * @return Apontador para o gestor.
+ */
+GestorVersoes *PublicarVersao(GestorVersoes *gv, Grafo *g, bool *inf);
+
+/**
+ * @brief Apaga as imagens substituídas que já nenhum leitor pode estar a usar.
+ *
+ * Só a thread escritora pode chamar esta função.
+ *
+ * @param gv Apontador para o gestor.
+ * @return int Número de imagens apagadas.
+ */
+int RecolherVersoes(GestorVersoes *gv);
+
+#endif
@@ -16,7 +16,9 @@
 #include "libs/caminhos.h"
 #include <locale.h>
 
+#ifdef _MSC_VER
 #pragma comment (lib,"libs\\Grafos.lib")
+#endif
 
  /**
   * @brief Função princial do programa
@@ -53,8 +55,12 @@ int main(int argc, char* argv[])
 	recebe = ExisteCaminhoGrafo(g2, 1, 3);
 
 	MostrarCaminho(g, 1, 4);
+	MostrarCaminhoLigacoes(g, 1, 4);
+	MostrarComponentes(g);
+	MostrarCentralidade(g);
 
-	int total = DistanciaMinimaEntreVertices(g2, 1, 4);
+	bool cicloNegativo;
+	Distancia total = DistanciaMinimaEntreVertices(g2, 1, 4, &cicloNegativo);
 
 	Grafo *g3 = CriarGrafoCaminhoMaisCurto(g);
 
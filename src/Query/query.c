@@ -0,0 +1,855 @@
+/**
+ * @file query.c
+ * @author Hugo Cruz (a23010)
+ * @brief Programa grafos-query: responde a consultas sobre um grafo lidas de um ficheiro ou da entrada padrão.
+ *
+ * O grafo é carregado uma única vez (CSV, binário ou imagem comprimida) e passado para uma imagem
+ * imutável. As consultas são lidas em lotes e cada lote é dividido em blocos, repartidos pelos
+ * trabalhadores do executor paralelo da biblioteca; cada trabalhador tem o seu espaço de trabalho
+ * e escreve as respostas num buffer do bloco, que depois é escrito pela ordem das consultas. No fim são indicados na saída
+ * de erro o débito e os percentis da latência.
+ *
+ * Com o grafo numa imagem não comprimida são calculadas à partida as componentes conexas e
+ * fortemente conexas, e as consultas dist, path e reach entre vértices que as componentes mostram
+ * não estarem ligados são respondidas sem pesquisa.
+ *
+ * Se o grafo tiver pesos negativos, os potenciais de Johnson são calculados uma vez ao carregar e
+ * dados a todos os trabalhadores, para que dist, path e reach usem as ligações negativas; um grafo
+ * com um ciclo negativo não tem caminhos mais curtos e é recusado. Nesse caso knn, que depende da
+ * ordem das distâncias reais, responde com erro.
+ *
+ * Consultas (uma por linha, as linhas vazias e começadas por # são ignoradas):
+ *  - dist origem destino   distância entre dois vértices ("inf" se não existir caminho);
+ *  - path origem destino   distância e vértices do caminho mais curto ("inf" e nenhum vértice se não existir);
+ *  - reach origem destino  1 se o destino é alcançável a partir da origem, 0 caso contrário;
+ *  - knn origem k          os k vértices mais próximos da origem, com a distância de cada um.
+ *
+ * Cada resposta é uma linha com os campos separados por ';', a começar pelo nome da consulta, por
+ * exemplo "path;0;3;12;0 2 3", "path;3;0;inf;" ou "knn;0;2;2:5 1:7". Como os pesos podem ser
+ * negativos, -1 é uma distância como as outras e a falta de caminho é indicada por "inf". Uma
+ * consulta inválida dá "erro;linha".
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include "../Grafos/InputOutput.h"
+#include "../Grafos/caminhos.h"
+#include "../Grafos/bellmanford.h"
+#include "../Grafos/compacto.h"
+#include "../Grafos/componentes.h"
+#include "../Grafos/paralelo.h"
+
+/**
+ * @def TAMANHO_BLOCO
+ * @brief Número de consultas que uma thread vai buscar de cada vez.
+ */
+#define TAMANHO_BLOCO 64
+
+/**
+ * @def TAMANHO_LINHA
+ * @brief Tamanho máximo de uma linha de consulta.
+ */
+#define TAMANHO_LINHA 256
+
+/**
+ * @brief Tipos de consulta.
+ *
+ */
+typedef enum TipoConsulta
+{
+	CONSULTA_DIST,		///< Distância entre dois vértices.
+	CONSULTA_PATH,		///< Caminho mais curto entre dois vértices.
+	CONSULTA_REACH,		///< Alcançabilidade de um vértice.
+	CONSULTA_KNN,		///< Vértices mais próximos de uma origem.
+	CONSULTA_INVALIDA	///< Linha que não é uma consulta válida.
+
+} TipoConsulta;
+
+/**
+ * @brief Estrutura de uma consulta lida.
+ *
+ */
+typedef struct Consulta
+{
+	TipoConsulta tipo;	///< Tipo da consulta.
+	int origem;			///< Vértice de origem.
+	int argumento;		///< Vértice de destino, ou k em knn.
+	long linha;			///< Linha da consulta na entrada.
+
+} Consulta;
+
+/**
+ * @brief Buffer com as respostas de um bloco de consultas.
+ *
+ */
+typedef struct BlocoRespostas
+{
+	char* texto;		///< Respostas, uma por linha.
+	size_t tamanho;		///< Número de bytes escritos.
+	size_t capacidade;	///< Número de bytes alocados.
+
+} BlocoRespostas;
+
+typedef struct Servico Servico;
+
+/**
+ * @brief Estado de um trabalhador do executor que responde a consultas.
+ *
+ */
+typedef struct Trabalhador
+{
+	Servico* s;				///< Estado partilhado.
+	EspacoCaminhos* e;		///< Espaço de trabalho próprio do trabalhador.
+	int* vertices;			///< Buffer para caminhos e vizinhos.
+	int capacidade;			///< Número de elementos de vertices.
+
+} Trabalhador;
+
+/**
+ * @brief Estado partilhado pelos trabalhadores do programa.
+ *
+ * Os arrays de cada lote só são reutilizados pelo lote seguinte depois de ParaleloPara terminar,
+ * ou seja, depois de todos os blocos estarem respondidos.
+ */
+struct Servico
+{
+	ImagemGrafo* imagem;		 ///< Imagem pesquisada (NULL se for usada a imagem comprimida).
+	ImagemCompacta* compacta;	 ///< Imagem comprimida pesquisada (NULL se for usada a imagem).
+	int kMaximo;				 ///< Maior k aceite em knn.
+	bool potenciais;			 ///< Indica se as pesquisas usam potenciais de Johnson (grafo com pesos negativos).
+	Componentes* conexas;		 ///< Componentes conexas da imagem (NULL se não foram calculadas).
+	Componentes* fortes;		 ///< Componentes fortemente conexas da imagem (NULL se não foram calculadas).
+
+	Consulta* consultas;		 ///< Consultas do lote.
+	double* latencias;			 ///< Latência de cada consulta do lote, em segundos.
+	int numConsultas;			 ///< Número de consultas do lote.
+	BlocoRespostas* blocos;		 ///< Respostas de cada bloco do lote.
+	int numBlocos;				 ///< Número de blocos do lote.
+
+	ExecutorParalelo* executor;	 ///< Executor que reparte os blocos (o trabalhador 0 é a thread principal).
+	Trabalhador* trabalhadores;	 ///< Estado de cada trabalhador do executor.
+	int numTrabalhadores;		 ///< Número de trabalhadores.
+};
+
+/**
+ * @brief Devolve o instante atual em segundos.
+ *
+ * @return double Segundos desde uma origem fixa.
+ */
+static double Agora()
+{
+	struct timespec t;
+	timespec_get(&t, TIME_UTC);
+	return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Compara dois doubles para qsort.
+ *
+ * @param a Apontador para o primeiro valor.
+ * @param b Apontador para o segundo valor.
+ * @return int Negativo, zero ou positivo, como em qsort.
+ */
+static int CompararDouble(const void* a, const void* b)
+{
+	double x = *(const double*)a, y = *(const double*)b;
+	return (x > y) - (x < y);
+}
+
+/**
+ * @brief Devolve o percentil p (entre 0 e 1) de um array ordenado, pelo método do posto mais próximo.
+ *
+ * @param amostras Array ordenado.
+ * @param n Número de amostras.
+ * @param p Percentil pretendido.
+ * @return double Valor do percentil.
+ */
+static double Percentil(double amostras[], long n, double p)
+{
+	long posicao = (long)ceil(p * n) - 1;
+	return amostras[posicao < 0 ? 0 : posicao];
+}
+
+/**
+ * @brief Lê um inteiro não negativo de uma linha e avança a posição de leitura.
+ *
+ * @param p Apontador para a posição de leitura.
+ * @param valor Apontador onde fica o número lido.
+ * @return true se foi lido um número.
+ */
+static bool LerNumero(const char** p, int* valor)
+{
+	const char* q = *p;
+
+	while (*q == ' ' || *q == '\t' || *q == ';')
+	{
+		q++;
+	}
+
+	if (*q < '0' || *q > '9')
+	{
+		return false;
+	}
+
+	long long n = 0;
+
+	while (*q >= '0' && *q <= '9' && n <= INT_MAX)
+	{
+		n = n * 10 + (*q++ - '0');
+	}
+
+	if (n > INT_MAX)
+	{
+		return false;
+	}
+
+	*valor = (int)n;
+	*p = q;
+	return true;
+}
+
+/**
+ * @brief Interpreta uma linha de consulta.
+ *
+ * @param linha Texto da linha, sem a mudança de linha.
+ * @param c Apontador para a consulta a preencher.
+ * @return true se a linha tem uma consulta (válida ou não), e false se deve ser ignorada.
+ */
+static bool InterpretarConsulta(const char* linha, Consulta* c)
+{
+	static const char* nomes[] = { "dist", "path", "reach", "knn" };
+	const char* p = linha;
+
+	while (*p == ' ' || *p == '\t')
+	{
+		p++;
+	}
+
+	if (*p == '\0' || *p == '\r' || *p == '#')
+	{
+		return false;
+	}
+
+	c->tipo = CONSULTA_INVALIDA;
+
+	for (int i = 0; i < (int)(sizeof(nomes) / sizeof(nomes[0])); i++)
+	{
+		size_t n = strlen(nomes[i]);
+
+		if (strncmp(p, nomes[i], n) == 0 && (p[n] == ' ' || p[n] == '\t' || p[n] == ';'))
+		{
+			const char* q = p + n;
+
+			if (LerNumero(&q, &c->origem) && LerNumero(&q, &c->argumento))
+			{
+				while (*q == ' ' || *q == '\t' || *q == '\r')
+				{
+					q++;
+				}
+
+				if (*q == '\0')
+				{
+					c->tipo = (TipoConsulta)i;
+				}
+			}
+
+			break;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * @brief Garante que um buffer de respostas tem espaço para mais n bytes.
+ *
+ * @param b Apontador para o buffer.
+ * @param n Número de bytes a acrescentar.
+ * @return true se há espaço.
+ */
+static bool ReservarBloco(BlocoRespostas* b, size_t n)
+{
+	if (b->tamanho + n <= b->capacidade)
+	{
+		return true;
+	}
+
+	size_t capacidade = b->capacidade == 0 ? 4096 : b->capacidade;
+
+	while (capacidade < b->tamanho + n)
+	{
+		capacidade *= 2;
+	}
+
+	char* aux = (char*)realloc(b->texto, capacidade);
+
+	if (aux == NULL)
+	{
+		return false;
+	}
+
+	b->texto = aux;
+	b->capacidade = capacidade;
+	return true;
+}
+
+/**
+ * @brief Garante que o buffer de vértices de um trabalhador tem pelo menos n elementos.
+ *
+ * @param t Apontador para o trabalhador.
+ * @param n Número de elementos necessários.
+ * @return true se há espaço.
+ */
+static bool ReservarVertices(Trabalhador* t, int n)
+{
+	if (n <= t->capacidade)
+	{
+		return true;
+	}
+
+	int* aux = (int*)realloc(t->vertices, sizeof(int) * n);
+
+	if (aux == NULL)
+	{
+		return false;
+	}
+
+	t->vertices = aux;
+	t->capacidade = n;
+	return true;
+}
+
+/**
+ * @brief Pesquisa a imagem do serviço com o espaço de trabalho de uma thread.
+ *
+ * @param s Apontador para o estado partilhado.
+ * @param e Apontador para o espaço de trabalho.
+ * @param origem O vértice de origem.
+ * @param destino O vértice onde a pesquisa pode parar.
+ * @return Distancia A distância da origem ao destino (DISTANCIA_INFINITA se não existir caminho).
+ */
+static Distancia Pesquisar(Servico* s, EspacoCaminhos* e, int origem, int destino)
+{
+	if (s->compacta != NULL)
+	{
+		return DijkstraCompacta(s->compacta, e, origem, destino);
+	}
+
+	return DijkstraImagem(s->imagem, e, origem, destino);
+}
+
+/**
+ * @brief Responde a uma consulta e acrescenta a resposta ao buffer do bloco.
+ *
+ * @param t Apontador para o trabalhador.
+ * @param c Apontador para a consulta.
+ * @param b Apontador para o buffer de respostas.
+ * @return true se a resposta foi escrita.
+ */
+static bool ResponderConsulta(Trabalhador* t, Consulta* c, BlocoRespostas* b)
+{
+	static const char* nomes[] = { "dist", "path", "reach", "knn" };
+	Servico* s = t->s;
+	EspacoCaminhos* e = t->e;
+	int numVertices = 0;
+	Distancia d = DISTANCIA_INFINITA;
+
+	//Com potenciais a fila não sai pela ordem das distâncias reais
+	if (c->tipo == CONSULTA_KNN && (c->argumento > s->kMaximo || s->potenciais))
+	{
+		c->tipo = CONSULTA_INVALIDA;
+	}
+
+	if (c->tipo == CONSULTA_INVALIDA)
+	{
+		if (!ReservarBloco(b, 32))
+		{
+			return false;
+		}
+
+		b->tamanho += sprintf(b->texto + b->tamanho, "erro;%ld\n", c->linha);
+		return true;
+	}
+
+	if (c->tipo == CONSULTA_KNN)
+	{
+		//O espaço foi associado à imagem quando foi criado, pelo que pode pesquisar só os mais próximos
+		if (!ReservarVertices(t, c->argumento))
+		{
+			return false;
+		}
+
+		numVertices = VerticesMaisProximos(e, c->origem, c->argumento, t->vertices);
+		numVertices = numVertices < 0 ? 0 : numVertices;
+	}
+	else
+	{
+		d = CaminhoPossivel(s->conexas, s->fortes, c->origem, c->argumento) ? Pesquisar(s, e, c->origem, c->argumento)
+			: DISTANCIA_INFINITA;
+
+		if (c->tipo == CONSULTA_PATH && d != DISTANCIA_INFINITA)
+		{
+			numVertices = CopiarCaminho(e->verticeAnt, e->tamanho, c->argumento, t->vertices, t->capacidade);
+
+			if (numVertices > t->capacidade)
+			{
+				if (!ReservarVertices(t, numVertices))
+				{
+					return false;
+				}
+
+				CopiarCaminho(e->verticeAnt, e->tamanho, c->argumento, t->vertices, t->capacidade);
+			}
+		}
+	}
+
+	//Cabeçalho com três números e, por vértice, um id e uma distância
+	if (!ReservarBloco(b, 96 + (size_t)numVertices * 36))
+	{
+		return false;
+	}
+
+	char* p = b->texto + b->tamanho;
+	p += sprintf(p, "%s;%d;%d", nomes[c->tipo], c->origem, c->argumento);
+
+	switch (c->tipo)
+	{
+	case CONSULTA_DIST:
+		p += d == DISTANCIA_INFINITA ? sprintf(p, ";inf") : sprintf(p, ";%lld", (long long)d);
+		break;
+
+	case CONSULTA_REACH:
+		p += sprintf(p, ";%d", d != DISTANCIA_INFINITA);
+		break;
+
+	case CONSULTA_PATH:
+		p += d == DISTANCIA_INFINITA ? sprintf(p, ";inf;") : sprintf(p, ";%lld;", (long long)d);
+
+		for (int i = 0; i < numVertices; i++)
+		{
+			p += sprintf(p, i == 0 ? "%d" : " %d", t->vertices[i]);
+		}
+		break;
+
+	default:
+		*p++ = ';';
+
+		for (int i = 0; i < numVertices; i++)
+		{
+			int v = t->vertices[i];
+			p += sprintf(p, i == 0 ? "%d:%lld" : " %d:%lld", v, (long long)e->distancias[v]);
+		}
+		break;
+	}
+
+	*p++ = '\n';
+	b->tamanho = p - b->texto;
+	return true;
+}
+
+/**
+ * @brief Responde a um intervalo de blocos do lote atual.
+ *
+ * @param contexto Apontador para o estado partilhado.
+ * @param inicio Primeiro bloco.
+ * @param fim Bloco a seguir ao último.
+ * @param trabalhador Número do trabalhador do executor.
+ */
+static void ResponderBlocos(void* contexto, int inicio, int fim, int trabalhador)
+{
+	Servico* s = (Servico*)contexto;
+	Trabalhador* t = &s->trabalhadores[trabalhador];
+
+	for (int b = inicio; b < fim; b++)
+	{
+		int primeira = b * TAMANHO_BLOCO;
+		int ultima = primeira + TAMANHO_BLOCO < s->numConsultas ? primeira + TAMANHO_BLOCO : s->numConsultas;
+		BlocoRespostas* respostas = &s->blocos[b];
+
+		respostas->tamanho = 0;
+
+		for (int i = primeira; i < ultima; i++)
+		{
+			double t0 = Agora();
+
+			if (!ResponderConsulta(t, &s->consultas[i], respostas))
+			{
+				//Sem memória para a resposta: a consulta é dada como erro
+				s->consultas[i].tipo = CONSULTA_INVALIDA;
+				ResponderConsulta(t, &s->consultas[i], respostas);
+			}
+
+			s->latencias[i] = Agora() - t0;
+		}
+	}
+}
+
+/**
+ * @brief Responde a um lote de consultas com todos os trabalhadores.
+ *
+ * A thread principal também responde a blocos e só volta quando o lote está concluído.
+ *
+ * @param s Apontador para o estado partilhado, com consultas e numConsultas preenchidos.
+ */
+static void ResponderLote(Servico* s)
+{
+	s->numBlocos = (s->numConsultas + TAMANHO_BLOCO - 1) / TAMANHO_BLOCO;
+	ParaleloPara(s->executor, 0, s->numBlocos, 1, ResponderBlocos, s);
+}
+
+/**
+ * @brief Indica se o nome de um ficheiro termina numa extensão.
+ *
+ * @param nome Nome do ficheiro.
+ * @param extensao Extensão, com o ponto.
+ * @return true se o nome termina na extensão.
+ */
+static bool TemExtensao(const char* nome, const char* extensao)
+{
+	size_t n = strlen(nome), m = strlen(extensao);
+	return n >= m && strcmp(nome + n - m, extensao) == 0;
+}
+
+/**
+ * @brief Mostra a forma de usar o programa.
+ *
+ * @param programa Nome do programa.
+ */
+static void MostrarUtilizacao(const char* programa)
+{
+	fprintf(stderr,
+		"Utilizacao: %s [opcoes] grafo.csv | vertices.bin adjacencias.bin | imagem.gcp\n"
+		"  -e ficheiro  le as consultas do ficheiro (por omissao da entrada padrao)\n"
+		"  -s ficheiro  escreve as respostas no ficheiro (por omissao na saida padrao)\n"
+		"  -t threads   numero de threads (por omissao, uma por processador)\n"
+		"  -l consultas numero de consultas por lote (por omissao 4096)\n"
+		"  -k maximo    maior k aceite em knn (por omissao 1000)\n"
+		"  -g ficheiro  guarda a imagem comprimida do grafo, que carrega mais depressa\n",
+		programa);
+}
+
+/**
+ * @brief Função principal do programa grafos-query.
+ *
+ * @param argc Números de argumentos
+ * @param argv Array de strings (opções e ficheiros do grafo)
+ * @return int 0 se todas as consultas foram respondidas, 1 em caso de erro.
+ */
+int main(int argc, char* argv[])
+{
+	char* ficheiroConsultas = NULL;
+	char* ficheiroRespostas = NULL;
+	char* ficheiroImagem = NULL;
+	char* ficheiros[2] = { NULL, NULL };
+	int numFicheiros = 0;
+	int numThreads = NumeroProcessadores();
+	int tamanhoLote = 4096;
+	int kMaximo = 1000;
+	bool inf;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (argv[i][0] == '-' && argv[i][1] != '\0' && argv[i][2] == '\0' && i + 1 < argc)
+		{
+			char opcao = argv[i][1];
+			char* valor = argv[++i];
+
+			switch (opcao)
+			{
+			case 'e': ficheiroConsultas = valor; break;
+			case 's': ficheiroRespostas = valor; break;
+			case 'g': ficheiroImagem = valor; break;
+			case 't': numThreads = atoi(valor); break;
+			case 'l': tamanhoLote = atoi(valor); break;
+			case 'k': kMaximo = atoi(valor); break;
+			default:
+				MostrarUtilizacao(argv[0]);
+				return 1;
+			}
+		}
+		else if (numFicheiros < 2)
+		{
+			ficheiros[numFicheiros++] = argv[i];
+		}
+		else
+		{
+			MostrarUtilizacao(argv[0]);
+			return 1;
+		}
+	}
+
+	if (numFicheiros == 0 || numThreads < 1 || tamanhoLote < 1 || kMaximo < 1)
+	{
+		MostrarUtilizacao(argv[0]);
+		return 1;
+	}
+
+	//Carregamento do grafo
+	Servico s;
+	memset(&s, 0, sizeof(s));
+	s.kMaximo = kMaximo;
+	double t0 = Agora();
+
+	if (numFicheiros == 1 && !TemExtensao(ficheiros[0], ".csv"))
+	{
+		s.compacta = CarregaImagemCompacta(ficheiros[0]);
+	}
+	else
+	{
+		Grafo* g = numFicheiros == 2 ? CarregaGrafo(ficheiros[0], ficheiros[1]) : CarregaDadosCSV(ficheiros[0]);
+
+		//A imagem comprimida só é criada quando vai ser guardada
+		if (g != NULL && ficheiroImagem != NULL)
+		{
+			s.compacta = CriarImagemCompacta(g, &inf);
+		}
+		else if (g != NULL)
+		{
+			s.imagem = CriarImagemGrafo(g, &inf);
+		}
+
+		ApagaGrafo(g);
+	}
+
+	if (s.imagem == NULL && s.compacta == NULL)
+	{
+		fprintf(stderr, "Nao foi possivel carregar o grafo\n");
+		return 1;
+	}
+
+	if (ficheiroImagem != NULL && !GuardaImagemCompacta(s.compacta, ficheiroImagem))
+	{
+		fprintf(stderr, "Nao foi possivel guardar a imagem em %s\n", ficheiroImagem);
+	}
+
+	fprintf(stderr, "grafo: %d vertices, %lld arestas, carregado em %.3f s\n",
+		s.compacta != NULL ? s.compacta->numVertices : s.imagem->numVertices,
+		s.compacta != NULL ? s.compacta->numArestas : (long long)s.imagem->numArestas, Agora() - t0);
+
+	FILE* entrada = ficheiroConsultas != NULL ? fopen(ficheiroConsultas, "r") : stdin;
+	FILE* saida = ficheiroRespostas != NULL ? fopen(ficheiroRespostas, "w") : stdout;
+
+	if (entrada == NULL || saida == NULL)
+	{
+		fprintf(stderr, "Nao foi possivel abrir o ficheiro de consultas ou de respostas\n");
+		return 1;
+	}
+
+	setvbuf(saida, NULL, _IOFBF, 1 << 20);
+
+	//Estado partilhado e executor
+	int maxBlocos = (tamanhoLote + TAMANHO_BLOCO - 1) / TAMANHO_BLOCO;
+	s.consultas = (Consulta*)malloc(sizeof(Consulta) * tamanhoLote);
+	s.latencias = (double*)malloc(sizeof(double) * tamanhoLote);
+	s.blocos = (BlocoRespostas*)calloc(maxBlocos, sizeof(BlocoRespostas));
+	s.executor = CriarExecutorParalelo(numThreads, &inf);
+
+	if (s.executor == NULL)
+	{
+		fprintf(stderr, "Nao foi possivel criar as threads\n");
+		return 1;
+	}
+
+	s.numTrabalhadores = NumeroTrabalhadores(s.executor);
+
+	//Sem memória para as componentes as consultas são todas pesquisadas
+	if (s.imagem != NULL)
+	{
+		double t1 = Agora();
+		s.conexas = ComponentesConexas(s.imagem, NULL, s.executor, &inf);
+		s.fortes = ComponentesFortes(s.imagem, &inf);
+
+		if (s.conexas != NULL && s.fortes != NULL)
+		{
+			fprintf(stderr, "componentes: %d conexas, %d fortemente conexas, calculadas em %.3f s\n",
+				s.conexas->numComponentes, s.fortes->numComponentes, Agora() - t1);
+		}
+	}
+
+	s.trabalhadores = (Trabalhador*)calloc(s.numTrabalhadores, sizeof(Trabalhador));
+
+	if (s.consultas == NULL || s.latencias == NULL || s.blocos == NULL || s.trabalhadores == NULL)
+	{
+		fprintf(stderr, "Sem memoria\n");
+		return 1;
+	}
+
+	for (int i = 0; i < s.numTrabalhadores; i++)
+	{
+		Trabalhador* t = &s.trabalhadores[i];
+		t->s = &s;
+		t->e = s.compacta != NULL ? CriarEspacoCompacta(s.compacta, &inf) : CriarEspacoImagem(s.imagem, &inf);
+
+		if (t->e == NULL)
+		{
+			fprintf(stderr, "Sem memoria\n");
+			return 1;
+		}
+	}
+
+	//Os potenciais de Johnson são calculados uma vez e copiados para os outros trabalhadores
+	double t2 = Agora();
+	bool cicloNegativo;
+	EspacoCaminhos* e0 = s.trabalhadores[0].e;
+	bool potenciais = s.compacta != NULL ? JohnsonCompacta(s.compacta, e0, &cicloNegativo)
+		: JohnsonImagem(s.imagem, e0, &cicloNegativo);
+
+	for (int i = 1; i < s.numTrabalhadores && potenciais; i++)
+	{
+		potenciais = CopiarPotenciaisEspaco(s.trabalhadores[i].e, e0);
+	}
+
+	if (!potenciais)
+	{
+		fprintf(stderr, cicloNegativo ? "O grafo tem um ciclo negativo\n" : "Sem memoria\n");
+		return 1;
+	}
+
+	s.potenciais = e0->potencial != NULL;
+
+	if (s.potenciais)
+	{
+		fprintf(stderr, "pesos negativos: potenciais de Johnson calculados em %.3f s\n", Agora() - t2);
+	}
+
+	//Leitura e resposta das consultas, lote a lote
+	double* amostras = NULL;
+	long numAmostras = 0, capacidadeAmostras = 0, erros = 0, numLinha = 0;
+	char linha[TAMANHO_LINHA];
+	bool fimEntrada = false;
+	t0 = Agora();
+
+	while (!fimEntrada)
+	{
+		s.numConsultas = 0;
+
+		while (s.numConsultas < tamanhoLote)
+		{
+			if (fgets(linha, sizeof(linha), entrada) == NULL)
+			{
+				fimEntrada = true;
+				break;
+			}
+
+			numLinha++;
+			size_t n = strlen(linha);
+			bool completa = n > 0 && linha[n - 1] == '\n';
+
+			//Uma linha maior que o buffer é descartada até ao fim e dada como inválida
+			if (!completa && !feof(entrada))
+			{
+				int ch;
+				while ((ch = fgetc(entrada)) != EOF && ch != '\n');
+				linha[0] = '?';
+				linha[1] = '\0';
+			}
+			else if (completa)
+			{
+				linha[n - 1] = '\0';
+			}
+
+			Consulta* c = &s.consultas[s.numConsultas];
+			c->linha = numLinha;
+
+			if (InterpretarConsulta(linha, c))
+			{
+				s.numConsultas++;
+			}
+		}
+
+		if (s.numConsultas == 0)
+		{
+			continue;
+		}
+
+		ResponderLote(&s);
+
+		//As respostas são escritas pela ordem das consultas
+		for (int b = 0; b < s.numBlocos; b++)
+		{
+			fwrite(s.blocos[b].texto, 1, s.blocos[b].tamanho, saida);
+		}
+
+		if (numAmostras + s.numConsultas > capacidadeAmostras)
+		{
+			capacidadeAmostras = (numAmostras + s.numConsultas) * 2;
+			double* aux = (double*)realloc(amostras, sizeof(double) * capacidadeAmostras);
+
+			if (aux == NULL)
+			{
+				fprintf(stderr, "Sem memoria\n");
+				return 1;
+			}
+
+			amostras = aux;
+		}
+
+		for (int i = 0; i < s.numConsultas; i++)
+		{
+			amostras[numAmostras++] = s.latencias[i];
+			erros += s.consultas[i].tipo == CONSULTA_INVALIDA;
+		}
+	}
+
+	fflush(saida);
+	double tempo = Agora() - t0;
+
+	//Termina as threads
+	ApagarExecutorParalelo(s.executor);
+
+	for (int i = 0; i < s.numTrabalhadores; i++)
+	{
+		ApagarEspacoCaminhos(s.trabalhadores[i].e);
+		free(s.trabalhadores[i].vertices);
+	}
+
+	//Débito e latência
+	fprintf(stderr, "consultas: %ld (%ld invalidas), %d threads, %.3f s, %.0f consultas/s\n",
+		numAmostras, erros, numThreads, tempo, tempo > 0 ? numAmostras / tempo : 0.0);
+
+	if (numAmostras > 0)
+	{
+		qsort(amostras, numAmostras, sizeof(double), CompararDouble);
+		fprintf(stderr, "latencia (us): p50 %.1f, p90 %.1f, p99 %.1f, p99.9 %.1f, max %.1f\n",
+			Percentil(amostras, numAmostras, 0.5) * 1e6, Percentil(amostras, numAmostras, 0.9) * 1e6,
+			Percentil(amostras, numAmostras, 0.99) * 1e6, Percentil(amostras, numAmostras, 0.999) * 1e6,
+			amostras[numAmostras - 1] * 1e6);
+	}
+
+	bool correu = !ferror(saida);
+
+	if (entrada != stdin)
+	{
+		fclose(entrada);
+	}
+
+	if (saida != stdout)
+	{
+		correu = fclose(saida) == 0 && correu;
+	}
+
+	for (int b = 0; b < maxBlocos; b++)
+	{
+		free(s.blocos[b].texto);
+	}
+
+	free(s.blocos);
+	free(s.consultas);
+	free(s.latencias);
+	free(s.trabalhadores);
+	free(amostras);
+	ApagarComponentes(s.conexas);
+	ApagarComponentes(s.fortes);
+	ApagarImagemGrafo(s.imagem);
+	ApagarImagemCompacta(s.compacta);
+
+	return correu ? 0 : 1;
+}
@@ -0,0 +1,476 @@
+/**
+ * @file client.c
+ * @author Hugo Cruz (a23010)
+ * @brief Cliente do servidor de consultas: envia consultas em texto como pedidos binários (Linux).
+ *
+ * As consultas são lidas da entrada padrão ou de um ficheiro, uma por linha, com a mesma sintaxe
+ * do grafos-query ("dist origem destino", "reach origem destino", "path origem destino") e ainda
+ * "info" e "reload ficheiro [ficheiro]". O cliente envia até janela pedidos sem esperar pelas
+ * respostas e escreve as respostas pela ordem das consultas, no mesmo formato do grafos-query.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "protocolo.h"
+
+/**
+ * @def TAMANHO_LINHA
+ * @brief Tamanho máximo de uma linha de consulta.
+ */
+#define TAMANHO_LINHA 1024
+
+/**
+ * @brief Consulta enviada e ainda não escrita.
+ *
+ */
+typedef struct Espera
+{
+	Pedido pedido;	///< Pedido enviado.
+	bool invalida;	///< Indica que a linha não era uma consulta (não foi enviada).
+	long linha;		///< Linha da consulta na entrada.
+	char* texto;	///< Resposta formatada (NULL enquanto não chegar).
+
+} Espera;
+
+/**
+ * @brief Devolve o instante atual em segundos.
+ *
+ * @return double Segundos desde uma origem fixa.
+ */
+static double Agora()
+{
+	struct timespec t;
+	timespec_get(&t, TIME_UTC);
+	return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Envia todos os bytes de um buffer.
+ *
+ * @param fd Socket.
+ * @param dados Bytes a enviar.
+ * @param n Número de bytes.
+ * @return true se todos os bytes foram enviados.
+ */
+static bool EnviarTudo(int fd, const unsigned char* dados, size_t n)
+{
+	while (n > 0)
+	{
+		ssize_t k = send(fd, dados, n, MSG_NOSIGNAL);
+
+		if (k < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+
+			return false;
+		}
+
+		dados += k;
+		n -= k;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Interpreta uma linha de consulta e prepara o pedido.
+ *
+ * @param linha Texto da linha.
+ * @param p Apontador para o pedido a preencher (o id é preenchido por quem chama).
+ * @param dados Buffer com MAX_DADOS_PEDIDO bytes para os dados do pedido.
+ * @return int 1 se a linha é um pedido, 0 se deve ser ignorada, -1 se é inválida.
+ */
+static int InterpretarLinha(char* linha, Pedido* p, unsigned char* dados)
+{
+	static const char* nomes[] = { "dist", "reach", "path" };
+	static const uint8_t tipos[] = { PEDIDO_DIST, PEDIDO_REACH, PEDIDO_PATH };
+	char nome[16];
+	char ficheiros[2][TAMANHO_LINHA];
+	int origem, destino;
+
+	memset(p, 0, sizeof(*p));
+
+	if (sscanf(linha, " %15s", nome) != 1 || nome[0] == '#')
+	{
+		return 0;
+	}
+
+	for (int i = 0; i < 3; i++)
+	{
+		if (strcmp(nome, nomes[i]) == 0)
+		{
+			if (sscanf(linha, " %*s %d %d", &origem, &destino) != 2)
+			{
+				return -1;
+			}
+
+			p->tipo = tipos[i];
+			p->origem = origem;
+			p->destino = destino;
+			return 1;
+		}
+	}
+
+	if (strcmp(nome, "info") == 0)
+	{
+		p->tipo = PEDIDO_INFO;
+		return 1;
+	}
+
+	if (strcmp(nome, "reload") == 0)
+	{
+		int n = sscanf(linha, " %*s %1023s %1023s", ficheiros[0], ficheiros[1]);
+		size_t tamanho = 0;
+
+		for (int i = 0; i < n; i++)
+		{
+			size_t m = strlen(ficheiros[i]) + 1;
+
+			if (tamanho + m > MAX_DADOS_PEDIDO)
+			{
+				return -1;
+			}
+
+			memcpy(dados + tamanho, ficheiros[i], m);
+			tamanho += m;
+		}
+
+		p->tipo = PEDIDO_RELOAD;
+		p->tamanho = (uint16_t)tamanho;
+		return n > 0 ? 1 : -1;
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Formata a resposta de um pedido.
+ *
+ * @param e Apontador para a consulta em espera.
+ * @param r Apontador para o cabeçalho da resposta.
+ * @param vertices Bytes dos inteiros a seguir ao cabeçalho.
+ * @return char* Texto da resposta, com a mudança de linha (NULL se não houver memória).
+ */
+static char* FormatarResposta(Espera* e, Resposta* r, const unsigned char* vertices)
+{
+	static const char* nomes[] = { "", "dist", "reach", "path", "reload", "info" };
+	char* texto = (char*)malloc(64 + (size_t)r->numVertices * 12);
+
+	if (texto == NULL)
+	{
+		return NULL;
+	}
+
+	char* p = texto;
+	Pedido* q = &e->pedido;
+
+	//Sem caminho a resposta tem o mesmo formato do grafos-query
+	if (r->estado == RESPOSTA_SEM_CAMINHO)
+	{
+		sprintf(p, "%s;%d;%d;inf%s\n", nomes[q->tipo], q->origem, q->destino, q->tipo == PEDIDO_PATH ? ";" : "");
+		return texto;
+	}
+
+	if (r->estado != RESPOSTA_OK)
+	{
+		static const char* estados[] = { "ok", "invalido", "erro", "ocupado" };
+		sprintf(p, "erro;%ld;%s\n", e->linha, r->estado < 4 ? estados[r->estado] : "?");
+		return texto;
+	}
+
+	switch (q->tipo)
+	{
+	case PEDIDO_INFO:
+		p += sprintf(p, "info;%lld;%d;%d", (long long)r->distancia,
+			r->numVertices > 0 ? (int32_t)LerU32(vertices) : 0, r->numVertices > 1 ? (int32_t)LerU32(vertices + 4) : 0);
+		break;
+
+	case PEDIDO_RELOAD:
+		p += sprintf(p, "reload;%lld", (long long)r->distancia);
+		break;
+
+	default:
+		p += sprintf(p, "%s;%d;%d;%lld", nomes[q->tipo], q->origem, q->destino, (long long)r->distancia);
+
+		if (q->tipo == PEDIDO_PATH)
+		{
+			*p++ = ';';
+
+			for (uint32_t i = 0; i < r->numVertices; i++)
+			{
+				p += sprintf(p, i == 0 ? "%d" : " %d", (int32_t)LerU32(vertices + 4 * i));
+			}
+		}
+		break;
+	}
+
+	*p++ = '\n';
+	*p = '\0';
+	return texto;
+}
+
+/**
+ * @brief Mostra a forma de usar o programa.
+ *
+ * @param programa Nome do programa.
+ */
+static void MostrarUtilizacao(const char* programa)
+{
+	fprintf(stderr,
+		"Utilizacao: %s [-u socket] [-j janela] [-e consultas]\n"
+		"  -u socket    caminho do socket (por omissao /tmp/grafos.sock)\n"
+		"  -j janela    numero maximo de pedidos sem resposta (por omissao 256)\n"
+		"  -e ficheiro  le as consultas do ficheiro (por omissao da entrada padrao)\n",
+		programa);
+}
+
+/**
+ * @brief Função principal do cliente.
+ *
+ * @param argc Números de argumentos
+ * @param argv Array de strings (opções)
+ * @return int 0 se todas as respostas foram recebidas, 1 em caso de erro.
+ */
+int main(int argc, char* argv[])
+{
+	char* caminhoSocket = "/tmp/grafos.sock";
+	char* ficheiroConsultas = NULL;
+	int janela = 256;
+
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		if (strcmp(argv[i], "-u") == 0)
+		{
+			caminhoSocket = argv[i + 1];
+		}
+		else if (strcmp(argv[i], "-j") == 0)
+		{
+			janela = atoi(argv[i + 1]);
+		}
+		else if (strcmp(argv[i], "-e") == 0)
+		{
+			ficheiroConsultas = argv[i + 1];
+		}
+		else
+		{
+			MostrarUtilizacao(argv[0]);
+			return 1;
+		}
+	}
+
+	if (argc % 2 == 0 || janela < 1)
+	{
+		MostrarUtilizacao(argv[0]);
+		return 1;
+	}
+
+	FILE* entrada = ficheiroConsultas != NULL ? fopen(ficheiroConsultas, "r") : stdin;
+	struct sockaddr_un endereco;
+	memset(&endereco, 0, sizeof(endereco));
+	endereco.sun_family = AF_UNIX;
+	strncpy(endereco.sun_path, caminhoSocket, sizeof(endereco.sun_path) - 1);
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+	if (entrada == NULL || fd < 0 || connect(fd, (struct sockaddr*)&endereco, sizeof(endereco)) < 0)
+	{
+		perror("cliente");
+		return 1;
+	}
+
+	//Consultas em espera, numa fila circular indexada pelo id do pedido
+	Espera* espera = (Espera*)calloc(janela, sizeof(Espera));
+	size_t capacidadeEntrada = 1 << 16;
+	unsigned char* recebidos = (unsigned char*)malloc(capacidadeEntrada);
+	unsigned char* envio = (unsigned char*)malloc((size_t)janela * PEDIDO_TAMANHO + MAX_DADOS_PEDIDO);
+	unsigned char dados[MAX_DADOS_PEDIDO];
+
+	if (espera == NULL || recebidos == NULL || envio == NULL)
+	{
+		fprintf(stderr, "Sem memoria\n");
+		return 1;
+	}
+
+	uint32_t lidas = 0, escritas = 0;
+	size_t tamanhoRecebidos = 0;
+	long numLinha = 0, respostas = 0;
+	bool fimEntrada = false, correu = true;
+	char linha[TAMANHO_LINHA];
+	double t0 = Agora();
+
+	setvbuf(stdout, NULL, _IOFBF, 1 << 20);
+
+	while (correu && (!fimEntrada || escritas != lidas))
+	{
+		//Lê consultas até a janela ficar cheia e envia-as de uma vez
+		size_t tamanhoEnvio = 0;
+
+		while (!fimEntrada && lidas - escritas < (uint32_t)janela)
+		{
+			if (fgets(linha, sizeof(linha), entrada) == NULL)
+			{
+				fimEntrada = true;
+				break;
+			}
+
+			numLinha++;
+			Pedido p;
+			int resultado = InterpretarLinha(linha, &p, dados);
+
+			if (resultado == 0)
+			{
+				continue;
+			}
+
+			Espera* e = &espera[lidas % janela];
+			p.id = lidas++;
+			e->pedido = p;
+			e->linha = numLinha;
+			e->invalida = resultado < 0;
+			e->texto = NULL;
+
+			if (!e->invalida)
+			{
+				CodificarPedido(&p, envio + tamanhoEnvio);
+				memcpy(envio + tamanhoEnvio + PEDIDO_TAMANHO, dados, p.tamanho);
+				tamanhoEnvio += PEDIDO_TAMANHO + p.tamanho;
+
+				//Um pedido de recarregamento é enviado sozinho para não encher o buffer
+				if (p.tipo == PEDIDO_RELOAD)
+				{
+					break;
+				}
+			}
+		}
+
+		if (tamanhoEnvio > 0 && !EnviarTudo(fd, envio, tamanhoEnvio))
+		{
+			perror("cliente");
+			correu = false;
+			break;
+		}
+
+		//Escreve as respostas já completas, pela ordem das consultas
+		while (escritas != lidas)
+		{
+			Espera* e = &espera[escritas % janela];
+
+			if (e->invalida)
+			{
+				printf("erro;%ld\n", e->linha);
+			}
+			else if (e->texto != NULL)
+			{
+				fputs(e->texto, stdout);
+				free(e->texto);
+				e->texto = NULL;
+			}
+			else
+			{
+				break;
+			}
+
+			escritas++;
+		}
+
+		if (escritas == lidas)
+		{
+			continue;
+		}
+
+		//Recebe respostas
+		ssize_t n = recv(fd, recebidos + tamanhoRecebidos, capacidadeEntrada - tamanhoRecebidos, 0);
+
+		if (n <= 0)
+		{
+			if (n < 0 && errno == EINTR)
+			{
+				continue;
+			}
+
+			fprintf(stderr, "O servidor fechou a ligacao\n");
+			correu = false;
+			break;
+		}
+
+		tamanhoRecebidos += n;
+		size_t i = 0;
+
+		while (tamanhoRecebidos - i >= RESPOSTA_TAMANHO)
+		{
+			Resposta r;
+			DescodificarResposta(recebidos + i, &r);
+			size_t tamanho = RESPOSTA_TAMANHO + (size_t)r.numVertices * 4;
+
+			if (tamanhoRecebidos - i < tamanho)
+			{
+				//Um caminho maior que o buffer obriga a aumentá-lo
+				if (tamanho > capacidadeEntrada)
+				{
+					unsigned char* aux = (unsigned char*)realloc(recebidos, tamanho);
+
+					if (aux == NULL)
+					{
+						correu = false;
+						break;
+					}
+
+					recebidos = aux;
+					capacidadeEntrada = tamanho;
+				}
+
+				break;
+			}
+
+			Espera* e = &espera[r.id % janela];
+
+			if (r.id - escritas < lidas - escritas && e->pedido.id == r.id && e->texto == NULL)
+			{
+				e->texto = FormatarResposta(e, &r, recebidos + i + RESPOSTA_TAMANHO);
+				respostas++;
+				correu = e->texto != NULL;
+			}
+
+			i += tamanho;
+		}
+
+		memmove(recebidos, recebidos + i, tamanhoRecebidos - i);
+		tamanhoRecebidos -= i;
+	}
+
+	fflush(stdout);
+	double tempo = Agora() - t0;
+	fprintf(stderr, "respostas: %ld, %.3f s, %.0f pedidos/s\n", respostas, tempo, tempo > 0 ? respostas / tempo : 0.0);
+
+	for (int i = 0; i < janela; i++)
+	{
+		free(espera[i].texto);
+	}
+
+	free(espera);
+	free(recebidos);
+	free(envio);
+	close(fd);
+
+	if (entrada != stdin)
+	{
+		fclose(entrada);
+	}
+
+	return correu ? 0 : 1;
+}
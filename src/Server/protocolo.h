@@ -0,0 +1,190 @@
+/**
+ * @file protocolo.h
+ * @author Hugo Cruz (a23010)
+ * @brief Ficheiro de cabeçalho com o protocolo binário entre o servidor de consultas e os clientes.
+ *
+ * Cada pedido tem um cabeçalho de PEDIDO_TAMANHO bytes, seguido de tamanho bytes de dados (só
+ * usados no recarregamento, com os nomes dos ficheiros separados por '\0'). Cada resposta tem um
+ * cabeçalho de RESPOSTA_TAMANHO bytes seguido de numVertices inteiros de 4 bytes. Todos os números
+ * são escritos em little-endian.
+ *
+ * Um cliente pode enviar vários pedidos sem esperar pelas respostas. As respostas podem chegar
+ * por outra ordem: cada resposta repete o id do pedido a que responde.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef PROTOCOLO_H
+#define PROTOCOLO_H
+
+#include <stdint.h>
+
+/**
+ * @def PEDIDO_TAMANHO
+ * @brief Número de bytes do cabeçalho de um pedido.
+ */
+#define PEDIDO_TAMANHO 16
+
+/**
+ * @def RESPOSTA_TAMANHO
+ * @brief Número de bytes do cabeçalho de uma resposta.
+ */
+#define RESPOSTA_TAMANHO 20
+
+/**
+ * @def MAX_DADOS_PEDIDO
+ * @brief Número máximo de bytes de dados de um pedido.
+ */
+#define MAX_DADOS_PEDIDO 8192
+
+/**
+ * @brief Tipos de pedido.
+ *
+ */
+typedef enum TipoPedido
+{
+	PEDIDO_DIST = 1,	///< Distância entre origem e destino (RESPOSTA_SEM_CAMINHO se não existir caminho).
+	PEDIDO_REACH = 2,	///< 1 se existe caminho entre origem e destino, 0 caso contrário.
+	PEDIDO_PATH = 3,	///< Distância e vértices do caminho mais curto (RESPOSTA_SEM_CAMINHO se não existir).
+	PEDIDO_RELOAD = 4,	///< Carrega um grafo novo a partir dos ficheiros indicados nos dados.
+	PEDIDO_INFO = 5		///< Versão do grafo carregado, com o número de vértices e de arestas.
+
+} TipoPedido;
+
+/**
+ * @brief Estados de uma resposta.
+ *
+ */
+typedef enum EstadoResposta
+{
+	RESPOSTA_OK = 0,		///< Pedido respondido.
+	RESPOSTA_INVALIDO = 1,	///< Tipo de pedido desconhecido ou dados inválidos.
+	RESPOSTA_ERRO = 2,		///< Erro do servidor (sem memória ou ficheiro que não pôde ser carregado).
+	RESPOSTA_OCUPADO = 3,	///< Já existe um recarregamento em curso.
+	RESPOSTA_SEM_CAMINHO = 4	///< Não existe caminho da origem ao destino (a distância é 0 e não há vértices).
+
+} EstadoResposta;
+
+/**
+ * @brief Cabeçalho de um pedido.
+ *
+ */
+typedef struct Pedido
+{
+	uint32_t id;		///< Identificador escolhido pelo cliente, repetido na resposta.
+	uint8_t tipo;		///< Tipo do pedido (TipoPedido).
+	uint16_t tamanho;	///< Número de bytes de dados a seguir ao cabeçalho.
+	int32_t origem;		///< Vértice de origem.
+	int32_t destino;	///< Vértice de destino.
+
+} Pedido;
+
+/**
+ * @brief Cabeçalho de uma resposta.
+ *
+ */
+typedef struct Resposta
+{
+	uint32_t id;			///< Identificador do pedido.
+	uint8_t tipo;			///< Tipo do pedido.
+	uint8_t estado;			///< Estado da resposta (EstadoResposta).
+	int64_t distancia;		///< Distância, alcançabilidade ou versão do grafo, conforme o tipo (qualquer valor é uma distância real, mesmo negativo).
+	uint32_t numVertices;	///< Número de inteiros a seguir ao cabeçalho.
+
+} Resposta;
+
+/**
+ * @brief Escreve um inteiro de 32 bits em little-endian.
+ *
+ * @param p Posição de escrita.
+ * @param v Valor.
+ */
+static inline void EscreverU32(unsigned char* p, uint32_t v)
+{
+	p[0] = (unsigned char)v;
+	p[1] = (unsigned char)(v >> 8);
+	p[2] = (unsigned char)(v >> 16);
+	p[3] = (unsigned char)(v >> 24);
+}
+
+/**
+ * @brief Lê um inteiro de 32 bits em little-endian.
+ *
+ * @param p Posição de leitura.
+ * @return uint32_t Valor lido.
+ */
+static inline uint32_t LerU32(const unsigned char* p)
+{
+	return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+/**
+ * @brief Escreve o cabeçalho de um pedido.
+ *
+ * @param p Apontador para o pedido.
+ * @param b Buffer com PEDIDO_TAMANHO bytes.
+ */
+static inline void CodificarPedido(const Pedido* p, unsigned char* b)
+{
+	EscreverU32(b, p->id);
+	b[4] = p->tipo;
+	b[5] = 0;
+	b[6] = (unsigned char)p->tamanho;
+	b[7] = (unsigned char)(p->tamanho >> 8);
+	EscreverU32(b + 8, (uint32_t)p->origem);
+	EscreverU32(b + 12, (uint32_t)p->destino);
+}
+
+/**
+ * @brief Lê o cabeçalho de um pedido.
+ *
+ * @param b Buffer com PEDIDO_TAMANHO bytes.
+ * @param p Apontador para o pedido a preencher.
+ */
+static inline void DescodificarPedido(const unsigned char* b, Pedido* p)
+{
+	p->id = LerU32(b);
+	p->tipo = b[4];
+	p->tamanho = (uint16_t)(b[6] | b[7] << 8);
+	p->origem = (int32_t)LerU32(b + 8);
+	p->destino = (int32_t)LerU32(b + 12);
+}
+
+/**
+ * @brief Escreve o cabeçalho de uma resposta.
+ *
+ * @param r Apontador para a resposta.
+ * @param b Buffer com RESPOSTA_TAMANHO bytes.
+ */
+static inline void CodificarResposta(const Resposta* r, unsigned char* b)
+{
+	EscreverU32(b, r->id);
+	b[4] = r->tipo;
+	b[5] = r->estado;
+	b[6] = 0;
+	b[7] = 0;
+	EscreverU32(b + 8, (uint32_t)((uint64_t)r->distancia & 0xFFFFFFFFu));
+	EscreverU32(b + 12, (uint32_t)((uint64_t)r->distancia >> 32));
+	EscreverU32(b + 16, r->numVertices);
+}
+
+/**
+ * @brief Lê o cabeçalho de uma resposta.
+ *
+ * @param b Buffer com RESPOSTA_TAMANHO bytes.
+ * @param r Apontador para a resposta a preencher.
+ */
+static inline void DescodificarResposta(const unsigned char* b, Resposta* r)
+{
+	r->id = LerU32(b);
+	r->tipo = b[4];
+	r->estado = b[5];
+	r->distancia = (int64_t)((uint64_t)LerU32(b + 8) | (uint64_t)LerU32(b + 12) << 32);
+	r->numVertices = LerU32(b + 16);
+}
+
+#endif
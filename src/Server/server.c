@@ -0,0 +1,1441 @@
+/**
+ * @file server.c
+ * @author Hugo Cruz (a23010)
+ * @brief Servidor de consultas sobre um grafo residente, através de um socket Unix local (Linux).
+ *
+ * O grafo é carregado uma vez e passado para uma imagem imutável. A thread principal corre um
+ * ciclo epoll que aceita ligações, lê os pedidos (vários pedidos seguidos da mesma ligação, sem
+ * esperar pelas respostas) e escreve as respostas. Os pedidos de distância, alcançabilidade e
+ * caminho vão para uma fila partilhada por um conjunto de threads, cada uma com o seu espaço de
+ * trabalho; as respostas voltam por outra fila e um eventfd acorda o ciclo.
+ *
+ * Os pedidos de alcançabilidade são respondidos com uma pesquisa em largura que para no destino,
+ * sem olhar para os pesos. Se o grafo tiver pesos negativos, os potenciais de Johnson são
+ * calculados uma vez por versão, ao carregar, e copiados para o espaço de cada thread quando ela
+ * passa a usar essa versão; um grafo com um ciclo negativo não tem caminhos mais curtos e não é
+ * carregado. Como qualquer distância, mesmo negativa, pode ser real, um pedido de distância ou
+ * caminho sem caminho é respondido com o estado RESPOSTA_SEM_CAMINHO.
+ *
+ * Cada pedido fica associado à versão do grafo que estava carregada quando chegou. Um pedido de
+ * recarregamento (ou o sinal SIGHUP, que volta a ler os ficheiros iniciais) carrega o grafo novo
+ * numa thread à parte; quando termina, os pedidos seguintes passam a usar a versão nova e a
+ * antiga só é libertada depois de respondidos os pedidos que ainda a usam. SIGINT e SIGTERM
+ * terminam o servidor depois de responder aos pedidos já recebidos.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+//accept4 é uma extensão do Linux
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <threads.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "../Grafos/InputOutput.h"
+#include "../Grafos/caminhos.h"
+#include "../Grafos/bellmanford.h"
+#include "../Grafos/compacto.h"
+#include "../Grafos/componentes.h"
+#include "../Grafos/largura.h"
+#include "../Grafos/paralelo.h"
+#include "protocolo.h"
+
+/**
+ * @def MAX_PENDENTES
+ * @brief Número de pedidos por responder a partir do qual uma ligação deixa de ser lida.
+ */
+#define MAX_PENDENTES 1024
+
+/**
+ * @def MAX_SAIDA
+ * @brief Número de bytes por enviar a partir do qual uma ligação deixa de ser lida.
+ */
+#define MAX_SAIDA (1 << 20)
+
+/**
+ * @def TAMANHO_LEITURA
+ * @brief Número de bytes lidos de uma ligação de cada vez.
+ */
+#define TAMANHO_LEITURA 65536
+
+/**
+ * @brief Versão do grafo carregada pelo servidor.
+ *
+ * Só a thread principal altera o número de referências: uma da versão atual e uma por cada
+ * pedido por responder que a usa.
+ */
+typedef struct VersaoGrafo
+{
+	ImagemGrafo* imagem;		///< Imagem pesquisada (NULL se for usada a imagem comprimida).
+	ImagemCompacta* compacta;	///< Imagem comprimida pesquisada (NULL se for usada a imagem).
+	Componentes* conexas;		///< Componentes conexas da imagem (NULL se não foram calculadas).
+	Componentes* fortes;		///< Componentes fortemente conexas da imagem (NULL se não foram calculadas).
+	ImagemGrafo* inversa;		///< Imagem inversa, partilhada pelas pesquisas em largura (NULL se não foi criada).
+	EspacoCaminhos* potenciais;	///< Espaço com os potenciais de Johnson da versão (sem potenciais se não houver pesos negativos).
+	unsigned long numero;		///< Número da versão (1 para o grafo inicial).
+	int referencias;			///< Número de referências à versão.
+
+} VersaoGrafo;
+
+/**
+ * @brief Espaços de trabalho e buffers de uma thread que responde aos pedidos.
+ *
+ */
+typedef struct EspacosThread
+{
+	EspacoCaminhos* caminhos;	///< Espaço das pesquisas de caminhos (criado na primeira tarefa).
+	EspacoLargura* largura;		///< Espaço das pesquisas em largura na imagem da versão associada.
+	int* nivel;					///< Níveis das pesquisas em largura na imagem comprimida.
+	int tamanhoNivel;			///< Número de elementos de nivel.
+	unsigned long numero;		///< Número da versão associada aos espaços (0 antes da primeira tarefa).
+	int* caminho;				///< Buffer de caminhos.
+	int capacidade;				///< Número de elementos de caminho.
+
+} EspacosThread;
+
+/**
+ * @brief Ligação de um cliente.
+ *
+ */
+typedef struct Ligacao
+{
+	int fd;						///< Socket da ligação (-1 depois de fechada).
+	unsigned char* entrada;		///< Bytes recebidos que ainda não formam um pedido completo.
+	size_t tamanhoEntrada;		///< Número de bytes em entrada.
+	unsigned char* saida;		///< Respostas por enviar.
+	size_t inicioSaida;			///< Posição do primeiro byte por enviar.
+	size_t tamanhoSaida;		///< Número de bytes escritos em saida.
+	size_t capacidadeSaida;		///< Número de bytes alocados em saida.
+	int pendentes;				///< Número de pedidos entregues às threads e ainda por responder.
+	unsigned int interesse;		///< Eventos registados no epoll.
+	bool porEnviar;				///< Indica se a ligação já está na lista de envio das respostas recolhidas.
+	bool libertar;				///< Indica se a ligação já está na lista de ligações a libertar.
+	struct Ligacao* proximaEnvio;	///< Ligação seguinte na lista de envio.
+	struct Ligacao* anterior;	///< Ligação anterior na lista de ligações do servidor.
+	struct Ligacao* seguinte;	///< Ligação seguinte na lista de ligações (ou na lista a libertar).
+
+} Ligacao;
+
+/**
+ * @brief Pedido entregue às threads.
+ *
+ */
+typedef struct Tarefa
+{
+	struct Tarefa* next;		///< Tarefa seguinte na fila.
+	Ligacao* ligacao;			///< Ligação que fez o pedido.
+	VersaoGrafo* versao;		///< Versão do grafo usada na resposta.
+	Pedido pedido;				///< Pedido.
+	unsigned char* resposta;	///< Resposta codificada.
+	size_t tamanhoResposta;		///< Número de bytes da resposta.
+
+} Tarefa;
+
+/**
+ * @brief Fila de tarefas.
+ *
+ */
+typedef struct FilaTarefas
+{
+	Tarefa* inicio;	///< Primeira tarefa.
+	Tarefa* fim;	///< Última tarefa.
+
+} FilaTarefas;
+
+/**
+ * @brief Estado do servidor.
+ *
+ */
+typedef struct Servidor
+{
+	int epoll;					///< Descritor do epoll.
+	int escuta;					///< Socket que aceita ligações (-1 depois de fechado).
+	int aviso;					///< eventfd escrito pelas threads quando há respostas ou um grafo carregado.
+	int sinais;					///< signalfd de SIGINT, SIGTERM e SIGHUP.
+	char* caminhoSocket;		///< Caminho do socket.
+
+	VersaoGrafo* atual;			///< Versão do grafo usada nos pedidos novos.
+	char* ficheiros[2];			///< Ficheiros do grafo inicial, relidos com SIGHUP.
+	int numFicheiros;			///< Número de ficheiros do grafo inicial.
+
+	mtx_t trinco;				///< Protege as filas, terminar e os campos do recarregamento.
+	cnd_t haTarefas;			///< Sinalizada quando há tarefas ou o servidor termina.
+	FilaTarefas porResponder;	///< Tarefas à espera de uma thread.
+	FilaTarefas respondidas;	///< Tarefas respondidas à espera da thread principal.
+	bool terminar;				///< Indica às threads que devem terminar.
+	thrd_t* threads;			///< Threads que respondem aos pedidos.
+	int numThreads;				///< Número de threads.
+
+	bool aRecarregar;			///< Indica se há um recarregamento em curso.
+	bool recargaConcluida;		///< Indica que a thread de carregamento terminou.
+	char* novosFicheiros[2];	///< Ficheiros do grafo a carregar.
+	int numNovosFicheiros;		///< Número de ficheiros do grafo a carregar.
+	VersaoGrafo* novaVersao;	///< Versão carregada (NULL se o carregamento falhou).
+	Tarefa* pedidoRecarga;		///< Pedido de recarregamento por responder (NULL se veio de SIGHUP).
+	thrd_t carregador;			///< Thread do carregamento.
+
+	Ligacao* ligacoes;			///< Ligações que ainda não foram libertadas.
+	Ligacao* aLibertar;			///< Ligações fechadas a libertar no fim da iteração do ciclo de eventos.
+	int totalPendentes;			///< Número de tarefas por responder em todas as ligações.
+	unsigned long respondidos;	///< Número de pedidos respondidos.
+
+} Servidor;
+
+/**
+ * @brief Indica se o nome de um ficheiro termina numa extensão.
+ *
+ * @param nome Nome do ficheiro.
+ * @param extensao Extensão, com o ponto.
+ * @return true se o nome termina na extensão.
+ */
+static bool TemExtensao(const char* nome, const char* extensao)
+{
+	size_t n = strlen(nome), m = strlen(extensao);
+	return n >= m && strcmp(nome + n - m, extensao) == 0;
+}
+
+/**
+ * @brief Liberta uma versão do grafo e tudo o que lhe pertence.
+ *
+ * @param v Apontador para a versão.
+ */
+static void ApagarVersao(VersaoGrafo* v)
+{
+	ApagarEspacoCaminhos(v->potenciais);
+	ApagarComponentes(v->conexas);
+	ApagarComponentes(v->fortes);
+	ApagarImagemGrafo(v->inversa);
+	ApagarImagemGrafo(v->imagem);
+	ApagarImagemCompacta(v->compacta);
+	free(v);
+}
+
+/**
+ * @brief Carrega uma versão do grafo.
+ *
+ * Um ficheiro .csv é lido com CarregaDadosCSV, dois ficheiros com CarregaGrafo e qualquer outro
+ * ficheiro como uma imagem comprimida. Com uma imagem não comprimida são também calculadas a
+ * imagem inversa e as componentes do grafo. Se o grafo tiver pesos negativos são calculados os
+ * potenciais de Johnson; com um ciclo negativo a versão não é carregada.
+ *
+ * @param ficheiros Nomes dos ficheiros.
+ * @param numFicheiros Número de ficheiros (1 ou 2).
+ * @return VersaoGrafo* Versão carregada, sem referências, ou NULL em caso de erro.
+ */
+static VersaoGrafo* CarregarVersao(char* ficheiros[], int numFicheiros)
+{
+	bool inf;
+	VersaoGrafo* v = (VersaoGrafo*)calloc(1, sizeof(VersaoGrafo));
+
+	if (v == NULL)
+	{
+		return NULL;
+	}
+
+	if (numFicheiros == 1 && !TemExtensao(ficheiros[0], ".csv"))
+	{
+		v->compacta = CarregaImagemCompacta(ficheiros[0]);
+	}
+	else
+	{
+		Grafo* g = numFicheiros == 2 ? CarregaGrafo(ficheiros[0], ficheiros[1]) : CarregaDadosCSV(ficheiros[0]);
+
+		if (g != NULL)
+		{
+			v->imagem = CriarImagemGrafo(g, &inf);
+			ApagaGrafo(g);
+		}
+
+		//A inversa e as componentes só aceleram as respostas, pelo que a falta de memória não é um erro
+		if (v->imagem != NULL)
+		{
+			v->inversa = InverterImagemGrafo(v->imagem, &inf);
+			v->conexas = ComponentesConexas(v->imagem, v->inversa, NULL, &inf);
+			v->fortes = ComponentesFortes(v->imagem, &inf);
+		}
+	}
+
+	if (v->imagem == NULL && v->compacta == NULL)
+	{
+		ApagarVersao(v);
+		return NULL;
+	}
+
+	//Os potenciais são calculados uma vez e copiados para o espaço de cada thread
+	bool cicloNegativo = false;
+	v->potenciais = v->compacta != NULL ? CriarEspacoCompacta(v->compacta, &inf) : CriarEspacoImagem(v->imagem, &inf);
+
+	if (v->potenciais == NULL || !(v->compacta != NULL ? JohnsonCompacta(v->compacta, v->potenciais, &cicloNegativo)
+		: JohnsonImagem(v->imagem, v->potenciais, &cicloNegativo)))
+	{
+		fprintf(stderr, cicloNegativo ? "o grafo tem um ciclo negativo\n" : "sem memoria para os potenciais do grafo\n");
+		ApagarVersao(v);
+		return NULL;
+	}
+
+	return v;
+}
+
+/**
+ * @brief Retira uma referência a uma versão e liberta-a quando deixa de ser usada.
+ *
+ * @param v Apontador para a versão.
+ */
+static void LargarVersao(VersaoGrafo* v)
+{
+	if (v != NULL && --v->referencias == 0)
+	{
+		ApagarVersao(v);
+	}
+}
+
+/**
+ * @brief Acrescenta uma tarefa ao fim de uma fila.
+ *
+ * @param f Apontador para a fila.
+ * @param t Apontador para a tarefa.
+ */
+static void AcrescentarTarefa(FilaTarefas* f, Tarefa* t)
+{
+	t->next = NULL;
+
+	if (f->fim == NULL)
+	{
+		f->inicio = t;
+	}
+	else
+	{
+		f->fim->next = t;
+	}
+
+	f->fim = t;
+}
+
+/**
+ * @brief Cria a resposta de uma tarefa.
+ *
+ * @param t Apontador para a tarefa.
+ * @param estado Estado da resposta.
+ * @param distancia Valor do campo distancia.
+ * @param vertices Inteiros a seguir ao cabeçalho (pode ser NULL se numVertices for 0).
+ * @param numVertices Número de inteiros.
+ * @return true se a resposta foi criada.
+ */
+static bool CriarResposta(Tarefa* t, EstadoResposta estado, int64_t distancia, const int* vertices, int numVertices)
+{
+	Resposta r = { t->pedido.id, t->pedido.tipo, (uint8_t)estado, distancia, (uint32_t)numVertices };
+
+	t->tamanhoResposta = RESPOSTA_TAMANHO + sizeof(int32_t) * numVertices;
+	t->resposta = (unsigned char*)malloc(t->tamanhoResposta);
+
+	if (t->resposta == NULL)
+	{
+		t->tamanhoResposta = 0;
+		return false;
+	}
+
+	CodificarResposta(&r, t->resposta);
+
+	for (int i = 0; i < numVertices; i++)
+	{
+		EscreverU32(t->resposta + RESPOSTA_TAMANHO + 4 * i, (uint32_t)vertices[i]);
+	}
+
+	return true;
+}
+
+/**
+ * @brief Associa os espaços de uma thread a uma versão do grafo.
+ *
+ * O espaço de caminhos passa a pesquisar a imagem da versão e recebe os seus potenciais de
+ * Johnson, e o espaço da pesquisa em largura (ou o array de níveis, numa imagem comprimida) passa
+ * a ter o tamanho da imagem. A cópia dos potenciais é sempre feita, mesmo que a imagem nova ocupe
+ * o endereço de uma versão já libertada.
+ *
+ * @param et Apontador para os espaços da thread.
+ * @param v Apontador para a versão.
+ * @return true se os espaços foram associados, e false se não houver memória.
+ */
+static bool AssociarVersao(EspacosThread* et, VersaoGrafo* v)
+{
+	bool inf;
+
+	if (et->caminhos == NULL)
+	{
+		et->caminhos = v->compacta != NULL ? CriarEspacoCompacta(v->compacta, &inf) : CriarEspacoImagem(v->imagem, &inf);
+
+		if (et->caminhos == NULL)
+		{
+			return false;
+		}
+	}
+
+	//Uma pesquisa sem origem só associa o espaço à imagem
+	if (v->compacta != NULL)
+	{
+		DijkstraCompacta(v->compacta, et->caminhos, -1, -1);
+	}
+	else
+	{
+		DijkstraImagem(v->imagem, et->caminhos, -1, -1);
+	}
+
+	if (!CopiarPotenciaisEspaco(et->caminhos, v->potenciais))
+	{
+		return false;
+	}
+
+	ApagarEspacoLargura(et->largura);
+	et->largura = NULL;
+
+	if (v->imagem != NULL)
+	{
+		et->largura = CriarEspacoLargura(v->imagem, v->inversa, &inf);
+
+		if (et->largura == NULL)
+		{
+			return false;
+		}
+	}
+	else if (et->tamanhoNivel < v->compacta->tamanho)
+	{
+		int* aux = (int*)realloc(et->nivel, sizeof(int) * v->compacta->tamanho);
+
+		if (aux == NULL)
+		{
+			return false;
+		}
+
+		et->nivel = aux;
+		et->tamanhoNivel = v->compacta->tamanho;
+	}
+
+	et->numero = v->numero;
+	return true;
+}
+
+/**
+ * @brief Responde a um pedido de distância, alcançabilidade ou caminho.
+ *
+ * @param t Apontador para a tarefa.
+ * @param et Apontador para os espaços e buffers da thread.
+ */
+static void ResponderTarefa(Tarefa* t, EspacosThread* et)
+{
+	VersaoGrafo* v = t->versao;
+	int origem = t->pedido.origem, destino = t->pedido.destino;
+
+	//Os espaços só mudam de versão quando a tarefa anterior da thread usou outra
+	if (et->numero != v->numero && !AssociarVersao(et, v))
+	{
+		CriarResposta(t, RESPOSTA_ERRO, -1, NULL, 0);
+		return;
+	}
+
+	//Quando as componentes mostram que não há caminho a pesquisa é dispensada
+	bool possivel = CaminhoPossivel(v->conexas, v->fortes, origem, destino);
+
+	//A alcançabilidade não depende dos pesos: basta uma pesquisa em largura que para no destino
+	if (t->pedido.tipo == PEDIDO_REACH)
+	{
+		bool alcancavel = false;
+
+		if (possivel && v->compacta != NULL)
+		{
+			alcancavel = destino >= 0 && LarguraCompacta(v->compacta, origem, destino, et->nivel) > 0 && et->nivel[destino] >= 0;
+		}
+		else if (possivel)
+		{
+			alcancavel = LarguraDirecional(et->largura, NULL, origem, destino) >= 0;
+		}
+
+		CriarResposta(t, RESPOSTA_OK, alcancavel, NULL, 0);
+		return;
+	}
+
+	EspacoCaminhos* e = et->caminhos;
+	Distancia d = DISTANCIA_INFINITA;
+
+	if (possivel)
+	{
+		d = v->compacta != NULL ? DijkstraCompacta(v->compacta, e, origem, destino) : DijkstraImagem(v->imagem, e, origem, destino);
+	}
+
+	//Com os potenciais de Johnson -1 é uma distância válida: a falta de caminho vai no estado
+	if (d == DISTANCIA_INFINITA)
+	{
+		CriarResposta(t, RESPOSTA_SEM_CAMINHO, 0, NULL, 0);
+		return;
+	}
+
+	int numVertices = 0;
+
+	if (t->pedido.tipo == PEDIDO_PATH)
+	{
+		numVertices = CopiarCaminho(e->verticeAnt, e->tamanho, destino, et->caminho, et->capacidade);
+
+		if (numVertices > et->capacidade)
+		{
+			int* aux = (int*)realloc(et->caminho, sizeof(int) * numVertices);
+
+			if (aux == NULL)
+			{
+				CriarResposta(t, RESPOSTA_ERRO, -1, NULL, 0);
+				return;
+			}
+
+			et->caminho = aux;
+			et->capacidade = numVertices;
+			CopiarCaminho(e->verticeAnt, e->tamanho, destino, et->caminho, et->capacidade);
+		}
+	}
+
+	CriarResposta(t, RESPOSTA_OK, (int64_t)d, et->caminho, numVertices);
+}
+
+/**
+ * @brief Avisa a thread principal através do eventfd.
+ *
+ * @param s Apontador para o servidor.
+ */
+static void Avisar(Servidor* s)
+{
+	uint64_t um = 1;
+
+	while (write(s->aviso, &um, sizeof(um)) < 0 && errno == EINTR);
+}
+
+/**
+ * @brief Função das threads que respondem aos pedidos.
+ *
+ * @param arg Apontador para o servidor.
+ * @return int 0.
+ */
+static int ExecutarTrabalhador(void* arg)
+{
+	Servidor* s = (Servidor*)arg;
+	EspacosThread et = { 0 };
+
+	while (true)
+	{
+		mtx_lock(&s->trinco);
+
+		while (!s->terminar && s->porResponder.inicio == NULL)
+		{
+			cnd_wait(&s->haTarefas, &s->trinco);
+		}
+
+		Tarefa* t = s->porResponder.inicio;
+
+		if (t == NULL)
+		{
+			mtx_unlock(&s->trinco);
+			break;
+		}
+
+		s->porResponder.inicio = t->next;
+
+		if (s->porResponder.inicio == NULL)
+		{
+			s->porResponder.fim = NULL;
+		}
+
+		mtx_unlock(&s->trinco);
+
+		ResponderTarefa(t, &et);
+
+		mtx_lock(&s->trinco);
+		bool primeira = s->respondidas.inicio == NULL;
+		AcrescentarTarefa(&s->respondidas, t);
+		mtx_unlock(&s->trinco);
+
+		//Só é preciso acordar a thread principal se a fila estava vazia
+		if (primeira)
+		{
+			Avisar(s);
+		}
+	}
+
+	ApagarEspacoCaminhos(et.caminhos);
+	ApagarEspacoLargura(et.largura);
+	free(et.nivel);
+	free(et.caminho);
+	return 0;
+}
+
+/**
+ * @brief Função da thread que carrega um grafo novo.
+ *
+ * @param arg Apontador para o servidor.
+ * @return int 0.
+ */
+static int ExecutarCarregador(void* arg)
+{
+	Servidor* s = (Servidor*)arg;
+	VersaoGrafo* v = CarregarVersao(s->novosFicheiros, s->numNovosFicheiros);
+
+	mtx_lock(&s->trinco);
+	s->novaVersao = v;
+	s->recargaConcluida = true;
+	mtx_unlock(&s->trinco);
+
+	Avisar(s);
+	return 0;
+}
+
+/**
+ * @brief Atualiza os eventos registados no epoll para uma ligação.
+ *
+ * Uma ligação deixa de ser lida quando tem demasiados pedidos por responder ou demasiados bytes
+ * por enviar, para que um cliente que não lê as respostas não faça crescer a memória do servidor.
+ *
+ * @param s Apontador para o servidor.
+ * @param l Apontador para a ligação.
+ * @param leitura Indica se a ligação pode ser lida (false quando o servidor está a terminar).
+ */
+static void AtualizarInteresse(Servidor* s, Ligacao* l, bool leitura)
+{
+	unsigned int interesse = 0;
+
+	if (leitura && l->pendentes < MAX_PENDENTES && l->tamanhoSaida - l->inicioSaida < MAX_SAIDA)
+	{
+		interesse |= EPOLLIN;
+	}
+
+	if (l->tamanhoSaida > l->inicioSaida)
+	{
+		interesse |= EPOLLOUT;
+	}
+
+	if (interesse != l->interesse)
+	{
+		struct epoll_event ev = { .events = interesse, .data.ptr = l };
+		epoll_ctl(s->epoll, EPOLL_CTL_MOD, l->fd, &ev);
+		l->interesse = interesse;
+	}
+}
+
+/**
+ * @brief Fecha o socket de uma ligação e, se não tiver pedidos por responder, marca-a para ser libertada.
+ *
+ * Com pedidos por responder a estrutura só é libertada depois da última resposta. A memória só é
+ * libertada no fim da iteração do ciclo de eventos, porque a mesma iteração ainda pode ter
+ * eventos da ligação.
+ *
+ * @param s Apontador para o servidor.
+ * @param l Apontador para a ligação.
+ */
+static void FecharLigacao(Servidor* s, Ligacao* l)
+{
+	if (l->fd >= 0)
+	{
+		close(l->fd);
+		l->fd = -1;
+	}
+
+	if (l->pendentes == 0 && !l->libertar)
+	{
+		l->libertar = true;
+
+		if (l->anterior != NULL)
+		{
+			l->anterior->seguinte = l->seguinte;
+		}
+		else
+		{
+			s->ligacoes = l->seguinte;
+		}
+
+		if (l->seguinte != NULL)
+		{
+			l->seguinte->anterior = l->anterior;
+		}
+
+		l->seguinte = s->aLibertar;
+		s->aLibertar = l;
+	}
+}
+
+/**
+ * @brief Liberta as ligações fechadas.
+ *
+ * @param s Apontador para o servidor.
+ */
+static void LibertarLigacoes(Servidor* s)
+{
+	while (s->aLibertar != NULL)
+	{
+		Ligacao* l = s->aLibertar;
+		s->aLibertar = l->seguinte;
+		free(l->entrada);
+		free(l->saida);
+		free(l);
+	}
+}
+
+/**
+ * @brief Acrescenta bytes às respostas por enviar de uma ligação.
+ *
+ * @param l Apontador para a ligação.
+ * @param dados Bytes a acrescentar.
+ * @param n Número de bytes.
+ * @return true se os bytes foram acrescentados.
+ */
+static bool AcrescentarSaida(Ligacao* l, const unsigned char* dados, size_t n)
+{
+	//Move os bytes por enviar para o início antes de aumentar o buffer
+	if (l->inicioSaida > 0 && l->tamanhoSaida + n > l->capacidadeSaida)
+	{
+		memmove(l->saida, l->saida + l->inicioSaida, l->tamanhoSaida - l->inicioSaida);
+		l->tamanhoSaida -= l->inicioSaida;
+		l->inicioSaida = 0;
+	}
+
+	if (l->tamanhoSaida + n > l->capacidadeSaida)
+	{
+		size_t capacidade = l->capacidadeSaida == 0 ? 4096 : l->capacidadeSaida;
+
+		while (capacidade < l->tamanhoSaida + n)
+		{
+			capacidade *= 2;
+		}
+
+		unsigned char* aux = (unsigned char*)realloc(l->saida, capacidade);
+
+		if (aux == NULL)
+		{
+			return false;
+		}
+
+		l->saida = aux;
+		l->capacidadeSaida = capacidade;
+	}
+
+	memcpy(l->saida + l->tamanhoSaida, dados, n);
+	l->tamanhoSaida += n;
+	return true;
+}
+
+/**
+ * @brief Envia as respostas por enviar de uma ligação até o socket não aceitar mais.
+ *
+ * @param l Apontador para a ligação.
+ * @return false se a ligação deve ser fechada.
+ */
+static bool EnviarSaida(Ligacao* l)
+{
+	while (l->inicioSaida < l->tamanhoSaida)
+	{
+		ssize_t n = send(l->fd, l->saida + l->inicioSaida, l->tamanhoSaida - l->inicioSaida, MSG_NOSIGNAL);
+
+		if (n < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+
+			return errno == EAGAIN || errno == EWOULDBLOCK;
+		}
+
+		l->inicioSaida += n;
+	}
+
+	l->inicioSaida = 0;
+	l->tamanhoSaida = 0;
+	return true;
+}
+
+/**
+ * @brief Responde na thread principal a um pedido que não vai para as threads.
+ *
+ * @param l Apontador para a ligação.
+ * @param p Apontador para o pedido.
+ * @param estado Estado da resposta.
+ * @param distancia Valor do campo distancia.
+ * @param vertices Inteiros a seguir ao cabeçalho (pode ser NULL se numVertices for 0).
+ * @param numVertices Número de inteiros.
+ * @return true se a resposta foi acrescentada.
+ */
+static bool ResponderDiretamente(Ligacao* l, Pedido* p, EstadoResposta estado, int64_t distancia, const int* vertices, int numVertices)
+{
+	Tarefa t = { .pedido = *p };
+
+	if (!CriarResposta(&t, estado, distancia, vertices, numVertices))
+	{
+		return false;
+	}
+
+	bool correu = AcrescentarSaida(l, t.resposta, t.tamanhoResposta);
+	free(t.resposta);
+	return correu;
+}
+
+/**
+ * @brief Inicia o carregamento de um grafo novo numa thread à parte.
+ *
+ * @param s Apontador para o servidor.
+ * @param ficheiros Nomes dos ficheiros (são copiados).
+ * @param numFicheiros Número de ficheiros.
+ * @param pedido Tarefa com o pedido de recarregamento (NULL se veio de SIGHUP).
+ * @return true se o carregamento foi iniciado.
+ */
+static bool IniciarRecarga(Servidor* s, char* ficheiros[], int numFicheiros, Tarefa* pedido)
+{
+	if (s->aRecarregar)
+	{
+		return false;
+	}
+
+	for (int i = 0; i < 2; i++)
+	{
+		free(s->novosFicheiros[i]);
+		s->novosFicheiros[i] = i < numFicheiros ? strdup(ficheiros[i]) : NULL;
+	}
+
+	s->numNovosFicheiros = numFicheiros;
+	s->recargaConcluida = false;
+	s->novaVersao = NULL;
+	s->pedidoRecarga = pedido;
+
+	if (thrd_create(&s->carregador, ExecutarCarregador, s) != thrd_success)
+	{
+		return false;
+	}
+
+	s->aRecarregar = true;
+	return true;
+}
+
+/**
+ * @brief Termina um recarregamento: troca a versão atual e responde ao pedido.
+ *
+ * @param s Apontador para o servidor.
+ */
+static void ConcluirRecarga(Servidor* s)
+{
+	thrd_join(s->carregador, NULL);
+	s->aRecarregar = false;
+
+	VersaoGrafo* v = s->novaVersao;
+
+	if (v != NULL)
+	{
+		v->numero = s->atual->numero + 1;
+		v->referencias = 1;
+		LargarVersao(s->atual);
+		s->atual = v;
+		fprintf(stderr, "grafo recarregado: versao %lu\n", v->numero);
+	}
+	else
+	{
+		fprintf(stderr, "nao foi possivel recarregar o grafo\n");
+	}
+
+	Tarefa* t = s->pedidoRecarga;
+	s->pedidoRecarga = NULL;
+
+	if (t != NULL)
+	{
+		Ligacao* l = t->ligacao;
+		l->pendentes--;
+		s->totalPendentes--;
+
+		if (l->fd >= 0 && ResponderDiretamente(l, &t->pedido, v != NULL ? RESPOSTA_OK : RESPOSTA_ERRO, (int64_t)s->atual->numero, NULL, 0) && EnviarSaida(l))
+		{
+			AtualizarInteresse(s, l, s->escuta >= 0);
+		}
+		else
+		{
+			FecharLigacao(s, l);
+		}
+
+		free(t);
+	}
+}
+
+/**
+ * @brief Trata um pedido completo lido de uma ligação.
+ *
+ * @param s Apontador para o servidor.
+ * @param l Apontador para a ligação.
+ * @param p Apontador para o cabeçalho do pedido.
+ * @param dados Dados do pedido (p->tamanho bytes).
+ * @param novas Fila onde ficam as tarefas para as threads.
+ * @return false se a ligação deve ser fechada.
+ */
+static bool TratarPedido(Servidor* s, Ligacao* l, Pedido* p, const unsigned char* dados, FilaTarefas* novas)
+{
+	switch (p->tipo)
+	{
+	case PEDIDO_DIST:
+	case PEDIDO_REACH:
+	case PEDIDO_PATH:
+	{
+		Tarefa* t = (Tarefa*)calloc(1, sizeof(Tarefa));
+
+		if (t == NULL)
+		{
+			return ResponderDiretamente(l, p, RESPOSTA_ERRO, -1, NULL, 0);
+		}
+
+		t->ligacao = l;
+		t->versao = s->atual;
+		t->pedido = *p;
+		s->atual->referencias++;
+		l->pendentes++;
+		s->totalPendentes++;
+		AcrescentarTarefa(novas, t);
+		return true;
+	}
+
+	case PEDIDO_INFO:
+	{
+		VersaoGrafo* v = s->atual;
+		int valores[2];
+		valores[0] = v->compacta != NULL ? v->compacta->numVertices : v->imagem->numVertices;
+		valores[1] = v->compacta != NULL ? (int)(v->compacta->numArestas > INT_MAX ? INT_MAX : v->compacta->numArestas) : v->imagem->numArestas;
+		return ResponderDiretamente(l, p, RESPOSTA_OK, (int64_t)v->numero, valores, 2);
+	}
+
+	case PEDIDO_RELOAD:
+	{
+		//Os dados têm um ou dois nomes de ficheiros, cada um terminado em '\0'
+		char* ficheiros[2] = { NULL, NULL };
+		int numFicheiros = 0;
+		size_t i = 0;
+
+		while (i < p->tamanho && numFicheiros < 2)
+		{
+			const unsigned char* fim = memchr(dados + i, '\0', p->tamanho - i);
+
+			if (fim == NULL || fim == dados + i)
+			{
+				break;
+			}
+
+			ficheiros[numFicheiros++] = (char*)dados + i;
+			i = fim - dados + 1;
+		}
+
+		if (numFicheiros == 0 || i != p->tamanho)
+		{
+			return ResponderDiretamente(l, p, RESPOSTA_INVALIDO, -1, NULL, 0);
+		}
+
+		Tarefa* t = (Tarefa*)calloc(1, sizeof(Tarefa));
+
+		if (t == NULL)
+		{
+			return ResponderDiretamente(l, p, RESPOSTA_ERRO, -1, NULL, 0);
+		}
+
+		t->ligacao = l;
+		t->pedido = *p;
+
+		if (!IniciarRecarga(s, ficheiros, numFicheiros, t))
+		{
+			free(t);
+			return ResponderDiretamente(l, p, RESPOSTA_OCUPADO, -1, NULL, 0);
+		}
+
+		l->pendentes++;
+		s->totalPendentes++;
+		return true;
+	}
+
+	default:
+		return ResponderDiretamente(l, p, RESPOSTA_INVALIDO, -1, NULL, 0);
+	}
+}
+
+/**
+ * @brief Lê os bytes disponíveis de uma ligação e trata os pedidos completos.
+ *
+ * @param s Apontador para o servidor.
+ * @param l Apontador para a ligação.
+ * @return false se a ligação deve ser fechada.
+ */
+static bool LerLigacao(Servidor* s, Ligacao* l)
+{
+	FilaTarefas novas = { NULL, NULL };
+	bool aberta = true;
+
+	while (l->pendentes < MAX_PENDENTES)
+	{
+		ssize_t n = recv(l->fd, l->entrada + l->tamanhoEntrada, TAMANHO_LEITURA + PEDIDO_TAMANHO + MAX_DADOS_PEDIDO - l->tamanhoEntrada, 0);
+
+		if (n == 0)
+		{
+			aberta = false;
+			break;
+		}
+
+		if (n < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+
+			aberta = errno == EAGAIN || errno == EWOULDBLOCK;
+			break;
+		}
+
+		l->tamanhoEntrada += n;
+
+		//Trata todos os pedidos completos; o resto fica para a leitura seguinte
+		size_t i = 0;
+
+		while (aberta && l->tamanhoEntrada - i >= PEDIDO_TAMANHO)
+		{
+			Pedido p;
+			DescodificarPedido(l->entrada + i, &p);
+
+			if (p.tamanho > MAX_DADOS_PEDIDO)
+			{
+				aberta = false;
+				break;
+			}
+
+			if (l->tamanhoEntrada - i < (size_t)PEDIDO_TAMANHO + p.tamanho)
+			{
+				break;
+			}
+
+			aberta = TratarPedido(s, l, &p, l->entrada + i + PEDIDO_TAMANHO, &novas);
+			i += PEDIDO_TAMANHO + p.tamanho;
+		}
+
+		memmove(l->entrada, l->entrada + i, l->tamanhoEntrada - i);
+		l->tamanhoEntrada -= i;
+
+		if (!aberta || l->tamanhoSaida - l->inicioSaida >= MAX_SAIDA)
+		{
+			break;
+		}
+	}
+
+	//Entrega às threads, de uma vez, as tarefas desta leitura
+	if (novas.inicio != NULL)
+	{
+		mtx_lock(&s->trinco);
+
+		if (s->porResponder.fim == NULL)
+		{
+			s->porResponder.inicio = novas.inicio;
+		}
+		else
+		{
+			s->porResponder.fim->next = novas.inicio;
+		}
+
+		s->porResponder.fim = novas.fim;
+		cnd_broadcast(&s->haTarefas);
+		mtx_unlock(&s->trinco);
+	}
+
+	return aberta && EnviarSaida(l);
+}
+
+/**
+ * @brief Aceita as ligações pendentes no socket de escuta.
+ *
+ * @param s Apontador para o servidor.
+ */
+static void AceitarLigacoes(Servidor* s)
+{
+	while (true)
+	{
+		int fd = accept4(s->escuta, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+		if (fd < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+
+			break;
+		}
+
+		Ligacao* l = (Ligacao*)calloc(1, sizeof(Ligacao));
+		unsigned char* entrada = (unsigned char*)malloc(TAMANHO_LEITURA + PEDIDO_TAMANHO + MAX_DADOS_PEDIDO);
+
+		if (l == NULL || entrada == NULL)
+		{
+			free(l);
+			free(entrada);
+			close(fd);
+			continue;
+		}
+
+		l->fd = fd;
+		l->entrada = entrada;
+		l->interesse = EPOLLIN;
+		l->seguinte = s->ligacoes;
+
+		if (s->ligacoes != NULL)
+		{
+			s->ligacoes->anterior = l;
+		}
+
+		s->ligacoes = l;
+
+		struct epoll_event ev = { .events = EPOLLIN, .data.ptr = l };
+
+		if (epoll_ctl(s->epoll, EPOLL_CTL_ADD, fd, &ev) < 0)
+		{
+			FecharLigacao(s, l);
+		}
+	}
+}
+
+/**
+ * @brief Entrega às ligações as respostas calculadas pelas threads.
+ *
+ * @param s Apontador para o servidor.
+ */
+static void RecolherRespostas(Servidor* s)
+{
+	uint64_t valor;
+
+	while (read(s->aviso, &valor, sizeof(valor)) < 0 && errno == EINTR);
+
+	mtx_lock(&s->trinco);
+	Tarefa* t = s->respondidas.inicio;
+	s->respondidas.inicio = s->respondidas.fim = NULL;
+	bool recarga = s->recargaConcluida;
+	s->recargaConcluida = false;
+	mtx_unlock(&s->trinco);
+
+	//Acrescenta todas as respostas antes de enviar, para juntar as respostas da mesma ligação
+	Ligacao* porEnviar = NULL;
+
+	while (t != NULL)
+	{
+		Ligacao* l = t->ligacao;
+		l->pendentes--;
+		s->totalPendentes--;
+		s->respondidos++;
+
+		if (l->fd >= 0 && (t->resposta == NULL || !AcrescentarSaida(l, t->resposta, t->tamanhoResposta)))
+		{
+			//Sem memória para a resposta o cliente ficaria à espera: a ligação é fechada
+			close(l->fd);
+			l->fd = -1;
+		}
+
+		if (!l->porEnviar)
+		{
+			l->porEnviar = true;
+			l->proximaEnvio = porEnviar;
+			porEnviar = l;
+		}
+
+		Tarefa* seguinte = t->next;
+		LargarVersao(t->versao);
+		free(t->resposta);
+		free(t);
+		t = seguinte;
+	}
+
+	while (porEnviar != NULL)
+	{
+		Ligacao* l = porEnviar;
+		porEnviar = l->proximaEnvio;
+		l->porEnviar = false;
+
+		if (l->fd >= 0 && EnviarSaida(l))
+		{
+			AtualizarInteresse(s, l, s->escuta >= 0);
+		}
+		else
+		{
+			FecharLigacao(s, l);
+		}
+	}
+
+	if (recarga)
+	{
+		ConcluirRecarga(s);
+	}
+}
+
+/**
+ * @brief Mostra a forma de usar o programa.
+ *
+ * @param programa Nome do programa.
+ */
+static void MostrarUtilizacao(const char* programa)
+{
+	fprintf(stderr,
+		"Utilizacao: %s [opcoes] grafo.csv | vertices.bin adjacencias.bin | imagem.gcp\n"
+		"  -u socket   caminho do socket (por omissao /tmp/grafos.sock)\n"
+		"  -t threads  numero de threads (por omissao, uma por processador)\n",
+		programa);
+}
+
+/**
+ * @brief Função principal do servidor.
+ *
+ * @param argc Números de argumentos
+ * @param argv Array de strings (opções e ficheiros do grafo)
+ * @return int 0 se o servidor terminou normalmente, 1 em caso de erro.
+ */
+int main(int argc, char* argv[])
+{
+	Servidor s;
+	memset(&s, 0, sizeof(s));
+	s.caminhoSocket = "/tmp/grafos.sock";
+	s.numThreads = NumeroProcessadores();
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-u") == 0 && i + 1 < argc)
+		{
+			s.caminhoSocket = argv[++i];
+		}
+		else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+		{
+			s.numThreads = atoi(argv[++i]);
+		}
+		else if (argv[i][0] != '-' && s.numFicheiros < 2)
+		{
+			s.ficheiros[s.numFicheiros++] = argv[i];
+		}
+		else
+		{
+			MostrarUtilizacao(argv[0]);
+			return 1;
+		}
+	}
+
+	if (s.numFicheiros == 0 || s.numThreads < 1)
+	{
+		MostrarUtilizacao(argv[0]);
+		return 1;
+	}
+
+	s.atual = CarregarVersao(s.ficheiros, s.numFicheiros);
+
+	if (s.atual == NULL)
+	{
+		fprintf(stderr, "Nao foi possivel carregar o grafo\n");
+		return 1;
+	}
+
+	s.atual->numero = 1;
+	s.atual->referencias = 1;
+
+	//Os sinais são lidos no ciclo de eventos em vez de interromperem as threads
+	sigset_t mascara;
+	sigemptyset(&mascara);
+	sigaddset(&mascara, SIGINT);
+	sigaddset(&mascara, SIGTERM);
+	sigaddset(&mascara, SIGHUP);
+	pthread_sigmask(SIG_BLOCK, &mascara, NULL);
+	signal(SIGPIPE, SIG_IGN);
+
+	struct sockaddr_un endereco;
+	memset(&endereco, 0, sizeof(endereco));
+	endereco.sun_family = AF_UNIX;
+
+	if (strlen(s.caminhoSocket) >= sizeof(endereco.sun_path))
+	{
+		fprintf(stderr, "Caminho do socket demasiado longo\n");
+		return 1;
+	}
+
+	strcpy(endereco.sun_path, s.caminhoSocket);
+	unlink(s.caminhoSocket);
+
+	s.escuta = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	s.aviso = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	s.sinais = signalfd(-1, &mascara, SFD_NONBLOCK | SFD_CLOEXEC);
+	s.epoll = epoll_create1(EPOLL_CLOEXEC);
+
+	if (s.escuta < 0 || s.aviso < 0 || s.sinais < 0 || s.epoll < 0 ||
+		bind(s.escuta, (struct sockaddr*)&endereco, sizeof(endereco)) < 0 || listen(s.escuta, 128) < 0)
+	{
+		perror("servidor");
+		return 1;
+	}
+
+	struct epoll_event ev = { .events = EPOLLIN };
+	ev.data.ptr = &s.escuta;
+	epoll_ctl(s.epoll, EPOLL_CTL_ADD, s.escuta, &ev);
+	ev.data.ptr = &s.aviso;
+	epoll_ctl(s.epoll, EPOLL_CTL_ADD, s.aviso, &ev);
+	ev.data.ptr = &s.sinais;
+	epoll_ctl(s.epoll, EPOLL_CTL_ADD, s.sinais, &ev);
+
+	mtx_init(&s.trinco, mtx_plain);
+	cnd_init(&s.haTarefas);
+	s.threads = (thrd_t*)malloc(sizeof(thrd_t) * s.numThreads);
+
+	for (int i = 0; i < s.numThreads; i++)
+	{
+		if (s.threads == NULL || thrd_create(&s.threads[i], ExecutarTrabalhador, &s) != thrd_success)
+		{
+			fprintf(stderr, "Nao foi possivel criar as threads\n");
+			return 1;
+		}
+	}
+
+	fprintf(stderr, "a servir %s com %d threads\n", s.caminhoSocket, s.numThreads);
+
+	//Ciclo de eventos; depois de SIGINT ou SIGTERM só espera pelos pedidos já recebidos
+	struct epoll_event eventos[64];
+
+	while (s.escuta >= 0 || s.totalPendentes > 0)
+	{
+		int n = epoll_wait(s.epoll, eventos, 64, -1);
+
+		if (n < 0 && errno != EINTR)
+		{
+			perror("epoll_wait");
+			break;
+		}
+
+		for (int i = 0; i < n; i++)
+		{
+			void* origem = eventos[i].data.ptr;
+
+			if (origem == &s.escuta)
+			{
+				AceitarLigacoes(&s);
+			}
+			else if (origem == &s.aviso)
+			{
+				RecolherRespostas(&s);
+			}
+			else if (origem == &s.sinais)
+			{
+				struct signalfd_siginfo info;
+
+				while (read(s.sinais, &info, sizeof(info)) == sizeof(info))
+				{
+					if (info.ssi_signo == SIGHUP)
+					{
+						IniciarRecarga(&s, s.ficheiros, s.numFicheiros, NULL);
+					}
+					else if (s.escuta >= 0)
+					{
+						//Deixa de aceitar ligações e de ler pedidos novos
+						close(s.escuta);
+						s.escuta = -1;
+						unlink(s.caminhoSocket);
+
+						for (Ligacao* l = s.ligacoes; l != NULL; l = l->seguinte)
+						{
+							if (l->fd >= 0)
+							{
+								AtualizarInteresse(&s, l, false);
+							}
+						}
+					}
+				}
+			}
+			else
+			{
+				Ligacao* l = (Ligacao*)origem;
+
+				//A ligação pode ter sido fechada por um evento anterior do mesmo epoll_wait
+				if (l->fd < 0)
+				{
+					continue;
+				}
+
+				bool aberta = true;
+
+				if (s.escuta >= 0 && (eventos[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)))
+				{
+					aberta = LerLigacao(&s, l);
+				}
+				else if (eventos[i].events & (EPOLLHUP | EPOLLERR))
+				{
+					aberta = false;
+				}
+				else if (eventos[i].events & EPOLLOUT)
+				{
+					aberta = EnviarSaida(l);
+				}
+
+				if (aberta)
+				{
+					AtualizarInteresse(&s, l, s.escuta >= 0);
+				}
+				else
+				{
+					FecharLigacao(&s, l);
+				}
+			}
+		}
+
+		LibertarLigacoes(&s);
+	}
+
+	//Tenta enviar o que falta às ligações abertas
+	while (s.ligacoes != NULL)
+	{
+		Ligacao* l = s.ligacoes;
+
+		if (l->fd >= 0)
+		{
+			EnviarSaida(l);
+		}
+
+		FecharLigacao(&s, l);
+	}
+
+	LibertarLigacoes(&s);
+
+	//Termina as threads
+	mtx_lock(&s.trinco);
+	s.terminar = true;
+	cnd_broadcast(&s.haTarefas);
+	mtx_unlock(&s.trinco);
+
+	for (int i = 0; i < s.numThreads; i++)
+	{
+		thrd_join(s.threads[i], NULL);
+	}
+
+	//Um recarregamento pedido com SIGHUP pode ainda estar em curso
+	if (s.aRecarregar)
+	{
+		thrd_join(s.carregador, NULL);
+
+		if (s.novaVersao != NULL)
+		{
+			s.novaVersao->referencias = 1;
+			LargarVersao(s.novaVersao);
+		}
+	}
+
+	fprintf(stderr, "servidor terminado: %lu pedidos respondidos\n", s.respondidos);
+
+	LargarVersao(s.atual);
+	free(s.novosFicheiros[0]);
+	free(s.novosFicheiros[1]);
+	free(s.threads);
+	mtx_destroy(&s.trinco);
+	cnd_destroy(&s.haTarefas);
+	close(s.aviso);
+	close(s.sinais);
+	close(s.epoll);
+	return 0;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file cache.c
+ * @author Hugo Cruz (a23010)
+ * @brief Teste da invalidação da cache de caminhos pela versão do grafo.
+ *
+ * Uma segunda pesquisa da mesma origem tem de ser resolvida pela cache. Depois de cada
+ * alteração do grafo a versão muda e a árvore guardada deixa de servir: a pesquisa seguinte é
+ * uma falha e devolve as distâncias do grafo alterado.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../Grafos/InputOutput.h"
+#include "../Grafos/caminhos.h"
+#include "../Grafos/lote.h"
+#include "testes.h"
+
+/**
+ * @brief Obtém a distância entre dois vértices pela árvore da origem e verifica a versão da árvore.
+ *
+ * @param g Apontador para o grafo.
+ * @param origem Vértice de origem.
+ * @param destino Vértice de destino.
+ * @return Distancia Distância da árvore (DISTANCIA_INFINITA se a árvore não existir).
+ */
+static Distancia DistanciaArvore(Grafo* g, int origem, int destino)
+{
+	ArvoreCaminhos* a = ObterArvoreCaminhos(g, origem);
+	VERIFICAR(a != NULL);
+
+	if (a == NULL)
+	{
+		return DISTANCIA_INFINITA;
+	}
+
+	VERIFICAR(a->versao == g->versao);
+	Distancia d = destino < a->tamanho ? a->distancias[destino] : DISTANCIA_INFINITA;
+	LibertarArvoreCaminhos(a);
+	return d;
+}
+
+int main(void)
+{
+	bool inf;
+	Grafo* g = CriarGrafo(&inf);
+
+	for (int i = 0; i < 4; i++)
+	{
+		g = InserirVerticeGrafo(g, i, &inf);
+	}
+
+	g = InserirAdjGrafo(g, 0, 1, 5, &inf);
+	g = InserirAdjGrafo(g, 1, 2, 5, &inf);
+	g = InserirAdjGrafo(g, 2, 3, 5, &inf);
+
+	VERIFICAR(DistanciaArvore(g, 0, 3) == 15);
+	VERIFICAR(DistanciaArvore(g, 0, 3) == 15);
+
+	EstatisticasCache s = ObterEstatisticasCacheGrafo(g);
+	VERIFICAR(s.falhas == 1 && s.acertos == 1 && s.entradas == 1);
+
+	//Um atalho novo muda a versão e a distância
+	unsigned long versao = g->versao;
+	g = InserirAdjGrafo(g, 0, 3, 4, &inf);
+	VERIFICAR(inf && g->versao != versao);
+	VERIFICAR(DistanciaArvore(g, 0, 3) == 4);
+
+	s = ObterEstatisticasCacheGrafo(g);
+	VERIFICAR(s.falhas == 2 && s.acertos == 1);
+
+	//Eliminar o atalho volta à distância anterior
+	versao = g->versao;
+	g = EliminaAdjGrafo(g, 0, 3, &inf);
+	VERIFICAR(inf && g->versao != versao);
+	VERIFICAR(DistanciaArvore(g, 0, 3) == 15);
+
+	//Eliminar um vértice do caminho deixa o destino inalcançável
+	g = EliminaVerticeGrafo(g, 2, &inf);
+	VERIFICAR(inf);
+	VERIFICAR(DistanciaArvore(g, 0, 3) == DISTANCIA_INFINITA);
+
+	//Um lote aplicado conta como uma única alteração
+	LoteAlteracoes* l = CriarLoteAlteracoes(4, &inf);
+	l = InserirVerticeLote(l, 2, &inf);
+	l = InserirAdjLote(l, 1, 2, 1, &inf);
+	l = InserirAdjLote(l, 2, 3, 1, &inf);
+	versao = g->versao;
+	g = AplicarLoteGrafo(g, l, &inf);
+	VERIFICAR(inf && g->versao != versao);
+	ApagarLoteAlteracoes(l);
+	VERIFICAR(DistanciaArvore(g, 0, 3) == 7);
+
+	s = ObterEstatisticasCacheGrafo(g);
+	VERIFICAR(s.falhas == 5 && s.acertos == 1);
+
+	//Uma pesquisa que falha não altera a versão nem invalida a cache
+	versao = g->versao;
+	g = EliminaAdjGrafo(g, 3, 0, &inf);
+	VERIFICAR(!inf && g->versao == versao);
+	VERIFICAR(DistanciaArvore(g, 0, 3) == 7);
+
+	s = ObterEstatisticasCacheGrafo(g);
+	VERIFICAR(s.falhas == 5 && s.acertos == 2);
+
+	//Sem orçamento a cache fica vazia e as pesquisas não são guardadas
+	g = ConfigurarCacheGrafo(g, 0, &inf);
+	VERIFICAR(inf);
+	VERIFICAR(DistanciaArvore(g, 0, 3) == 7);
+	s = ObterEstatisticasCacheGrafo(g);
+	VERIFICAR(s.entradas == 0 && s.ocupado == 0);
+
+	ApagaGrafo(g);
+	return RESULTADO_TESTE;
+}
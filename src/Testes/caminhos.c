@@ -0,0 +1,540 @@
+/**
+ * @file caminhos.c
+ * @author Hugo Cruz (a23010)
+ * @brief Teste das distâncias calculadas por Dijkstra, Bellman-Ford e Yen.
+ *
+ * Os grafos são pequenos e as distâncias esperadas foram calculadas à mão. Cada algoritmo é
+ * comparado com esses valores e com os outros algoritmos: Dijkstra sobre a lista, a imagem e a
+ * imagem comprimida, Bellman-Ford nos dois modos, e o algoritmo de Yen com e sem pesos negativos.
+ * Num grafo aleatório sem ciclos, com pesos negativos, as pesquisas nas imagens com os potenciais
+ * de Johnson têm de dar as distâncias de Bellman-Ford; as pesquisas de várias origens em paralelo
+ * e a centralidade de proximidade também usam os potenciais. A alcançabilidade não depende dos
+ * pesos, mesmo com um ciclo negativo, e EscreverCaminhos distingue a falta de caminho do ciclo.
+ * CriarGrafoCaminhoMaisCurto recusa distâncias que não podem ser guardadas como pesos.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../Grafos/InputOutput.h"
+#include "../Grafos/caminhos.h"
+#include "../Grafos/bellmanford.h"
+#include "../Grafos/kcaminhos.h"
+#include "../Grafos/imagem.h"
+#include "../Grafos/compacto.h"
+#include "../Grafos/centralidade.h"
+#include "testes.h"
+
+#define NUM_VERTICES 6
+#define NUM_ALEATORIOS 200
+
+/**
+ * @brief Cria um grafo com os vértices 0 a n - 1 e as adjacências indicadas.
+ *
+ * @param n Número de vértices.
+ * @param arestas Origem, destino e peso de cada adjacência.
+ * @param numArestas Número de adjacências.
+ * @return Grafo* Apontador para o grafo criado.
+ */
+static Grafo* CriarGrafoTeste(int n, int arestas[][3], int numArestas)
+{
+	bool inf;
+	Grafo* g = CriarGrafo(&inf);
+
+	for (int i = 0; i < n; i++)
+	{
+		g = InserirVerticeGrafo(g, i, &inf);
+		VERIFICAR(inf);
+	}
+
+	for (int i = 0; i < numArestas; i++)
+	{
+		g = InserirAdjGrafo(g, arestas[i][0], arestas[i][1], arestas[i][2], &inf);
+		VERIFICAR(inf);
+	}
+
+	return g;
+}
+
+/**
+ * @brief Verifica Dijkstra sobre a lista, a imagem e a imagem comprimida num grafo sem pesos negativos.
+ */
+static void TestarDijkstra(void)
+{
+	int arestas[][3] = {
+		{0, 1, 7}, {0, 2, 9}, {0, 5, 14}, {1, 2, 10}, {1, 3, 15},
+		{2, 3, 11}, {2, 5, 2}, {3, 4, 6}, {5, 4, 9}
+	};
+	Distancia esperadas[NUM_VERTICES] = {0, 7, 9, 20, 20, 11};
+	Grafo* g = CriarGrafoTeste(NUM_VERTICES, arestas, sizeof(arestas) / sizeof(arestas[0]));
+	bool inf, ciclo;
+
+	Distancia distancias[NUM_VERTICES];
+	int ant[NUM_VERTICES];
+	VERIFICAR(TamanhoArraysCaminhos(g) == NUM_VERTICES);
+	Dijkstra(g, 0, distancias, ant);
+
+	for (int i = 0; i < NUM_VERTICES; i++)
+	{
+		VERIFICAR(distancias[i] == esperadas[i]);
+		VERIFICAR(DistanciaMinimaEntreVertices(g, 0, i, &ciclo) == esperadas[i] && !ciclo);
+	}
+
+	//O caminho mais curto até 4 passa por 2 e 5
+	VERIFICAR(ant[4] == 5 && ant[5] == 2 && ant[2] == 0);
+
+	//Sem ligações a sair de 4 nenhum outro vértice é alcançável
+	VERIFICAR(DistanciaMinimaEntreVertices(g, 4, 0, &ciclo) == DISTANCIA_INFINITA && !ciclo);
+
+	ImagemGrafo* im = CriarImagemGrafo(g, &inf);
+	VERIFICAR(inf);
+	EspacoCaminhos* e = CriarEspacoImagem(im, &inf);
+	VERIFICAR(inf);
+
+	ImagemCompacta* ic = ComprimirImagemGrafo(im, &inf);
+	VERIFICAR(inf);
+	EspacoCaminhos* ec = CriarEspacoCompacta(ic, &inf);
+	VERIFICAR(inf);
+
+	for (int i = 0; i < NUM_VERTICES; i++)
+	{
+		VERIFICAR(DijkstraImagem(im, e, 0, i) == esperadas[i]);
+		VERIFICAR(DijkstraCompacta(ic, ec, 0, i) == esperadas[i]);
+	}
+
+	ApagarEspacoCaminhos(ec);
+	ApagarImagemCompacta(ic);
+	ApagarEspacoCaminhos(e);
+	ApagarImagemGrafo(im);
+	ApagaGrafo(g);
+}
+
+/**
+ * @brief Verifica Bellman-Ford nos dois modos com pesos negativos e com um ciclo negativo.
+ */
+static void TestarBellmanFord(void)
+{
+	int arestas[][3] = {
+		{0, 1, 4}, {0, 2, 5}, {1, 3, -2}, {2, 1, -3}, {3, 4, 2}, {2, 4, 4}
+	};
+	Distancia esperadas[5] = {0, 2, 5, 0, 2};
+	Grafo* g = CriarGrafoTeste(5, arestas, sizeof(arestas) / sizeof(arestas[0]));
+	ModoBellmanFord modos[] = {BELLMAN_FORD_FILA, BELLMAN_FORD_ARESTAS};
+	bool ciclo;
+
+	VERIFICAR(ExistemPesosNegativos(g));
+
+	for (int m = 0; m < 2; m++)
+	{
+		Distancia distancias[5];
+		int ant[5];
+
+		VERIFICAR(BellmanFord(g, 0, distancias, ant, modos[m], &ciclo) && !ciclo);
+
+		for (int i = 0; i < 5; i++)
+		{
+			VERIFICAR(distancias[i] == esperadas[i]);
+		}
+
+		VERIFICAR(ant[3] == 1 && ant[1] == 2 && ant[2] == 0);
+	}
+
+	for (int i = 0; i < 5; i++)
+	{
+		VERIFICAR(DistanciaMinimaEntreVertices(g, 0, i, &ciclo) == esperadas[i] && !ciclo);
+	}
+
+	//Com 3 -> 2 (-4) o ciclo 2 -> 1 -> 3 -> 2 custa -9
+	bool inf;
+	g = InserirAdjGrafo(g, 3, 2, -4, &inf);
+	VERIFICAR(inf);
+
+	for (int m = 0; m < 2; m++)
+	{
+		Distancia distancias[5];
+		int ant[5];
+
+		BellmanFord(g, 0, distancias, ant, modos[m], &ciclo);
+		VERIFICAR(ciclo);
+	}
+
+	VERIFICAR(DistanciaMinimaEntreVertices(g, 0, 4, &ciclo) == DISTANCIA_INFINITA && ciclo);
+
+	//O ciclo não é alcançável a partir de 4
+	VERIFICAR(DistanciaMinimaEntreVertices(g, 4, 4, &ciclo) == 0 && !ciclo);
+
+	ApagaGrafo(g);
+}
+
+/**
+ * @brief Verifica que um espaço de trabalho usado em dois grafos com a mesma versão pesquisa cada um.
+ */
+static void TestarEspacoDoisGrafos(void)
+{
+	int arestas1[][3] = { {0, 1, 1} };
+	int arestas2[][3] = { {0, 1, 7} };
+	Grafo* g1 = CriarGrafoTeste(2, arestas1, 1);
+	Grafo* g2 = CriarGrafoTeste(2, arestas2, 1);
+	bool inf;
+
+	VERIFICAR(g1->versao == g2->versao);
+
+	EspacoCaminhos* e = CriarEspacoCaminhos(g1, &inf);
+	VERIFICAR(inf);
+	VERIFICAR(DijkstraRestrito(g1, e, 0, 1, NULL, 0) == 1);
+	VERIFICAR(DijkstraRestrito(g2, e, 0, 1, NULL, 0) == 7);
+	VERIFICAR(DijkstraRestrito(g1, e, 0, 1, NULL, 0) == 1);
+
+	ApagarEspacoCaminhos(e);
+	ApagaGrafo(g1);
+	ApagaGrafo(g2);
+}
+
+/**
+ * @brief Verifica ExisteCaminhoGrafo com um ciclo negativo e depois de alterações ao grafo.
+ */
+static void TestarAlcance(void)
+{
+	//O ciclo 1 -> 2 -> 1 custa -4, mas o vértice 3 continua alcançável a partir de 0
+	int arestas[][3] = {
+		{0, 1, 1}, {1, 2, -5}, {2, 1, 1}, {2, 3, 1}
+	};
+	Grafo* g = CriarGrafoTeste(5, arestas, sizeof(arestas) / sizeof(arestas[0]));
+	bool inf;
+
+	VERIFICAR(ExisteCaminhoGrafo(g, 0, 3));
+	VERIFICAR(ExisteCaminhoGrafo(g, 2, 1));
+	VERIFICAR(!ExisteCaminhoGrafo(g, 3, 0));
+	VERIFICAR(!ExisteCaminhoGrafo(g, 0, 4));
+	VERIFICAR(!ExisteCaminhoGrafo(g, 0, 0));
+	VERIFICAR(ContabilizarMemoriaGrafo(g).caches > 0);
+
+	//A imagem guardada é descartada quando o grafo muda
+	g = InserirAdjGrafo(g, 3, 4, 2, &inf);
+	VERIFICAR(inf && ExisteCaminhoGrafo(g, 0, 4));
+	g = EliminaAdjGrafo(g, 2, 3, &inf);
+	VERIFICAR(inf && !ExisteCaminhoGrafo(g, 0, 4));
+
+	ApagaGrafo(g);
+}
+
+/**
+ * @brief Devolve o peso da adjacência de origem para destino.
+ *
+ * @param g Apontador para o grafo.
+ * @param origem Vértice de origem.
+ * @param destino Vértice de destino.
+ * @return int Peso da adjacência (-1 se não existir).
+ */
+static int PesoAdjacencia(Grafo* g, int origem, int destino)
+{
+	for (Vertice* v = g->inicioGrafo; v != NULL; v = v->nextV)
+	{
+		for (Adjacente* a = v->id == origem ? v->nextA : NULL; a != NULL; a = a->next)
+		{
+			if (a->id == destino)
+			{
+				return a->peso;
+			}
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Verifica CriarGrafoCaminhoMaisCurto com pesos negativos e com distâncias que não podem ser pesos.
+ */
+static void TestarGrafoCaminhoMaisCurto(void)
+{
+	int arestas[][3] = { {0, 1, 5}, {1, 2, -3} };
+	Grafo* g = CriarGrafoTeste(3, arestas, 2);
+	Grafo* apsp = CriarGrafoCaminhoMaisCurto(g);
+	VERIFICAR(apsp != NULL);
+
+	if (apsp != NULL)
+	{
+		VERIFICAR(PesoAdjacencia(apsp, 0, 1) == 5 && PesoAdjacencia(apsp, 0, 2) == 2 && PesoAdjacencia(apsp, 1, 2) == -3);
+		VERIFICAR(PesoAdjacencia(apsp, 2, 0) == 0);
+		ApagaGrafo(apsp);
+	}
+
+	ApagaGrafo(g);
+
+	//A distância 0 de 0 a 2 confundir-se-ia com a falta de caminho
+	int zero[][3] = { {0, 1, 3}, {1, 2, -3} };
+	g = CriarGrafoTeste(3, zero, 2);
+	VERIFICAR(CriarGrafoCaminhoMaisCurto(g) == NULL);
+	ApagaGrafo(g);
+
+	//60000 só cabe num peso de 32 bits
+	int longe[][3] = { {0, 1, 30000}, {1, 2, 30000} };
+	g = CriarGrafoTeste(3, longe, 2);
+	apsp = CriarGrafoCaminhoMaisCurto(g);
+	VERIFICAR((apsp != NULL) == PESO_VALIDO(60000));
+	VERIFICAR(apsp == NULL || PesoAdjacencia(apsp, 0, 2) == 60000);
+	ApagaGrafo(apsp);
+	ApagaGrafo(g);
+}
+
+/**
+ * @brief Verifica que EscreverCaminhos distingue a falta de caminho de um ciclo negativo.
+ */
+static void TestarEscreverCaminhos(void)
+{
+	int arestas[][3] = { {0, 1, 5}, {1, 2, -3} };
+	int origens[] = { 0, 0, 2 };
+	int destinos[] = { 2, 3, 1 };
+	Grafo* g = CriarGrafoTeste(4, arestas, 2);
+	char texto[128];
+	bool inf;
+
+	VERIFICAR(EscreverCaminhos(g, origens, destinos, 3, "teste_caminhos.txt"));
+	FILE* fp = fopen("teste_caminhos.txt", "r");
+	size_t lidos = fp != NULL ? fread(texto, 1, sizeof(texto) - 1, fp) : 0;
+	texto[lidos] = '\0';
+	VERIFICAR(strcmp(texto, "0;2;2;0 1 2\n0;3;inf;\n2;1;inf;\n") == 0);
+
+	if (fp != NULL)
+	{
+		fclose(fp);
+	}
+
+	//Com o ciclo negativo 1 -> 2 -> 1 a origem 0 não tem caminhos mais curtos; 3 continua sem caminho
+	g = InserirAdjGrafo(g, 2, 1, 1, &inf);
+	VERIFICAR(inf);
+	origens[2] = 3;
+	VERIFICAR(EscreverCaminhos(g, origens, destinos, 3, "teste_caminhos.txt"));
+	fp = fopen("teste_caminhos.txt", "r");
+	lidos = fp != NULL ? fread(texto, 1, sizeof(texto) - 1, fp) : 0;
+	texto[lidos] = '\0';
+	VERIFICAR(strcmp(texto, "0;2;ciclo;\n0;3;ciclo;\n3;1;inf;\n") == 0);
+
+	if (fp != NULL)
+	{
+		fclose(fp);
+	}
+
+	remove("teste_caminhos.txt");
+	ApagaGrafo(g);
+}
+
+/**
+ * @brief Verifica os custos e os vértices de um caminho de um conjunto.
+ *
+ * @param c Apontador para o conjunto.
+ * @param i Índice do caminho.
+ * @param custo Custo esperado.
+ * @param vertices Vértices esperados.
+ * @param n Número de vértices esperados.
+ */
+static void VerificarCaminho(ConjuntoCaminhos* c, int i, Distancia custo, int vertices[], int n)
+{
+	VERIFICAR(c->custos[i] == custo);
+	VERIFICAR(c->inicio[i + 1] - c->inicio[i] == n);
+
+	for (int j = 0; j < n && j < c->inicio[i + 1] - c->inicio[i]; j++)
+	{
+		VERIFICAR(c->vertices[c->inicio[i] + j] == vertices[j]);
+	}
+}
+
+/**
+ * @brief Verifica o algoritmo de Yen com pesos positivos, com pesos negativos e com um ciclo negativo.
+ */
+static void TestarYen(void)
+{
+	int arestas[][3] = {
+		{0, 1, 3}, {0, 2, 2}, {1, 3, 4}, {2, 1, 1}, {2, 3, 2}, {2, 4, 3},
+		{3, 4, 2}, {3, 5, 1}, {4, 5, 2}
+	};
+	Grafo* g = CriarGrafoTeste(NUM_VERTICES, arestas, sizeof(arestas) / sizeof(arestas[0]));
+	bool inf;
+
+	ConjuntoCaminhos* c = KCaminhosMaisCurtos(g, 0, 5, 3, &inf);
+	VERIFICAR(inf && c != NULL);
+
+	if (c != NULL)
+	{
+		int p0[] = {0, 2, 3, 5};
+		int p1[] = {0, 2, 4, 5};
+		VERIFICAR(c->total == 3);
+		VerificarCaminho(c, 0, 5, p0, 4);
+		VerificarCaminho(c, 1, 7, p1, 4);
+		VERIFICAR(c->custos[2] == 8);
+		ApagarConjuntoCaminhos(c);
+	}
+
+	//Sem caminho o conjunto fica vazio
+	c = KCaminhosMaisCurtos(g, 5, 0, 3, &inf);
+	VERIFICAR(inf && c != NULL && c->total == 0);
+	ApagarConjuntoCaminhos(c);
+	ApagaGrafo(g);
+
+	//Os dois caminhos custam 2, um deles com um peso negativo
+	int negativas[][3] = {{0, 1, 5}, {1, 3, -3}, {0, 2, 1}, {2, 3, 1}};
+	g = CriarGrafoTeste(4, negativas, sizeof(negativas) / sizeof(negativas[0]));
+
+	c = KCaminhosMaisCurtos(g, 0, 3, 2, &inf);
+	VERIFICAR(inf && c != NULL);
+
+	if (c != NULL)
+	{
+		VERIFICAR(c->total == 2);
+		VERIFICAR(c->total < 1 || c->custos[0] == 2);
+		VERIFICAR(c->total < 2 || c->custos[1] == 2);
+		ApagarConjuntoCaminhos(c);
+	}
+
+	//Com um ciclo negativo não há caminhos mais curtos
+	g = InserirAdjGrafo(g, 3, 1, 1, &inf);
+	VERIFICAR(inf);
+	c = KCaminhosMaisCurtos(g, 0, 3, 2, &inf);
+	VERIFICAR(!inf && c == NULL);
+	ApagaGrafo(g);
+}
+
+/**
+ * @brief Verifica as pesquisas nas imagens com potenciais de Johnson contra Bellman-Ford.
+ */
+static void TestarJohnsonImagens(void)
+{
+	bool inf, ciclo;
+	Grafo* g = CriarGrafo(&inf);
+	unsigned s = 777;
+
+	for (int i = 0; i < NUM_ALEATORIOS; i++)
+	{
+		g = InserirVerticeGrafo(g, i, &inf);
+	}
+
+	//Só ligações de ids menores para maiores, pelo que não há ciclos
+	for (int i = 0; i < NUM_ALEATORIOS * 6; i++)
+	{
+		s = s * 1103515245u + 12345u;
+		int a = (int)((s >> 8) % NUM_ALEATORIOS);
+		s = s * 1103515245u + 12345u;
+		int b = (int)((s >> 8) % NUM_ALEATORIOS);
+		int peso = (int)((s >> 20) % 70) - 20;
+
+		if (a != b && peso != 0)
+		{
+			g = InserirAdjGrafo(g, a < b ? a : b, a < b ? b : a, peso, &inf);
+		}
+	}
+
+	ImagemGrafo* im = CriarImagemGrafo(g, &inf);
+	ImagemCompacta* ic = ComprimirImagemGrafo(im, &inf);
+	EspacoCaminhos* e = CriarEspacoImagem(im, &inf);
+	EspacoCaminhos* outro = CriarEspacoImagem(im, &inf);
+	EspacoCaminhos* ec = CriarEspacoCompacta(ic, &inf);
+
+	VERIFICAR(JohnsonImagem(im, e, &ciclo) && !ciclo && e->potencial != NULL);
+	VERIFICAR(CopiarPotenciaisEspaco(outro, e) && outro->potencial != NULL);
+	VERIFICAR(!CopiarPotenciaisEspaco(ec, e));
+	VERIFICAR(JohnsonCompacta(ic, ec, &ciclo) && !ciclo && ec->potencial != NULL);
+
+	Distancia distancias[NUM_ALEATORIOS];
+	int ant[NUM_ALEATORIOS];
+
+	for (int origem = 0; origem < NUM_ALEATORIOS; origem += 7)
+	{
+		VERIFICAR(BellmanFord(g, origem, distancias, ant, BELLMAN_FORD_FILA, &ciclo));
+
+		for (int destino = 0; destino < NUM_ALEATORIOS; destino++)
+		{
+			VERIFICAR(DijkstraImagem(im, outro, origem, destino) == distancias[destino]);
+			VERIFICAR(DijkstraCompacta(ic, ec, origem, destino) == distancias[destino]);
+		}
+
+		//Os potenciais continuam no espaço entre pesquisas da mesma imagem
+		VERIFICAR(outro->potencial != NULL && ec->potencial != NULL);
+	}
+
+	ApagarEspacoCaminhos(ec);
+	ApagarEspacoCaminhos(outro);
+	ApagarEspacoCaminhos(e);
+	ApagarImagemCompacta(ic);
+	ApagarImagemGrafo(im);
+
+	//Com o ciclo negativo 0 -> 1 -> 0 a imagem é recusada; o peso cabe em PESO_MINIMO mesmo com GRAFOS_PESO_16
+	g = InserirAdjGrafo(g, 0, 1, 1, &inf);
+	VERIFICAR(inf);
+	g = InserirAdjGrafo(g, 1, 0, -30000, &inf);
+	VERIFICAR(inf);
+	im = CriarImagemGrafo(g, &inf);
+	e = CriarEspacoImagem(im, &inf);
+	VERIFICAR(!JohnsonImagem(im, e, &ciclo) && ciclo && e->potencial == NULL);
+
+	ApagarEspacoCaminhos(e);
+	ApagarImagemGrafo(im);
+	ApagaGrafo(g);
+}
+
+/**
+ * @brief Verifica DistanciasVariasOrigens e CentralidadeProximidade com pesos negativos, repartidas por um executor.
+ */
+static void TestarVariasOrigens(void)
+{
+	int arestas[][3] = { {0, 1, 5}, {1, 2, -3} };
+	Distancia esperadas[3][3] = {
+		{0, 5, 2},
+		{DISTANCIA_INFINITA, 0, -3},
+		{DISTANCIA_INFINITA, DISTANCIA_INFINITA, 0}
+	};
+	Grafo* g = CriarGrafoTeste(3, arestas, 2);
+	bool inf;
+	ExecutorParalelo* ex = CriarExecutorParalelo(3, &inf);
+	ImagemGrafo* im = CriarImagemGrafo(g, &inf);
+	Distancia distancias[3 * 3];
+
+	VERIFICAR(DistanciasVariasOrigens(im, ex, NULL, 3, distancias));
+
+	for (int i = 0; i < 3; i++)
+	{
+		for (int j = 0; j < 3; j++)
+		{
+			VERIFICAR(distancias[i * 3 + j] == esperadas[i][j]);
+		}
+	}
+
+	//0 alcança os outros dois a uma distância total de 7; a soma de 1 é -3, sem proximidade definida
+	double proximidade[3];
+	VERIFICAR(CentralidadeProximidade(im, ex, NULL, 3, proximidade));
+	VERIFICAR(fabs(proximidade[0] - 2.0 / 7.0) < 1e-12);
+	VERIFICAR(isnan(proximidade[1]));
+	VERIFICAR(proximidade[2] == 0);
+
+	//Com o ciclo negativo 1 -> 2 -> 1 nenhuma distância é calculada
+	ApagarImagemGrafo(im);
+	g = InserirAdjGrafo(g, 2, 1, 1, &inf);
+	VERIFICAR(inf);
+	im = CriarImagemGrafo(g, &inf);
+	VERIFICAR(!DistanciasVariasOrigens(im, ex, NULL, 3, distancias));
+	VERIFICAR(!CentralidadeProximidade(im, ex, NULL, 3, proximidade));
+
+	ApagarImagemGrafo(im);
+	ApagarExecutorParalelo(ex);
+	ApagaGrafo(g);
+}
+
+int main(void)
+{
+	TestarDijkstra();
+	TestarBellmanFord();
+	TestarAlcance();
+	TestarEscreverCaminhos();
+	TestarGrafoCaminhoMaisCurto();
+	TestarEspacoDoisGrafos();
+	TestarYen();
+	TestarJohnsonImagens();
+	TestarVariasOrigens();
+
+	return RESULTADO_TESTE;
+}
@@ -0,0 +1,217 @@
+/**
+ * @file compacto.c
+ * @author Hugo Cruz (a23010)
+ * @brief Teste da ida e volta de uma imagem comprimida por um ficheiro.
+ *
+ * Um grafo aleatório, com pesos negativos e ids eliminados, é comprimido, guardado e carregado.
+ * A imagem carregada tem de ser igual byte a byte à original e as adjacências descodificadas
+ * têm de ser as do grafo. Um ficheiro cortado e um ficheiro com um destino que não existe têm
+ * de ser recusados.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "../Grafos/InputOutput.h"
+#include "../Grafos/compacto.h"
+#include "../Grafos/imagem.h"
+#include "testes.h"
+
+#define NUM_VERTICES 300
+#define NUM_ARESTAS 3000
+#define FICHEIRO "teste_compacto.bin"
+
+/**
+ * @brief Verifica que duas imagens comprimidas são iguais.
+ *
+ * @param a Apontador para a primeira imagem.
+ * @param b Apontador para a segunda imagem.
+ */
+static void VerificarIguais(ImagemCompacta* a, ImagemCompacta* b)
+{
+	VERIFICAR(a->tamanho == b->tamanho && a->numVertices == b->numVertices && a->numArestas == b->numArestas);
+
+	if (a->tamanho != b->tamanho)
+	{
+		return;
+	}
+
+	VERIFICAR(memcmp(a->existe, b->existe, a->tamanho * sizeof(bool)) == 0);
+	VERIFICAR(memcmp(a->inicio, b->inicio, (a->tamanho + 1) * sizeof(long long)) == 0);
+	VERIFICAR(a->inicio[a->tamanho] == b->inicio[b->tamanho] &&
+		memcmp(a->dados, b->dados, (size_t)a->inicio[a->tamanho]) == 0);
+}
+
+/**
+ * @brief Verifica que as adjacências descodificadas de uma imagem comprimida são as de uma imagem.
+ *
+ * Para cada vértice são comparados o número de adjacências e, para cada destino, a soma dos pesos.
+ *
+ * @param im Apontador para a imagem descomprimida.
+ * @param c Apontador para a imagem comprimida.
+ */
+static void VerificarAdjacencias(ImagemGrafo* im, ImagemCompacta* c)
+{
+	long long soma[NUM_VERTICES];
+
+	for (int u = 0; u < im->tamanho; u++)
+	{
+		VERIFICAR(im->existe[u] == c->existe[u]);
+
+		if (!im->existe[u])
+		{
+			VERIFICAR(c->inicio[u] == c->inicio[u + 1]);
+			continue;
+		}
+
+		memset(soma, 0, sizeof(soma));
+
+		for (int i = im->inicio[u]; i < im->inicio[u + 1]; i++)
+		{
+			soma[im->destinos[i]] += im->pesos[i];
+		}
+
+		CursorCompacto cursor;
+		int destino, lidas = 0;
+		PesoAresta peso;
+		IniciarCursorCompacto(c, u, &cursor);
+
+		while (ProximaAdjacenciaCompacta(&cursor, &destino, &peso))
+		{
+			VERIFICAR(destino >= 0 && destino < NUM_VERTICES);
+			soma[destino] -= peso;
+			lidas++;
+		}
+
+		VERIFICAR(lidas == im->inicio[u + 1] - im->inicio[u]);
+
+		for (int v = 0; v < NUM_VERTICES; v++)
+		{
+			VERIFICAR(soma[v] == 0);
+		}
+	}
+}
+
+/**
+ * @brief Guarda o ficheiro com os primeiros bytes de um conteúdo, alterando opcionalmente um byte.
+ *
+ * @param conteudo Conteúdo original.
+ * @param tamanho Número de bytes a escrever.
+ * @param posicao Posição do byte a alterar (-1 para não alterar).
+ * @param valor Novo valor do byte.
+ */
+static void EscreverFicheiro(unsigned char* conteudo, long tamanho, long posicao, unsigned char valor)
+{
+	FILE* fp = fopen(FICHEIRO, "wb");
+
+	if (fp == NULL)
+	{
+		VERIFICAR(fp != NULL);
+		return;
+	}
+
+	for (long i = 0; i < tamanho; i++)
+	{
+		fputc(i == posicao ? valor : conteudo[i], fp);
+	}
+
+	fclose(fp);
+}
+
+int main(void)
+{
+	bool inf;
+	Grafo* g = CriarGrafo(&inf);
+	unsigned s = 12345;
+
+	for (int i = 0; i < NUM_VERTICES; i++)
+	{
+		g = InserirVerticeGrafo(g, i, &inf);
+	}
+
+	for (int i = 0; i < NUM_ARESTAS; i++)
+	{
+		s = s * 1103515245u + 12345u;
+		int origem = (int)((s >> 8) % NUM_VERTICES);
+		s = s * 1103515245u + 12345u;
+		int destino = (int)((s >> 8) % NUM_VERTICES);
+		int peso = (int)((s >> 20) % 200) - 50;
+
+		if (peso != 0)
+		{
+			g = InserirAdjGrafo(g, origem, destino, peso, &inf);
+		}
+	}
+
+	//Ids eliminados ficam com blocos vazios; o último id passa a ser o maior
+	for (int i = 0; i < NUM_VERTICES - 1; i += 7)
+	{
+		g = EliminaVerticeGrafo(g, i, &inf);
+	}
+
+	ImagemGrafo* im = CriarImagemGrafo(g, &inf);
+	VERIFICAR(inf);
+	ImagemCompacta* original = CriarImagemCompacta(g, &inf);
+	VERIFICAR(inf);
+	VerificarAdjacencias(im, original);
+
+	VERIFICAR(GuardaImagemCompacta(original, FICHEIRO));
+	ImagemCompacta* carregada = CarregaImagemCompacta(FICHEIRO);
+	VERIFICAR(carregada != NULL);
+
+	if (carregada != NULL)
+	{
+		VerificarIguais(original, carregada);
+		VerificarAdjacencias(im, carregada);
+
+		int nivelOriginal[NUM_VERTICES], nivelCarregada[NUM_VERTICES];
+		VERIFICAR(LarguraCompacta(original, 1, -1, nivelOriginal) == LarguraCompacta(carregada, 1, -1, nivelCarregada));
+		VERIFICAR(memcmp(nivelOriginal, nivelCarregada, sizeof(nivelOriginal)) == 0);
+		ApagarImagemCompacta(carregada);
+	}
+
+	//Lê o ficheiro para o corromper
+	FILE* fp = fopen(FICHEIRO, "rb");
+	VERIFICAR(fp != NULL);
+	unsigned char* conteudo = NULL;
+	long tamanho = 0;
+
+	if (fp != NULL)
+	{
+		fseek(fp, 0, SEEK_END);
+		tamanho = ftell(fp);
+		fseek(fp, 0, SEEK_SET);
+		conteudo = malloc(tamanho);
+		VERIFICAR(conteudo != NULL && fread(conteudo, 1, tamanho, fp) == (size_t)tamanho);
+		fclose(fp);
+	}
+
+	if (conteudo != NULL)
+	{
+		//Um ficheiro cortado é recusado
+		EscreverFicheiro(conteudo, tamanho - 1, -1, 0);
+		VERIFICAR(CarregaImagemCompacta(FICHEIRO) == NULL);
+
+		//O primeiro destino do vértice 1 passa a ser o vértice eliminado 0 (diferença -1, 1 em zigzag)
+		long dados = tamanho - (long)original->inicio[original->tamanho];
+		long posicao = dados + (long)original->inicio[1];
+		VERIFICAR(conteudo[posicao] > 0 && conteudo[posicao] < 0x80 && conteudo[posicao + 1] < 0x80);
+		EscreverFicheiro(conteudo, tamanho, posicao + 1, 1);
+		ImagemCompacta* corrompida = CarregaImagemCompacta(FICHEIRO);
+		VERIFICAR(corrompida == NULL);
+		ApagarImagemCompacta(corrompida);
+
+		free(conteudo);
+	}
+
+	remove(FICHEIRO);
+	ApagarImagemCompacta(original);
+	ApagarImagemGrafo(im);
+	ApagaGrafo(g);
+	return RESULTADO_TESTE;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file componentes.c
+ * @author Hugo Cruz (a23010)
+ * @brief Teste das componentes fortemente conexas e conexas.
+ *
+ * O grafo tem três ciclos ligados num só sentido, um vértice isolado e um id livre. Os vértices
+ * de cada ciclo têm de ficar com o mesmo número, os de ciclos diferentes com números diferentes,
+ * e cada ligação entre componentes tem de ir de um número maior para um menor.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../Grafos/InputOutput.h"
+#include "../Grafos/componentes.h"
+#include "../Grafos/imagem.h"
+#include "testes.h"
+
+#define NUM_IDS 10
+
+int main(void)
+{
+	//Ciclos {0, 1, 2}, {3, 4} e {5, 6, 7}, ligados 2 -> 3 e 4 -> 5; 9 fica isolado e 8 não existe
+	int arestas[][3] = {
+		{0, 1, 1}, {1, 2, 1}, {2, 0, 1}, {2, 3, 1}, {3, 4, 1},
+		{4, 3, 1}, {4, 5, 1}, {5, 6, 1}, {6, 7, 1}, {7, 5, 1}
+	};
+	int grupo[NUM_IDS] = {0, 0, 0, 1, 1, 2, 2, 2, -1, 3};
+	bool inf;
+	Grafo* g = CriarGrafo(&inf);
+
+	for (int i = 0; i < NUM_IDS; i++)
+	{
+		if (grupo[i] >= 0)
+		{
+			g = InserirVerticeGrafo(g, i, &inf);
+		}
+	}
+
+	for (int i = 0; i < (int)(sizeof(arestas) / sizeof(arestas[0])); i++)
+	{
+		g = InserirAdjGrafo(g, arestas[i][0], arestas[i][1], arestas[i][2], &inf);
+		VERIFICAR(inf);
+	}
+
+	ImagemGrafo* im = CriarImagemGrafo(g, &inf);
+	VERIFICAR(inf);
+
+	Componentes* fortes = ComponentesFortes(im, &inf);
+	VERIFICAR(inf && fortes != NULL);
+
+	if (fortes != NULL)
+	{
+		VERIFICAR(fortes->tamanho == NUM_IDS);
+		VERIFICAR(fortes->numComponentes == 4);
+		VERIFICAR(fortes->componente[8] == -1);
+
+		for (int i = 0; i < NUM_IDS; i++)
+		{
+			for (int j = 0; j < NUM_IDS; j++)
+			{
+				if (grupo[i] >= 0 && grupo[j] >= 0)
+				{
+					VERIFICAR((fortes->componente[i] == fortes->componente[j]) == (grupo[i] == grupo[j]));
+				}
+			}
+		}
+
+		VERIFICAR(fortes->numMembros[fortes->componente[0]] == 3);
+		VERIFICAR(fortes->numMembros[fortes->componente[3]] == 2);
+		VERIFICAR(fortes->numMembros[fortes->componente[5]] == 3);
+		VERIFICAR(fortes->numMembros[fortes->componente[9]] == 1);
+
+		//Ordem topológica inversa
+		VERIFICAR(fortes->componente[2] > fortes->componente[3]);
+		VERIFICAR(fortes->componente[4] > fortes->componente[5]);
+
+		VERIFICAR(CaminhoPossivel(NULL, fortes, 0, 7));
+		VERIFICAR(!CaminhoPossivel(NULL, fortes, 7, 0));
+	}
+
+	Componentes* conexas = ComponentesConexas(im, NULL, NULL, &inf);
+	VERIFICAR(inf && conexas != NULL);
+
+	if (conexas != NULL)
+	{
+		VERIFICAR(conexas->numComponentes == 2);
+		VERIFICAR(conexas->componente[0] == conexas->componente[7]);
+		VERIFICAR(conexas->componente[0] != conexas->componente[9]);
+		VERIFICAR(conexas->componente[8] == -1);
+		VERIFICAR(!CaminhoPossivel(conexas, fortes, 0, 9));
+	}
+
+	ApagarComponentes(conexas);
+	ApagarComponentes(fortes);
+	ApagarImagemGrafo(im);
+	ApagaGrafo(g);
+	return RESULTADO_TESTE;
+}
@@ -0,0 +1,218 @@
+/**
+ * @file concorrente.c
+ * @author Hugo Cruz (a23010)
+ * @brief Teste de esforço da construção concorrente de um grafo.
+ *
+ * Oito threads inserem todos os vértices ao mesmo tempo, pelo que cada id é disputado por todas
+ * e só uma inserção pode ter sucesso. Depois as mesmas threads inserem adjacências com origens
+ * espalhadas por todas as faixas de bloqueio. O grafo concluído tem de ter cada vértice uma vez,
+ * por ordem de id, e cada origem com o número e a soma de pesos das adjacências inseridas. Com
+ * GRAFOS_SANITIZER=thread o teste serve também para o ThreadSanitizer verificar a sincronização.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <stdlib.h>
+#include <threads.h>
+#include "../Grafos/concorrente.h"
+#include "testes.h"
+
+#define NUM_THREADS 8
+#define NUM_VERTICES 5000
+#define NUM_ARESTAS 200000
+
+/**
+ * @brief Estado de uma thread escritora.
+ *
+ */
+typedef struct Escritor
+{
+	GrafoConcorrente* gc; ///< Construção partilhada.
+	int numero;			  ///< Número da thread (0 a NUM_THREADS - 1).
+	int vertices;		  ///< Número de vértices que esta thread conseguiu inserir.
+	int falhas;			  ///< Número de adjacências cuja inserção falhou.
+
+} Escritor;
+
+/**
+ * @brief Calcula a origem, o destino e o peso da adjacência com um dado índice.
+ *
+ * @param i Índice da adjacência.
+ * @param origem Apontador para a origem calculada.
+ * @param destino Apontador para o destino calculado.
+ * @param peso Apontador para o peso calculado.
+ */
+static void Aresta(int i, int* origem, int* destino, int* peso)
+{
+	unsigned s = (unsigned)i * 2654435761u;
+	*origem = (int)(s % NUM_VERTICES);
+	s = s * 1103515245u + 12345u;
+	*destino = (int)((s >> 8) % NUM_VERTICES);
+	*peso = 1 + i % 50;
+}
+
+/**
+ * @brief Função das threads: tenta inserir todos os vértices, começando num id diferente em cada thread.
+ *
+ * @param arg Apontador para o Escritor.
+ * @return int 0.
+ */
+static int InserirVertices(void* arg)
+{
+	Escritor* w = (Escritor*)arg;
+	bool inf;
+
+	//Cada thread começa num id diferente para as disputas acontecerem em toda a gama
+	for (int k = 0; k < NUM_VERTICES; k++)
+	{
+		InserirVerticeConcorrente(w->gc, (k + w->numero * (NUM_VERTICES / NUM_THREADS)) % NUM_VERTICES, &inf);
+
+		if (inf)
+		{
+			w->vertices++;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Função das threads: insere as adjacências de índice numero, numero + NUM_THREADS, ...
+ *
+ * @param arg Apontador para o Escritor.
+ * @return int 0.
+ */
+static int InserirArestas(void* arg)
+{
+	Escritor* w = (Escritor*)arg;
+	bool inf;
+
+	for (int i = w->numero; i < NUM_ARESTAS; i += NUM_THREADS)
+	{
+		int origem, destino, peso;
+		Aresta(i, &origem, &destino, &peso);
+		InserirAdjConcorrente(w->gc, origem, destino, peso, &inf);
+
+		if (!inf)
+		{
+			w->falhas++;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Executa uma função em NUM_THREADS threads e espera que todas terminem.
+ *
+ * @param funcao Função das threads.
+ * @param escritores Array com o estado de cada thread.
+ */
+static void ExecutarThreads(thrd_start_t funcao, Escritor escritores[])
+{
+	thrd_t threads[NUM_THREADS];
+
+	for (int i = 0; i < NUM_THREADS; i++)
+	{
+		VERIFICAR(thrd_create(&threads[i], funcao, &escritores[i]) == thrd_success);
+	}
+
+	for (int i = 0; i < NUM_THREADS; i++)
+	{
+		thrd_join(threads[i], NULL);
+	}
+}
+
+/**
+ * @brief Função principal do teste.
+ *
+ */
+int main()
+{
+	bool inf;
+	Grafo* g = CriarGrafo(&inf);
+	GrafoConcorrente* gc = IniciarConstrucaoConcorrente(g, NUM_VERTICES, &inf);
+	Escritor escritores[NUM_THREADS];
+
+	VERIFICAR(gc != NULL && inf);
+
+	if (gc == NULL)
+	{
+		return RESULTADO_TESTE;
+	}
+
+	for (int i = 0; i < NUM_THREADS; i++)
+	{
+		escritores[i].gc = gc;
+		escritores[i].numero = i;
+		escritores[i].vertices = 0;
+		escritores[i].falhas = 0;
+	}
+
+	ExecutarThreads(InserirVertices, escritores);
+	ExecutarThreads(InserirArestas, escritores);
+
+	int vertices = 0, falhas = 0;
+
+	for (int i = 0; i < NUM_THREADS; i++)
+	{
+		vertices += escritores[i].vertices;
+		falhas += escritores[i].falhas;
+	}
+
+	//Cada id só pode ter sido ganho por uma thread
+	VERIFICAR(vertices == NUM_VERTICES);
+	VERIFICAR(falhas == 0);
+
+	g = ConcluirConstrucaoConcorrente(gc, &inf);
+	VERIFICAR(g != NULL && inf);
+
+	//Número e soma de pesos esperados das adjacências de cada origem
+	int* numEsperado = (int*)calloc(NUM_VERTICES, sizeof(int));
+	long long* somaEsperada = (long long*)calloc(NUM_VERTICES, sizeof(long long));
+
+	for (int i = 0; i < NUM_ARESTAS; i++)
+	{
+		int origem, destino, peso;
+		Aresta(i, &origem, &destino, &peso);
+		numEsperado[origem]++;
+		somaEsperada[origem] += peso;
+	}
+
+	int esperado = 0;
+
+	for (Vertice* v = g->inicioGrafo; v != NULL; v = v->nextV)
+	{
+		//A lista de vértices fica por ordem de id, sem repetidos
+		VERIFICAR(v->id == esperado);
+		esperado++;
+
+		int num = 0;
+		long long soma = 0;
+
+		for (Adjacente* a = v->nextA; a != NULL; a = a->next)
+		{
+			VERIFICAR(a->id >= 0 && a->id < NUM_VERTICES);
+			num++;
+			soma += a->peso;
+		}
+
+		if (v->id >= 0 && v->id < NUM_VERTICES)
+		{
+			VERIFICAR(num == numEsperado[v->id]);
+			VERIFICAR(soma == somaEsperada[v->id]);
+		}
+	}
+
+	VERIFICAR(esperado == NUM_VERTICES);
+
+	free(numEsperado);
+	free(somaEsperada);
+	ApagaGrafo(g);
+
+	return RESULTADO_TESTE;
+}
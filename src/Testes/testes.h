@@ -0,0 +1,46 @@
+/**
+ * @file testes.h
+ * @author Hugo Cruz (a23010)
+ * @brief Macro de verificação partilhada pelos programas de teste.
+ *
+ * Cada programa de src/Testes é um teste registado no CTest: termina com 0 se todas as
+ * verificações passarem e com 1 se alguma falhar.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef TESTES_H
+#define TESTES_H
+
+#include <stdio.h>
+
+/**
+ * @brief Número de verificações que falharam no programa de teste.
+ */
+static int falhasTeste = 0;
+
+/**
+ * @def VERIFICAR
+ * @brief Verifica uma condição e, se for falsa, escreve a linha e a condição e conta a falha.
+ */
+#define VERIFICAR(condicao)                                                        \
+	do                                                                             \
+	{                                                                              \
+		if (!(condicao))                                                           \
+		{                                                                          \
+			fprintf(stderr, "%s:%d: falhou: %s\n", __FILE__, __LINE__, #condicao); \
+			falhasTeste++;                                                         \
+		}                                                                          \
+	} while (0)
+
+/**
+ * @def RESULTADO_TESTE
+ * @brief Código de saída do programa de teste (0 se nenhuma verificação falhou).
+ */
+#define RESULTADO_TESTE (falhasTeste == 0 ? 0 : 1)
+
+#endif